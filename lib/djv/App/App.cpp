@@ -4,19 +4,25 @@
 #include <djv/App/App.h>
 
 #include <djv/App/AudioTool.h>
+#include <djv/App/BatchExport.h>
 #include <djv/App/Benchmark.h>
+#include <djv/App/BenchmarkSuite.h>
 #include <djv/App/Capture.h>
 #include <djv/App/ColorPickerTool.h>
 #include <djv/App/ColorTool.h>
 #include <djv/App/DiagTool.h>
 #include <djv/App/ExportTool.h>
 #include <djv/App/FilesTool.h>
+#include <djv/App/FrameCache.h>
 #include <djv/App/InfoTool.h>
 #include <djv/App/MagnifyTool.h>
 #include <djv/App/MainWindow.h>
 #include <djv/App/MessagesTool.h>
+#include <djv/App/ScopesTool.h>
 #include <djv/App/SecondaryWindow.h>
+#include <djv/App/SeqWatcher.h>
 #include <djv/App/SettingsTool.h>
+#include <djv/App/StartupTrace.h>
 #include <djv/App/Indicator.h>
 #include <djv/App/SysLogTool.h>
 #include <djv/App/ViewTool.h>
@@ -24,9 +30,17 @@
 #include <djv/UI/SeparateAudioDialog.h>
 #include <djv/Models/AppInfoModel.h>
 #include <djv/Models/AudioModel.h>
+#include <djv/Models/CacheWarmUpModel.h>
 #include <djv/Models/ColorModel.h>
+#include <djv/Models/CompressedImageCache.h>
 #include <djv/Models/FilesModel.h>
+#include <djv/Models/FrameBufferPool.h>
+#include <djv/Models/MemoryModel.h>
+#include <djv/Models/ReadThreadModel.h>
 #include <djv/Models/RecentFilesModel.h>
+#include <djv/Models/SeqCache.h>
+#include <djv/Models/ThreadPool.h>
+#include <djv/Models/ThumbnailDiskCache.h>
 #include <djv/Models/TimeUnitsModel.h>
 #include <djv/Models/CommandsModel.h>
 #include <djv/Models/ToolsModel.h>
@@ -56,8 +70,15 @@
 #include <ftk/Core/OS.h>
 #include <ftk/Core/Timer.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <filesystem>
+#include <future>
+#include <map>
 #include <optional>
+#include <set>
+#include <unordered_map>
 
 #if defined(__GLIBC__)
 #include <malloc.h>
@@ -76,6 +97,7 @@ namespace djv
             std::shared_ptr<ftk::CmdLineOption<ftk::V2F> > wipeCenter;
             std::shared_ptr<ftk::CmdLineOption<float> > wipeRotation;
             std::shared_ptr<ftk::CmdLineOption<std::string> > frameRange;
+            std::shared_ptr<ftk::CmdLineFlag> watch;
             std::shared_ptr<ftk::CmdLineOption<double> > speed;
             std::shared_ptr<ftk::CmdLineOption<tl::Playback> > playback;
             std::shared_ptr<ftk::CmdLineOption<tl::Loop> > loop;
@@ -108,13 +130,109 @@ namespace djv
             std::shared_ptr<ftk::CmdLineListOption<std::string> > command;
             std::shared_ptr<ftk::CmdLineOption<int> > debugLoop;
             std::shared_ptr<ftk::CmdLineOption<double> > benchmark;
+            std::shared_ptr<ftk::CmdLineOption<std::string> > benchmarkOutput;
+            std::shared_ptr<ftk::CmdLineOption<std::string> > benchmarkManifest;
+            std::shared_ptr<ftk::CmdLineOption<std::string> > benchmarkBaseline;
+            std::shared_ptr<ftk::CmdLineOption<double> > benchmarkTolerance;
             std::shared_ptr<ftk::CmdLineOption<std::string> > captureManifest;
             std::shared_ptr<ftk::CmdLineOption<std::string> > captureShot;
             std::shared_ptr<ftk::CmdLineOption<std::string> > captureOutput;
+            std::shared_ptr<ftk::CmdLineOption<std::string> > startupTrace;
+            std::shared_ptr<ftk::CmdLineOption<models::ExportFileType> > exportFileType;
+            std::shared_ptr<ftk::CmdLineOption<std::string> > exportDir;
+            std::shared_ptr<ftk::CmdLineOption<int> > exportWidth;
         };
 
         namespace
         {
+            // Opening is mostly waiting on the disk -- listing a directory
+            // for a sequence's frames and reading a header -- rather than
+            // work for the processor, so this is not tied to the number of
+            // cores. It is kept modest so that a drop of many shots does not
+            // swamp a file server with requests.
+            const size_t openThreadCount = 8;
+
+            // The most the player keeps uncompressed when the cache mode is
+            // compressed: around thirty 4K half float frames to read ahead
+            // with.
+            const float compressedReadAheadGB = 2.F;
+
+            // The least the current file is cut back to when the memory
+            // budget is short, which is still a second or two of 4K.
+            const float playerMinGB = 1.F;
+
+            // With adaptive resolution, frames being dropped while at least
+            // this many seconds are cached ahead of the frame being played
+            // is taken as drawing, rather than reading, having fallen behind
+            // playback. Once this many seconds have gone by at a reduced
+            // resolution without frames being dropped, the next one up is
+            // tried.
+            const double behindSeconds = 1.0;
+            const int catchUpSeconds = 4;
+            const int decimationMax = 4;
+
+            // Create the timeline for a file. Given copies of what it needs
+            // from the item, so that it can be called from any thread.
+            std::shared_ptr<tl::Timeline> createTimeline(
+                const std::shared_ptr<ftk::Context>& context,
+                const std::shared_ptr<StartupTrace>& trace,
+                const std::shared_ptr<models::SeqCache>& seqCache,
+                ftk::Path path,
+                const ftk::Path& audioPath,
+                bool framesStated,
+                const tl::Options& options)
+            {
+                // A range that was asked for is used as it is. One that was
+                // not is looked for on disk again here, so that reopening
+                // picks up frames rendered since -- the path holds the frames
+                // that were there when it was opened, and findSeq() is what
+                // goes and looks.
+                if (!framesStated && path.isSeq())
+                {
+                    StartupSpan span(
+                        trace,
+                        ftk::Format("Find sequence: {0}").arg(path.getFileName()),
+                        "files");
+                    // A sequence that has gone from disk keeps the range it
+                    // had rather than becoming a timeline of nothing. The
+                    // cache only lists the directory again when it has
+                    // changed.
+                    path = seqCache->findSeq(path, options.pathOptions);
+                }
+                StartupSpan span(
+                    trace,
+                    ftk::Format("Timeline: {0}").arg(path.getFileName()),
+                    "files");
+                return tl::Timeline::create(context, path, audioPath, options);
+            }
+
+            typedef std::pair<std::shared_ptr<tl::Timeline>, std::string> OpenResult;
+
+            // A file being opened on the open threads. It is run by
+            // whichever gets to it first: one of the threads, or a caller
+            // that has to wait for it and would otherwise be waiting for
+            // the queue to get round to it as well.
+            struct OpenRequest
+            {
+                std::shared_ptr<models::FilesModelItem> file;
+                std::atomic<bool> started{ false };
+                std::packaged_task<OpenResult()> task;
+                std::future<OpenResult> future;
+            };
+
+            void runOpen(OpenRequest& request)
+            {
+                if (!request.started.exchange(true))
+                {
+                    request.task();
+                }
+            }
+
+            uint64_t toBytes(float gb)
+            {
+                return static_cast<uint64_t>(std::max(gb, 0.F) * 1024.0 * 1024.0 * 1024.0);
+            }
+
             // "1-100", and "-10-20" for a sequence starting before zero. The
             // separator is the first dash after the first character, so a
             // negative start is not mistaken for it.
@@ -175,6 +293,7 @@ namespace djv
         struct App::Private
         {
             CmdLine cmdLine;
+            std::shared_ptr<StartupTrace> startupTrace;
 
             std::shared_ptr<models::AppInfoModel> appInfoModel;
             std::shared_ptr<models::SettingsModel> settingsModel;
@@ -184,8 +303,63 @@ namespace djv
             std::vector<std::shared_ptr<models::FilesModelItem> > files;
             std::vector<std::shared_ptr<models::FilesModelItem> > activeFiles;
             std::shared_ptr<models::RecentFilesModel> recentFilesModel;
-            std::vector<std::shared_ptr<tl::Timeline> > timelines;
+            std::shared_ptr<models::SeqCache> seqCache;
+            std::shared_ptr<SeqWatcher> seqWatcher;
+            std::shared_ptr<models::ThumbnailDiskCache> thumbnailDiskCache;
+            std::shared_ptr<models::FrameBufferPool> frameBufferPool;
+            std::shared_ptr<FrameCache> frameCache;
+            std::shared_ptr<models::MemoryModel> memoryModel;
+            // The memory accounts of the caches the application owns, and
+            // the budgets they were last given.
+            std::set<std::string> memoryAccounts;
+            std::map<std::string, uint64_t> memoryBudgets;
+            bool memoryUpdating = false;
+            // The frames on disk when a watched sequence was last looked at.
+            std::map<std::shared_ptr<models::FilesModelItem>, ftk::RangeI64> watchFrames;
+            // The timelines of the open files, by the ID of their item, so
+            // that finding one does not mean searching the files.
+            std::unordered_map<uint64_t, std::shared_ptr<tl::Timeline> > timelines;
+            // The IDs of the files without a timeline yet, those left for
+            // lazy opening and those being opened, and the files being
+            // opened on the open threads.
+            std::set<uint64_t> unopened;
+            std::map<uint64_t, std::shared_ptr<OpenRequest> > opening;
+            std::shared_ptr<models::ThreadPool> openThreadPool;
+            std::shared_ptr<ftk::Timer> openTimer;
             std::shared_ptr<ftk::Observable<std::shared_ptr<tl::Player> > > player;
+            // The fraction of the full resolution frames are read at, and
+            // what has been seen since it last changed: the frames dropped,
+            // the seconds since one was, and how often drawing has fallen
+            // behind at each fraction in this run of playback. Whether
+            // frames have been read reduced, and are in the player's cache
+            // that way, is kept until the cache is read again.
+            std::shared_ptr<ftk::Observable<int> > decimation;
+            bool decimated = false;
+            struct Resolution
+            {
+                bool valid = false;
+                std::chrono::steady_clock::time_point time;
+                size_t dropped = 0;
+                int steady = 0;
+                std::map<int, int> behind;
+            };
+            Resolution resolution;
+            std::shared_ptr<ftk::Observer<tl::Playback> > playbackObserver;
+            std::shared_ptr<ftk::Observer<models::PlaybackSettings> > playbackSettingsObserver;
+            // Filling the cache over the in/out range before it is played.
+            // It is checked on a timer rather than when the cache changes,
+            // since a cache that has filled up stops changing.
+            std::shared_ptr<models::CacheWarmUpModel> cacheWarmUpModel;
+            std::shared_ptr<ftk::Timer> cacheWarmUpTimer;
+            // Players kept ready for the files either side of the current
+            // one, with the timeline each was made from so that one left
+            // behind by a reload is not used.
+            struct Prefetch
+            {
+                std::shared_ptr<tl::Timeline> timeline;
+                std::shared_ptr<tl::Player> player;
+            };
+            std::map<std::shared_ptr<models::FilesModelItem>, Prefetch> prefetch;
             std::shared_ptr<models::ColorModel> colorModel;
             std::shared_ptr<models::ViewportModel> viewportModel;
             std::shared_ptr<models::AudioModel> audioModel;
@@ -200,7 +374,26 @@ namespace djv
             std::shared_ptr<ui::SeparateAudioDialog> separateAudioDialog;
 
             std::shared_ptr<ftk::Observer<tl::PlayerCacheOptions> > cacheObserver;
+            std::shared_ptr<ftk::Observer<models::DiskCacheSettings> > diskCacheObserver;
+            std::shared_ptr<ftk::Observer<models::PrefetchSettings> > prefetchObserver;
+            std::shared_ptr<ftk::Observer<models::FrameCacheSettings> > frameCacheObserver;
+            std::shared_ptr<ftk::Observer<tl::ui::ThumbnailCacheOptions> > thumbnailCacheObserver;
+            std::shared_ptr<ftk::Observer<models::MemorySettings> > memoryObserver;
+            std::shared_ptr<ftk::ListObserver<models::MemoryUsage> > memoryUsageObserver;
+            std::shared_ptr<ftk::Observer<tl::PlayerCacheInfo> > cacheInfoObserver;
             std::shared_ptr<ftk::Observer<models::ImageSeqSettings> > imageSeqObserver;
+            // The number of threads sequences are read with, found for each
+            // storage by measuring how fast the current file's cache fills.
+            std::shared_ptr<models::ReadThreadModel> readThreadModel;
+            std::vector<std::string> mounts;
+            struct ReadSample
+            {
+                std::string storage;
+                size_t count = 0;
+                std::chrono::steady_clock::time_point time;
+                double frames = 0.0;
+            };
+            ReadSample readSample;
             // The policy the open files were built with, so that a change to
             // or from Skip can be told apart from the rest.
             tl::MissingFrames missingFrames = tl::MissingFrames::First;
@@ -221,9 +414,6 @@ namespace djv
 
             std::shared_ptr<ftk::Timer> debugTimer;
             int debugInput = 0;
-#if defined(__GLIBC__)
-            std::shared_ptr<ftk::Timer> trimTimer;
-#endif // __GLIBC__
 
             std::shared_ptr<ftk::Timer> commandTimer;
             //! Files whose timeline could not be created, closed on a
@@ -241,6 +431,9 @@ namespace djv
         {
             FTK_P();
 
+            // First, so that everything after it can be traced.
+            p.startupTrace = StartupTrace::create(context);
+
             p.appInfoModel = appInfoModel ? appInfoModel : models::AppInfoModel::create();
 
             p.cmdLine.inputs = ftk::CmdLineListArg<std::string>::create(
@@ -280,6 +473,11 @@ namespace djv
                 "following the missing frames setting. Applies to the first "
                 "file opened.",
                 "Playback");
+            p.cmdLine.watch = ftk::CmdLineFlag::create(
+                { "-watch" },
+                "Watch the image sequences opened for new frames, such as a "
+                "render in progress.",
+                "Playback");
             p.cmdLine.speed = ftk::CmdLineOption<double>::create(
                 { "-speed" },
                 "Playback speed.",
@@ -419,6 +617,27 @@ namespace djv
                 "rate achieved.",
                 "Benchmark",
                 5.0);
+            p.cmdLine.benchmarkOutput = ftk::CmdLineOption<std::string>::create(
+                { "-benchmarkOutput" },
+                "Benchmark output file (JSON). The standard output is used "
+                "when this is not given.",
+                "Benchmark");
+            p.cmdLine.benchmarkManifest = ftk::CmdLineOption<std::string>::create(
+                { "-benchmarkManifest" },
+                "Run the scenarios of a benchmark manifest (JSON) one after "
+                "the other and exit.",
+                "Benchmark");
+            p.cmdLine.benchmarkBaseline = ftk::CmdLineOption<std::string>::create(
+                { "-benchmarkBaseline" },
+                "Compare the manifest results with a stored output file, and "
+                "fail if any of them regressed.",
+                "Benchmark");
+            p.cmdLine.benchmarkTolerance = ftk::CmdLineOption<double>::create(
+                { "-benchmarkTolerance" },
+                "How far a result may fall behind the baseline, as a "
+                "percentage, before it counts as a regression.",
+                "Benchmark",
+                10.0);
             p.cmdLine.captureManifest = ftk::CmdLineOption<std::string>::create(
                 { "-captureManifest" },
                 "Screenshot manifest (JSON).",
@@ -431,7 +650,32 @@ namespace djv
                 { "-captureOutput" },
                 "Output directory for PNG + JSON.", "Capture",
                 std::string("."));
-
+            p.cmdLine.startupTrace = ftk::CmdLineOption<std::string>::create(
+                { "-startupTrace" },
+                "Write how long starting up took to a Chrome trace event "
+                "file (JSON), which chrome://tracing and Perfetto can open.",
+                "Testing");
+            p.cmdLine.exportFileType = ftk::CmdLineOption<models::ExportFileType>::create(
+                { "-export" },
+                "Export the in/out range of the inputs without opening a "
+                "window, then exit. The file names, codec, and render size "
+                "come from the export settings; existing files are "
+                "overwritten.",
+                "Export",
+                std::optional<models::ExportFileType>(),
+                ftk::quotes(models::getExportFileTypeLabels()));
+            p.cmdLine.exportDir = ftk::CmdLineOption<std::string>::create(
+                { "-exportDir" },
+                "Export directory.",
+                "Export");
+            p.cmdLine.exportWidth = ftk::CmdLineOption<int>::create(
+                { "-exportWidth" },
+                "Export render width. The height follows the aspect ratio.",
+                "Export");
+
+            // Timed by hand rather than with a span, which would end after
+            // the trace is turned off for want of an output file.
+            const auto initStart = std::chrono::steady_clock::now();
             ftk::App::_init(
                 context,
                 argv,
@@ -450,6 +694,7 @@ namespace djv
                     p.cmdLine.timeUnits,
                     p.cmdLine.seek,
                     p.cmdLine.frameRange,
+                    p.cmdLine.watch,
                     p.cmdLine.inPoint,
                     p.cmdLine.outPoint,
 #if defined(TLRENDER_OCIO)
@@ -477,14 +722,30 @@ namespace djv
                     p.cmdLine.command,
                     p.cmdLine.debugLoop,
                     p.cmdLine.benchmark,
+                    p.cmdLine.benchmarkOutput,
+                    p.cmdLine.benchmarkManifest,
+                    p.cmdLine.benchmarkBaseline,
+                    p.cmdLine.benchmarkTolerance,
                     p.cmdLine.captureManifest,
                     p.cmdLine.captureShot,
-                    p.cmdLine.captureOutput
+                    p.cmdLine.captureOutput,
+                    p.cmdLine.startupTrace,
+                    p.cmdLine.exportFileType,
+                    p.cmdLine.exportDir,
+                    p.cmdLine.exportWidth
                 },
                 ftk::AppFiles{
                     p.appInfoModel->getDocsDirName(),
                     p.appInfoModel->getShortName(),
                     p.appInfoModel->getVersionMajor() });
+            p.startupTrace->addSpan(
+                "Settings file and command line",
+                "startup",
+                initStart,
+                std::chrono::steady_clock::now());
+            p.startupTrace->setOutput(p.cmdLine.startupTrace->found() ?
+                std::filesystem::u8path(p.cmdLine.startupTrace->getValue()) :
+                std::filesystem::path());
         }
 
         App::App() :
@@ -535,6 +796,36 @@ namespace djv
             return _p->recentFilesModel;
         }
 
+        const std::shared_ptr<models::SeqCache>& App::getSeqCache() const
+        {
+            return _p->seqCache;
+        }
+
+        const std::shared_ptr<models::ThumbnailDiskCache>& App::getThumbnailDiskCache() const
+        {
+            return _p->thumbnailDiskCache;
+        }
+
+        const std::shared_ptr<FrameCache>& App::getFrameCache() const
+        {
+            return _p->frameCache;
+        }
+
+        const std::shared_ptr<models::FrameBufferPool>& App::getFrameBufferPool() const
+        {
+            return _p->frameBufferPool;
+        }
+
+        const std::shared_ptr<models::MemoryModel>& App::getMemoryModel() const
+        {
+            return _p->memoryModel;
+        }
+
+        const std::shared_ptr<models::CacheWarmUpModel>& App::getCacheWarmUpModel() const
+        {
+            return _p->cacheWarmUpModel;
+        }
+
         const std::shared_ptr<models::ColorModel>& App::getColorModel() const
         {
             return _p->colorModel;
@@ -567,7 +858,9 @@ namespace djv
                 _p->cmdLine.listCommands->found() ||
                 _p->cmdLine.command->found() ||
                 _p->cmdLine.captureShot->found() ||
-                _p->cmdLine.benchmark->found();
+                _p->cmdLine.benchmark->found() ||
+                _p->cmdLine.benchmarkManifest->found() ||
+                _p->cmdLine.exportFileType->found();
         }
 
         void App::openDialog()
@@ -622,6 +915,29 @@ namespace djv
             bool gatherSeq)
         {
             FTK_P();
+            p.filesModel->add(_getOpenItems(path, audioPath, frames, gatherSeq));
+        }
+
+        void App::open(const std::vector<ftk::Path>& paths)
+        {
+            FTK_P();
+            std::vector<std::shared_ptr<models::FilesModelItem> > items;
+            for (const auto& path : paths)
+            {
+                const auto tmp = _getOpenItems(path, ftk::Path(), std::nullopt, true);
+                items.insert(items.end(), tmp.begin(), tmp.end());
+            }
+            p.filesModel->add(items);
+        }
+
+        std::vector<std::shared_ptr<models::FilesModelItem> > App::_getOpenItems(
+            const ftk::Path& path,
+            const ftk::Path& audioPath,
+            const std::optional<ftk::RangeI64>& frames,
+            bool gatherSeq)
+        {
+            FTK_P();
+            std::vector<std::shared_ptr<models::FilesModelItem> > out;
             ftk::DirListOptions dirListOptions;
             dirListOptions.seqExts = tl::getExts(_context, static_cast<int>(tl::FileType::Seq));
             dirListOptions.seqMaxDigits = p.settingsModel->getImageSeq().maxDigits;
@@ -630,7 +946,7 @@ namespace djv
             // stated range has already said what it wants.
             dirListOptions.seq = gatherSeq && !frames.has_value();
             bool first = true;
-            for (const auto& i : tl::getPaths(_context, path, dirListOptions))
+            for (const auto& i : p.seqCache->getPaths(_context, path, dirListOptions))
             {
                 auto item = std::make_shared<models::FilesModelItem>();
                 item->path = i;
@@ -645,8 +961,9 @@ namespace djv
                 }
                 first = false;
                 item->audioPath = audioPath;
-                p.filesModel->add(item);
+                out.push_back(item);
             }
+            return out;
         }
 
         void App::reload()
@@ -661,13 +978,7 @@ namespace djv
             const auto files = p.files;
             for (const auto& i : activeFiles)
             {
-                const auto j = std::find(p.files.begin(), p.files.end(), i);
-                if (j != p.files.end())
-                {
-                    const size_t index = j - p.files.begin();
-                    p.files.erase(j);
-                    p.timelines.erase(p.timelines.begin() + index);
-                }
+                p.timelines.erase(i->id);
             }
             p.activeFiles.clear();
             std::optional<int64_t> frame;
@@ -713,7 +1024,10 @@ namespace djv
             // The items are the same objects holding different things now --
             // a reload finds the frames again, so the range can have changed
             // -- and the list of them did not change, so say so.
-            p.filesModel->refresh();
+            for (const auto& i : activeFiles)
+            {
+                p.filesModel->refresh(i);
+            }
 
             if (frame.has_value())
             {
@@ -742,11 +1056,61 @@ namespace djv
             return _p->player;
         }
 
+        std::shared_ptr<ftk::IObservable<int> > App::observeDecimation() const
+        {
+            return _p->decimation;
+        }
+
+        void App::warmUpCache(bool play)
+        {
+            FTK_P();
+            auto player = p.player->get();
+            if (!player)
+                return;
+
+            // Held at the in point, so that the cache fills ahead of it,
+            // and at the full resolution, which is what will be played.
+            cancelCacheWarmUp();
+            player->stop();
+            _setDecimation(1);
+            player->seek(player->getInOutRange().start_time());
+            p.cacheWarmUpModel->start(play);
+            _context->log("djv::app::App", "Warming up the cache");
+
+            if (!p.cacheWarmUpTimer)
+            {
+                p.cacheWarmUpTimer = ftk::Timer::create(_context);
+                p.cacheWarmUpTimer->setRepeating(true);
+            }
+            p.cacheWarmUpTimer->start(
+                std::chrono::milliseconds(250),
+                [this] { _cacheWarmUpUpdate(); });
+        }
+
+        void App::cancelCacheWarmUp()
+        {
+            FTK_P();
+            if (p.cacheWarmUpTimer)
+            {
+                p.cacheWarmUpTimer->stop();
+            }
+            if (p.cacheWarmUpModel->observeWarmUp()->get().active)
+            {
+                p.cacheWarmUpModel->cancel();
+                _context->log("djv::app::App", "Cache warm-up cancelled");
+            }
+        }
+
         const std::shared_ptr<ToolWidgetFactory>& App::getToolWidgetFactory() const
         {
             return _p->toolWidgetFactory;
         }
 
+        const std::shared_ptr<StartupTrace>& App::getStartupTrace() const
+        {
+            return _p->startupTrace;
+        }
+
         std::shared_ptr<Indicator> App::createIndicator()
         {
             return Indicator::create(
@@ -773,7 +1137,8 @@ namespace djv
                 {
                     p.secondaryWindow = SecondaryWindow::create(
                         _context,
-                        std::dynamic_pointer_cast<App>(shared_from_this()));
+                        std::dynamic_pointer_cast<App>(shared_from_this()),
+                        p.mainWindow);
                     p.secondaryWindow->setCloseCallback(
                         [this]
                         {
@@ -924,11 +1289,22 @@ namespace djv
         {
             FTK_P();
 
-            _modelsInit();
-            _observersInit();
-            _inputFilesInit();
-            
-            _uiInit();
+            {
+                StartupSpan span(p.startupTrace, "Models");
+                _modelsInit();
+            }
+            {
+                StartupSpan span(p.startupTrace, "Observers");
+                _observersInit();
+            }
+            {
+                StartupSpan span(p.startupTrace, "Input files");
+                _inputFilesInit();
+            }
+            {
+                StartupSpan span(p.startupTrace, "Tools");
+                _uiInit();
+            }
 
             if (p.cmdLine.version->found())
             {
@@ -940,8 +1316,36 @@ namespace djv
                 std::cout << ftk::join(getSysInfo(), '\n') << std::endl;
                 return;
             }
+            else if (p.cmdLine.exportFileType->found())
+            {
+                // The overrides are for this run only, so they go to a copy
+                // rather than back into the saved settings.
+                models::ExportSettings settings = p.settingsModel->getExport();
+                if (p.cmdLine.exportDir->found())
+                {
+                    settings.dir = p.cmdLine.exportDir->getValue();
+                }
+                if (p.cmdLine.exportWidth->found())
+                {
+                    settings.renderSize = models::ExportRenderSize::Custom;
+                    settings.customWidth = p.cmdLine.exportWidth->getValue();
+                }
+                auto batchExport = BatchExport::create(
+                    _context,
+                    std::dynamic_pointer_cast<App>(shared_from_this()),
+                    settings,
+                    p.cmdLine.exportFileType->getValue());
+                if (!batchExport->run())
+                {
+                    throw std::runtime_error("The export failed");
+                }
+                return;
+            }
             
-            _mainWindowInit();
+            {
+                StartupSpan span(p.startupTrace, "Main window");
+                _mainWindowInit();
+            }
 
             if (p.cmdLine.listCommands->found())
             {
@@ -1048,7 +1452,10 @@ namespace djv
             {
                 auto benchmark = Benchmark::create(
                     _context, std::dynamic_pointer_cast<App>(shared_from_this()),
-                    p.cmdLine.benchmark->getValue());
+                    p.cmdLine.benchmark->getValue(),
+                    p.cmdLine.benchmarkOutput->found() ?
+                        p.cmdLine.benchmarkOutput->getValue() :
+                        std::string());
                 if (!benchmark->begin())
                 {
                     throw std::runtime_error("Cannot set up the benchmark");
@@ -1061,6 +1468,31 @@ namespace djv
                 return;
             }
 
+            if (p.cmdLine.benchmarkManifest->found())
+            {
+                auto benchmarkSuite = BenchmarkSuite::create(
+                    _context,
+                    std::dynamic_pointer_cast<App>(shared_from_this()),
+                    p.cmdLine.benchmarkManifest->getValue(),
+                    p.cmdLine.benchmarkOutput->found() ?
+                        p.cmdLine.benchmarkOutput->getValue() :
+                        std::string(),
+                    p.cmdLine.benchmarkBaseline->found() ?
+                        p.cmdLine.benchmarkBaseline->getValue() :
+                        std::string(),
+                    p.cmdLine.benchmarkTolerance->getValue());
+                if (!benchmarkSuite->begin())
+                {
+                    throw std::runtime_error("Cannot set up the benchmark suite");
+                }
+                ftk::App::run();
+                if (!benchmarkSuite->succeeded())
+                {
+                    throw std::runtime_error("The benchmark suite failed or regressed");
+                }
+                return;
+            }
+
             if (p.cmdLine.captureShot->found())
             {
                 auto capture = Capture::create(
@@ -1083,16 +1515,21 @@ namespace djv
             }
 
             ftk::App::run();
+            // Written at the first frame drawn, unless there never was one.
+            p.startupTrace->finish();
         }
 
         void App::_modelsInit()
         {
             FTK_P();
 
-            p.settingsModel = models::SettingsModel::create(
-                _context,
-                getSettings(),
-                getDefaultDisplayScale());
+            {
+                StartupSpan span(p.startupTrace, "Settings model");
+                p.settingsModel = models::SettingsModel::create(
+                    _context,
+                    getSettings(),
+                    getDefaultDisplayScale());
+            }
             if (getColorStyleCmdLineOption()->found() ||
                 getDisplayScaleCmdLineOption()->found())
             {
@@ -1157,15 +1594,57 @@ namespace djv
             p.filesModel = models::FilesModel::create(getSettings());
 
             p.recentFilesModel = models::RecentFilesModel::create(_context, getSettings());
+
+            p.seqCache = models::SeqCache::create();
+            p.readThreadModel = models::ReadThreadModel::create(
+                getSettings(),
+                p.settingsModel->getImageSeq().readThreadCount);
+            p.mounts = models::getMounts();
+            p.openThreadPool = models::ThreadPool::create(openThreadCount);
+            p.openTimer = ftk::Timer::create(_context);
+            p.openTimer->setRepeating(true);
+            p.seqWatcher = SeqWatcher::create(_context);
+            p.seqWatcher->setCallback(
+                [this](const std::vector<std::string>& value)
+                {
+                    _watchChanged(value);
+                });
+
+            p.thumbnailDiskCache = models::ThumbnailDiskCache::create(
+                models::ThumbnailDiskCache::getDefaultDir());
+#if defined(__GLIBC__)
+            // The frames the read plugins decode are still allocated with
+            // malloc. With the threshold fixed, rather than raised each
+            // time a large block is freed, glibc maps frames on their own
+            // and unmaps them when they are freed, instead of keeping them
+            // in the heap after the file that used them is closed.
+            mallopt(M_MMAP_THRESHOLD, 4 * 1024 * 1024);
+#endif // __GLIBC__
+            p.frameBufferPool = models::FrameBufferPool::create();
+            p.frameCache = FrameCache::create(
+                _context,
+                FrameCache::getDefaultDir(),
+                p.frameBufferPool);
+            p.memoryModel = models::MemoryModel::create();
+            p.cacheWarmUpModel = models::CacheWarmUpModel::create();
+
             auto fileBrowserSystem = _context->getSystem<ftk::FileBrowserSystem>();
-            fileBrowserSystem->getModel()->setExts(tl::getExts(_context));
+            std::vector<std::string> exts;
+            std::vector<std::string> seqExts;
+            {
+                // Asks every plugin what it reads.
+                StartupSpan span(p.startupTrace, "Plugin extensions");
+                exts = tl::getExts(_context);
+                seqExts = tl::getExts(_context, static_cast<int>(tl::FileType::Seq));
+            }
+            fileBrowserSystem->getModel()->setExts(exts);
             // From what the settings restored rather than from a fresh set:
             // the sequence extensions are the build's to say and cannot come
             // from a settings file, but everything else in there is the
             // user's and was just loaded.
             ftk::FileBrowserOptions fileBrowserOptions =
                 fileBrowserSystem->getModel()->getOptions();
-            fileBrowserOptions.dirList.seqExts = tl::getExts(_context, static_cast<int>(tl::FileType::Seq));
+            fileBrowserOptions.dirList.seqExts = seqExts;
             fileBrowserSystem->getModel()->setOptions(fileBrowserOptions);
             fileBrowserSystem->setRecentFilesModel(p.recentFilesModel);
 
@@ -1232,14 +1711,87 @@ namespace djv
             FTK_P();
 
             p.player = ftk::Observable<std::shared_ptr<tl::Player> >::create();
+            p.decimation = ftk::Observable<int>::create(1);
+
+            p.playbackSettingsObserver = ftk::Observer<models::PlaybackSettings>::create(
+                p.settingsModel->observePlayback(),
+                [this](const models::PlaybackSettings& value)
+                {
+                    if (!value.adaptiveResolution)
+                    {
+                        _setDecimation(1);
+                    }
+                },
+                ftk::ObserverAction::Suppress);
 
             p.cacheObserver = ftk::Observer<tl::PlayerCacheOptions>::create(
                 p.settingsModel->observeCache(),
-                [this](const tl::PlayerCacheOptions& value)
+                [this](const tl::PlayerCacheOptions&)
                 {
-                    if (auto player = _p->player->get())
+                    _prefetchUpdate();
+                });
+
+            p.diskCacheObserver = ftk::Observer<models::DiskCacheSettings>::create(
+                p.settingsModel->observeDiskCache(),
+                [this](const models::DiskCacheSettings& value)
+                {
+                    FTK_P();
+                    p.thumbnailDiskCache->setMaxMB(value.thumbnailMB);
+                    p.frameCache->setDiskDir(value.frameDir.empty() ?
+                        FrameCache::getDefaultDir() :
+                        std::filesystem::u8path(value.frameDir));
+                    p.frameCache->setDiskMaxGB(value.frameGB);
+                });
+
+            p.prefetchObserver = ftk::Observer<models::PrefetchSettings>::create(
+                p.settingsModel->observePrefetch(),
+                [this](const models::PrefetchSettings&)
+                {
+                    _prefetchUpdate();
+                });
+
+            p.frameCacheObserver = ftk::Observer<models::FrameCacheSettings>::create(
+                p.settingsModel->observeFrameCache(),
+                [this](const models::FrameCacheSettings&)
+                {
+                    _memoryUpdate();
+                });
+
+            p.thumbnailCacheObserver = ftk::Observer<tl::ui::ThumbnailCacheOptions>::create(
+                p.settingsModel->observeThumbnailCache(),
+                [this](const tl::ui::ThumbnailCacheOptions&)
+                {
+                    _memoryUpdate();
+                });
+
+            p.memoryObserver = ftk::Observer<models::MemorySettings>::create(
+                p.settingsModel->observeMemory(),
+                [this](const models::MemorySettings& value)
+                {
+                    _p->memoryModel->setBudget(toBytes(value.budgetGB));
+                });
+
+            // Other accounts, an export for one, change what the caches
+            // here are given.
+            p.memoryUsageObserver = ftk::ListObserver<models::MemoryUsage>::create(
+                p.memoryModel->observeUsage(),
+                [this](const std::vector<models::MemoryUsage>& value)
+                {
+                    FTK_P();
+                    if (p.memoryUpdating)
+                        return;
+                    bool changed = false;
+                    for (const auto& usage : value)
+                    {
+                        if (p.memoryAccounts.count(usage.id))
+                        {
+                            const auto i = p.memoryBudgets.find(usage.id);
+                            changed |= i == p.memoryBudgets.end() || i->second != usage.budget;
+                        }
+                    }
+                    if (changed)
                     {
-                        player->setCacheOptions(value);
+                        _memoryApply();
                     }
                 });
 
@@ -1258,6 +1810,7 @@ namespace djv
                 [this](const models::ImageSeqSettings& value)
                 {
                     FTK_P();
+                    p.readThreadModel->setDefault(value.readThreadCount);
                     const bool reopen =
                         value.io.missingFrames != p.missingFrames &&
                         (tl::isStructural(value.io.missingFrames) ||
@@ -1267,9 +1820,14 @@ namespace djv
                     {
                         _reload(true);
                     }
-                    else if (auto player = p.player->get())
+                    else
                     {
-                        player->setIOOptions(p.settingsModel->getIOOptions());
+                        if (auto player = p.player->get())
+                        {
+                            player->setIOOptions(_getIOOptions());
+                        }
+                        p.prefetch.clear();
+                        _prefetchUpdate();
                     }
                 });
 
@@ -1346,6 +1904,7 @@ namespace djv
                 p.settingsModel->observeStyle(),
                 [this](const models::StyleSettings& value)
                 {
+                    StartupSpan span(_p->startupTrace, "Style and fonts");
                     auto fontSystem = getFontSystem();
                     const auto& fonts = fontSystem->getFonts();
                     for (const auto& font : value.fontFiles)
@@ -1488,6 +2047,14 @@ namespace djv
                         }
                     }
                 }
+
+                if (p.cmdLine.watch->found())
+                {
+                    for (const auto& file : p.filesModel->getFiles())
+                    {
+                        p.filesModel->setWatch(file, true);
+                    }
+                }
             }
         }
 
@@ -1507,6 +2074,7 @@ namespace djv
             p.toolWidgetFactory->addTool("Information", &InfoTool::create);
             p.toolWidgetFactory->addTool("Magnify", &MagnifyTool::create);
             p.toolWidgetFactory->addTool("Messages", &MessagesTool::create);
+            p.toolWidgetFactory->addTool("Scopes", &ScopesTool::create);
             p.toolWidgetFactory->addTool("Settings", &SettingsTool::create);
             p.toolWidgetFactory->addTool("System Log", &SysLogTool::create);
             p.toolWidgetFactory->addTool("View", &ViewTool::create);
@@ -1566,247 +2134,948 @@ namespace djv
         {
             FTK_P();
 
-            std::vector<std::shared_ptr<tl::Timeline> > timelines(files.size());
-            for (size_t i = 0; i < files.size(); ++i)
+            // With lazy opening, a file without a timeline is left until it
+            // is looked at, or the background gets round to it. Without it,
+            // the file is opened on the open threads, and taken from them
+            // by _openUpdate() once it has been.
+            const bool lazyOpen = p.settingsModel->getPrefetch().lazyOpen;
+            std::unordered_map<uint64_t, std::shared_ptr<tl::Timeline> > timelines;
+            std::set<uint64_t> unopened;
+            std::vector<std::shared_ptr<models::FilesModelItem> > pending;
+            for (const auto& file : files)
             {
-                const auto j = std::find(p.files.begin(), p.files.end(), files[i]);
-                if (j != p.files.end())
+                if (auto timeline = _getTimeline(file))
                 {
-                    timelines[i] = p.timelines[j - p.files.begin()];
+                    timelines[file->id] = timeline;
                 }
-            }
-
-            for (size_t i = 0; i < files.size(); ++i)
-            {
-                if (!timelines[i])
+                else
                 {
-                    try
-                    {
-                        tl::Options options;
-                        const models::ImageSeqSettings imageSeq = p.settingsModel->getImageSeq();
-                        options.imageSeqAudio = imageSeq.audio;
-                        options.imageSeqAudioExts = imageSeq.audioExts;
-                        options.imageSeqAudioFileName = imageSeq.audioFileName;
-                        const models::OTIOSettings otio = p.settingsModel->getOTIO();
-                        options.spatial = otio.spatial;
-                        options.compat = otio.compat;
-                        options.ioOptions = p.settingsModel->getIOOptions();
-                        options.pathOptions.seqMaxDigits = imageSeq.maxDigits;
-                        options.readThreadCount = imageSeq.readThreadCount;
-
-                        // A range that was asked for is used as it is. One
-                        // that was not is looked for on disk again here, so
-                        // that reopening picks up frames rendered since --
-                        // the path holds the frames that were there when it
-                        // was opened, and findSeq() is what goes and looks.
-                        ftk::Path path = files[i]->path;
-                        if (!files[i]->framesStated && path.isSeq())
-                        {
-                            const auto seq = ftk::findSeq(path, options.pathOptions);
-                            if (!seq.empty())
-                            {
-                                // Only when something was found: a sequence
-                                // that has gone from disk keeps the range it
-                                // had rather than becoming a timeline of
-                                // nothing.
-                                path.setSeq(seq);
-                            }
-                        }
-                        timelines[i] = tl::Timeline::create(
-                            _context,
-                            path,
-                            files[i]->audioPath,
-                            options);
-
-                        // Opening a sequence finds the frames on disk, which
-                        // the path does not know about when it names one
-                        // file. Kept beside the path rather than folded into
-                        // it: a path carrying a range is taken as a range
-                        // that was asked for, and reopening would stop
-                        // looking for frames that have arrived since.
-                        files[i]->timeRange = timelines[i]->getTimeRange();
-
-                        // Replaced rather than added to: a file that is
-                        // reopened comes back through here with its layers
-                        // already listed from the time before.
-                        files[i]->videoLayers.clear();
-                        for (const auto& video : timelines[i]->getIOInfo().video)
-                        {
-                            files[i]->videoLayers.push_back(video.name);
-                        }
-                        if (files[i]->videoLayer >= files[i]->videoLayers.size())
-                        {
-                            files[i]->videoLayer = 0;
-                        }
-
-                        // Recorded here rather than when the file is opened:
-                        // one that cannot be read should not be offered back
-                        // in the recent files.
-                        p.recentFilesModel->addRecent(files[i]->path);
-                    }
-                    catch (const std::exception& e)
+                    unopened.insert(file->id);
+                    if (!lazyOpen)
                     {
-                        _context->log("djv::app::App", e.what(), ftk::LogType::Error);
-                        // Only a file that has just been opened is taken
-                        // back out. Reloading runs through here too, and a
-                        // file that has become unreadable since it was opened
-                        // -- a share that went away, say -- should stay put
-                        // rather than disappear from the session.
-                        if (files[i]->newFile)
-                        {
-                            p.failedFiles.push_back(files[i]);
-                        }
+                        pending.push_back(file);
                     }
                 }
             }
 
-#if defined(__GLIBC__)
-            // Closing a file frees its memory, but glibc keeps what was
-            // freed in the allocator rather than returning it to the
-            // system, so the process still appears to be holding it. Ask
-            // for it back once the closed file's teardown has settled.
+            // The buffers kept for the frames of a file that was closed
+            // are unlikely to fit the next one, so they go back to the
+            // system now rather than when newer ones push them out.
             if (files.size() < p.files.size())
             {
-                if (!p.trimTimer)
-                {
-                    p.trimTimer = ftk::Timer::create(_context);
-                }
-                p.trimTimer->start(
-                    std::chrono::seconds(2),
-                    []
-                    {
-                        malloc_trim(0);
-                    });
+                p.frameBufferPool->release();
             }
-#endif // __GLIBC__
 
             p.files = files;
             p.timelines = timelines;
+            p.unopened = unopened;
+            _openTimelines(pending);
             _colorModelUpdate();
+            _watchUpdate();
 
-            // A file that could not be opened should not sit in the tab bar
-            // and the files tool as though it had.
-            if (!p.failedFiles.empty())
+            // Let go of the players for files that were closed or opened
+            // again. New ones are made once the current file is known.
+            for (auto i = p.prefetch.begin(); i != p.prefetch.end();)
             {
-                if (!p.closeFailedTimer)
+                if (_getTimeline(i->first) != i->second.timeline)
+                {
+                    i = p.prefetch.erase(i);
+                }
+                else
                 {
-                    p.closeFailedTimer = ftk::Timer::create(_context);
+                    ++i;
                 }
-                p.closeFailedTimer->start(
-                    std::chrono::milliseconds(0),
-                    [this] { _closeFailed(); });
+            }
+            _memoryUpdate();
+
+            if (!p.unopened.empty())
+            {
+                p.openTimer->start(
+                    std::chrono::milliseconds(100),
+                    [this] { _openUpdate(); });
             }
         }
 
-        void App::_closeFailed()
+        tl::Options App::_getTimelineOptions(const ftk::Path& path) const
         {
             FTK_P();
-            auto failed = p.failedFiles;
-            p.failedFiles.clear();
-            for (const auto& item : failed)
+            tl::Options out;
+            const models::ImageSeqSettings imageSeq = p.settingsModel->getImageSeq();
+            out.imageSeqAudio = imageSeq.audio;
+            out.imageSeqAudioExts = imageSeq.audioExts;
+            out.imageSeqAudioFileName = imageSeq.audioFileName;
+            const models::OTIOSettings otio = p.settingsModel->getOTIO();
+            out.spatial = otio.spatial;
+            out.compat = otio.compat;
+            out.ioOptions = p.settingsModel->getIOOptions();
+            out.pathOptions.seqMaxDigits = imageSeq.maxDigits;
+            out.readThreadCount = imageSeq.readThreadCount;
+            if (imageSeq.readThreadAuto && path.isSeq())
             {
-                const auto& files = p.filesModel->getFiles();
-                const auto i = std::find(files.begin(), files.end(), item);
-                if (i != files.end())
-                {
-                    p.filesModel->close(static_cast<int>(i - files.begin()));
-                }
+                out.readThreadCount = p.readThreadModel->getCount(
+                    models::getStorage(path.get(), p.mounts));
             }
+            return out;
         }
 
-        void App::_reloadUpdate(const std::shared_ptr<models::FilesModelItem>& item)
+        void App::_readSampleUpdate(const tl::PlayerCacheInfo& value)
         {
             FTK_P();
-            if (!item)
+            auto player = p.player->get();
+            if (!player || !p.settingsModel->getImageSeq().readThreadAuto)
+                return;
+            const auto& timeline = player->getTimeline();
+            const ftk::Path& path = timeline->getPath();
+            if (!path.isSeq())
+                return;
+
+            // The cache grows by what is read less what is played, so it is
+            // only measured while stopped. Frames that are reduced in size,
+            // or come from the frame cache tiers, say nothing about how fast
+            // the storage is read either.
+            if (player->getPlayback() != tl::Playback::Stop ||
+                p.decimation->get() > 1 ||
+                models::FrameCacheMode::Compressed == p.settingsModel->getFrameCache().mode ||
+                p.settingsModel->getDiskCache().frameGB > 0.F)
             {
+                p.readSample = Private::ReadSample();
                 return;
             }
 
-            // Keep where playback had got to. _activeUpdate saves this for a
-            // file that is losing focus, which this one is not.
-            if (!p.activeFiles.empty() && p.activeFiles.front() == item)
+            double frames = 0.0;
+            for (const auto& range : value.video)
             {
-                if (auto player = p.player->get())
-                {
-                    item->speed = player->getSpeed();
-                    item->currentTime = player->getCurrentTime();
-                }
+                frames += range.duration().value();
             }
-            if (item->path.getFrames().has_value() &&
-                item->currentTime.has_value())
+            const auto now = std::chrono::steady_clock::now();
+
+            // Only a cache that is filling says how fast frames are read: a
+            // full one fills as fast as it is played, and a seek empties it.
+            // Measuring starts again from here when it is neither.
+            if (p.readSample.storage.empty() ||
+                value.videoPercentage >= 95.F ||
+                frames < p.readSample.frames)
             {
-                const ftk::RangeI64& frames = item->path.getFrames().value();
-                item->currentTime = OTIO_NS::RationalTime(
-                    ftk::clamp(
-                        item->currentTime->value(),
-                        static_cast<double>(frames.min()),
-                        static_cast<double>(frames.max())),
-                    item->currentTime->rate());
+                p.readSample.storage = models::getStorage(path.get(), p.mounts);
+                p.readSample.count = timeline->getOptions().readThreadCount;
+                p.readSample.time = now;
+                p.readSample.frames = frames;
+                return;
             }
-
-            const auto i = std::find(p.files.begin(), p.files.end(), item);
-            if (i != p.files.end())
+            const float seconds = std::chrono::duration<float>(now - p.readSample.time).count();
+            if (seconds >= 2.F)
             {
-                p.timelines[i - p.files.begin()].reset();
+                const float framesPerSecond = (frames - p.readSample.frames) / seconds;
+                if (p.readThreadModel->addSample(
+                    p.readSample.storage,
+                    p.readSample.count,
+                    framesPerSecond))
+                {
+                    _context->log(
+                        "djv::app::App",
+                        ftk::Format("Read threads for {0}: {1} ({2} FPS with {3})").
+                            arg(p.readSample.storage).
+                            arg(p.readThreadModel->getCount(p.readSample.storage)).
+                            arg(framesPerSecond, 1).
+                            arg(p.readSample.count));
+                }
+                p.readSample.time = now;
+                p.readSample.frames = frames;
             }
-
-            // Both updates decide what can be kept by comparing item
-            // pointers, and the pointer has not changed, so the timeline and
-            // the player it belongs to have to be taken out of the way first.
-            p.activeFiles.clear();
-            _filesUpdate(p.filesModel->getFiles());
-            _activeUpdate(p.filesModel->getActive());
-
-            // The item is the same object holding different things now -- its
-            // range and its layers were filled in by the update above -- and
-            // the list of them never changed, so say so, or the tools go on
-            // showing what was there before the file was reopened.
-            p.filesModel->refresh();
         }
 
-        void App::_activeUpdate(const std::vector<std::shared_ptr<models::FilesModelItem> >& activeFiles)
+        tl::IOOptions App::_getIOOptions() const
         {
             FTK_P();
+            return p.settingsModel->getIOOptions();
+        }
 
-            if (!p.activeFiles.empty())
+        void App::_setDecimation(int value)
+        {
+            FTK_P();
+            auto player = p.player->get();
+            if (p.decimation->setIfChanged(value))
             {
-                if (auto player = p.player->get())
+                // Only the frames read from now on change, so that what the
+                // player has cached is kept while it plays.
+                p.resolution.valid = false;
+                if (player)
                 {
-                    p.activeFiles.front()->speed = player->getSpeed();
-                    p.activeFiles.front()->currentTime = player->getCurrentTime();
-                    p.activeFiles.front()->inOutRange = player->getInOutRange();
+                    p.frameCache->setDecimation(
+                        player->getTimeline()->getPath(),
+                        value);
+                }
+                if (value > 1)
+                {
+                    p.decimated = true;
                 }
+                _context->log(
+                    "djv::app::App",
+                    value > 1 ?
+                        ftk::Format("Playing at 1/{0} resolution").arg(value).str() :
+                        std::string("Playing at full resolution"));
             }
 
-            std::shared_ptr<tl::Player> player;
-            if (!activeFiles.empty())
+            // Frames cached at a reduced resolution are read again once
+            // playback has stopped, rather than shown soft in a still
+            // picture.
+            if (1 == value && p.decimated && player &&
+                tl::Playback::Stop == player->getPlayback())
             {
-                if (!p.activeFiles.empty() && activeFiles[0] == p.activeFiles[0])
-                {
-                    player = p.player->get();
+                p.decimated = false;
+                player->clearCache();
+            }
+        }
+
+        void App::_resolutionUpdate(const tl::PlayerCacheInfo& value)
+        {
+            FTK_P();
+            auto player = p.player->get();
+            if (!player || !p.settingsModel->getPlayback().adaptiveResolution)
+                return;
+            const tl::Playback playback = player->getPlayback();
+            if (tl::Playback::Stop == playback ||
+                !player->getTimeline()->getPath().isSeq())
+                return;
+
+            // How much is cached ahead of the frame being played, in the
+            // direction it plays, carried on from the other end of the
+            // in/out range when the cache has wrapped round there to loop.
+            const OTIO_NS::RationalTime current = player->getCurrentTime();
+            const OTIO_NS::TimeRange inOutRange = player->getInOutRange();
+            const bool forward = tl::Playback::Forward == playback;
+            double ahead = 0.0;
+            bool wrap = false;
+            for (const auto& range : value.video)
+            {
+                if (range.contains(current))
+                {
+                    if (forward)
+                    {
+                        ahead = (range.end_time_exclusive() - current).to_seconds();
+                        wrap = range.end_time_exclusive() >= inOutRange.end_time_exclusive();
+                    }
+                    else
+                    {
+                        ahead = (current - range.start_time()).to_seconds();
+                        wrap = range.start_time() <= inOutRange.start_time();
+                    }
+                    break;
+                }
+            }
+            if (wrap)
+            {
+                const OTIO_NS::RationalTime other = forward ?
+                    inOutRange.start_time() :
+                    inOutRange.end_time_inclusive();
+                for (const auto& range : value.video)
+                {
+                    if (range.contains(other))
+                    {
+                        ahead += range.duration().to_seconds();
+                        break;
+                    }
+                }
+            }
+
+            // The frames the viewport has dropped in this run of playback.
+            size_t dropped = 0;
+            if (p.mainWindow)
+            {
+                dropped = p.mainWindow->getViewport()->observeDroppedFrames()->get();
+            }
+
+            const auto now = std::chrono::steady_clock::now();
+            if (!p.resolution.valid)
+            {
+                p.resolution.valid = true;
+                p.resolution.time = now;
+                p.resolution.dropped = dropped;
+                p.resolution.steady = 0;
+                return;
+            }
+            if (std::chrono::duration<float>(now - p.resolution.time).count() < 1.F)
+                return;
+
+            // Only drawing falling behind is answered with a reduced
+            // resolution: with frames cached ahead, what is dropped is
+            // down to uploading and drawing them, which smaller frames cut.
+            // When reading is what falls behind, the frames are still read
+            // and decoded at the full size before they are reduced, so a
+            // reduced resolution would only add to the work. A fraction that
+            // has fallen behind twice in this run of playback is not gone
+            // back to, so that the picture does not keep changing.
+            const int decimation = p.decimation->get();
+            const bool droppedFrames = dropped > p.resolution.dropped;
+            p.resolution.time = now;
+            p.resolution.dropped = dropped;
+            if (droppedFrames && ahead >= behindSeconds)
+            {
+                p.resolution.steady = 0;
+                ++p.resolution.behind[decimation];
+                if (decimation < decimationMax)
+                {
+                    _setDecimation(decimation * 2);
+                }
+            }
+            else if (droppedFrames)
+            {
+                p.resolution.steady = 0;
+            }
+            else if (
+                decimation > 1 &&
+                ++p.resolution.steady >= catchUpSeconds &&
+                p.resolution.behind[decimation / 2] < 2)
+            {
+                _setDecimation(decimation / 2);
+            }
+        }
+
+        void App::_cacheWarmUpUpdate()
+        {
+            FTK_P();
+            auto player = p.player->get();
+            if (!player)
+            {
+                cancelCacheWarmUp();
+                return;
+            }
+
+            // The frames of the in/out range that are cached.
+            const OTIO_NS::TimeRange& inOutRange = player->getInOutRange();
+            const double rate = inOutRange.duration().rate();
+            const tl::PlayerCacheInfo& cacheInfo = player->observeCacheInfo()->get();
+            double cached = 0.0;
+            for (const auto& range : cacheInfo.video)
+            {
+                const OTIO_NS::RationalTime start =
+                    std::max(range.start_time(), inOutRange.start_time());
+                const OTIO_NS::RationalTime end =
+                    std::min(range.end_time_exclusive(), inOutRange.end_time_exclusive());
+                if (end > start)
+                {
+                    cached += (end - start).rescaled_to(rate).value();
+                }
+            }
+            const double total = inOutRange.duration().value();
+
+            const bool play = p.cacheWarmUpModel->observeWarmUp()->get().play;
+            if (p.cacheWarmUpModel->update(cached, total, cacheInfo.videoPercentage >= 99.F))
+            {
+                p.cacheWarmUpTimer->stop();
+                if (cached < total)
+                {
+                    _context->log(
+                        "djv::app::App",
+                        ftk::Format("Only {0}% of the in/out range fits in the cache").
+                            arg(cached / total * 100.0, 0),
+                        ftk::LogType::Warning);
+                }
+                else
+                {
+                    _context->log("djv::app::App", "The cache is warmed up");
+                }
+                if (play)
+                {
+                    player->forward();
+                }
+            }
+        }
+
+        void App::_openTimelines(const std::vector<std::shared_ptr<models::FilesModelItem> >& files)
+        {
+            FTK_P();
+
+            // The files do not depend on each other, so they are opened
+            // side by side: a drop of forty shots on network storage
+            // waits for the slowest rather than for the sum of them all.
+            // Only the timelines are made on the open threads; the
+            // settings are read here, and the items and models are
+            // updated back on this thread as each one finishes. A file
+            // already being opened is left to finish.
+            for (const auto& file : files)
+            {
+                if (p.opening.find(file->id) != p.opening.end())
+                    continue;
+                const auto context = _context;
+                const auto trace = p.startupTrace;
+                const auto seqCache = p.seqCache;
+                const ftk::Path path = file->path;
+                const ftk::Path audioPath = file->audioPath;
+                const bool framesStated = file->framesStated;
+                const tl::Options options = _getTimelineOptions(path);
+                auto request = std::make_shared<OpenRequest>();
+                request->file = file;
+                request->task = std::packaged_task<OpenResult()>(
+                    [context, trace, seqCache, path, audioPath, framesStated, options]
+                    {
+                        OpenResult out;
+                        try
+                        {
+                            out.first = createTimeline(
+                                context,
+                                trace,
+                                seqCache,
+                                path,
+                                audioPath,
+                                framesStated,
+                                options);
+                        }
+                        catch (const std::exception& e)
+                        {
+                            out.second = e.what();
+                        }
+                        return out;
+                    });
+                request->future = request->task.get_future();
+                p.opening[file->id] = request;
+                p.openThreadPool->add([request] { runOpen(*request); });
+            }
+            if (!p.opening.empty() && !p.openTimer->isActive())
+            {
+                p.openTimer->start(
+                    std::chrono::milliseconds(100),
+                    [this] { _openUpdate(); });
+            }
+        }
+
+        void App::_timelineOpened(
+            const std::shared_ptr<models::FilesModelItem>& file,
+            const std::shared_ptr<tl::Timeline>& timeline,
+            const std::string& error)
+        {
+            FTK_P();
+            p.unopened.erase(file->id);
+            if (timeline)
+            {
+                p.timelines[file->id] = timeline;
+
+                // Opening a sequence finds the frames on disk, which
+                // the path does not know about when it names one
+                // file. Kept beside the path rather than folded into
+                // it: a path carrying a range is taken as a range
+                // that was asked for, and reopening would stop
+                // looking for frames that have arrived since.
+                file->timeRange = timeline->getTimeRange();
+
+                // Replaced rather than added to: a file that is
+                // reopened comes back through here with its layers
+                // already listed from the time before.
+                file->videoLayers.clear();
+                for (const auto& video : timeline->getIOInfo().video)
+                {
+                    file->videoLayers.push_back(video.name);
+                }
+                if (file->videoLayer >= file->videoLayers.size())
+                {
+                    file->videoLayer = 0;
+                }
+
+                // Recorded here rather than when the file is opened:
+                // one that cannot be read should not be offered back
+                // in the recent files.
+                p.recentFilesModel->addRecent(file->path);
+            }
+            else
+            {
+                _context->log("djv::app::App", error, ftk::LogType::Error);
+                // Only a file that has never been opened is taken back
+                // out. Reloading runs through here too, and a file that
+                // has become unreadable since it was opened -- a share
+                // that went away, say -- should stay put rather than
+                // disappear from the session. One left for lazy opening
+                // has no range yet, however long it has been in the list.
+                if (file->newFile || !file->timeRange.has_value())
+                {
+                    p.failedFiles.push_back(file);
+
+                    // A file that could not be opened should not sit in the
+                    // tab bar and the files tool as though it had.
+                    if (!p.closeFailedTimer)
+                    {
+                        p.closeFailedTimer = ftk::Timer::create(_context);
+                    }
+                    p.closeFailedTimer->start(
+                        std::chrono::milliseconds(0),
+                        [this] { _closeFailed(); });
+                }
+            }
+        }
+
+        void App::_openUnopened(const std::vector<std::shared_ptr<models::FilesModelItem> >& files)
+        {
+            FTK_P();
+            std::vector<std::shared_ptr<models::FilesModelItem> > unopened;
+            for (const auto& file : files)
+            {
+                if (p.unopened.find(file->id) != p.unopened.end())
+                {
+                    unopened.push_back(file);
+                }
+            }
+            _openTimelines(unopened);
+
+            // Waited for, since whoever looks at a file -- the command
+            // line, the benchmarks -- goes on to use its player straight
+            // afterwards. One the threads have not started yet is opened
+            // here rather than behind the rest of the queue.
+            for (const auto& file : unopened)
+            {
+                const auto i = p.opening.find(file->id);
+                if (i == p.opening.end())
+                    continue;
+                const auto request = i->second;
+                p.opening.erase(i);
+                runOpen(*request);
+                const OpenResult result = request->future.get();
+                _timelineOpened(file, result.first, result.second);
+
+                // The range and the layers are known now.
+                p.filesModel->refresh(file);
+            }
+        }
+
+        void App::_openUpdate()
+        {
+            FTK_P();
+
+            // The files that have finished opening. One is only taken if it
+            // is still waiting: it may have been closed since. Taken out
+            // first, since refreshing the files model can come back round
+            // to opening more of them.
+            std::vector<std::shared_ptr<OpenRequest> > finished;
+            for (auto i = p.opening.begin(); i != p.opening.end();)
+            {
+                if (i->second->future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                {
+                    finished.push_back(i->second);
+                    i = p.opening.erase(i);
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+            bool opened = false;
+            for (const auto& request : finished)
+            {
+                const auto& file = request->file;
+                if (p.unopened.find(file->id) != p.unopened.end())
+                {
+                    const OpenResult result = request->future.get();
+                    _timelineOpened(file, result.first, result.second);
+                    p.filesModel->refresh(file);
+                    opened = true;
+                }
+            }
+            if (opened)
+            {
+                // The neighbours of the current file get their players
+                // once they have timelines.
+                _prefetchUpdate();
+            }
+
+            if (p.unopened.empty() && p.opening.empty())
+            {
+                p.openTimer->stop();
+                return;
+            }
+            // One file at a time in the background, and only once the
+            // files that were opened straight away have finished.
+            if (!p.opening.empty())
+                return;
+            if (!p.settingsModel->getPrefetch().openInBackground)
+                return;
+
+            // Left alone while something is playing, so as not to compete
+            // with it for the disk.
+            if (auto player = p.player->get())
+            {
+                if (player->getPlayback() != tl::Playback::Stop)
+                    return;
+            }
+
+            // The files after the current one first, since those are the
+            // ones most likely to be looked at next.
+            size_t start = 0;
+            if (!p.activeFiles.empty())
+            {
+                const int index = p.filesModel->getIndex(p.activeFiles.front());
+                if (index != -1)
+                {
+                    start = index;
+                }
+            }
+            for (size_t i = 0; i < p.files.size(); ++i)
+            {
+                const auto& file = p.files[(start + i) % p.files.size()];
+                if (p.unopened.find(file->id) != p.unopened.end())
+                {
+                    _openTimelines({ file });
+                    break;
+                }
+            }
+        }
+
+        void App::_closeFailed()
+        {
+            FTK_P();
+            auto failed = p.failedFiles;
+            p.failedFiles.clear();
+            for (const auto& item : failed)
+            {
+                const int index = p.filesModel->getIndex(item);
+                if (index != -1)
+                {
+                    p.filesModel->close(index);
+                }
+            }
+        }
+
+        void App::_reloadUpdate(const std::shared_ptr<models::FilesModelItem>& item)
+        {
+            FTK_P();
+            if (!item)
+            {
+                return;
+            }
+
+            // Keep where playback had got to. _activeUpdate saves this for a
+            // file that is losing focus, which this one is not.
+            if (!p.activeFiles.empty() && p.activeFiles.front() == item)
+            {
+                if (auto player = p.player->get())
+                {
+                    item->speed = player->getSpeed();
+                    item->currentTime = player->getCurrentTime();
+                }
+            }
+            if (item->path.getFrames().has_value() &&
+                item->currentTime.has_value())
+            {
+                const ftk::RangeI64& frames = item->path.getFrames().value();
+                item->currentTime = OTIO_NS::RationalTime(
+                    ftk::clamp(
+                        item->currentTime->value(),
+                        static_cast<double>(frames.min()),
+                        static_cast<double>(frames.max())),
+                    item->currentTime->rate());
+            }
+
+            p.timelines.erase(item->id);
+            // One still being opened is opened again, since what it was
+            // reading may be what has changed.
+            p.opening.erase(item->id);
+
+            // Both updates decide what can be kept by comparing item
+            // pointers, and the pointer has not changed, so the timeline and
+            // the player it belongs to have to be taken out of the way first.
+            p.activeFiles.clear();
+            _filesUpdate(p.filesModel->getFiles());
+            _activeUpdate(p.filesModel->getActive());
+
+            // The item is the same object holding different things now -- its
+            // range and its layers were filled in by the updates above, when
+            // it is being looked at, and are once it has been opened again
+            // otherwise -- and the list of them never changed, so say so, or
+            // the tools go on showing what was there before the file was
+            // reopened.
+            p.filesModel->refresh(item);
+        }
+
+        void App::_watchUpdate()
+        {
+            FTK_P();
+            std::vector<std::string> dirs;
+            std::map<std::shared_ptr<models::FilesModelItem>, ftk::RangeI64> watchFrames;
+            for (const auto& file : p.files)
+            {
+                if (file->watch && file->path.isSeq())
+                {
+                    dirs.push_back(models::getSeqDir(file->path));
+                    const auto i = p.watchFrames.find(file);
+                    if (i != p.watchFrames.end())
+                    {
+                        watchFrames.insert(*i);
+                    }
+                    else
+                    {
+                        // Where to start from, so that the first change
+                        // is measured against what was there when the
+                        // watch began. The file has just been opened, so
+                        // this comes out of the cache.
+                        ftk::PathOptions pathOptions;
+                        pathOptions.seqMaxDigits = p.settingsModel->getImageSeq().maxDigits;
+                        const ftk::Path found = p.seqCache->findSeq(file->path, pathOptions);
+                        if (found.getFrames().has_value())
+                        {
+                            watchFrames[file] = found.getFrames().value();
+                        }
+                    }
+                }
+            }
+            p.watchFrames = watchFrames;
+            p.seqWatcher->setDirs(dirs);
+        }
+
+        void App::_watchChanged(const std::vector<std::string>& dirs)
+        {
+            FTK_P();
+            for (const auto& dir : dirs)
+            {
+                p.seqCache->invalidate(dir);
+            }
+
+            ftk::PathOptions pathOptions;
+            pathOptions.seqMaxDigits = p.settingsModel->getImageSeq().maxDigits;
+            std::vector<OTIO_NS::TimeRange> arrived;
+            bool clearCache = false;
+            std::vector<std::shared_ptr<models::FilesModelItem> > reopen;
+            for (const auto& file : p.files)
+            {
+                if (!file->watch ||
+                    std::find(dirs.begin(), dirs.end(), models::getSeqDir(file->path)) == dirs.end())
+                {
+                    continue;
+                }
+                const ftk::Path found = p.seqCache->findSeq(file->path, pathOptions);
+                if (!found.getFrames().has_value())
+                {
+                    continue;
+                }
+                const ftk::RangeI64 frames = found.getFrames().value();
+                const auto i = p.watchFrames.find(file);
+                std::optional<ftk::RangeI64> prev;
+                if (i != p.watchFrames.end())
+                {
+                    if (frames == i->second)
+                    {
+                        // Something else in the directory, or a frame being
+                        // written over.
+                        continue;
+                    }
+                    prev = i->second;
+                }
+                p.watchFrames[file] = frames;
+
+                const bool active = std::find(
+                    p.activeFiles.begin(),
+                    p.activeFiles.end(),
+                    file) != p.activeFiles.end();
+                if (file->framesStated)
+                {
+                    // The timeline already covers the frames that have
+                    // arrived, so it and the player are kept. The frames
+                    // that arrived are the ones either side of what was
+                    // there before.
+                    if (!active)
+                        continue;
+                    const auto player = p.player->get();
+                    const std::optional<ftk::RangeI64>& stated = file->path.getFrames();
+                    if (!player || !stated.has_value() || p.activeFiles.front() != file)
+                    {
+                        // A compare file is on the timeline of the file
+                        // being compared to, so which of its frames are
+                        // cached is not known here.
+                        clearCache = true;
+                        continue;
+                    }
+                    std::vector<ftk::RangeI64> ranges;
+                    if (!prev.has_value())
+                    {
+                        ranges.push_back(frames);
+                    }
+                    else
+                    {
+                        if (frames.min() < prev->min())
+                        {
+                            ranges.push_back(ftk::RangeI64(frames.min(), prev->min() - 1));
+                        }
+                        if (frames.max() > prev->max())
+                        {
+                            ranges.push_back(ftk::RangeI64(prev->max() + 1, frames.max()));
+                        }
+                    }
+                    const OTIO_NS::TimeRange& timeRange = player->getTimeRange();
+                    const double rate = timeRange.duration().rate();
+                    for (const auto& range : ranges)
+                    {
+                        arrived.push_back(OTIO_NS::TimeRange(
+                            timeRange.start_time() +
+                                OTIO_NS::RationalTime(range.min() - stated->min(), rate),
+                            OTIO_NS::RationalTime(range.max() - range.min() + 1, rate)));
+                    }
                 }
                 else
                 {
-                    auto i = std::find(p.files.begin(), p.files.end(), activeFiles[0]);
-                    if (i != p.files.end())
+                    reopen.push_back(file);
+                }
+            }
+
+            // A frame the player read before it arrived is cached as
+            // missing. The player can only let go of its whole cache, not
+            // of single frames, so that is done only when one of the
+            // frames that arrived is in it; frames that arrive ahead of
+            // what has been read are read as they are reached, and the
+            // cache is kept.
+            if (auto player = p.player->get())
+            {
+                if (!clearCache && !arrived.empty())
+                {
+                    for (const auto& range : player->observeCacheInfo()->get().video)
                     {
-                        if (auto timeline = p.timelines[i - p.files.begin()])
+                        for (const auto& i : arrived)
                         {
-                            try
+                            if (range.start_time() < i.end_time_exclusive() &&
+                                i.start_time() < range.end_time_exclusive())
                             {
-                                tl::PlayerOptions playerOptions;
-                                playerOptions.audioDevice = p.audioModel->getDevice();
-                                playerOptions.cache = p.settingsModel->getCache();
-                                playerOptions.audioBufferFrameCount =
-                                    p.settingsModel->getAudio().bufferFrameCount;
-                                player = tl::Player::create(_context, timeline, playerOptions);
+                                clearCache = true;
+                                break;
                             }
-                            catch (const std::exception& e)
+                        }
+                        if (clearCache)
+                            break;
+                    }
+                }
+                if (clearCache)
+                {
+                    player->clearCache();
+                }
+            }
+            std::vector<std::shared_ptr<models::FilesModelItem> > inactive;
+            for (const auto& file : reopen)
+            {
+                if (std::find(p.activeFiles.begin(), p.activeFiles.end(), file) != p.activeFiles.end())
+                {
+                    if (p.activeFiles.front() == file)
+                    {
+                        if (auto player = p.player->get())
+                        {
+                            // In/out points around the whole of what had
+                            // been rendered are taken as covering all of
+                            // it, new frames included, rather than
+                            // stopping where the render had got to.
+                            const auto inOutRange = player->getInOutRange();
+                            if (inOutRange == player->getTimeRange())
+                            {
+                                file->inOutRange.reset();
+                            }
+                            else
                             {
-                                _context->log("djv::app::App", e.what(), ftk::LogType::Error);
+                                file->inOutRange = inOutRange;
                             }
                         }
                     }
+                    // The timeline and player are made again: a tlRender
+                    // timeline's range is fixed when it is created and the
+                    // player cannot be given a new one, so one that has
+                    // grown is a new timeline, and the player's cache
+                    // starts over. Where playback had got to, and the
+                    // in/out points, carry over; the frames that were
+                    // cached come back from the frame cache when its
+                    // memory or disk tier is on, rather than from the
+                    // file.
+                    _reloadUpdate(file);
+                }
+                else
+                {
+                    // Not being played, so there is no player to keep
+                    // from being replaced; only the timeline is made
+                    // again.
+                    if (p.timelines.erase(file->id) > 0)
+                    {
+                        inactive.push_back(file);
+                    }
+                }
+            }
+            if (!inactive.empty())
+            {
+                _filesUpdate(p.filesModel->getFiles());
+                for (const auto& file : inactive)
+                {
+                    p.filesModel->refresh(file);
+                }
+            }
+        }
+
+        std::shared_ptr<tl::Timeline> App::_getTimeline(
+            const std::shared_ptr<models::FilesModelItem>& item) const
+        {
+            FTK_P();
+            const auto i = p.timelines.find(item->id);
+            return i != p.timelines.end() ? i->second : nullptr;
+        }
+
+        void App::_activeUpdate(const std::vector<std::shared_ptr<models::FilesModelItem> >& activeFiles)
+        {
+            FTK_P();
+
+            // Files left for lazy opening are opened once they are looked at.
+            _openUnopened(activeFiles);
+
+            if (!p.activeFiles.empty())
+            {
+                if (auto player = p.player->get())
+                {
+                    p.activeFiles.front()->speed = player->getSpeed();
+                    p.activeFiles.front()->currentTime = player->getCurrentTime();
+                    p.activeFiles.front()->inOutRange = player->getInOutRange();
+                }
+            }
+
+            std::shared_ptr<tl::Player> player;
+            if (!activeFiles.empty())
+            {
+                if (!p.activeFiles.empty() && activeFiles[0] == p.activeFiles[0])
+                {
+                    player = p.player->get();
+                }
+                else
+                {
+                    // The player being changed from goes back to the full
+                    // resolution, whether it is kept ready or let go of,
+                    // and reads again what it has cached reduced.
+                    _setDecimation(1);
+                    if (p.decimated)
+                    {
+                        p.decimated = false;
+                        if (auto prevPlayer = p.player->get())
+                        {
+                            prevPlayer->clearCache();
+                        }
+                    }
+
+                    // The player being changed from is kept ready as well,
+                    // for stepping back to it; _prefetchUpdate() lets it go
+                    // when it is not one of the new file's neighbours.
+                    auto prevPlayer = p.player->get();
+                    if (prevPlayer && !p.activeFiles.empty() &&
+                        p.settingsModel->getPrefetch().files > 0)
+                    {
+                        prevPlayer->stop();
+                        prevPlayer->setCompare({});
+                        prevPlayer->setMute(true);
+                        prevPlayer->setCacheOptions(_getPrefetchCacheOptions());
+                        p.prefetch[p.activeFiles[0]] =
+                            { prevPlayer->getTimeline(), prevPlayer };
+                    }
+
+                    if (auto timeline = _getTimeline(activeFiles[0]))
+                    {
+                        auto j = p.prefetch.find(activeFiles[0]);
+                        if (j != p.prefetch.end() && j->second.timeline == timeline)
+                        {
+                            player = j->second.player;
+                            p.prefetch.erase(j);
+                            player->setCacheOptions(_getCacheOptions(timeline));
+                            player->setAudioDevice(p.audioModel->getDevice());
+                        }
+                        else
+                        {
+                            StartupSpan span(p.startupTrace, "Player", "files");
+                            player = _createPlayer(timeline, _getCacheOptions(timeline));
+                        }
+                    }
                 }
             }
             if (player)
@@ -1833,12 +3102,7 @@ namespace djv
                 std::vector<std::shared_ptr<tl::Timeline> > compare;
                 for (size_t i = 1; i < activeFiles.size(); ++i)
                 {
-                    auto j = std::find(p.files.begin(), p.files.end(), activeFiles[i]);
-                    if (j != p.files.end())
-                    {
-                        auto timeline = p.timelines[j - p.files.begin()];
-                        compare.push_back(timeline);
-                    }
+                    compare.push_back(_getTimeline(activeFiles[i]));
                 }
                 player->setCompare(compare);
                 player->setCompareTime(p.filesModel->getCompareTime());
@@ -1855,11 +3119,348 @@ namespace djv
             }
 
             p.activeFiles = activeFiles;
+            if (player != p.player->get())
+            {
+                cancelCacheWarmUp();
+            }
             p.player->setIfChanged(player);
+            p.cacheInfoObserver.reset();
+            p.playbackObserver.reset();
+            p.readSample = Private::ReadSample();
+            p.resolution = Private::Resolution();
+            if (player)
+            {
+                p.playbackObserver = ftk::Observer<tl::Playback>::create(
+                    player->observePlayback(),
+                    [this](tl::Playback value)
+                    {
+                        FTK_P();
+                        p.resolution = Private::Resolution();
+                        if (tl::Playback::Stop == value)
+                        {
+                            _setDecimation(1);
+                        }
+                        else
+                        {
+                            cancelCacheWarmUp();
+                        }
+                    });
+
+                p.cacheInfoObserver = ftk::Observer<tl::PlayerCacheInfo>::create(
+                    player->observeCacheInfo(),
+                    [this](const tl::PlayerCacheInfo& value)
+                    {
+                        FTK_P();
+                        if (auto player = p.player->get())
+                        {
+                            const tl::PlayerCacheOptions& options = player->getCacheOptions();
+                            p.memoryModel->setUsed(
+                                "Player",
+                                toBytes(options.videoGB * value.videoPercentage / 100.F) +
+                                toBytes(options.audioGB * value.audioPercentage / 100.F));
+                        }
+                        const auto stats = p.frameCache->getMemoryCache()->getStats();
+                        p.memoryModel->setUsed("Compressed frames", stats.size);
+                        _readSampleUpdate(value);
+                        _resolutionUpdate(value);
+                    });
+            }
             _colorModelUpdate();
 
             _layersUpdate(p.filesModel->observeLayers()->get());
             _audioUpdate();
+            _prefetchUpdate();
+        }
+
+        float App::_getVideoGB() const
+        {
+            FTK_P();
+            float out = p.settingsModel->getCache().videoGB;
+            const auto& prefetch = p.settingsModel->getPrefetch();
+            if (prefetch.files > 0)
+            {
+                // Never less than a quarter, so that a large prefetch cache
+                // cannot leave the current file with nothing to play from.
+                out = std::max(out - prefetch.videoGB, out / 4.F);
+            }
+            return out;
+        }
+
+        tl::PlayerCacheOptions App::_getCacheOptions(
+            const std::shared_ptr<tl::Timeline>& timeline) const
+        {
+            FTK_P();
+            tl::PlayerCacheOptions out = p.settingsModel->getCache();
+            out.videoGB = _getVideoGB();
+            if (models::FrameCacheMode::Compressed == p.settingsModel->getFrameCache().mode &&
+                timeline &&
+                timeline->getPath().isSeq())
+            {
+                // The player only keeps enough frames to read ahead with;
+                // the rest of the video cache goes to the compressed frames
+                // it reads them from. Only image sequences are read through
+                // the frame cache, so a movie keeps the whole cache.
+                out.videoGB = std::min(out.videoGB / 4.F, compressedReadAheadGB);
+            }
+            return out;
+        }
+
+        tl::PlayerCacheOptions App::_getPrefetchCacheOptions() const
+        {
+            FTK_P();
+            const auto& cache = p.settingsModel->getCache();
+            const auto& prefetch = p.settingsModel->getPrefetch();
+            const size_t count = std::max(prefetch.files * 2, 1);
+            tl::PlayerCacheOptions out;
+            out.videoGB = (cache.videoGB - _getVideoGB()) / count;
+            out.audioGB = cache.audioGB / count;
+            // A file is started from where it was left, so there is
+            // nothing behind that to keep.
+            out.readBehind = 0.F;
+            return out;
+        }
+
+        std::shared_ptr<tl::Player> App::_createPlayer(
+            const std::shared_ptr<tl::Timeline>& timeline,
+            const tl::PlayerCacheOptions& cache)
+        {
+            FTK_P();
+            std::shared_ptr<tl::Player> out;
+            try
+            {
+                tl::PlayerOptions playerOptions;
+                playerOptions.audioDevice = p.audioModel->getDevice();
+                playerOptions.cache = cache;
+                playerOptions.audioBufferFrameCount =
+                    p.settingsModel->getAudio().bufferFrameCount;
+                out = tl::Player::create(_context, timeline, playerOptions);
+            }
+            catch (const std::exception& e)
+            {
+                _context->log("djv::app::App", e.what(), ftk::LogType::Error);
+            }
+            return out;
+        }
+
+        void App::_prefetchUpdate()
+        {
+            FTK_P();
+
+            // The neighbours of the current file, nearest first, wrapping
+            // around the ends of the list as next and previous do.
+            std::vector<size_t> indexes;
+            const auto& settings = p.settingsModel->getPrefetch();
+            if (settings.files > 0 && !p.activeFiles.empty())
+            {
+                const int index = p.filesModel->getIndex(p.activeFiles[0]);
+                const int size = p.files.size();
+                if (index >= 0 && index < size)
+                {
+                    for (int j = 1; j <= settings.files && j < size; ++j)
+                    {
+                        for (int k : { index + j, index - j })
+                        {
+                            const size_t l = (k % size + size) % size;
+                            if (std::find(indexes.begin(), indexes.end(), l) == indexes.end() &&
+                                l != static_cast<size_t>(index))
+                            {
+                                indexes.push_back(l);
+                            }
+                        }
+                    }
+                }
+            }
+
+            std::map<std::shared_ptr<models::FilesModelItem>, Private::Prefetch> prefetch;
+            const tl::PlayerCacheOptions cacheOptions = _getPrefetchCacheOptions();
+            if (cacheOptions.videoGB > 0.F)
+            {
+                // A file kept ready is one about to be looked at, so with
+                // lazy opening it is opened now. It is not waited for: its
+                // player is made when _openUpdate() takes its timeline.
+                std::vector<std::shared_ptr<models::FilesModelItem> > neighbours;
+                for (size_t index : indexes)
+                {
+                    if (p.unopened.find(p.files[index]->id) != p.unopened.end())
+                    {
+                        neighbours.push_back(p.files[index]);
+                    }
+                }
+                _openTimelines(neighbours);
+
+                for (size_t index : indexes)
+                {
+                    const auto& item = p.files[index];
+                    const auto timeline = _getTimeline(item);
+                    if (!timeline)
+                        continue;
+                    const auto i = p.prefetch.find(item);
+                    if (i != p.prefetch.end() && i->second.timeline == timeline)
+                    {
+                        i->second.player->setCacheOptions(cacheOptions);
+                        prefetch[item] = i->second;
+                    }
+                    else if (auto player = _createPlayer(timeline, cacheOptions))
+                    {
+                        // Started where it will be shown from, so that the
+                        // frames read are the ones that will be played.
+                        player->setMute(true);
+                        const std::optional<OTIO_NS::TimeRange> inOutRange = item->inOutRange;
+                        if (inOutRange.has_value())
+                        {
+                            player->setInOutRange(*inOutRange);
+                        }
+                        const std::optional<OTIO_NS::RationalTime> currentTime = item->currentTime;
+                        if (currentTime.has_value())
+                        {
+                            player->seek(*currentTime);
+                        }
+                        prefetch[item] = { timeline, player };
+                    }
+                }
+            }
+            p.prefetch = prefetch;
+            _memoryUpdate();
+        }
+
+        void App::_memoryUpdate()
+        {
+            FTK_P();
+            // Applied once at the end rather than as each account changes.
+            p.memoryUpdating = true;
+            std::set<std::string> ids;
+            auto setAccount = [&p, &ids](
+                const std::string& id,
+                const std::string& file,
+                models::MemoryPriority priority,
+                uint64_t min,
+                uint64_t max)
+            {
+                models::MemoryAccount account;
+                account.name = id;
+                account.file = file;
+                account.priority = priority;
+                account.min = std::min(min, max);
+                account.max = max;
+                p.memoryModel->setAccount(id, account);
+                ids.insert(id);
+            };
+
+            // The current file, with the files compared to it, which share
+            // its cache. It gives up the most it can last.
+            if (auto player = p.player->get())
+            {
+                std::string file;
+                if (!p.activeFiles.empty())
+                {
+                    file = p.activeFiles.front()->path.getFileName();
+                    if (p.activeFiles.size() > 1)
+                    {
+                        file += ftk::Format(" + {0} compared").arg(static_cast<int>(p.activeFiles.size()) - 1);
+                    }
+                }
+                const tl::PlayerCacheOptions options = _getCacheOptions(player->getTimeline());
+                setAccount(
+                    "Player",
+                    file,
+                    models::MemoryPriority::High,
+                    toBytes(playerMinGB),
+                    toBytes(options.videoGB + options.audioGB));
+            }
+
+            // The files kept ready, which go first.
+            const tl::PlayerCacheOptions prefetchOptions = _getPrefetchCacheOptions();
+            for (const auto& i : p.prefetch)
+            {
+                setAccount(
+                    "Prefetch: " + i.first->path.get(),
+                    i.first->path.getFileName(),
+                    models::MemoryPriority::Low,
+                    0,
+                    toBytes(prefetchOptions.videoGB + prefetchOptions.audioGB));
+            }
+
+            if (models::FrameCacheMode::Compressed == p.settingsModel->getFrameCache().mode)
+            {
+                auto player = p.player->get();
+                setAccount(
+                    "Compressed frames",
+                    std::string(),
+                    models::MemoryPriority::Normal,
+                    0,
+                    toBytes(_getVideoGB() -
+                        _getCacheOptions(player ? player->getTimeline() : nullptr).videoGB));
+            }
+
+            const auto& thumbnailCache = p.settingsModel->getThumbnailCache();
+            setAccount(
+                "Thumbnails",
+                std::string(),
+                models::MemoryPriority::Normal,
+                0,
+                toBytes((thumbnailCache.thumbnailMB + thumbnailCache.waveformMB) / 1024.F));
+
+            for (const auto& id : p.memoryAccounts)
+            {
+                if (!ids.count(id))
+                {
+                    p.memoryModel->removeAccount(id);
+                }
+            }
+            p.memoryAccounts = ids;
+            p.memoryUpdating = false;
+            _memoryApply();
+        }
+
+        void App::_memoryApply()
+        {
+            FTK_P();
+            p.memoryBudgets.clear();
+            for (const auto& id : p.memoryAccounts)
+            {
+                p.memoryBudgets[id] = p.memoryModel->getAccountBudget(id);
+            }
+            auto getScale = [&p](const std::string& id, float gb)
+            {
+                const uint64_t max = toBytes(gb);
+                const auto i = p.memoryBudgets.find(id);
+                return i != p.memoryBudgets.end() && max > 0 && i->second < max ?
+                    static_cast<float>(i->second / static_cast<double>(max)) :
+                    1.F;
+            };
+
+            if (auto player = p.player->get())
+            {
+                tl::PlayerCacheOptions options = _getCacheOptions(player->getTimeline());
+                const float scale = getScale("Player", options.videoGB + options.audioGB);
+                options.videoGB *= scale;
+                options.audioGB *= scale;
+                player->setCacheOptions(options);
+            }
+
+            for (const auto& i : p.prefetch)
+            {
+                tl::PlayerCacheOptions options = _getPrefetchCacheOptions();
+                const float scale = getScale(
+                    "Prefetch: " + i.first->path.get(),
+                    options.videoGB + options.audioGB);
+                options.videoGB *= scale;
+                options.audioGB *= scale;
+                i.second.player->setCacheOptions(options);
+            }
+
+            const auto i = p.memoryBudgets.find("Compressed frames");
+            p.frameCache->setMemoryMaxGB(i != p.memoryBudgets.end() ?
+                i->second / static_cast<float>(toBytes(1.F)) :
+                0.F);
+
+            tl::ui::ThumbnailCacheOptions thumbnailCache = p.settingsModel->getThumbnailCache();
+            const float scale = getScale(
+                "Thumbnails",
+                (thumbnailCache.thumbnailMB + thumbnailCache.waveformMB) / 1024.F);
+            thumbnailCache.thumbnailMB *= scale;
+            thumbnailCache.waveformMB *= scale;
+            _context->getSystem<tl::ui::ThumbnailSystem>()->setCacheOptions(thumbnailCache);
         }
 
         void App::_colorModelUpdate()
@@ -1875,13 +3476,9 @@ namespace djv
             {
                 std::pair<std::string, ftk::ImageTags> item;
                 item.first = file->path.get();
-                const auto i = std::find(p.files.begin(), p.files.end(), file);
-                if (i != p.files.end())
+                if (const auto timeline = _getTimeline(file))
                 {
-                    if (const auto& timeline = p.timelines[i - p.files.begin()])
-                    {
-                        item.second = timeline->getIOInfo().tags;
-                    }
+                    item.second = timeline->getIOInfo().tags;
                 }
                 activeFiles.push_back(item);
             }
@@ -1897,17 +3494,17 @@ namespace djv
                 std::vector<int> compareVideoLayers;
                 if (!value.empty() && value.size() == p.files.size() && !p.activeFiles.empty())
                 {
-                    auto i = std::find(p.files.begin(), p.files.end(), p.activeFiles.front());
-                    if (i != p.files.end())
+                    int index = p.filesModel->getIndex(p.activeFiles.front());
+                    if (index != -1)
                     {
-                        videoLayer = value[i - p.files.begin()];
+                        videoLayer = value[index];
                     }
                     for (size_t j = 1; j < p.activeFiles.size(); ++j)
                     {
-                        i = std::find(p.files.begin(), p.files.end(), p.activeFiles[j]);
-                        if (i != p.files.end())
+                        index = p.filesModel->getIndex(p.activeFiles[j]);
+                        if (index != -1)
                         {
-                            compareVideoLayers.push_back(value[i - p.files.begin()]);
+                            compareVideoLayers.push_back(value[index]);
                         }
                     }
                 }
@@ -27,10 +27,15 @@ namespace djv
 
         class AppInfoModel;
         class AudioModel;
+        class CacheWarmUpModel;
         class ColorModel;
         class CommandsModel;
         class FilesModel;
+        class FrameBufferPool;
+        class MemoryModel;
         class RecentFilesModel;
+        class SeqCache;
+        class ThumbnailDiskCache;
         class TimeUnitsModel;
         class ToolsModel;
         class ViewportModel;
@@ -39,8 +44,10 @@ namespace djv
     //! DJV Application
     namespace app
     {
+        class FrameCache;
         class MainWindow;
         class Indicator;
+        class StartupTrace;
         class ToolWidgetFactory;
 
         //! Application.
@@ -83,6 +90,24 @@ namespace djv
             //! Get the recent files model.
             DJV_API const std::shared_ptr<models::RecentFilesModel>& getRecentFilesModel() const;
 
+            //! Get the image sequence cache.
+            DJV_API const std::shared_ptr<models::SeqCache>& getSeqCache() const;
+
+            //! Get the thumbnail disk cache.
+            DJV_API const std::shared_ptr<models::ThumbnailDiskCache>& getThumbnailDiskCache() const;
+
+            //! Get the frame cache.
+            DJV_API const std::shared_ptr<FrameCache>& getFrameCache() const;
+
+            //! Get the pool the frames the application allocates come from.
+            DJV_API const std::shared_ptr<models::FrameBufferPool>& getFrameBufferPool() const;
+
+            //! Get the memory model.
+            DJV_API const std::shared_ptr<models::MemoryModel>& getMemoryModel() const;
+
+            //! Get the cache warm-up model.
+            DJV_API const std::shared_ptr<models::CacheWarmUpModel>& getCacheWarmUpModel() const;
+
             //! Get the color model.
             DJV_API const std::shared_ptr<models::ColorModel>& getColorModel() const;
 
@@ -124,6 +149,12 @@ namespace djv
                 const std::optional<ftk::RangeI64>& frames = std::optional<ftk::RangeI64>(),
                 bool gatherSeq = true);
 
+            //! Open several files at once, such as a drop of many shots.
+            //! They are read together rather than one after the other, which
+            //! matters most on network storage where finding each sequence's
+            //! frames is slow.
+            DJV_API void open(const std::vector<ftk::Path>&);
+
             //! Open a file dialog.
             DJV_API void openDialog();
 
@@ -136,6 +167,23 @@ namespace djv
             //! Observe the timeline player.
             DJV_API std::shared_ptr<ftk::IObservable<std::shared_ptr<tl::Player> > > observePlayer() const;
 
+            //! Observe the fraction of the full resolution the player is
+            //! reading frames at: 1 for the full resolution, 2 for half,
+            //! and 4 for a quarter. Only anything but 1 while adaptive
+            //! resolution is on and the frames cannot be read fast enough.
+            DJV_API std::shared_ptr<ftk::IObservable<int> > observeDecimation() const;
+
+            //! Fill the cache over the in/out range before playing it.
+            //! Playback is stopped at the in point and held while the
+            //! frames are read, and started once they are all cached when
+            //! play is true. Starting playback, or changing files, cancels
+            //! the warm-up. A range larger than the cache is filled as far
+            //! as it fits.
+            DJV_API void warmUpCache(bool play);
+
+            //! Cancel filling the cache, leaving playback where it is.
+            DJV_API void cancelCacheWarmUp();
+
             //! Get the tool widget factory.
             DJV_API const std::shared_ptr<ToolWidgetFactory>& getToolWidgetFactory() const;
 
@@ -151,6 +199,9 @@ namespace djv
             //! Set whether the secondary window is active.
             DJV_API void setSecondaryWindow(bool);
 
+            //! Get the startup trace.
+            DJV_API const std::shared_ptr<StartupTrace>& getStartupTrace() const;
+
             //! Get system information.
             DJV_API std::vector<std::string> getSysInfo() const;
 
@@ -168,15 +219,48 @@ namespace djv
             virtual void _viewUpdate(const ftk::V2I& pos, double zoom, bool frame);
 
         private:
+            std::vector<std::shared_ptr<models::FilesModelItem> > _getOpenItems(
+                const ftk::Path& path,
+                const ftk::Path& audioPath,
+                const std::optional<ftk::RangeI64>& frames,
+                bool gatherSeq);
             void _closeFailed();
             void _filesUpdate(const std::vector<std::shared_ptr<models::FilesModelItem> >&);
+            tl::Options _getTimelineOptions(const ftk::Path&) const;
+            void _readSampleUpdate(const tl::PlayerCacheInfo&);
+            tl::IOOptions _getIOOptions() const;
+            void _setDecimation(int);
+            void _resolutionUpdate(const tl::PlayerCacheInfo&);
+            void _cacheWarmUpUpdate();
+            // Start opening files on the open threads.
+            void _openTimelines(const std::vector<std::shared_ptr<models::FilesModelItem> >&);
+            void _timelineOpened(
+                const std::shared_ptr<models::FilesModelItem>&,
+                const std::shared_ptr<tl::Timeline>&,
+                const std::string& error);
+            // Open the files without a timeline yet, and wait for them.
+            void _openUnopened(const std::vector<std::shared_ptr<models::FilesModelItem> >&);
+            void _openUpdate();
             void _activeUpdate(const std::vector<std::shared_ptr<models::FilesModelItem> >&);
+            std::shared_ptr<tl::Timeline> _getTimeline(
+                const std::shared_ptr<models::FilesModelItem>&) const;
+            float _getVideoGB() const;
+            tl::PlayerCacheOptions _getCacheOptions(const std::shared_ptr<tl::Timeline>&) const;
+            tl::PlayerCacheOptions _getPrefetchCacheOptions() const;
+            std::shared_ptr<tl::Player> _createPlayer(
+                const std::shared_ptr<tl::Timeline>&,
+                const tl::PlayerCacheOptions&);
+            void _prefetchUpdate();
+            void _memoryUpdate();
+            void _memoryApply();
             void _colorModelUpdate();
             // Reopen the active files. When the timeline is about to be a
             // different shape, the position and the in/out range cannot be
             // carried over as they are, since both are in timeline time.
             void _reload(bool restructured);
             void _reloadUpdate(const std::shared_ptr<models::FilesModelItem>&);
+            void _watchUpdate();
+            void _watchChanged(const std::vector<std::string>&);
             void _layersUpdate(const std::vector<int>&);
             void _audioUpdate();
 
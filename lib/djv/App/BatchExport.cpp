@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djv/App/BatchExport.h>
+
+#include <djv/App/App.h>
+#include <djv/App/Exporter.h>
+
+#include <tlRender/Timeline/Player.h>
+
+#include <ftk/GL/Window.h>
+#include <ftk/Core/Context.h>
+#include <ftk/Core/Format.h>
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+namespace djv
+{
+    namespace app
+    {
+        namespace
+        {
+            void note(const std::string& msg)
+            {
+                std::cerr << "djv export: " << msg << std::endl;
+            }
+        }
+
+        struct BatchExport::Private
+        {
+            std::weak_ptr<ftk::Context> context;
+            std::weak_ptr<App> app;
+            models::ExportSettings settings;
+            models::ExportFileType fileType = models::ExportFileType::Seq;
+        };
+
+        void BatchExport::_init(
+            const std::shared_ptr<ftk::Context>& context,
+            const std::shared_ptr<App>& app,
+            const models::ExportSettings& settings,
+            models::ExportFileType fileType)
+        {
+            FTK_P();
+            p.context = context;
+            p.app = app;
+            p.settings = settings;
+            p.fileType = fileType;
+        }
+
+        BatchExport::BatchExport() :
+            _p(new Private)
+        {}
+
+        BatchExport::~BatchExport()
+        {}
+
+        std::shared_ptr<BatchExport> BatchExport::create(
+            const std::shared_ptr<ftk::Context>& context,
+            const std::shared_ptr<App>& app,
+            const models::ExportSettings& settings,
+            models::ExportFileType fileType)
+        {
+            auto out = std::shared_ptr<BatchExport>(new BatchExport);
+            out->_init(context, app, settings, fileType);
+            return out;
+        }
+
+        bool BatchExport::run()
+        {
+            FTK_P();
+            auto context = p.context.lock();
+            auto app = p.app.lock();
+            if (!context || !app)
+                return false;
+
+            auto player = app->observePlayer()->get();
+            if (!player)
+            {
+                note("no file to export");
+                return false;
+            }
+            // Held where the command line left it: the start playback
+            // setting would otherwise move the frame a single image export
+            // takes.
+            player->setPlayback(tl::Playback::Stop);
+
+            bool out = false;
+            try
+            {
+                // The renderer needs a context to draw in, and a hidden one
+                // pixel window is the cheapest way to get one; everything is
+                // drawn into the export's own offscreen buffer.
+                auto glWindow = ftk::gl::Window::create(
+                    context,
+                    "export",
+                    ftk::Size2I(1, 1),
+                    static_cast<int>(ftk::gl::WindowOptions::MakeCurrent));
+
+                const ExportJob job = createExportJob(context, app, p.settings, p.fileType);
+                const int64_t frames = static_cast<int64_t>(job.range.duration().value());
+                note(ftk::Format("{0} frames at {1} x {2}").
+                    arg(frames).
+                    arg(job.info.size.w).
+                    arg(job.info.size.h).str());
+
+                const auto startTime = std::chrono::steady_clock::now();
+                auto exporter = Exporter::create(
+                    context,
+                    player,
+                    job,
+                    app->getFrameBufferPool());
+                int64_t percent = 0;
+                while (!exporter->isFinished())
+                {
+                    if (!exporter->tick())
+                    {
+                        // Everything is drawn; the writer is finishing off.
+                        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                    }
+                    // A line every tenth, which is enough to see a job is
+                    // moving without filling a farm log.
+                    const int64_t written = exporter->getFramesWritten();
+                    const int64_t writtenPercent = frames > 0 ? (written * 100 / frames) : 100;
+                    if (writtenPercent >= percent + 10)
+                    {
+                        percent = writtenPercent - writtenPercent % 10;
+                        note(ftk::Format("{0}%").arg(percent).str());
+                    }
+                }
+
+                const std::chrono::duration<double> elapsed =
+                    std::chrono::steady_clock::now() - startTime;
+                note(ftk::Format("wrote {0} frames in {1}s ({2} FPS)").
+                    arg(frames).
+                    arg(elapsed.count(), 2).
+                    arg(elapsed.count() > 0.0 ? frames / elapsed.count() : 0.0, 2).str());
+                out = true;
+            }
+            catch (const std::exception& e)
+            {
+                note(e.what());
+            }
+            return out;
+        }
+    }
+}
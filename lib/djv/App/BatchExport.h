@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <djv/Models/Export.h>
+#include <djv/Models/SettingsModel.h>
+
+#include <ftk/Core/Util.h>
+
+#include <memory>
+
+namespace ftk
+{
+    class Context;
+}
+
+namespace djv
+{
+    namespace app
+    {
+        class App;
+
+        //! Command line export.
+        //!
+        //! Renders the in/out range of the command line inputs and writes it
+        //! with no window at all: there is no layout to run, no dialog to
+        //! update, and no event loop to wait on, so the frames go straight
+        //! from the reader to the writer as fast as the export pipeline
+        //! allows. The color, comparison, and render size are the same ones
+        //! the Export tool would use.
+        //!
+        //! Existing output is overwritten without asking, since there is
+        //! nobody to ask.
+        class DJV_API_TYPE BatchExport : public std::enable_shared_from_this<BatchExport>
+        {
+        protected:
+            void _init(
+                const std::shared_ptr<ftk::Context>&,
+                const std::shared_ptr<App>&,
+                const models::ExportSettings&,
+                models::ExportFileType);
+
+            BatchExport();
+
+        public:
+            DJV_API ~BatchExport();
+
+            DJV_API static std::shared_ptr<BatchExport> create(
+                const std::shared_ptr<ftk::Context>&,
+                const std::shared_ptr<App>&,
+                const models::ExportSettings&,
+                models::ExportFileType);
+
+            //! Render and write every frame, returning when the output is
+            //! finished. Returns false if the export failed.
+            DJV_API bool run();
+
+        private:
+            FTK_PRIVATE();
+        };
+    }
+}
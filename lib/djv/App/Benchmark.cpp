@@ -6,6 +6,9 @@
 #include <djv/App/App.h>
 #include <djv/App/MainWindow.h>
 #include <djv/App/Viewport.h>
+#include <djv/Models/ColorModel.h>
+#include <djv/Models/FilesModel.h>
+#include <djv/Models/ViewportModel.h>
 
 #include <tlRender/Timeline/Player.h>
 
@@ -13,8 +16,13 @@
 #include <ftk/Core/Format.h>
 #include <ftk/Core/Timer.h>
 
+#include <nlohmann/json.hpp>
+
 #include <algorithm>
+#include <array>
 #include <chrono>
+#include <cmath>
+#include <fstream>
 #include <iostream>
 #include <vector>
 
@@ -36,6 +44,35 @@ namespace djv
             {
                 std::cerr << "djv benchmark: " << msg << std::endl;
             }
+
+            // Nearest rank, so that every value reported is one that was
+            // actually measured.
+            double percentile(const std::vector<double>& sorted, double value)
+            {
+                const size_t rank = static_cast<size_t>(
+                    std::ceil(value / 100.0 * sorted.size()));
+                return sorted[std::min(sorted.size(), std::max<size_t>(1, rank)) - 1];
+            }
+
+            nlohmann::json getStats(std::vector<double> values)
+            {
+                nlohmann::json out;
+                out["count"] = values.size();
+                if (!values.empty())
+                {
+                    std::sort(values.begin(), values.end());
+                    double total = 0.0;
+                    for (double v : values)
+                    {
+                        total += v;
+                    }
+                    out["mean"] = total / static_cast<double>(values.size());
+                    out["p50"] = percentile(values, 50.0);
+                    out["p95"] = percentile(values, 95.0);
+                    out["p99"] = percentile(values, 99.0);
+                }
+                return out;
+            }
         }
 
         struct Benchmark::Private
@@ -43,24 +80,31 @@ namespace djv
             std::weak_ptr<ftk::Context> context;
             std::weak_ptr<App> app;
             double seconds = 0.0;
+            std::string output;
 
             std::shared_ptr<ftk::Timer> timer;
             std::chrono::steady_clock::time_point startTime;
             bool warm = false;
             std::vector<double> fps;
             size_t droppedStart = 0;
+            std::array<std::vector<double>, static_cast<size_t>(RenderStage::Count)> cpu;
+            std::array<std::vector<double>, static_cast<size_t>(RenderStage::Count)> gpu;
             bool success = false;
+            nlohmann::json result;
+            std::function<void(void)> finishedCallback;
         };
 
         void Benchmark::_init(
             const std::shared_ptr<ftk::Context>& context,
             const std::shared_ptr<App>& app,
-            double seconds)
+            double seconds,
+            const std::string& output)
         {
             FTK_P();
             p.context = context;
             p.app = app;
             p.seconds = seconds;
+            p.output = output;
         }
 
         Benchmark::Benchmark() :
@@ -73,10 +117,11 @@ namespace djv
         std::shared_ptr<Benchmark> Benchmark::create(
             const std::shared_ptr<ftk::Context>& context,
             const std::shared_ptr<App>& app,
-            double seconds)
+            double seconds,
+            const std::string& output)
         {
             auto out = std::shared_ptr<Benchmark>(new Benchmark);
-            out->_init(context, app, seconds);
+            out->_init(context, app, seconds, output);
             return out;
         }
 
@@ -99,6 +144,14 @@ namespace djv
             // present to. An offscreen window skips the swap, which is what
             // keeps the measurement off the monitor's refresh rate.
             app->setOffscreen(true);
+            if (!app->getWindows().empty())
+            {
+                if (auto window = std::dynamic_pointer_cast<MainWindow>(
+                    app->getWindows().front()))
+                {
+                    window->getViewport()->setRenderTimingEnabled(true);
+                }
+            }
 
             player->setPlayback(tl::Playback::Forward);
             p.startTime = std::chrono::steady_clock::now();
@@ -113,11 +166,21 @@ namespace djv
             return true;
         }
 
+        void Benchmark::setFinishedCallback(const std::function<void(void)>& value)
+        {
+            _p->finishedCallback = value;
+        }
+
         bool Benchmark::succeeded() const
         {
             return _p->success;
         }
 
+        const nlohmann::json& Benchmark::getResult() const
+        {
+            return _p->result;
+        }
+
         void Benchmark::_tick()
         {
             FTK_P();
@@ -140,6 +203,7 @@ namespace djv
                 // while the cache filled are not charged to the render path.
                 p.warm = true;
                 p.startTime = now;
+                window->getViewport()->takeRenderTimings();
                 if (auto player = app->observePlayer()->get())
                 {
                     p.droppedStart = player->getDroppedFrames();
@@ -148,13 +212,34 @@ namespace djv
             }
 
             p.fps.push_back(window->getViewport()->observeFPS()->get());
-
+            for (const auto& sample : window->getViewport()->takeRenderTimings())
+            {
+                const size_t i = static_cast<size_t>(sample.stage);
+                p.cpu[i].push_back(sample.cpu);
+                if (sample.gpu.has_value())
+                {
+                    p.gpu[i].push_back(*sample.gpu);
+                }
+            }
 
             if (elapsed.count() >= p.seconds)
             {
-                _report();
                 p.timer->stop();
-                app->exit();
+                window->getViewport()->setRenderTimingEnabled(false);
+                if (auto player = app->observePlayer()->get())
+                {
+                    player->setPlayback(tl::Playback::Stop);
+                }
+                _report();
+                if (p.finishedCallback)
+                {
+                    p.finishedCallback();
+                }
+                else
+                {
+                    _write();
+                    app->exit();
+                }
             }
         }
 
@@ -198,7 +283,81 @@ namespace djv
                 arg(player->getSpeed(), 2).
                 arg(low, 2).str());
             note(ftk::Format("dropped frames {0}").arg(dropped).str());
+
+            nlohmann::json stages;
+            for (const auto stage : getRenderStageEnums())
+            {
+                const size_t i = static_cast<size_t>(stage);
+                nlohmann::json json;
+                json["cpu"] = getStats(p.cpu[i]);
+                if (!p.gpu[i].empty())
+                {
+                    json["gpu"] = getStats(p.gpu[i]);
+                }
+                stages[to_string(stage)] = json;
+                const nlohmann::json& cpu = json["cpu"];
+                if (!p.cpu[i].empty())
+                {
+                    note(ftk::Format("{0}: CPU {1}ms mean, {2}ms p95{3}").
+                        arg(to_string(stage)).
+                        arg(cpu["mean"].get<double>(), 3).
+                        arg(cpu["p95"].get<double>(), 3).
+                        arg(json.contains("gpu") ?
+                            std::string(ftk::Format(", GPU {0}ms mean, {1}ms p95").
+                                arg(json["gpu"]["mean"].get<double>(), 3).
+                                arg(json["gpu"]["p95"].get<double>(), 3)) :
+                            std::string()).str());
+                }
+            }
+
+            // What the drawing was doing, which is what a comparison between
+            // two runs is about.
+            const auto& ocioOptions = app->getColorModel()->getOCIOOptions();
+            const auto& lutOptions = app->getColorModel()->getLUTOptions();
+            p.result = {
+                { "file", player->getPath().get() },
+                { "seconds", p.seconds },
+                { "colorBuffer", ftk::gl::to_string(app->getViewportModel()->getColorBuffer()) },
+                { "compare", tl::to_string(app->getFilesModel()->getCompareOptions().compare) },
+                { "ocio", {
+                    { "enabled", ocioOptions.enabled },
+                    { "fileName", ocioOptions.fileName },
+                    { "input", ocioOptions.input },
+                    { "display", ocioOptions.display },
+                    { "view", ocioOptions.view },
+                    { "look", ocioOptions.look } } },
+                { "lut", {
+                    { "enabled", lutOptions.enabled },
+                    { "fileName", lutOptions.fileName },
+                    { "order", tl::to_string(lutOptions.order) } } },
+                { "playback", {
+                    { "fps", mean },
+                    { "fpsSlowestTenth", low },
+                    { "speed", player->getSpeed() },
+                    { "droppedFrames", dropped } } },
+                { "stages", stages } };
             p.success = true;
         }
+
+        void Benchmark::_write()
+        {
+            FTK_P();
+            if (!p.success)
+                return;
+            if (!p.output.empty())
+            {
+                std::ofstream f(p.output);
+                f << p.result.dump(2) << std::endl;
+                if (!f)
+                {
+                    note(ftk::Format("cannot write: {0}").arg(p.output).str());
+                    p.success = false;
+                }
+            }
+            else
+            {
+                std::cout << p.result.dump(2) << std::endl;
+            }
+        }
     }
 }
@@ -7,6 +7,10 @@
 
 #include <ftk/Core/Util.h>
 
+#include <nlohmann/json.hpp>
+
+#include <functional>
+
 #include <memory>
 #include <string>
 
@@ -29,25 +33,30 @@ namespace djv
         //! timer inside the normal event loop, which is what sizes the window
         //! and produces a buffer to draw into.
         //!
-        //! What is measured is the rate frames reach the viewport and how many
-        //! were dropped -- whether playback keeps up. It is not a measure of
-        //! what drawing costs: the only per-frame render timing ftk keeps is a
-        //! DiagSystem sampler, which ticks once every three seconds and is
-        //! rounded to a millisecond, so it cannot tell two filters apart.
+        //! Two things are measured. The first is the rate frames reach the
+        //! viewport and how many were dropped -- whether playback keeps up.
+        //! That rate is capped at the display refresh: an offscreen window
+        //! still swaps buffers and the swap interval is 1, so every frame
+        //! waits for vsync however cheap it was, and a 1080p sequence and a
+        //! 320x180 one both report 59 when asked for 120.
         //!
-        //! The rate is also capped at the display refresh. An offscreen window
-        //! still swaps buffers and the swap interval is 1, so every frame waits
-        //! for vsync however cheap it was: a 1080p sequence and a 320x180 one
-        //! both report 59 when asked for 120. A source slower than the monitor
-        //! therefore has headroom this cannot see, and a shortfall only shows
-        //! up once playback falls below the refresh rate.
+        //! The second is what drawing costs, which the rate cannot show. The
+        //! viewport times each stage of every drawing (see RenderTiming), on
+        //! the CPU and with GPU timer queries, around the drawing rather than
+        //! the swap, so vsync does not enter into it. The mean and the 50th,
+        //! 95th, and 99th percentiles of each stage are written as JSON along
+        //! with the color buffer, comparison, and color options they were
+        //! measured with, so that runs differing in one of them can be put
+        //! side by side. The JSON goes to the output file when there is one,
+        //! and to the standard output otherwise.
         class DJV_API_TYPE Benchmark : public std::enable_shared_from_this<Benchmark>
         {
         protected:
             void _init(
                 const std::shared_ptr<ftk::Context>&,
                 const std::shared_ptr<App>&,
-                double seconds);
+                double seconds,
+                const std::string& output);
 
             Benchmark();
 
@@ -57,19 +66,29 @@ namespace djv
             DJV_API static std::shared_ptr<Benchmark> create(
                 const std::shared_ptr<ftk::Context>&,
                 const std::shared_ptr<App>&,
-                double seconds);
+                double seconds,
+                const std::string& output = std::string());
 
             //! Start playback and arm the sampling timer. Returns false if
             //! there is nothing to play. After this returns true, the caller
             //! runs the event loop.
             DJV_API bool begin();
 
+            //! Set a callback for when the run is finished. Without one the
+            //! result is written and the application exits; with one, the
+            //! caller takes the result and decides what happens next.
+            DJV_API void setFinishedCallback(const std::function<void(void)>&);
+
             //! Whether the run produced a measurement.
             DJV_API bool succeeded() const;
 
+            //! Get the result.
+            DJV_API const nlohmann::json& getResult() const;
+
         private:
             void _tick();
             void _report();
+            void _write();
 
             FTK_PRIVATE();
         };
@@ -0,0 +1,546 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djv/App/BenchmarkSuite.h>
+
+#include <djv/App/App.h>
+#include <djv/App/Benchmark.h>
+#include <djv/Models/ColorModel.h>
+#include <djv/Models/FilesModel.h>
+#include <djv/Models/SettingsModel.h>
+#include <djv/Models/ViewportModel.h>
+
+#include <tlRender/Timeline/Player.h>
+
+#include <ftk/Core/Context.h>
+#include <ftk/Core/Format.h>
+#include <ftk/Core/Path.h>
+#include <ftk/Core/String.h>
+#include <ftk/Core/Timer.h>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+
+namespace djv
+{
+    namespace app
+    {
+        namespace
+        {
+            // Budgets in ticks of the timer below, the same as the capture.
+            const std::chrono::milliseconds tickInterval(30);
+            const int reloadGraceTicks = 4; // 120ms for a reload to begin
+            const int timeoutTicks = 1000;  // 30s hard cap waiting for media
+
+            const double defaultSeconds = 5.0;
+
+            void note(const std::string& msg)
+            {
+                std::cerr << "djv benchmark: " << msg << std::endl;
+            }
+
+            void note(const std::string& id, const std::string& msg)
+            {
+                std::cerr << "djv benchmark [" << id << "]: " << msg << std::endl;
+            }
+
+            nlohmann::json read(const std::filesystem::path& path)
+            {
+                std::ifstream f(path);
+                if (!f.is_open())
+                {
+                    throw std::runtime_error(ftk::Format(
+                        "cannot open \"{0}\"").arg(path.u8string()));
+                }
+                nlohmann::json out;
+                f >> out;
+                return out;
+            }
+
+            // A baseline may be from another version, or edited by hand,
+            // so nothing in it is taken to be there or of the right type.
+            const nlohmann::json* getObject(const nlohmann::json& json, const std::string& key)
+            {
+                return json.is_object() && json.contains(key) && json.at(key).is_object() ?
+                    &json.at(key) :
+                    nullptr;
+            }
+
+            double getNumber(const nlohmann::json& json, const std::string& key)
+            {
+                return json.is_object() && json.contains(key) && json.at(key).is_number() ?
+                    json.at(key).get<double>() :
+                    0.0;
+            }
+
+            const nlohmann::json* findScenario(const nlohmann::json& doc, const std::string& id)
+            {
+                if (doc.is_object() && doc.contains("scenarios") && doc.at("scenarios").is_array())
+                {
+                    for (const auto& i : doc.at("scenarios"))
+                    {
+                        if (i.is_object() &&
+                            i.contains("id") &&
+                            i.at("id").is_string() &&
+                            i.at("id").get<std::string>() == id)
+                            return &i;
+                    }
+                }
+                return nullptr;
+            }
+        }
+
+        struct BenchmarkSuite::Private
+        {
+            std::weak_ptr<ftk::Context> context;
+            std::weak_ptr<App> app;
+            std::filesystem::path manifest;
+            std::filesystem::path output;
+            std::filesystem::path baseline;
+            double tolerance = 0.0;
+
+            nlohmann::json scenarios;
+            nlohmann::json baselineDoc;
+            nlohmann::json results = nlohmann::json::array();
+
+            // What the settings were before the suite, which every scenario
+            // starts from so that one does not inherit another's changes.
+            tl::PlayerCacheOptions cache;
+            models::ImageSeqSettings imageSeq;
+            ftk::gl::TextureType colorBuffer = ftk::gl::TextureType::RGBA_U8;
+            tl::OCIOOptions ocioOptions;
+            tl::CompareOptions compareOptions;
+
+            enum class Phase
+            {
+                Setup,
+                Open,
+                Reload,
+                Run,
+                Collect
+            };
+            Phase phase = Phase::Setup;
+            size_t index = 0;
+            int ticks = 0;
+            int reloadGrace = 0;
+            std::shared_ptr<Benchmark> benchmark;
+            bool failed = false;
+
+            std::shared_ptr<ftk::Timer> timer;
+            bool success = false;
+        };
+
+        void BenchmarkSuite::_init(
+            const std::shared_ptr<ftk::Context>& context,
+            const std::shared_ptr<App>& app,
+            const std::filesystem::path& manifest,
+            const std::filesystem::path& output,
+            const std::filesystem::path& baseline,
+            double tolerance)
+        {
+            FTK_P();
+            p.context = context;
+            p.app = app;
+            p.manifest = manifest;
+            p.output = output;
+            p.baseline = baseline;
+            p.tolerance = tolerance;
+        }
+
+        BenchmarkSuite::BenchmarkSuite() :
+            _p(new Private)
+        {}
+
+        BenchmarkSuite::~BenchmarkSuite()
+        {}
+
+        std::shared_ptr<BenchmarkSuite> BenchmarkSuite::create(
+            const std::shared_ptr<ftk::Context>& context,
+            const std::shared_ptr<App>& app,
+            const std::filesystem::path& manifest,
+            const std::filesystem::path& output,
+            const std::filesystem::path& baseline,
+            double tolerance)
+        {
+            auto out = std::shared_ptr<BenchmarkSuite>(new BenchmarkSuite);
+            out->_init(context, app, manifest, output, baseline, tolerance);
+            return out;
+        }
+
+        bool BenchmarkSuite::begin()
+        {
+            FTK_P();
+            auto context = p.context.lock();
+            auto app = p.app.lock();
+            if (!context || !app)
+                return false;
+
+            try
+            {
+                p.scenarios = read(p.manifest).at("scenarios");
+                if (!p.baseline.empty())
+                {
+                    p.baselineDoc = read(p.baseline);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                note(e.what());
+                return false;
+            }
+            if (p.scenarios.empty())
+            {
+                note("no scenarios in the manifest");
+                return false;
+            }
+
+            p.cache = app->getSettingsModel()->getCache();
+            p.imageSeq = app->getSettingsModel()->getImageSeq();
+            p.colorBuffer = app->getViewportModel()->getColorBuffer();
+            p.ocioOptions = app->getColorModel()->getOCIOOptions();
+            p.compareOptions = app->getFilesModel()->getCompareOptions();
+
+            app->setOffscreen(true);
+
+            p.timer = ftk::Timer::create(context);
+            p.timer->setRepeating(true);
+            auto weak = std::weak_ptr<BenchmarkSuite>(shared_from_this());
+            p.timer->start(tickInterval, [weak] {
+                if (auto self = weak.lock())
+                    self->_tick();
+            });
+            return true;
+        }
+
+        bool BenchmarkSuite::succeeded() const
+        {
+            return _p->success;
+        }
+
+        void BenchmarkSuite::_tick()
+        {
+            FTK_P();
+            auto app = p.app.lock();
+            if (!app)
+                return;
+            if (p.index >= p.scenarios.size())
+            {
+                _finish();
+                return;
+            }
+            const nlohmann::json& scenario = p.scenarios[p.index];
+            const std::string id = scenario.value("id", std::string());
+
+            if (Private::Phase::Open == p.phase ||
+                Private::Phase::Reload == p.phase)
+            {
+                if (++p.ticks > timeoutTicks)
+                {
+                    note(id, "timed out waiting for the media");
+                    p.results.push_back({ { "id", id }, { "error", "timed out" } });
+                    p.failed = true;
+                    ++p.index;
+                    p.phase = Private::Phase::Setup;
+                    return;
+                }
+            }
+
+            switch (p.phase)
+            {
+            case Private::Phase::Setup:
+                note(id, "setting up");
+                _setup(scenario);
+                p.ticks = 0;
+                p.phase = Private::Phase::Open;
+                break;
+            case Private::Phase::Open:
+            {
+                const size_t inputs = scenario.value("inputs", nlohmann::json::array()).size();
+                if (app->getFilesModel()->getFiles().size() >= inputs)
+                {
+                    // The comparison needs the files it compares, so it is
+                    // set once they are all open.
+                    // Opening a file makes it the A file, which would leave
+                    // the last input as A rather than the first.
+                    auto filesModel = app->getFilesModel();
+                    filesModel->setA(scenario.value("a", 0));
+                    for (const auto& b : scenario.value("b", nlohmann::json::array()))
+                    {
+                        filesModel->setB(b.get<int>(), true);
+                    }
+                    if (scenario.contains("compare"))
+                    {
+                        tl::CompareOptions options = filesModel->getCompareOptions();
+                        tl::from_string(scenario.at("compare").get<std::string>(), options.compare);
+                        filesModel->setCompareOptions(options);
+                    }
+                    p.reloadGrace = reloadGraceTicks;
+                    p.phase = Private::Phase::Reload;
+                }
+                break;
+            }
+            case Private::Phase::Reload:
+                if (p.reloadGrace > 0)
+                {
+                    --p.reloadGrace;
+                }
+                else if (_ready())
+                {
+                    _run();
+                }
+                break;
+            case Private::Phase::Collect:
+            {
+                nlohmann::json result = p.benchmark->getResult();
+                if (p.benchmark->succeeded())
+                {
+                    result["id"] = id;
+                }
+                else
+                {
+                    result = { { "id", id }, { "error", "no measurement" } };
+                    p.failed = true;
+                }
+                p.results.push_back(result);
+                p.benchmark.reset();
+                ++p.index;
+                p.phase = Private::Phase::Setup;
+                break;
+            }
+            default: break;
+            }
+        }
+
+        void BenchmarkSuite::_setup(const nlohmann::json& scenario)
+        {
+            FTK_P();
+            auto app = p.app.lock();
+            auto settingsModel = app->getSettingsModel();
+            auto filesModel = app->getFilesModel();
+            filesModel->closeAll();
+
+            tl::PlayerCacheOptions cache = p.cache;
+            if (scenario.contains("cache"))
+            {
+                const auto& json = scenario.at("cache");
+                cache.videoGB = json.value("videoGB", cache.videoGB);
+                cache.audioGB = json.value("audioGB", cache.audioGB);
+                cache.readBehind = json.value("readBehind", cache.readBehind);
+            }
+            settingsModel->setCache(cache);
+
+            // The read threads are a timeline option, so they are set before
+            // the files are opened.
+            models::ImageSeqSettings imageSeq = p.imageSeq;
+            if (scenario.contains("readThreadCount"))
+            {
+                // A number asked for is measured as it is, not tuned away.
+                imageSeq.readThreadCount = scenario.at("readThreadCount").get<size_t>();
+                imageSeq.readThreadAuto = false;
+            }
+            settingsModel->setImageSeq(imageSeq);
+
+            ftk::gl::TextureType colorBuffer = p.colorBuffer;
+            if (scenario.contains("colorBuffer"))
+            {
+                ftk::gl::from_string(scenario.at("colorBuffer").get<std::string>(), colorBuffer);
+            }
+            app->getViewportModel()->setColorBuffer(colorBuffer);
+
+            tl::OCIOOptions ocioOptions = p.ocioOptions;
+            if (scenario.contains("ocio"))
+            {
+                const auto& json = scenario.at("ocio");
+                ocioOptions.enabled = json.value("enabled", ocioOptions.enabled);
+                ocioOptions.fileName = json.value("fileName", ocioOptions.fileName);
+                ocioOptions.input = json.value("input", ocioOptions.input);
+                ocioOptions.display = json.value("display", ocioOptions.display);
+                ocioOptions.view = json.value("view", ocioOptions.view);
+                ocioOptions.look = json.value("look", ocioOptions.look);
+            }
+            app->getColorModel()->setOCIOOptions(ocioOptions);
+
+            filesModel->setCompareOptions(p.compareOptions);
+
+            for (const auto& input : scenario.value("inputs", nlohmann::json::array()))
+            {
+                ftk::Path path(input.get<std::string>());
+                if (path.hasSeqWildcard())
+                    path = ftk::expandSeq(path);
+                app->open(path);
+            }
+        }
+
+        bool BenchmarkSuite::_ready() const
+        {
+            FTK_P();
+            auto app = p.app.lock();
+            if (!app)
+                return false;
+            auto player = app->observePlayer()->get();
+            return player && !player->getIOInfo().video.empty();
+        }
+
+        void BenchmarkSuite::_run()
+        {
+            FTK_P();
+            auto context = p.context.lock();
+            auto app = p.app.lock();
+            const nlohmann::json& scenario = p.scenarios[p.index];
+            const std::string id = scenario.value("id", std::string());
+            auto player = app->observePlayer()->get();
+            if (scenario.contains("speed"))
+            {
+                player->setSpeed(scenario.at("speed").get<double>());
+            }
+            note(id, "running");
+            p.benchmark = Benchmark::create(
+                context,
+                app,
+                scenario.value("seconds", defaultSeconds));
+            auto weak = std::weak_ptr<BenchmarkSuite>(shared_from_this());
+            p.benchmark->setFinishedCallback(
+                [weak]
+                {
+                    // Collected from the next tick rather than here, where
+                    // the benchmark is still running its own.
+                    if (auto self = weak.lock())
+                        self->_p->phase = Private::Phase::Collect;
+                });
+            p.phase = Private::Phase::Run;
+            if (!p.benchmark->begin())
+            {
+                p.phase = Private::Phase::Collect;
+            }
+        }
+
+        void BenchmarkSuite::_finish()
+        {
+            FTK_P();
+            auto app = p.app.lock();
+            p.timer->stop();
+
+            app->getFilesModel()->closeAll();
+            app->getSettingsModel()->setCache(p.cache);
+            app->getSettingsModel()->setImageSeq(p.imageSeq);
+            app->getViewportModel()->setColorBuffer(p.colorBuffer);
+            app->getColorModel()->setOCIOOptions(p.ocioOptions);
+            app->getFilesModel()->setCompareOptions(p.compareOptions);
+
+            nlohmann::json doc = {
+                { "system", app->getSysInfo() },
+                { "scenarios", p.results } };
+            bool regressed = false;
+            if (!p.baselineDoc.is_null())
+            {
+                const std::vector<std::string> regressions = _compare();
+                for (const auto& regression : regressions)
+                {
+                    note(regression);
+                }
+                note(ftk::Format("{0} regressions against {1} ({2}% tolerance)").
+                    arg(regressions.size()).
+                    arg(p.baseline.u8string()).
+                    arg(p.tolerance).str());
+                doc["baseline"] = p.baseline.u8string();
+                doc["tolerance"] = p.tolerance;
+                doc["regressions"] = regressions;
+                regressed = !regressions.empty();
+            }
+
+            bool written = true;
+            if (!p.output.empty())
+            {
+                std::ofstream f(p.output);
+                f << doc.dump(2) << std::endl;
+                if (!f)
+                {
+                    note(ftk::Format("cannot write: {0}").arg(p.output.u8string()).str());
+                    written = false;
+                }
+            }
+            else
+            {
+                std::cout << doc.dump(2) << std::endl;
+            }
+
+            p.success = !p.failed && !regressed && written;
+            app->exit();
+        }
+
+        std::vector<std::string> BenchmarkSuite::_compare() const
+        {
+            FTK_P();
+            std::vector<std::string> out;
+            const double tolerance = p.tolerance / 100.0;
+            for (const auto& result : p.results)
+            {
+                const std::string id = result.value("id", std::string());
+                const nlohmann::json* base = findScenario(p.baselineDoc, id);
+                if (!base || base->contains("error") || result.contains("error"))
+                {
+                    if (!base)
+                    {
+                        note(id, "not in the baseline");
+                    }
+                    continue;
+                }
+
+                // Playback is compared by the frame rate, which falling is
+                // the regression.
+                const nlohmann::json* playback = getObject(result, "playback");
+                const nlohmann::json* basePlayback = getObject(*base, "playback");
+                if (!playback || !basePlayback)
+                {
+                    note(id, "no playback to compare with the baseline");
+                }
+                else
+                {
+                    const double fps = getNumber(*playback, "fps");
+                    const double baseFPS = getNumber(*basePlayback, "fps");
+                    if (baseFPS > 0.0 && fps < baseFPS * (1.0 - tolerance))
+                    {
+                        out.push_back(ftk::Format("{0}: playback {1} FPS, baseline {2}").
+                            arg(id).
+                            arg(fps, 2).
+                            arg(baseFPS, 2));
+                    }
+                }
+
+                // The stages by the mean, which rising is the regression. The
+                // percentiles are in the output to look at, but a single
+                // slow frame moves them too far for a pass or fail.
+                const nlohmann::json* stages = getObject(result, "stages");
+                const nlohmann::json* baseStages = getObject(*base, "stages");
+                if (!stages || !baseStages)
+                    continue;
+                for (const auto& stage : baseStages->items())
+                {
+                    const nlohmann::json* current = getObject(*stages, stage.key());
+                    if (!current)
+                        continue;
+                    for (const std::string clock : { "cpu", "gpu" })
+                    {
+                        const nlohmann::json* currentClock = getObject(*current, clock);
+                        const nlohmann::json* baseClock = getObject(stage.value(), clock);
+                        if (!currentClock || !baseClock)
+                            continue;
+                        const double mean = getNumber(*currentClock, "mean");
+                        const double baseMean = getNumber(*baseClock, "mean");
+                        if (baseMean > 0.0 && mean > baseMean * (1.0 + tolerance))
+                        {
+                            out.push_back(ftk::Format("{0}: {1} {2} {3}ms, baseline {4}ms").
+                                arg(id).
+                                arg(stage.key()).
+                                arg(ftk::toUpper(clock)).
+                                arg(mean, 3).
+                                arg(baseMean, 3));
+                        }
+                    }
+                }
+            }
+            return out;
+        }
+    }
+}
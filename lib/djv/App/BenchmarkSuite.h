@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <djv/Models/Export.h>
+
+#include <ftk/Core/Util.h>
+
+#include <nlohmann/json.hpp>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ftk
+{
+    class Context;
+}
+
+namespace djv
+{
+    namespace app
+    {
+        class App;
+
+        //! Benchmark suite.
+        //!
+        //! Runs the scenarios of a benchmark manifest one after the other in
+        //! a single process. The manifest follows the capture manifest: a
+        //! "scenarios" array whose entries have an "id", the "inputs" to
+        //! open, and what to set up before playing them. The first input
+        //! is the A file unless "a" gives the index of another, and "b"
+        //! gives the indexes of the B files:
+        //!
+        //!     {
+        //!       "scenarios": [
+        //!         {
+        //!           "id": "bart-wipe-f16",
+        //!           "inputs": [ "shot.#.exr", "other.exr" ],
+        //!           "b": [ 1 ],
+        //!           "compare": "Wipe",
+        //!           "colorBuffer": "RGBA_F16",
+        //!           "ocio": { "enabled": true, "fileName": "config.ocio", "view": "Film" },
+        //!           "cache": { "videoGB": 4, "audioGB": 0.5, "readBehind": 0.5 },
+        //!           "readThreadCount": 8,
+        //!           "speed": 48,
+        //!           "seconds": 10
+        //!         }
+        //!       ]
+        //!     }
+        //!
+        //! Anything a scenario leaves out is as the settings were before
+        //! the suite started, and they are put back that way once it is
+        //! done. The results of every scenario are written together as
+        //! JSON, in the form a baseline is read back in: a run can be
+        //! compared against a stored one, and a frame rate that falls or a
+        //! drawing stage that slows by more than the tolerance fails the
+        //! run.
+        class DJV_API_TYPE BenchmarkSuite : public std::enable_shared_from_this<BenchmarkSuite>
+        {
+        protected:
+            void _init(
+                const std::shared_ptr<ftk::Context>&,
+                const std::shared_ptr<App>&,
+                const std::filesystem::path& manifest,
+                const std::filesystem::path& output,
+                const std::filesystem::path& baseline,
+                double tolerance);
+
+            BenchmarkSuite();
+
+        public:
+            DJV_API ~BenchmarkSuite();
+
+            //! Create a new suite. The tolerance is a percentage.
+            DJV_API static std::shared_ptr<BenchmarkSuite> create(
+                const std::shared_ptr<ftk::Context>&,
+                const std::shared_ptr<App>&,
+                const std::filesystem::path& manifest,
+                const std::filesystem::path& output,
+                const std::filesystem::path& baseline,
+                double tolerance);
+
+            //! Read the manifest and the baseline and start the first
+            //! scenario. Returns false on a setup error. After this returns
+            //! true, the caller runs the event loop.
+            DJV_API bool begin();
+
+            //! Whether every scenario ran and none of them regressed.
+            DJV_API bool succeeded() const;
+
+        private:
+            void _tick();
+            void _setup(const nlohmann::json&);
+            bool _ready() const;
+            void _run();
+            void _finish();
+            std::vector<std::string> _compare() const;
+
+            FTK_PRIVATE();
+        };
+    }
+}
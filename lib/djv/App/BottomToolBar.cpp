@@ -11,6 +11,7 @@
 #include <djv/UI/AudioPopup.h>
 #include <djv/UI/SpeedPopup.h>
 #include <djv/Models/AudioModel.h>
+#include <djv/Models/CacheWarmUpModel.h>
 #include <djv/Models/TimeUnitsModel.h>
 
 #include <tlRender/UI/PlaybackLoopWidget.h>
@@ -47,6 +48,7 @@ namespace djv
             std::shared_ptr<tl::ui::TimeEdit> currentTimeEdit;
             std::shared_ptr<tl::ui::TimeLabel> durationLabel;
             std::shared_ptr<tl::ui::TimeUnitsWidget> timeUnitsWidget;
+            std::shared_ptr<ftk::ToolButton> warmUpButton;
             std::shared_ptr<ftk::ToolButton> speedButton;
             std::shared_ptr<ui::SpeedPopup> speedPopup;
             std::shared_ptr<ftk::Label> audioLabel;
@@ -68,6 +70,7 @@ namespace djv
             std::shared_ptr<ftk::Observer<OTIO_NS::TimeRange> > inOutRangeObserver;
             std::shared_ptr<ftk::Observer<float> > volumeObserver;
             std::shared_ptr<ftk::Observer<bool> > muteObserver;
+            std::shared_ptr<ftk::Observer<models::CacheWarmUp> > warmUpObserver;
         };
 
         void BottomToolBar::_init(
@@ -129,6 +132,13 @@ namespace djv
             p.timeUnitsWidget->setTooltip("Time units.");
             ftk::setScreenshotTag(p.timeUnitsWidget, "Playback.TimeUnits");
 
+            p.warmUpButton = ftk::ToolButton::create(context, "Cache");
+            p.warmUpButton->setCheckable(true);
+            p.warmUpButton->setTooltip(
+                "Fill the cache over the in/out range, then start playback "
+                "once it is cached. Click again to cancel.");
+            ftk::setScreenshotTag(p.warmUpButton, "Playback.WarmUp");
+
             p.speedButton = ftk::ToolButton::create(context);
             p.speedButton->setPopupIcon("MenuArrow");
             p.speedButton->setTooltip("Playback speed.");
@@ -172,6 +182,7 @@ namespace djv
             p.durationLabel->setParent(hLayout);
             p.timeUnitsWidget->setParent(hLayout);
             p.speedButton->setParent(hLayout);
+            p.warmUpButton->setParent(hLayout);
             auto spacer = ftk::Spacer::create(context, ftk::Orientation::Horizontal, p.layout);
             spacer->setHStretch(ftk::Stretch::Expanding);
             hLayout2 = ftk::HorizontalLayout::create(context, p.layout);
@@ -253,6 +264,23 @@ namespace djv
                     }
                 });
 
+            p.warmUpButton->setCheckedCallback(
+                [this](bool value)
+                {
+                    FTK_P();
+                    if (auto app = p.app.lock())
+                    {
+                        if (value)
+                        {
+                            app->warmUpCache(true);
+                        }
+                        else
+                        {
+                            app->cancelCacheWarmUp();
+                        }
+                    }
+                });
+
             p.speedButton->setPressedCallback(
                 [this]
                 {
@@ -299,6 +327,14 @@ namespace djv
                     FTK_P();
                     p.audioButton->setIcon(value ? "Mute" : "Volume");
                 });
+
+            p.warmUpObserver = ftk::Observer<models::CacheWarmUp>::create(
+                app->getCacheWarmUpModel()->observeWarmUp(),
+                [this](const models::CacheWarmUp& value)
+                {
+                    FTK_P();
+                    p.warmUpButton->setChecked(value.active);
+                });
         }
 
         BottomToolBar::BottomToolBar() :
@@ -478,6 +514,7 @@ namespace djv
             p.currentTimeEdit->setEnabled(p.player.get());
             p.durationLabel->setEnabled(p.player.get());
             p.speedButton->setEnabled(video);
+            p.warmUpButton->setEnabled(video);
         }
 
         void BottomToolBar::_showSpeedPopup()
@@ -9,25 +9,59 @@
 #include <djv/Models/SettingsModel.h>
 
 #include <ftk/UI/ColorSwatch.h>
+#include <ftk/UI/ComboBox.h>
 #include <ftk/UI/FormLayout.h>
 #include <ftk/UI/Label.h>
 #include <ftk/UI/RowLayout.h>
 #include <ftk/UI/ScreenshotTag.h>
+#include <ftk/UI/Settings.h>
 #include <ftk/Core/Format.h>
 
+#include <array>
+
 namespace djv
 {
     namespace app
     {
+        FTK_ENUM_IMPL(
+            ColorPickerArea,
+            "Pixel",
+            "3x3",
+            "5x5",
+            "9x9",
+            "15x15",
+            "31x31",
+            "Box");
+
+        int getColorPickerAreaSize(ColorPickerArea value)
+        {
+            const std::array<int, static_cast<size_t>(ColorPickerArea::Count)> data =
+            {
+                1, 3, 5, 9, 15, 31, 0
+            };
+            return data[static_cast<size_t>(value)];
+        }
+
         struct ColorPickerTool::Private
         {
+            std::shared_ptr<ftk::Settings> settings;
+            std::weak_ptr<Viewport> viewport;
+            ColorPickerArea area = ColorPickerArea::Pixel;
+
             std::shared_ptr<ftk::ColorSwatch> colorSwatch;
             std::shared_ptr<ftk::Label> colorLabel;
             std::shared_ptr<ftk::Label> pixelLabel;
+            std::shared_ptr<ftk::ComboBox> areaComboBox;
+            std::shared_ptr<ftk::Label> minLabel;
+            std::shared_ptr<ftk::Label> maxLabel;
+            std::shared_ptr<ftk::Label> meanLabel;
+            std::shared_ptr<ftk::Label> stdDevLabel;
             std::shared_ptr<ftk::Label> mouseLabel;
+            std::shared_ptr<ftk::FormLayout> formLayout;
 
             std::shared_ptr<ftk::Observer<std::optional<ftk::V2I> > > pickObserver;
             std::shared_ptr<ftk::Observer<std::optional<ftk::Color4F> > > colorSampleObserver;
+            std::shared_ptr<ftk::Observer<std::optional<models::ImageStats> > > colorStatsObserver;
             std::shared_ptr<ftk::Observer<models::MouseSettings> > settingsObserver;
         };
 
@@ -47,6 +81,12 @@ namespace djv
                 parent);
             FTK_P();
 
+            p.settings = app->getSettings();
+            std::string s;
+            p.settings->get("/ColorPicker/Area", s);
+            from_string(s, p.area);
+            p.viewport = mainWindow->getViewport();
+
             p.colorSwatch = ftk::ColorSwatch::create(context);
             p.colorSwatch->setColor(ftk::Color4F(0.F, 0.F, 0.F));
             p.colorSwatch->setBorder(false);
@@ -60,21 +100,53 @@ namespace djv
             p.pixelLabel->setFont(ftk::FontType::Mono);
             ftk::setScreenshotTag(p.pixelLabel, "ColorPicker.Pixel");
 
+            p.areaComboBox = ftk::ComboBox::create(context, getColorPickerAreaLabels());
+            p.areaComboBox->setHStretch(ftk::Stretch::Expanding);
+            p.areaComboBox->setTooltip(
+                "The region the minimum, maximum, mean, and standard deviation "
+                "of each channel are measured over. Box measures the box "
+                "dragged out with the picker.");
+            ftk::setScreenshotTag(p.areaComboBox, "ColorPicker.Area");
+
+            p.minLabel = ftk::Label::create(context);
+            p.minLabel->setFont(ftk::FontType::Mono);
+            p.maxLabel = ftk::Label::create(context);
+            p.maxLabel->setFont(ftk::FontType::Mono);
+            p.meanLabel = ftk::Label::create(context);
+            p.meanLabel->setFont(ftk::FontType::Mono);
+            p.stdDevLabel = ftk::Label::create(context);
+            p.stdDevLabel->setFont(ftk::FontType::Mono);
+
             p.mouseLabel = ftk::Label::create(context);
             ftk::setScreenshotTag(p.mouseLabel, "ColorPicker.Mouse");
 
             auto layout = ftk::VerticalLayout::create(context);
             layout->setSpacingRole(ftk::SizeRole::None);
             p.colorSwatch->setParent(layout);
-            auto formLayout = ftk::FormLayout::create(context, layout);
-            formLayout->setMarginRole(ftk::SizeRole::Margin);
-            formLayout->setSpacingRole(ftk::SizeRole::SpacingSmall);
-            formLayout->addRow("Color:", p.colorLabel);
-            formLayout->addRow("Pixel:", p.pixelLabel);
-            formLayout->addRow("Mouse:", p.mouseLabel);
+            p.formLayout = ftk::FormLayout::create(context, layout);
+            p.formLayout->setMarginRole(ftk::SizeRole::Margin);
+            p.formLayout->setSpacingRole(ftk::SizeRole::SpacingSmall);
+            p.formLayout->addRow("Color:", p.colorLabel);
+            p.formLayout->addRow("Pixel:", p.pixelLabel);
+            p.formLayout->addRow("Area:", p.areaComboBox);
+            p.formLayout->addRow("Min:", p.minLabel);
+            p.formLayout->addRow("Max:", p.maxLabel);
+            p.formLayout->addRow("Mean:", p.meanLabel);
+            p.formLayout->addRow("Std dev:", p.stdDevLabel);
+            p.formLayout->addRow("Mouse:", p.mouseLabel);
 
             _setWidget(layout);
 
+            _areaUpdate();
+
+            p.areaComboBox->setIndexCallback(
+                [this](int value)
+                {
+                    FTK_P();
+                    p.area = static_cast<ColorPickerArea>(value);
+                    _areaUpdate();
+                });
+
             p.pickObserver = ftk::Observer<std::optional<ftk::V2I> >::create(
                 mainWindow->getViewport()->observePick(),
                 [this](const std::optional<ftk::V2I>& value)
@@ -106,6 +178,37 @@ namespace djv
                     p.colorLabel->setText(text);
                 });
 
+            p.colorStatsObserver = ftk::Observer<std::optional<models::ImageStats> >::create(
+                mainWindow->getViewport()->observeColorStats(),
+                [this](const std::optional<models::ImageStats>& value)
+                {
+                    FTK_P();
+                    std::array<std::string, 4> text = { "-", "-", "-", "-" };
+                    if (value.has_value())
+                    {
+                        const std::array<const std::array<float, 4>*, 4> values =
+                        {
+                            &value->min,
+                            &value->max,
+                            &value->mean,
+                            &value->stdDev
+                        };
+                        for (size_t i = 0; i < values.size(); ++i)
+                        {
+                            std::vector<std::string> s;
+                            for (int c = 0; c < value->channels; ++c)
+                            {
+                                s.push_back(ftk::Format("{0}").arg((*values[i])[c], 4));
+                            }
+                            text[i] = ftk::join(s, " ");
+                        }
+                    }
+                    p.minLabel->setText(text[0]);
+                    p.maxLabel->setText(text[1]);
+                    p.meanLabel->setText(text[2]);
+                    p.stdDevLabel->setText(text[3]);
+                });
+
             p.settingsObserver = ftk::Observer<models::MouseSettings>::create(
                 app->getSettingsModel()->observeMouse(),
                 [this](const models::MouseSettings& value)
@@ -133,7 +236,16 @@ namespace djv
         {}
 
         ColorPickerTool::~ColorPickerTool()
-        {}
+        {
+            FTK_P();
+            p.settings->set("/ColorPicker/Area", to_string(p.area));
+            // Nothing is left to show the statistics, so they are no longer
+            // measured.
+            if (auto viewport = p.viewport.lock())
+            {
+                viewport->setColorStatsArea(1);
+            }
+        }
 
         std::shared_ptr<ColorPickerTool> ColorPickerTool::create(
             const std::shared_ptr<ftk::Context>& context,
@@ -145,5 +257,20 @@ namespace djv
             out->_init(context, app, mainWindow, parent);
             return out;
         }
+
+        void ColorPickerTool::_areaUpdate()
+        {
+            FTK_P();
+            p.areaComboBox->setCurrentIndex(static_cast<int>(p.area));
+            const bool stats = p.area != ColorPickerArea::Pixel;
+            p.formLayout->setRowVisible(p.minLabel, stats);
+            p.formLayout->setRowVisible(p.maxLabel, stats);
+            p.formLayout->setRowVisible(p.meanLabel, stats);
+            p.formLayout->setRowVisible(p.stdDevLabel, stats);
+            if (auto viewport = p.viewport.lock())
+            {
+                viewport->setColorStatsArea(getColorPickerAreaSize(p.area));
+            }
+        }
     }
 }
@@ -10,6 +10,26 @@ namespace djv
 {
     namespace app
     {
+        //! Color picker area: the pixel picked, a square of pixels centered
+        //! on it, or a box dragged out with the picker.
+        enum class DJV_API_TYPE ColorPickerArea
+        {
+            Pixel,
+            _3x3,
+            _5x5,
+            _9x9,
+            _15x15,
+            _31x31,
+            Box,
+
+            Count,
+            First = Pixel
+        };
+        FTK_ENUM(ColorPickerArea);
+
+        //! Get the size of a color picker area, with zero for a box.
+        DJV_API int getColorPickerAreaSize(ColorPickerArea);
+
         //! Color picker tool.
         class DJV_API_TYPE ColorPickerTool : public IToolWidget
         {
@@ -34,6 +54,8 @@ namespace djv
                 const std::shared_ptr<IWidget>& parent = nullptr);
 
         private:
+            void _areaUpdate();
+
             FTK_PRIVATE();
         };
     }
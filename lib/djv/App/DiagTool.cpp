@@ -5,24 +5,44 @@
 
 #include <djv/App/App.h>
 
+#include <djv/Models/FrameBufferPool.h>
+
 #include <tlRender/Timeline/Player.h>
 #include <tlRender/IO/Plugin.h>
 
+#include <ftk/UI/Bellows.h>
 #include <ftk/UI/DiagWidget.h>
 #include <ftk/UI/GraphWidget.h>
+#include <ftk/UI/GridLayout.h>
+#include <ftk/UI/Label.h>
 #include <ftk/UI/RowLayout.h>
 #include <ftk/UI/ScrollWidget.h>
 #include <ftk/Core/Format.h>
 #include <ftk/Core/String.h>
 #include <ftk/Core/Timer.h>
 
+#include <map>
+
 namespace djv
 {
     namespace app
     {
+        namespace
+        {
+            std::string getGB(uint64_t value)
+            {
+                return std::string(ftk::Format("{0}GB").arg(value / (1024.0 * 1024.0 * 1024.0), 2));
+            }
+        }
+
         struct DiagTool::Private
         {
+            std::shared_ptr<ftk::GridLayout> memoryLayout;
+            std::map<std::string, std::shared_ptr<ftk::Label> > poolLabels;
             std::shared_ptr<ftk::DiagWidget> diagWidget;
+
+            std::shared_ptr<ftk::ListObserver<models::MemoryUsage> > memoryObserver;
+            std::shared_ptr<ftk::Timer> poolTimer;
         };
 
         void DiagTool::_init(
@@ -41,11 +61,40 @@ namespace djv
                 parent);
             FTK_P();
 
+            p.memoryLayout = ftk::GridLayout::create(context);
+            p.memoryLayout->setMarginRole(ftk::SizeRole::Margin);
+            p.memoryLayout->setSpacingRole(ftk::SizeRole::SpacingSmall);
+
+            auto poolLayout = ftk::GridLayout::create(context);
+            poolLayout->setMarginRole(ftk::SizeRole::Margin);
+            poolLayout->setSpacingRole(ftk::SizeRole::SpacingSmall);
+            int row = 0;
+            for (const auto& name : { "In use", "Kept", "Given back", "Reused" })
+            {
+                auto label = ftk::Label::create(context, name, poolLayout);
+                poolLayout->setGridPos(label, row, 0);
+                p.poolLabels[name] = ftk::Label::create(context, std::string(), poolLayout);
+                poolLayout->setGridPos(p.poolLabels[name], row, 1);
+                ++row;
+            }
+
             p.diagWidget = ftk::DiagWidget::create(context);
             p.diagWidget->setMarginRole(ftk::SizeRole::Margin);
 
+            auto layout = ftk::VerticalLayout::create(context);
+            layout->setSpacingRole(ftk::SizeRole::None);
+            auto bellows = ftk::Bellows::create(context, "Memory", layout);
+            bellows->setWidget(p.memoryLayout);
+            bellows->setOpen(true);
+            bellows = ftk::Bellows::create(context, "Frame Buffers", layout);
+            bellows->setWidget(poolLayout);
+            bellows->setOpen(true);
+            bellows = ftk::Bellows::create(context, "Objects", layout);
+            bellows->setWidget(p.diagWidget);
+            bellows->setOpen(true);
+
             auto scrollWidget = ftk::ScrollWidget::create(context);
-            scrollWidget->setWidget(p.diagWidget);
+            scrollWidget->setWidget(layout);
             scrollWidget->setBorder(false);
             scrollWidget->setVStretch(ftk::Stretch::Expanding);
             // The contents have no natural end, so this takes what room is
@@ -53,6 +102,25 @@ namespace djv
             // the height they need.
             setVStretch(ftk::Stretch::Expanding);
             _setWidget(scrollWidget);
+
+            p.memoryObserver = ftk::ListObserver<models::MemoryUsage>::create(
+                app->getMemoryModel()->observeUsage(),
+                [this](const std::vector<models::MemoryUsage>& value)
+                {
+                    _memoryUpdate(value);
+                });
+
+            // The pool is used from the reader threads, so it is looked at
+            // rather than observed.
+            _poolUpdate();
+            p.poolTimer = ftk::Timer::create(context);
+            p.poolTimer->setRepeating(true);
+            p.poolTimer->start(
+                std::chrono::seconds(1),
+                [this]
+                {
+                    _poolUpdate();
+                });
         }
 
         DiagTool::DiagTool() :
@@ -72,5 +140,63 @@ namespace djv
             out->_init(context, app, mainWindow, parent);
             return out;
         }
+
+        void DiagTool::_memoryUpdate(const std::vector<models::MemoryUsage>& value)
+        {
+            FTK_P();
+            p.memoryLayout->clear();
+            auto context = getContext();
+            uint64_t budget = 0;
+            int row = 0;
+            for (const auto& usage : value)
+            {
+                auto label = ftk::Label::create(context, usage.account.name, p.memoryLayout);
+                p.memoryLayout->setGridPos(label, row, 0);
+                label = ftk::Label::create(context, usage.account.file, p.memoryLayout);
+                p.memoryLayout->setGridPos(label, row, 1);
+                label = ftk::Label::create(
+                    context,
+                    usage.used.has_value() ?
+                        std::string(ftk::Format("{0} / {1}").arg(getGB(usage.used.value())).arg(getGB(usage.budget))) :
+                        getGB(usage.budget),
+                    p.memoryLayout);
+                label->setTooltip(std::string(ftk::Format("Asked for {0}, priority {1}").
+                    arg(getGB(usage.account.max)).
+                    arg(models::to_string(usage.account.priority))));
+                p.memoryLayout->setGridPos(label, row, 2);
+                budget += usage.budget;
+                ++row;
+            }
+            auto app = _app.lock();
+            const uint64_t limit = app ? app->getMemoryModel()->getBudget() : 0;
+            auto label = ftk::Label::create(context, "Total", p.memoryLayout);
+            p.memoryLayout->setGridPos(label, row, 0);
+            label = ftk::Label::create(
+                context,
+                limit > 0 ?
+                    std::string(ftk::Format("{0} of {1}").arg(getGB(budget)).arg(getGB(limit))) :
+                    std::string(ftk::Format("{0}, no limit").arg(getGB(budget))),
+                p.memoryLayout);
+            p.memoryLayout->setGridPos(label, row, 2);
+        }
+
+        void DiagTool::_poolUpdate()
+        {
+            FTK_P();
+            auto app = _app.lock();
+            if (!app)
+                return;
+            const models::FrameBufferPoolStats stats = app->getFrameBufferPool()->getStats();
+            p.poolLabels["In use"]->setText(getGB(stats.used));
+            p.poolLabels["Kept"]->setText(getGB(stats.free));
+            p.poolLabels["Given back"]->setText(getGB(stats.released));
+            const size_t count = stats.hits + stats.misses;
+            p.poolLabels["Reused"]->setText(count > 0 ?
+                std::string(ftk::Format("{0} of {1} frames, {2}%").
+                    arg(stats.hits).
+                    arg(count).
+                    arg(static_cast<int>(stats.hits * 100 / count))) :
+                std::string("No frames"));
+        }
     }
 }
@@ -5,12 +5,18 @@
 
 #include <djv/App/IToolWidget.h>
 #include <djv/Models/Export.h>
+#include <djv/Models/MemoryModel.h>
 
 namespace djv
 {
     namespace app
     {
         //! Diagnostics tool.
+        //!
+        //! Shows the memory budget of each cache, and what it is using
+        //! when that is known, how much of the frame buffer pool is in use
+        //! and how often it is reused, along with the objects the toolkit
+        //! counts.
         class DJV_API_TYPE DiagTool : public IToolWidget
         {
             FTK_NON_COPYABLE(DiagTool);
@@ -34,6 +40,9 @@ namespace djv
                 const std::shared_ptr<IWidget>& parent = nullptr);
 
         private:
+            void _memoryUpdate(const std::vector<models::MemoryUsage>&);
+            void _poolUpdate();
+
             FTK_PRIVATE();
         };
     }
@@ -4,21 +4,13 @@
 #include <djv/App/ExportTool.h>
 
 #include <djv/App/App.h>
+#include <djv/App/Exporter.h>
 #include <djv/App/ExportWidgets.h>
-#include <djv/Models/ColorModel.h>
 #include <djv/Models/FilesModel.h>
+#include <djv/Models/MemoryModel.h>
 #include <djv/Models/ViewportModel.h>
 
-#include <tlRender/GL/Render.h>
 #include <tlRender/Timeline/CompareOptions.h>
-#include <tlRender/Timeline/IRender.h>
-#include <tlRender/Timeline/Util.h>
-#include <tlRender/IO/System.h>
-#if defined(TLRENDER_FFMPEG_PLUGIN)
-#include <tlRender/IO/FFmpeg.h>
-#endif // TLRENDER_FFMPEG_PLUGIN
-
-#include <tlRender/Core/Audio.h>
 
 #include <ftk/UI/ComboBox.h>
 #include <ftk/UI/DialogSystem.h>
@@ -31,90 +23,19 @@
 #include <ftk/UI/ScreenshotTag.h>
 #include <ftk/UI/TabBar.h>
 #include <ftk/UI/TabWidget.h>
-#include <ftk/GL/GL.h>
-#include <ftk/GL/OffscreenBuffer.h>
-#include <ftk/GL/Util.h>
 #include <ftk/Core/Format.h>
 #include <ftk/Core/Timer.h>
 
-#include <algorithm>
-#include <cmath>
-#include <cstring>
-#include <filesystem>
-
 namespace djv
 {
     namespace app
     {
-        namespace
-        {
-            const int customSizeMin = 1;
-            const int customSizeMax = 16384;
-
-            // Scale a comparison layout to the export size. The boxes come
-            // out of the comparison at the size it lays out to naturally; a
-            // custom or preset export size stretches that, the same as the
-            // single image case does. Scaling the edges rather than the
-            // origin and the size keeps neighbouring boxes touching instead
-            // of leaving a seam between them.
-            std::vector<ftk::Box2I> scaleBoxes(
-                const std::vector<ftk::Box2I>& boxes,
-                const ftk::Size2I& from,
-                const ftk::Size2I& to)
-            {
-                if (!from.isValid() || from == to)
-                {
-                    return boxes;
-                }
-                const double sx = to.w / static_cast<double>(from.w);
-                const double sy = to.h / static_cast<double>(from.h);
-                std::vector<ftk::Box2I> out;
-                for (const auto& box : boxes)
-                {
-                    const int x0 = std::lround(box.min.x * sx);
-                    const int y0 = std::lround(box.min.y * sy);
-                    const int x1 = std::lround((box.max.x + 1) * sx);
-                    const int y1 = std::lround((box.max.y + 1) * sy);
-                    out.push_back(ftk::Box2I(x0, y0, x1 - x0, y1 - y0));
-                }
-                return out;
-            }
-        }
-
         struct ExportTool::Private
         {
             std::shared_ptr<tl::Player> player;
             std::shared_ptr<models::SettingsModel> settings;
 
-            struct ExportData
-            {
-                models::ExportFileType fileType = models::ExportFileType::Image;
-                OTIO_NS::TimeRange range;
-                int64_t frame = 0;
-                ftk::Path path;
-                ftk::ImageInfo info;
-                std::shared_ptr<tl::IWrite> writer;
-                bool hasAudio = false;
-                double audioStartSeconds = 0.0;
-                double audioDurationSeconds = 0.0;
-                double audioSeconds = 0.0;
-                int64_t audioSamples = 0;
-                tl::OCIOOptions ocioOptions;
-                tl::LUTOptions lutOptions;
-                // One entry per video source: the A file followed by the
-                // files it is being compared with. The layout is computed
-                // once so that it cannot shift part way through a movie.
-                std::vector<ftk::ImageOptions> imageOptions;
-                std::vector<tl::DisplayOptions> displayOptions;
-                tl::CompareOptions compareOptions;
-                std::vector<ftk::Box2I> boxes;
-                ftk::gl::TextureType colorBuffer = ftk::gl::TextureType::RGBA_U8;
-                std::shared_ptr<ftk::gl::OffscreenBuffer> buffer;
-                std::shared_ptr<tl::IRender> render;
-                GLenum glFormat = 0;
-                GLenum glType = 0;
-            };
-            std::unique_ptr<ExportData> exportData;
+            std::shared_ptr<Exporter> exporter;
 
             std::shared_ptr<ftk::FileEdit> dirEdit;
             std::shared_ptr<ftk::ComboBox> renderSizeComboBox;
@@ -169,7 +90,8 @@ namespace djv
                 "The other choices scale to the width given.");
             ftk::setScreenshotTag(p.renderSizeComboBox, "Export.RenderSize");
             p.renderWidthEdit = ftk::IntEdit::create(context);
-            p.renderWidthEdit->setRange(customSizeMin, customSizeMax);
+            const ftk::RangeI widthRange = getExportWidthRange();
+            p.renderWidthEdit->setRange(widthRange.min(), widthRange.max());
             p.renderWidthEdit->setTooltip(
                 "The height follows the aspect ratio of what is being "
                 "exported.");
@@ -333,101 +255,12 @@ namespace djv
             return out;
         }
 
-        std::vector<ftk::ImageInfo> ExportTool::_getInfos() const
-        {
-            FTK_P();
-            std::vector<ftk::ImageInfo> out;
-            if (p.player)
-            {
-                const tl::IOInfo& ioInfo = p.player->getIOInfo();
-                if (!ioInfo.video.empty())
-                {
-                    out.push_back(ioInfo.video.front());
-                    for (const auto& compare : p.player->getCompare())
-                    {
-                        // A source without video still takes a place in the
-                        // layout, so that the sources stay lined up with the
-                        // frames requested for them.
-                        const tl::IOInfo& compareIOInfo = compare->getIOInfo();
-                        out.push_back(
-                            !compareIOInfo.video.empty() ?
-                            compareIOInfo.video.front() :
-                            ftk::ImageInfo());
-                    }
-                }
-            }
-            return out;
-        }
-
-        ftk::Size2I ExportTool::_getDefaultSize() const
-        {
-            ftk::Size2I out;
-            if (auto app = _app.lock())
-            {
-                const std::vector<ftk::ImageInfo> infos = _getInfos();
-                const tl::AspectRatioOptions& aspectRatio =
-                    app->getViewportModel()->getDisplayOptions().aspectRatio;
-                out = tl::getRenderSize(
-                    app->getFilesModel()->getCompareOptions(),
-                    aspectRatio,
-                    infos);
-                // The B comparison sizes itself from the B file, which there
-                // need not be one of yet. Fall back to the A file so that the
-                // export still has a size to work with; it renders the same
-                // empty picture the viewport shows in the meantime.
-                if (!out.isValid() && !infos.empty())
-                {
-                    out = tl::getRenderSize(infos.front(), aspectRatio);
-                }
-            }
-            return out;
-        }
-
-        ftk::Size2I ExportTool::_getWidthSize(int width) const
-        {
-            ftk::Size2I out;
-            const ftk::Size2I size = _getDefaultSize();
-            if (size.isValid())
-            {
-                out.w = std::clamp(width, customSizeMin, customSizeMax);
-                out.h = std::clamp(
-                    static_cast<int>(std::lround(
-                        out.w * size.h / static_cast<double>(size.w))),
-                    customSizeMin,
-                    customSizeMax);
-            }
-            return out;
-        }
-
-        ftk::Size2I ExportTool::_getExportSize(
-            const models::ExportSettings& settings) const
-        {
-            ftk::Size2I out;
-            switch (settings.renderSize)
-            {
-            case models::ExportRenderSize::Default:
-                out = _getDefaultSize();
-                break;
-            case models::ExportRenderSize::Custom:
-                out = _getWidthSize(settings.customWidth);
-                break;
-            default:
-                // A preset is a width like any other: taking its height as
-                // well would squash anything that is not the shape it was
-                // named for, since the export scales to fill rather than
-                // letterboxing.
-                out = _getWidthSize(models::getWidth(settings.renderSize));
-                break;
-            }
-            return out;
-        }
-
         void ExportTool::_sizeUpdate()
         {
             FTK_P();
             // Blank until there is something to take an aspect ratio from,
             // which is also when there is nothing to export.
-            const ftk::Size2I size = _getExportSize(p.settings->getExport());
+            const ftk::Size2I size = getExportSize(_app.lock(), p.settings->getExport());
             p.outputSizeLabel->setText(size.isValid() ?
                 ftk::Format("{0} x {1}").arg(size.w).arg(size.h).str() :
                 std::string());
@@ -446,28 +279,6 @@ namespace djv
             p.tabWidget->setCurrent(static_cast<int>(settings.fileType));
         }
 
-        OTIO_NS::TimeRange ExportTool::_getExportRange(
-            models::ExportFileType fileType) const
-        {
-            FTK_P();
-            OTIO_NS::TimeRange out;
-            if (p.player)
-            {
-                switch (fileType)
-                {
-                case models::ExportFileType::Image:
-                    out = OTIO_NS::TimeRange(
-                        p.player->getCurrentTime(),
-                        OTIO_NS::RationalTime(1.0, p.player->getTimeRange().duration().rate()));
-                    break;
-                default:
-                    out = p.player->getInOutRange();
-                    break;
-                }
-            }
-            return out;
-        }
-
         void ExportTool::_export(models::ExportFileType fileType)
         {
             FTK_P();
@@ -478,7 +289,7 @@ namespace djv
             // twice write the same files: overwriting is easy to do without
             // meaning to, and a rendered sequence is expensive to lose.
             const auto options = p.settings->getExport();
-            const OTIO_NS::TimeRange range = _getExportRange(fileType);
+            const OTIO_NS::TimeRange range = getExportRange(p.player, fileType);
             if (getExportExists(options, fileType, range))
             {
                 // The names are in the tool, a click away from the button
@@ -521,235 +332,46 @@ namespace djv
                 auto context = getContext();
                 try
                 {
-                    const tl::IOInfo ioInfo = p.player->getIOInfo();
-                    if (ioInfo.video.empty())
-                    {
-                        throw std::runtime_error("No video to render");
-                    }
-                    p.exportData.reset(new Private::ExportData);
-                    p.exportData->fileType = fileType;
-
-                    // Get the time range.
-                    const auto options = p.settings->getExport();
-                    p.exportData->range = _getExportRange(fileType);
-                    p.exportData->frame = p.exportData->range.start_time().value();
-
-                    // Get the video sources. The export renders what the
-                    // viewport shows, so the files being compared with the A
-                    // file are laid out alongside it rather than dropped.
                     auto app = _app.lock();
-                    const auto& displayOptions = app->getViewportModel()->getDisplayOptions();
-                    p.exportData->compareOptions =
-                        app->getFilesModel()->getCompareOptions();
-                    const std::vector<ftk::ImageInfo> infos = _getInfos();
-                    const ftk::Size2I compareSize = _getDefaultSize();
-
-                    // Get the render size.
-                    p.exportData->info.size = _getExportSize(options);
-
-                    // Check the output directory before anything is rendered,
-                    // rather than letting each writer report it in its own way.
-                    // An empty one is an error and not an implicit write to
-                    // wherever the application happens to be running: the field
-                    // is filled in with a real directory, so clearing it is
-                    // something the user did.
-                    if (options.dir.empty())
-                    {
-                        throw std::runtime_error("No export directory");
-                    }
-                    if (!std::filesystem::is_directory(
-                        std::filesystem::u8path(options.dir)))
-                    {
-                        throw std::runtime_error(
-                            ftk::Format("Directory not found: \"{0}\"").
-                            arg(options.dir).str());
-                    }
-
-                    // Get the export path.
-                    const std::string fileName = getExportFileName(
-                        options,
-                        fileType,
-                        static_cast<int64_t>(
-                            p.exportData->range.start_time().value()));
-                    p.exportData->path = ftk::Path(options.dir, fileName);
-
-                    // Get the writer.
-                    auto ioSystem = context->getSystem<tl::WriteSystem>();
-                    auto plugin = ioSystem->getPlugin(p.exportData->path);
-                    if (!plugin)
-                    {
-                        throw std::runtime_error(
-                            ftk::Format("Cannot open: \"{0}\"").arg(p.exportData->path.get()));
-                    }
-                    p.exportData->info.type = ioInfo.video.front().type;
-                    p.exportData->info = plugin->getInfo(p.exportData->info);
-                    if (ftk::ImageType::None == p.exportData->info.type)
-                    {
-                        p.exportData->info.type = ftk::ImageType::RGBA_U8;
-                    }
-                    p.exportData->boxes = scaleBoxes(
-                        tl::getBoxes(
-                            p.exportData->compareOptions,
-                            displayOptions.aspectRatio,
-                            infos),
-                        compareSize,
-                        p.exportData->info.size);
-                    p.exportData->glFormat = ftk::gl::getReadPixelsFormat(p.exportData->info.type);
-                    p.exportData->glType = ftk::gl::getReadPixelsType(p.exportData->info.type);
-                    if (GL_NONE == p.exportData->glFormat || GL_NONE == p.exportData->glType)
-                    {
-                        throw std::runtime_error(
-                            ftk::Format("Cannot open: \"{0}\"").arg(p.exportData->path.get()));
-                    }
-                    const double speed = p.player->getSpeed();
-                    tl::IOInfo outputInfo;
-                    outputInfo.video.push_back(p.exportData->info);
-                    outputInfo.videoTime = OTIO_NS::TimeRange(
-                        OTIO_NS::RationalTime(0.0, speed),
-                        p.exportData->range.duration().rescaled_to(speed));
-                    if (models::ExportFileType::Movie == fileType)
-                    {
-                        // A movie's frames start at zero, so where it came
-                        // from in the timeline is only recoverable from the
-                        // start timecode. Rates that have no timecode of
-                        // their own are left without one rather than given a
-                        // wrong one.
-                        try
-                        {
-                            outputInfo.tags["timecode"] =
-                                p.exportData->range.start_time().to_timecode();
-                        }
-                        catch (const std::exception&)
-                        {}
-                    }
-#if defined(TLRENDER_FFMPEG_PLUGIN)
-                    if (models::ExportFileType::Movie == fileType &&
-                        ioInfo.audio.isValid() &&
-                        std::dynamic_pointer_cast<tl::ffmpeg::WritePlugin>(plugin))
-                    {
-                        p.exportData->hasAudio = true;
-                        outputInfo.audio = ioInfo.audio;
-                        outputInfo.audioTime = OTIO_NS::TimeRange(
-                            OTIO_NS::RationalTime(0.0, ioInfo.audio.sampleRate),
-                            p.exportData->range.duration().rescaled_to(ioInfo.audio.sampleRate));
-                        p.exportData->audioStartSeconds =
-                            p.exportData->range.start_time().rescaled_to(1.0).value();
-                        p.exportData->audioDurationSeconds =
-                            p.exportData->range.duration().rescaled_to(1.0).value();
-                    }
-#endif // TLRENDER_FFMPEG_PLUGIN
-
-                    // What the output pixels are. The export bakes the
-                    // display transform, so the color description written
-                    // is the display's; an unrecognized display writes
-                    // nothing rather than guessing. Without color
-                    // management the source pixels pass through, and the
-                    // source's description with them.
-                    const tl::OCIOOptions ocioOptions =
-                        app->getColorModel()->getOCIOOptions();
-                    if (ocioOptions.enabled &&
-                        !ocioOptions.display.empty() &&
-                        !ocioOptions.view.empty())
-                    {
-                        const ftk::ImageTags colorTags =
-                            tl::getDisplayColorTags(
-                                ocioOptions,
-                                models::ExportFileType::Movie != fileType);
-                        outputInfo.tags.insert(
-                            colorTags.begin(),
-                            colorTags.end());
-                    }
-                    else
-                    {
-                        for (const auto& tag :
-                            { "Color Primaries", "Color Transfer", "Chromaticities" })
-                        {
-                            const auto i = ioInfo.tags.find(tag);
-                            if (i != ioInfo.tags.end())
-                            {
-                                outputInfo.tags[tag] = i->second;
-                            }
-                        }
-                    }
-
-                    tl::IOOptions ioOptions;
-                    ioOptions["FFmpeg/Codec"] = options.movieCodec;
-                    if (!options.movieAudioCodec.empty() &&
-                        options.movieAudioCodec != "Auto")
-                    {
-                        ioOptions["FFmpeg/AudioCodec"] = options.movieAudioCodec;
-                    }
-                    p.exportData->writer = plugin->write(p.exportData->path, outputInfo, ioOptions);
-
-                    // Create the renderer.
-                    p.exportData->ocioOptions = ocioOptions;
-                    p.exportData->lutOptions = app->getColorModel()->getLUTOptions();
-                    p.exportData->imageOptions = std::vector<ftk::ImageOptions>(
-                        infos.size(),
-                        app->getViewportModel()->getImageOptions());
-                    p.exportData->displayOptions = std::vector<tl::DisplayOptions>(
-                        infos.size(),
-                        displayOptions);
-                    // Each file's resolved input color space, the same as
-                    // the viewport, so the export bakes what the viewport
-                    // shows.
-                    const auto resolvedInputs =
-                        app->getColorModel()->observeResolvedInputs()->get();
-                    for (size_t i = 0;
-                        i < p.exportData->displayOptions.size() &&
-                            i < resolvedInputs.size();
-                        ++i)
-                    {
-                        p.exportData->displayOptions[i].ocioInput = resolvedInputs[i];
-                    }
-                    p.exportData->colorBuffer = app->getViewportModel()->getColorBuffer();
-                    p.exportData->render = tl::gl::Render::create(
-                        context->getLogSystem(),
-                        context->getSystem<ftk::FontSystem>());
-                    {
-                        // The same per layer resolution as the viewport, so
-                        // the export bakes what the viewport shows.
-                        const auto colorModel = app->getColorModel();
-                        p.exportData->render->setOCIOInputResolver(
-                            [colorModel](const std::string& path, const ftk::ImageTags& tags)
-                            {
-                                return colorModel->getOCIOOptions().input.empty() ?
-                                    colorModel->resolveInput(path, tags) :
-                                    std::string();
-                            });
-                    }
-                    ftk::gl::OffscreenBufferOptions offscreenBufferOptions;
-                    // The wipe comparison masks with the stencil buffer, so
-                    // the buffer needs one. Paired with depth, as the
-                    // viewport does, for the combined format rather than a
-                    // stencil-only attachment.
-#if defined(FTK_API_GL_4_1)
-                    offscreenBufferOptions.depth = ftk::gl::OffscreenDepth::_24;
-                    offscreenBufferOptions.stencil = ftk::gl::OffscreenStencil::_8;
-#elif defined(FTK_API_GLES_2)
-                    offscreenBufferOptions.stencil = ftk::gl::OffscreenStencil::_8;
-#endif // FTK_API_GL_4_1
-                    p.exportData->buffer = ftk::gl::OffscreenBuffer::create(
-                        p.exportData->info.size,
-                        p.exportData->colorBuffer,
-                        offscreenBufferOptions);
+                    const ExportJob job = createExportJob(
+                        context,
+                        app,
+                        p.settings->getExport(),
+                        fileType);
+                    p.exporter = Exporter::create(
+                        context,
+                        p.player,
+                        job,
+                        app->getFrameBufferPool());
+
+                    // The export is what was asked for, so the caches make
+                    // room for it rather than the other way around.
+                    models::MemoryAccount account;
+                    account.name = "Export";
+                    account.priority = models::MemoryPriority::High;
+                    account.min = p.exporter->getMemorySize();
+                    account.max = account.min;
+                    app->getMemoryModel()->setAccount("Export", account);
 
                     // Create the progress dialog.
                     p.progressDialog = ftk::ProgressDialog::create(
                         context,
                         "Export",
                         "Rendering:");
-                    p.progressDialog->setRange(0.0, p.exportData->range.duration().value() - 1.0);
-                    p.progressDialog->setMessage(ftk::Format("Frame: {0} / {1}").
-                        arg(p.exportData->frame).
-                        arg(p.exportData->range.end_time_inclusive().value()));
+                    p.progressDialog->setRange(0.0, job.range.duration().value());
+                    p.progressDialog->setMessage(ftk::Format("Frame: 0 / {0}").
+                        arg(static_cast<int64_t>(job.range.duration().value())));
                     p.progressDialog->setCloseCallback(
                         [this]
                         {
                             FTK_P();
                             p.progressTimer->stop();
-                            p.exportData.reset();
+                            p.exporter.reset();
                             p.progressDialog.reset();
+                            if (auto app = _app.lock())
+                            {
+                                app->getMemoryModel()->removeAccount("Export");
+                            }
                         });
                     p.progressDialog->open(getWindow());
                     p.progressTimer->start(
@@ -759,19 +381,15 @@ namespace djv
                             FTK_P();
                             if (_exportFrame())
                             {
-                                const int64_t start = p.exportData->range.start_time().value();
-                                p.progressDialog->setValue(p.exportData->frame - start);
-                                const int64_t end = p.exportData->range.end_time_inclusive().value();
-                                if (p.exportData->frame <= end)
-                                {
-                                    p.progressDialog->setMessage(ftk::Format("Frame: {0} / {1}").
-                                        arg(p.exportData->frame - start).
-                                        arg(static_cast<int64_t>(p.exportData->range.duration().value())));
-                                }
-                                else
-                                {
-                                    p.progressDialog->close();
-                                }
+                                // The progress is what has been written rather
+                                // than what has been drawn, which runs ahead of
+                                // it by the frames still in the pipeline.
+                                const int64_t written = p.exporter->getFramesWritten();
+                                p.progressDialog->setValue(written);
+                                p.progressDialog->setMessage(ftk::Format("Frame: {0} / {1}").
+                                    arg(written).
+                                    arg(static_cast<int64_t>(
+                                        p.exporter->getJob().range.duration().value())));
                             }
                             else if (p.progressDialog)
                             {
@@ -799,94 +417,16 @@ namespace djv
             bool out = false;
             try
             {
-                // Get the video for the A file and each of the files it is
-                // being compared with. The requests are all made before any
-                // of them is waited on so that the sources are read in
-                // parallel.
-                const OTIO_NS::RationalTime t(p.exportData->frame, p.exportData->range.duration().rate());
-                auto ioOptions = p.player->getTimeline()->getOptions().ioOptions;
-                ioOptions["Layer"] = ftk::Format("{0}").arg(p.player->getVideoLayer());
-                std::vector<tl::VideoRequest> requests;
-                requests.push_back(p.player->getTimeline()->getVideo(t, ioOptions));
-                const auto& compare = p.player->getCompare();
-                const auto& compareVideoLayers = p.player->getCompareVideoLayers();
-                for (size_t i = 0; i < compare.size(); ++i)
-                {
-                    // The same time mapping the player uses, so that the
-                    // frame exported for each source is the frame that was
-                    // on screen.
-                    const OTIO_NS::RationalTime compareTime = tl::getCompareTime(
-                        t,
-                        p.player->getTimeRange(),
-                        compare[i]->getTimeRange(),
-                        p.player->getCompareTime());
-                    ioOptions["Layer"] = ftk::Format("{0}").arg(
-                        i < compareVideoLayers.size() ?
-                        compareVideoLayers[i] :
-                        p.player->getVideoLayer());
-                    requests.push_back(compare[i]->getVideo(compareTime, ioOptions));
-                }
-                std::vector<tl::VideoFrame> videoFrame;
-                for (auto& request : requests)
+                // Render the next frame, or once they have all been rendered,
+                // wait for the writer to catch up.
+                if (!p.exporter->tick())
                 {
-                    videoFrame.push_back(request.future.get());
+                    out = !p.exporter->isFinished();
                 }
-
-                // Render the video.
-                ftk::gl::OffscreenBufferBinding binding(p.exportData->buffer);
-                p.exportData->render->begin(p.exportData->info.size);
-                p.exportData->render->setOCIOOptions(p.exportData->ocioOptions);
-                p.exportData->render->setLUTOptions(p.exportData->lutOptions);
-                p.exportData->render->drawVideo(
-                    videoFrame,
-                    p.exportData->boxes,
-                    p.exportData->imageOptions,
-                    p.exportData->displayOptions,
-                    p.exportData->compareOptions,
-                    p.exportData->colorBuffer);
-                p.exportData->render->end();
-
-                // Write the output image.
-                auto image = ftk::Image::create(p.exportData->info);
-                glPixelStorei(GL_PACK_ALIGNMENT, p.exportData->info.layout.alignment);
-#if defined(FTK_API_GL_4_1)
-                glPixelStorei(GL_PACK_SWAP_BYTES, p.exportData->info.layout.endian != ftk::getEndian());
-#endif // FTK_API_GL_4_1
-                glReadPixels(
-                    0,
-                    0,
-                    p.exportData->info.size.w,
-                    p.exportData->info.size.h,
-                    p.exportData->glFormat,
-                    p.exportData->glType,
-                    image->getData());
-
-                // The sequence writers name each file from the time it is
-                // written at, so those keep the frame numbers of the timeline
-                // -- which is what the file name shown in the tool promises.
-                // A movie has no frame numbers in its name and the time
-                // becomes the presentation timestamp, so it starts at zero.
-                const int64_t start = p.exportData->range.start_time().value();
-                const double speed = p.player->getSpeed();
-                const OTIO_NS::RationalTime t2(
-                    models::ExportFileType::Movie == p.exportData->fileType ?
-                        p.exportData->frame - start :
-                        p.exportData->frame,
-                    speed);
-                p.exportData->writer->writeVideo(t2, image);
-
-                ++p.exportData->frame;
-
-                // Write the audio.
-                _exportAudio();
-
-                // Finish writing after the last frame.
-                if (p.exportData->frame > p.exportData->range.end_time_inclusive().value())
+                else
                 {
-                    p.exportData->writer->finish();
+                    out = true;
                 }
-
-                out = true;
             }
             catch (const std::exception& e)
             {
@@ -904,64 +444,5 @@ namespace djv
             }
             return out;
         }
-
-        void ExportTool::_exportAudio()
-        {
-            FTK_P();
-            if (!p.exportData->hasAudio)
-                return;
-
-            const int64_t start = p.exportData->range.start_time().value();
-            const double speed = p.player->getSpeed();
-            const double videoSeconds = OTIO_NS::RationalTime(
-                p.exportData->frame - start,
-                speed).rescaled_to(1.0).value();
-            while (p.exportData->audioSeconds <
-                std::min(videoSeconds, p.exportData->audioDurationSeconds))
-            {
-                // Get one second of audio from the timeline and mix the
-                // layers together.
-                auto frame = p.player->getTimeline()->getAudio(
-                    p.exportData->audioStartSeconds + p.exportData->audioSeconds).future.get();
-                std::vector<std::shared_ptr<tl::Audio> > layers;
-                for (const auto& layer : frame.layers)
-                {
-                    if (layer.audio)
-                    {
-                        layers.push_back(layer.audio);
-                    }
-                }
-                auto audio = tl::mixAudio(layers, 1.F);
-                if (audio && audio->isValid())
-                {
-                    // Trim the final chunk to the in/out range.
-                    const double remaining =
-                        p.exportData->audioDurationSeconds - p.exportData->audioSeconds;
-                    if (remaining < 1.0)
-                    {
-                        const size_t sampleCount = std::min(
-                            audio->getSampleCount(),
-                            static_cast<size_t>(
-                                remaining * audio->getInfo().sampleRate + .5));
-                        auto tmp = tl::Audio::create(audio->getInfo(), sampleCount);
-                        std::memcpy(
-                            tmp->getData(),
-                            audio->getData(),
-                            tmp->getByteCount());
-                        audio = tmp;
-                    }
-                    const OTIO_NS::TimeRange timeRange(
-                        OTIO_NS::RationalTime(
-                            p.exportData->audioSamples,
-                            audio->getInfo().sampleRate),
-                        OTIO_NS::RationalTime(
-                            audio->getSampleCount(),
-                            audio->getInfo().sampleRate));
-                    p.exportData->writer->writeAudio(timeRange, audio);
-                    p.exportData->audioSamples += audio->getSampleCount();
-                }
-                p.exportData->audioSeconds += 1.0;
-            }
-        }
     }
 }
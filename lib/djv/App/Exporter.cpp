@@ -0,0 +1,942 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djv/App/Exporter.h>
+
+#include <djv/App/App.h>
+#include <djv/App/ExportWidgets.h>
+#include <djv/Models/ColorModel.h>
+#include <djv/Models/FilesModel.h>
+#include <djv/Models/FrameBufferPool.h>
+#include <djv/Models/ViewportModel.h>
+
+#include <tlRender/GL/Render.h>
+#include <tlRender/Timeline/CompareOptions.h>
+#include <tlRender/Timeline/Util.h>
+#if defined(TLRENDER_FFMPEG_PLUGIN)
+#include <tlRender/IO/FFmpeg.h>
+#endif // TLRENDER_FFMPEG_PLUGIN
+
+#include <tlRender/Core/Audio.h>
+
+#include <ftk/GL/GL.h>
+#include <ftk/GL/OffscreenBuffer.h>
+#include <ftk/GL/Util.h>
+#include <ftk/Core/Context.h>
+#include <ftk/Core/Format.h>
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace djv
+{
+    namespace app
+    {
+        namespace
+        {
+            // How many frames are requested ahead of the one being drawn.
+            // Enough to keep the timeline's read threads busy while the GPU
+            // and the writer work; every one of them holds a decoded frame
+            // for each source, so more is memory for no gain.
+            const size_t readAhead = 8;
+
+            // How many frames are between being drawn and being copied out.
+            // Two would do if the copy always finished within a frame; the
+            // third absorbs the frames where it does not.
+            const size_t readbackCount = 3;
+
+            // How many finished frames may wait for the writer. A slow disk
+            // holds the rendering back here rather than letting the images
+            // pile up in memory.
+            const size_t writeQueueMax = 8;
+
+            const int customSizeMin = 1;
+            const int customSizeMax = 16384;
+
+            // Scale a comparison layout to the export size. The boxes come
+            // out of the comparison at the size it lays out to naturally; a
+            // custom or preset export size stretches that, the same as the
+            // single image case does. Scaling the edges rather than the
+            // origin and the size keeps neighbouring boxes touching instead
+            // of leaving a seam between them.
+            std::vector<ftk::Box2I> scaleBoxes(
+                const std::vector<ftk::Box2I>& boxes,
+                const ftk::Size2I& from,
+                const ftk::Size2I& to)
+            {
+                if (!from.isValid() || from == to)
+                {
+                    return boxes;
+                }
+                const double sx = to.w / static_cast<double>(from.w);
+                const double sy = to.h / static_cast<double>(from.h);
+                std::vector<ftk::Box2I> out;
+                for (const auto& box : boxes)
+                {
+                    const int x0 = std::lround(box.min.x * sx);
+                    const int y0 = std::lround(box.min.y * sy);
+                    const int x1 = std::lround((box.max.x + 1) * sx);
+                    const int y1 = std::lround((box.max.y + 1) * sy);
+                    out.push_back(ftk::Box2I(x0, y0, x1 - x0, y1 - y0));
+                }
+                return out;
+            }
+        }
+
+        ftk::RangeI getExportWidthRange()
+        {
+            return ftk::RangeI(customSizeMin, customSizeMax);
+        }
+
+        std::vector<ftk::ImageInfo> getExportInfos(
+            const std::shared_ptr<tl::Player>& player)
+        {
+            std::vector<ftk::ImageInfo> out;
+            if (player)
+            {
+                const tl::IOInfo& ioInfo = player->getIOInfo();
+                if (!ioInfo.video.empty())
+                {
+                    out.push_back(ioInfo.video.front());
+                    for (const auto& compare : player->getCompare())
+                    {
+                        // A source without video still takes a place in the
+                        // layout, so that the sources stay lined up with the
+                        // frames requested for them.
+                        const tl::IOInfo& compareIOInfo = compare->getIOInfo();
+                        out.push_back(
+                            !compareIOInfo.video.empty() ?
+                            compareIOInfo.video.front() :
+                            ftk::ImageInfo());
+                    }
+                }
+            }
+            return out;
+        }
+
+        namespace
+        {
+            ftk::Size2I getDefaultSize(const std::shared_ptr<App>& app)
+            {
+                ftk::Size2I out;
+                if (app)
+                {
+                    const std::vector<ftk::ImageInfo> infos =
+                        getExportInfos(app->observePlayer()->get());
+                    const tl::AspectRatioOptions& aspectRatio =
+                        app->getViewportModel()->getDisplayOptions().aspectRatio;
+                    out = tl::getRenderSize(
+                        app->getFilesModel()->getCompareOptions(),
+                        aspectRatio,
+                        infos);
+                    // The B comparison sizes itself from the B file, which
+                    // there need not be one of yet. Fall back to the A file so
+                    // that the export still has a size to work with; it
+                    // renders the same empty picture the viewport shows in the
+                    // meantime.
+                    if (!out.isValid() && !infos.empty())
+                    {
+                        out = tl::getRenderSize(infos.front(), aspectRatio);
+                    }
+                }
+                return out;
+            }
+
+            ftk::Size2I getWidthSize(const std::shared_ptr<App>& app, int width)
+            {
+                ftk::Size2I out;
+                const ftk::Size2I size = getDefaultSize(app);
+                if (size.isValid())
+                {
+                    out.w = std::clamp(width, customSizeMin, customSizeMax);
+                    out.h = std::clamp(
+                        static_cast<int>(std::lround(
+                            out.w * size.h / static_cast<double>(size.w))),
+                        customSizeMin,
+                        customSizeMax);
+                }
+                return out;
+            }
+        }
+
+        ftk::Size2I getExportSize(
+            const std::shared_ptr<App>& app,
+            const models::ExportSettings& settings)
+        {
+            ftk::Size2I out;
+            switch (settings.renderSize)
+            {
+            case models::ExportRenderSize::Default:
+                out = getDefaultSize(app);
+                break;
+            case models::ExportRenderSize::Custom:
+                out = getWidthSize(app, settings.customWidth);
+                break;
+            default:
+                // A preset is a width like any other: taking its height as
+                // well would squash anything that is not the shape it was
+                // named for, since the export scales to fill rather than
+                // letterboxing.
+                out = getWidthSize(app, models::getWidth(settings.renderSize));
+                break;
+            }
+            return out;
+        }
+
+        OTIO_NS::TimeRange getExportRange(
+            const std::shared_ptr<tl::Player>& player,
+            models::ExportFileType fileType)
+        {
+            OTIO_NS::TimeRange out;
+            if (player)
+            {
+                switch (fileType)
+                {
+                case models::ExportFileType::Image:
+                    out = OTIO_NS::TimeRange(
+                        player->getCurrentTime(),
+                        OTIO_NS::RationalTime(1.0, player->getTimeRange().duration().rate()));
+                    break;
+                default:
+                    out = player->getInOutRange();
+                    break;
+                }
+            }
+            return out;
+        }
+
+        ExportJob createExportJob(
+            const std::shared_ptr<ftk::Context>& context,
+            const std::shared_ptr<App>& app,
+            const models::ExportSettings& options,
+            models::ExportFileType fileType)
+        {
+            ExportJob job;
+            const auto player = app->observePlayer()->get();
+            if (!player)
+            {
+                throw std::runtime_error("No file to export");
+            }
+            const tl::IOInfo ioInfo = player->getIOInfo();
+            if (ioInfo.video.empty())
+            {
+                throw std::runtime_error("No video to render");
+            }
+            job.fileType = fileType;
+
+            // Get the time range.
+            job.range = getExportRange(player, fileType);
+
+            // Get the video sources. The export renders what the viewport
+            // shows, so the files being compared with the A file are laid out
+            // alongside it rather than dropped.
+            const auto& displayOptions = app->getViewportModel()->getDisplayOptions();
+            job.compareOptions = app->getFilesModel()->getCompareOptions();
+            const std::vector<ftk::ImageInfo> infos = getExportInfos(player);
+            const ftk::Size2I compareSize = getDefaultSize(app);
+
+            // Get the render size.
+            job.info.size = getExportSize(app, options);
+
+            // Check the output directory before anything is rendered,
+            // rather than letting each writer report it in its own way.
+            // An empty one is an error and not an implicit write to
+            // wherever the application happens to be running: the field
+            // is filled in with a real directory, so clearing it is
+            // something the user did.
+            if (options.dir.empty())
+            {
+                throw std::runtime_error("No export directory");
+            }
+            if (!std::filesystem::is_directory(
+                std::filesystem::u8path(options.dir)))
+            {
+                throw std::runtime_error(
+                    ftk::Format("Directory not found: \"{0}\"").
+                    arg(options.dir).str());
+            }
+
+            // Get the export path.
+            const std::string fileName = getExportFileName(
+                options,
+                fileType,
+                static_cast<int64_t>(
+                    job.range.start_time().value()));
+            const ftk::Path exportPath(options.dir, fileName);
+
+            // Get the writer.
+            auto ioSystem = context->getSystem<tl::WriteSystem>();
+            auto plugin = ioSystem->getPlugin(exportPath);
+            if (!plugin)
+            {
+                throw std::runtime_error(
+                    ftk::Format("Cannot open: \"{0}\"").arg(exportPath.get()));
+            }
+            job.info.type = ioInfo.video.front().type;
+            job.info = plugin->getInfo(job.info);
+            if (ftk::ImageType::None == job.info.type)
+            {
+                job.info.type = ftk::ImageType::RGBA_U8;
+            }
+            job.boxes = scaleBoxes(
+                tl::getBoxes(
+                    job.compareOptions,
+                    displayOptions.aspectRatio,
+                    infos),
+                compareSize,
+                job.info.size);
+            if (GL_NONE == ftk::gl::getReadPixelsFormat(job.info.type) ||
+                GL_NONE == ftk::gl::getReadPixelsType(job.info.type))
+            {
+                throw std::runtime_error(
+                    ftk::Format("Cannot open: \"{0}\"").arg(exportPath.get()));
+            }
+            const double speed = player->getSpeed();
+            tl::IOInfo outputInfo;
+            outputInfo.video.push_back(job.info);
+            outputInfo.videoTime = OTIO_NS::TimeRange(
+                OTIO_NS::RationalTime(0.0, speed),
+                job.range.duration().rescaled_to(speed));
+            if (models::ExportFileType::Movie == fileType)
+            {
+                // A movie's frames start at zero, so where it came
+                // from in the timeline is only recoverable from the
+                // start timecode. Rates that have no timecode of
+                // their own are left without one rather than given a
+                // wrong one.
+                try
+                {
+                    outputInfo.tags["timecode"] =
+                        job.range.start_time().to_timecode();
+                }
+                catch (const std::exception&)
+                {}
+            }
+#if defined(TLRENDER_FFMPEG_PLUGIN)
+            if (models::ExportFileType::Movie == fileType &&
+                ioInfo.audio.isValid() &&
+                std::dynamic_pointer_cast<tl::ffmpeg::WritePlugin>(plugin))
+            {
+                job.hasAudio = true;
+                outputInfo.audio = ioInfo.audio;
+                outputInfo.audioTime = OTIO_NS::TimeRange(
+                    OTIO_NS::RationalTime(0.0, ioInfo.audio.sampleRate),
+                    job.range.duration().rescaled_to(ioInfo.audio.sampleRate));
+                job.audioStartSeconds =
+                    job.range.start_time().rescaled_to(1.0).value();
+                job.audioDurationSeconds =
+                    job.range.duration().rescaled_to(1.0).value();
+            }
+#endif // TLRENDER_FFMPEG_PLUGIN
+
+            // What the output pixels are. The export bakes the
+            // display transform, so the color description written
+            // is the display's; an unrecognized display writes
+            // nothing rather than guessing. Without color
+            // management the source pixels pass through, and the
+            // source's description with them.
+            const tl::OCIOOptions ocioOptions =
+                app->getColorModel()->getOCIOOptions();
+            if (ocioOptions.enabled &&
+                !ocioOptions.display.empty() &&
+                !ocioOptions.view.empty())
+            {
+                const ftk::ImageTags colorTags =
+                    tl::getDisplayColorTags(
+                        ocioOptions,
+                        models::ExportFileType::Movie != fileType);
+                outputInfo.tags.insert(
+                    colorTags.begin(),
+                    colorTags.end());
+            }
+            else
+            {
+                for (const auto& tag :
+                    { "Color Primaries", "Color Transfer", "Chromaticities" })
+                {
+                    const auto i = ioInfo.tags.find(tag);
+                    if (i != ioInfo.tags.end())
+                    {
+                        outputInfo.tags[tag] = i->second;
+                    }
+                }
+            }
+
+            tl::IOOptions ioOptions;
+            ioOptions["FFmpeg/Codec"] = options.movieCodec;
+            if (!options.movieAudioCodec.empty() &&
+                options.movieAudioCodec != "Auto")
+            {
+                ioOptions["FFmpeg/AudioCodec"] = options.movieAudioCodec;
+            }
+            job.writer = plugin->write(exportPath, outputInfo, ioOptions);
+
+            // Create the renderer.
+            job.ocioOptions = ocioOptions;
+            job.lutOptions = app->getColorModel()->getLUTOptions();
+            job.imageOptions = std::vector<ftk::ImageOptions>(
+                infos.size(),
+                app->getViewportModel()->getImageOptions());
+            job.displayOptions = std::vector<tl::DisplayOptions>(
+                infos.size(),
+                displayOptions);
+            // Each file's resolved input color space, the same as
+            // the viewport, so the export bakes what the viewport
+            // shows.
+            const auto resolvedInputs =
+                app->getColorModel()->observeResolvedInputs()->get();
+            for (size_t i = 0;
+                i < job.displayOptions.size() &&
+                    i < resolvedInputs.size();
+                ++i)
+            {
+                job.displayOptions[i].ocioInput = resolvedInputs[i];
+            }
+            job.colorBuffer = app->getViewportModel()->getColorBuffer();
+            job.render = tl::gl::Render::create(
+                context->getLogSystem(),
+                context->getSystem<ftk::FontSystem>());
+            {
+                // The same per layer resolution as the viewport, so
+                // the export bakes what the viewport shows.
+                const auto colorModel = app->getColorModel();
+                job.render->setOCIOInputResolver(
+                    [colorModel](const std::string& path, const ftk::ImageTags& tags)
+                    {
+                        return colorModel->getOCIOOptions().input.empty() ?
+                            colorModel->resolveInput(path, tags) :
+                            std::string();
+                    });
+            }
+            return job;
+        }
+
+        struct Exporter::Private
+        {
+            std::weak_ptr<ftk::Context> context;
+            std::shared_ptr<tl::Player> player;
+            std::shared_ptr<tl::Timeline> timeline;
+            ExportJob job;
+            std::shared_ptr<models::FrameBufferPool> pool;
+            double speed = 0.0;
+
+            std::shared_ptr<ftk::gl::OffscreenBuffer> buffer;
+            GLenum glFormat = 0;
+            GLenum glType = 0;
+            size_t byteCount = 0;
+
+            struct Read
+            {
+                int64_t frame = 0;
+                std::vector<tl::VideoRequest> requests;
+            };
+            std::deque<Read> reads;
+            int64_t readFrame = 0;
+            int64_t renderFrame = 0;
+
+            struct Readback
+            {
+                GLuint pbo = 0;
+                std::optional<int64_t> frame;
+            };
+            std::vector<Readback> readbacks;
+            size_t readbackIndex = 0;
+
+            struct Write
+            {
+                int64_t frame = 0;
+                std::shared_ptr<ftk::Image> image;
+            };
+            struct WriterData
+            {
+                std::deque<Write> queue;
+                bool rendered = false;
+                bool cancel = false;
+                bool finished = false;
+                int64_t framesWritten = 0;
+                std::string error;
+            };
+            WriterData writerData;
+            std::mutex mutex;
+            std::condition_variable cv;
+            std::thread writerThread;
+
+            // Only touched by the writer thread.
+            double audioSeconds = 0.0;
+            int64_t audioSamples = 0;
+        };
+
+        void Exporter::_init(
+            const std::shared_ptr<ftk::Context>& context,
+            const std::shared_ptr<tl::Player>& player,
+            const ExportJob& job,
+            const std::shared_ptr<models::FrameBufferPool>& pool)
+        {
+            FTK_P();
+            p.context = context;
+            p.player = player;
+            p.timeline = player->getTimeline();
+            p.job = job;
+            p.pool = pool;
+            p.speed = player->getSpeed();
+            p.readFrame = job.range.start_time().value();
+            p.renderFrame = p.readFrame;
+
+            p.glFormat = ftk::gl::getReadPixelsFormat(job.info.type);
+            p.glType = ftk::gl::getReadPixelsType(job.info.type);
+            if (GL_NONE == p.glFormat || GL_NONE == p.glType)
+            {
+                throw std::runtime_error("Cannot read back the output image type");
+            }
+            p.byteCount = job.info.getByteCount();
+
+            ftk::gl::OffscreenBufferOptions offscreenBufferOptions;
+            // The wipe comparison masks with the stencil buffer, so the
+            // buffer needs one. Paired with depth, as the viewport does, for
+            // the combined format rather than a stencil-only attachment.
+#if defined(FTK_API_GL_4_1)
+            offscreenBufferOptions.depth = ftk::gl::OffscreenDepth::_24;
+            offscreenBufferOptions.stencil = ftk::gl::OffscreenStencil::_8;
+#elif defined(FTK_API_GLES_2)
+            offscreenBufferOptions.stencil = ftk::gl::OffscreenStencil::_8;
+#endif // FTK_API_GL_4_1
+            p.buffer = ftk::gl::OffscreenBuffer::create(
+                job.info.size,
+                job.colorBuffer,
+                offscreenBufferOptions);
+
+#if defined(FTK_API_GL_4_1)
+            p.readbacks.resize(readbackCount);
+            for (auto& readback : p.readbacks)
+            {
+                glGenBuffers(1, &readback.pbo);
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo);
+                glBufferData(GL_PIXEL_PACK_BUFFER, p.byteCount, nullptr, GL_STREAM_READ);
+            }
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+#endif // FTK_API_GL_4_1
+
+            p.writerThread = std::thread(
+                [this]
+                {
+                    _writerThread();
+                });
+        }
+
+        Exporter::Exporter() :
+            _p(new Private)
+        {}
+
+        Exporter::~Exporter()
+        {
+            FTK_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.writerData.cancel = true;
+            }
+            p.cv.notify_all();
+            if (p.writerThread.joinable())
+            {
+                p.writerThread.join();
+            }
+#if defined(FTK_API_GL_4_1)
+            for (const auto& readback : p.readbacks)
+            {
+                if (readback.pbo)
+                {
+                    glDeleteBuffers(1, &readback.pbo);
+                }
+            }
+#endif // FTK_API_GL_4_1
+        }
+
+        std::shared_ptr<Exporter> Exporter::create(
+            const std::shared_ptr<ftk::Context>& context,
+            const std::shared_ptr<tl::Player>& player,
+            const ExportJob& job,
+            const std::shared_ptr<models::FrameBufferPool>& pool)
+        {
+            auto out = std::shared_ptr<Exporter>(new Exporter);
+            out->_init(context, player, job, pool);
+            return out;
+        }
+
+        const ExportJob& Exporter::getJob() const
+        {
+            return _p->job;
+        }
+
+        bool Exporter::tick()
+        {
+            FTK_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                if (!p.writerData.error.empty())
+                {
+                    throw std::runtime_error(p.writerData.error);
+                }
+            }
+            const int64_t end = p.job.range.end_time_inclusive().value();
+            if (p.renderFrame > end)
+            {
+                return false;
+            }
+
+            // Keep the reads ahead of the drawing. Only the oldest is waited
+            // on; the rest are decoding in the meantime.
+            while (p.reads.size() < readAhead && p.readFrame <= end)
+            {
+                Private::Read read;
+                read.frame = p.readFrame;
+                read.requests = _request(p.readFrame);
+                p.reads.push_back(std::move(read));
+                ++p.readFrame;
+            }
+            Private::Read read = std::move(p.reads.front());
+            p.reads.pop_front();
+            std::vector<tl::VideoFrame> videoFrames;
+            for (auto& request : read.requests)
+            {
+                videoFrames.push_back(request.future.get());
+            }
+
+            {
+                ftk::gl::OffscreenBufferBinding binding(p.buffer);
+                _render(videoFrames);
+                _readback(read.frame);
+            }
+            ++p.renderFrame;
+
+            if (p.renderFrame > end)
+            {
+                // What is still in the ring is the tail of the range.
+                _flushReadbacks(true);
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex);
+                    p.writerData.rendered = true;
+                }
+                p.cv.notify_all();
+            }
+            return true;
+        }
+
+        uint64_t Exporter::getMemorySize() const
+        {
+            FTK_P();
+            // The frames read ahead are the sources rather than the output,
+            // but are taken to be the same size.
+            const size_t sources = std::max(p.job.imageOptions.size(), static_cast<size_t>(1));
+            return static_cast<uint64_t>(p.byteCount) *
+                (readAhead * sources + readbackCount + writeQueueMax);
+        }
+
+        int64_t Exporter::getFramesWritten() const
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.writerData.framesWritten;
+        }
+
+        bool Exporter::isFinished() const
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            if (!p.writerData.error.empty())
+            {
+                throw std::runtime_error(p.writerData.error);
+            }
+            return p.writerData.finished;
+        }
+
+        std::vector<tl::VideoRequest> Exporter::_request(int64_t frame)
+        {
+            FTK_P();
+            // Get the video for the A file and each of the files it is being
+            // compared with. The requests are all made before any of them is
+            // waited on so that the sources are read in parallel.
+            const OTIO_NS::RationalTime t(frame, p.job.range.duration().rate());
+            auto ioOptions = p.timeline->getOptions().ioOptions;
+            ioOptions["Layer"] = ftk::Format("{0}").arg(p.player->getVideoLayer());
+            std::vector<tl::VideoRequest> out;
+            out.push_back(p.timeline->getVideo(t, ioOptions));
+            const auto& compare = p.player->getCompare();
+            const auto& compareVideoLayers = p.player->getCompareVideoLayers();
+            for (size_t i = 0; i < compare.size(); ++i)
+            {
+                // The same time mapping the player uses, so that the frame
+                // exported for each source is the frame that was on screen.
+                const OTIO_NS::RationalTime compareTime = tl::getCompareTime(
+                    t,
+                    p.player->getTimeRange(),
+                    compare[i]->getTimeRange(),
+                    p.player->getCompareTime());
+                ioOptions["Layer"] = ftk::Format("{0}").arg(
+                    i < compareVideoLayers.size() ?
+                    compareVideoLayers[i] :
+                    p.player->getVideoLayer());
+                out.push_back(compare[i]->getVideo(compareTime, ioOptions));
+            }
+            return out;
+        }
+
+        void Exporter::_render(const std::vector<tl::VideoFrame>& videoFrames)
+        {
+            FTK_P();
+            p.job.render->begin(p.job.info.size);
+            p.job.render->setOCIOOptions(p.job.ocioOptions);
+            p.job.render->setLUTOptions(p.job.lutOptions);
+            p.job.render->drawVideo(
+                videoFrames,
+                p.job.boxes,
+                p.job.imageOptions,
+                p.job.displayOptions,
+                p.job.compareOptions,
+                p.job.colorBuffer);
+            p.job.render->end();
+        }
+
+        void Exporter::_readback(int64_t frame)
+        {
+            FTK_P();
+            glPixelStorei(GL_PACK_ALIGNMENT, p.job.info.layout.alignment);
+#if defined(FTK_API_GL_4_1)
+            glPixelStorei(GL_PACK_SWAP_BYTES, p.job.info.layout.endian != ftk::getEndian());
+
+            // The slot being reused holds the oldest frame in the ring, whose
+            // copy has had the drawing of the frames since to finish in.
+            _flushReadbacks(false);
+            auto& readback = p.readbacks[p.readbackIndex];
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo);
+            glReadPixels(
+                0,
+                0,
+                p.job.info.size.w,
+                p.job.info.size.h,
+                p.glFormat,
+                p.glType,
+                nullptr);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            readback.frame = frame;
+            p.readbackIndex = (p.readbackIndex + 1) % p.readbacks.size();
+#else // FTK_API_GL_4_1
+            // Without pixel pack buffers the copy is synchronous.
+            auto image = p.pool ?
+                p.pool->createImage(p.job.info) :
+                ftk::Image::create(p.job.info);
+            glReadPixels(
+                0,
+                0,
+                p.job.info.size.w,
+                p.job.info.size.h,
+                p.glFormat,
+                p.glType,
+                image->getData());
+            _write(frame, image);
+#endif // FTK_API_GL_4_1
+        }
+
+        void Exporter::_flushReadbacks(bool all)
+        {
+#if defined(FTK_API_GL_4_1)
+            FTK_P();
+            // Oldest first, so the writer gets the frames in order.
+            const size_t count = all ? p.readbacks.size() : 1;
+            for (size_t i = 0; i < count; ++i)
+            {
+                auto& readback = p.readbacks[(p.readbackIndex + i) % p.readbacks.size()];
+                if (readback.frame.has_value())
+                {
+                    const int64_t frame = readback.frame.value();
+                    readback.frame.reset();
+                    auto image = p.pool ?
+                        p.pool->createImage(p.job.info) :
+                        ftk::Image::create(p.job.info);
+                    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo);
+                    const void* data = glMapBufferRange(
+                        GL_PIXEL_PACK_BUFFER,
+                        0,
+                        p.byteCount,
+                        GL_MAP_READ_BIT);
+                    if (data)
+                    {
+                        std::memcpy(image->getData(), data, p.byteCount);
+                        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+                    }
+                    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+                    if (!data)
+                    {
+                        // The pooled image holds whatever was in it last,
+                        // so writing it would put a wrong frame in the
+                        // output. Fail the export instead.
+                        const std::string error = ftk::Format(
+                            "Cannot read back frame {0}").arg(frame);
+                        {
+                            std::unique_lock<std::mutex> lock(p.mutex);
+                            p.writerData.error = error;
+                        }
+                        p.cv.notify_all();
+                        throw std::runtime_error(error);
+                    }
+                    _write(frame, image);
+                }
+            }
+#endif // FTK_API_GL_4_1
+        }
+
+        void Exporter::_write(int64_t frame, const std::shared_ptr<ftk::Image>& image)
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.cv.wait(
+                lock,
+                [this]
+                {
+                    FTK_P();
+                    return
+                        p.writerData.queue.size() < writeQueueMax ||
+                        !p.writerData.error.empty();
+                });
+            if (!p.writerData.error.empty())
+            {
+                throw std::runtime_error(p.writerData.error);
+            }
+            p.writerData.queue.push_back({ frame, image });
+            lock.unlock();
+            p.cv.notify_all();
+        }
+
+        void Exporter::_writerThread()
+        {
+            FTK_P();
+            const int64_t start = p.job.range.start_time().value();
+            try
+            {
+                while (true)
+                {
+                    Private::Write write;
+                    {
+                        std::unique_lock<std::mutex> lock(p.mutex);
+                        p.cv.wait(
+                            lock,
+                            [this]
+                            {
+                                FTK_P();
+                                return
+                                    !p.writerData.queue.empty() ||
+                                    p.writerData.rendered ||
+                                    p.writerData.cancel;
+                            });
+                        if (p.writerData.cancel)
+                        {
+                            return;
+                        }
+                        if (p.writerData.queue.empty())
+                        {
+                            break;
+                        }
+                        write = p.writerData.queue.front();
+                        p.writerData.queue.pop_front();
+                    }
+                    // There is room in the queue again.
+                    p.cv.notify_all();
+
+                    // The sequence writers name each file from the time it is
+                    // written at, so those keep the frame numbers of the
+                    // timeline -- which is what the file name shown in the
+                    // tool promises. A movie has no frame numbers in its name
+                    // and the time becomes the presentation timestamp, so it
+                    // starts at zero.
+                    const OTIO_NS::RationalTime t(
+                        models::ExportFileType::Movie == p.job.fileType ?
+                            write.frame - start :
+                            write.frame,
+                        p.speed);
+                    p.job.writer->writeVideo(t, write.image);
+
+                    // The audio follows the video, one second at a time.
+                    _writeAudio(write.frame - start + 1);
+
+                    std::unique_lock<std::mutex> lock(p.mutex);
+                    ++p.writerData.framesWritten;
+                }
+
+                // Finish writing after the last frame.
+                p.job.writer->finish();
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.writerData.finished = true;
+            }
+            catch (const std::exception& e)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex);
+                    p.writerData.error = e.what();
+                }
+                p.cv.notify_all();
+            }
+        }
+
+        void Exporter::_writeAudio(int64_t framesWritten)
+        {
+            FTK_P();
+            if (!p.job.hasAudio)
+                return;
+
+            const double videoSeconds = OTIO_NS::RationalTime(
+                framesWritten,
+                p.speed).rescaled_to(1.0).value();
+            while (p.audioSeconds <
+                std::min(videoSeconds, p.job.audioDurationSeconds))
+            {
+                // Get one second of audio from the timeline and mix the
+                // layers together.
+                auto frame = p.timeline->getAudio(
+                    p.job.audioStartSeconds + p.audioSeconds).future.get();
+                std::vector<std::shared_ptr<tl::Audio> > layers;
+                for (const auto& layer : frame.layers)
+                {
+                    if (layer.audio)
+                    {
+                        layers.push_back(layer.audio);
+                    }
+                }
+                auto audio = tl::mixAudio(layers, 1.F);
+                if (audio && audio->isValid())
+                {
+                    // Trim the final chunk to the in/out range.
+                    const double remaining =
+                        p.job.audioDurationSeconds - p.audioSeconds;
+                    if (remaining < 1.0)
+                    {
+                        const size_t sampleCount = std::min(
+                            audio->getSampleCount(),
+                            static_cast<size_t>(
+                                remaining * audio->getInfo().sampleRate + .5));
+                        auto tmp = tl::Audio::create(audio->getInfo(), sampleCount);
+                        std::memcpy(
+                            tmp->getData(),
+                            audio->getData(),
+                            tmp->getByteCount());
+                        audio = tmp;
+                    }
+                    const OTIO_NS::TimeRange timeRange(
+                        OTIO_NS::RationalTime(
+                            p.audioSamples,
+                            audio->getInfo().sampleRate),
+                        OTIO_NS::RationalTime(
+                            audio->getSampleCount(),
+                            audio->getInfo().sampleRate));
+                    p.job.writer->writeAudio(timeRange, audio);
+                    p.audioSamples += audio->getSampleCount();
+                }
+                p.audioSeconds += 1.0;
+            }
+        }
+    }
+}
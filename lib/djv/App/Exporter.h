@@ -0,0 +1,164 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <djv/Models/Export.h>
+#include <djv/Models/SettingsModel.h>
+
+#include <tlRender/Timeline/IRender.h>
+#include <tlRender/Timeline/Player.h>
+#include <tlRender/IO/System.h>
+
+#include <ftk/GL/Texture.h>
+
+#include <memory>
+
+namespace ftk
+{
+    class Context;
+}
+
+namespace djv
+{
+    namespace models
+    {
+        class FrameBufferPool;
+    }
+
+    namespace app
+    {
+        class App;
+
+        //! What an export renders and where it goes: worked out from the
+        //! player and the settings before the first frame, and fixed from
+        //! then on so that nothing can shift part way through a movie.
+        struct DJV_API_TYPE ExportJob
+        {
+            models::ExportFileType fileType = models::ExportFileType::Image;
+            OTIO_NS::TimeRange range;
+            ftk::ImageInfo info;
+            std::shared_ptr<tl::IWrite> writer;
+            bool hasAudio = false;
+            double audioStartSeconds = 0.0;
+            double audioDurationSeconds = 0.0;
+            tl::OCIOOptions ocioOptions;
+            tl::LUTOptions lutOptions;
+
+            //! One entry per video source: the A file followed by the files
+            //! it is being compared with.
+            std::vector<ftk::ImageOptions> imageOptions;
+            std::vector<tl::DisplayOptions> displayOptions;
+            tl::CompareOptions compareOptions;
+            std::vector<ftk::Box2I> boxes;
+            ftk::gl::TextureType colorBuffer = ftk::gl::TextureType::RGBA_U8;
+            std::shared_ptr<tl::IRender> render;
+        };
+
+        //! Get the range of export widths.
+        DJV_API ftk::RangeI getExportWidthRange();
+
+        //! Get the images an export lays out: the A file followed by the
+        //! files it is being compared with.
+        DJV_API std::vector<ftk::ImageInfo> getExportInfos(
+            const std::shared_ptr<tl::Player>&);
+
+        //! Get the size an export comes out at, or an invalid size when
+        //! there is nothing to export.
+        DJV_API ftk::Size2I getExportSize(
+            const std::shared_ptr<App>&,
+            const models::ExportSettings&);
+
+        //! Get the time range an export covers.
+        DJV_API OTIO_NS::TimeRange getExportRange(
+            const std::shared_ptr<tl::Player>&,
+            models::ExportFileType);
+
+        //! Create an export job from what the application is showing: the
+        //! active files, the comparison, and the color and display options.
+        //! The writer is opened, so this throws if the output cannot be
+        //! written. Needs an OpenGL context for the renderer.
+        DJV_API ExportJob createExportJob(
+            const std::shared_ptr<ftk::Context>&,
+            const std::shared_ptr<App>&,
+            const models::ExportSettings&,
+            models::ExportFileType);
+
+        //! Export renderer.
+        //!
+        //! The stages of an export -- reading the sources, drawing them,
+        //! reading the pixels back from the GPU, and encoding and writing
+        //! the result -- run overlapped rather than one after the other, so
+        //! that an export takes as long as its slowest stage instead of the
+        //! sum of them:
+        //!
+        //! - The video for the next few frames is requested ahead of the one
+        //!   being drawn, so the timeline is decoding while the GPU works.
+        //! - The pixels are read back through a ring of pixel pack buffers,
+        //!   so the copy of one frame runs behind the drawing of the next
+        //!   rather than stalling it.
+        //! - The finished images go to a thread of their own for writing,
+        //!   through a queue that is bounded so a slow disk holds the
+        //!   rendering back rather than filling memory.
+        //!
+        //! Drawing needs the OpenGL context, so everything but the writing
+        //! happens in tick(), on the thread that owns the context.
+        class DJV_API_TYPE Exporter : public std::enable_shared_from_this<Exporter>
+        {
+            FTK_NON_COPYABLE(Exporter);
+
+        protected:
+            void _init(
+                const std::shared_ptr<ftk::Context>&,
+                const std::shared_ptr<tl::Player>&,
+                const ExportJob&,
+                const std::shared_ptr<models::FrameBufferPool>&);
+
+            Exporter();
+
+        public:
+            DJV_API ~Exporter();
+
+            //! Create a new exporter. The writer is started straight away;
+            //! the frames are rendered by calling tick(). The images read
+            //! back are created in the pool when one is given, so that each
+            //! frame reuses the memory of one that has been written.
+            DJV_API static std::shared_ptr<Exporter> create(
+                const std::shared_ptr<ftk::Context>&,
+                const std::shared_ptr<tl::Player>&,
+                const ExportJob&,
+                const std::shared_ptr<models::FrameBufferPool>& = nullptr);
+
+            //! Get the job.
+            DJV_API const ExportJob& getJob() const;
+
+            //! Render the next frame. Returns false once there is nothing
+            //! left to render, after which the caller waits for isFinished().
+            //! Throws if the export failed, including on the writer thread.
+            DJV_API bool tick();
+
+            //! Get the most memory the frames in flight can take up, in
+            //! bytes: those read ahead, those being read back, and those
+            //! waiting for the writer.
+            DJV_API uint64_t getMemorySize() const;
+
+            //! Get the number of frames that have been written.
+            DJV_API int64_t getFramesWritten() const;
+
+            //! Get whether every frame has been written and the output
+            //! finished.
+            DJV_API bool isFinished() const;
+
+        private:
+            std::vector<tl::VideoRequest> _request(int64_t frame);
+            void _render(const std::vector<tl::VideoFrame>&);
+            void _readback(int64_t frame);
+            void _flushReadbacks(bool all);
+            void _write(int64_t frame, const std::shared_ptr<ftk::Image>&);
+            void _writerThread();
+            void _writeAudio(int64_t framesWritten);
+
+            FTK_PRIVATE();
+        };
+    }
+}
@@ -16,6 +16,7 @@ namespace djv
     {
         struct FileActions::Private
         {
+            std::weak_ptr<App> app;
             std::shared_ptr<ftk::ListObserver<std::shared_ptr<models::FilesModelItem> > > filesObserver;
             std::shared_ptr<ftk::Observer<std::shared_ptr<models::FilesModelItem> > > aObserver;
             std::shared_ptr<ftk::Observer<std::shared_ptr<tl::Player> > > playerObserver;
@@ -28,6 +29,8 @@ namespace djv
             IActions::_init(context, app, "File");
             FTK_P();
 
+            p.app = app;
+
             // Register the commands.
             auto appWeak = std::weak_ptr<App>(app);
             _addCommand(
@@ -85,6 +88,20 @@ namespace djv
                     }
                 });
 
+            _addCheckCommand(
+                "Watch",
+                "Watch the current image sequence for new frames.",
+                [appWeak](const nlohmann::json& args)
+                {
+                    const bool value = args.at("value").get<bool>();
+                    if (auto app = appWeak.lock())
+                    {
+                        app->getFilesModel()->setWatch(
+                            app->getFilesModel()->getA(),
+                            value);
+                    }
+                });
+
             _addCommand(
                 "Next",
                 "Change to the next file.",
@@ -190,6 +207,9 @@ namespace djv
                 "Reload",
                 "FileReload",
                 _command("Reload"));
+            _actions["Watch"] = ftk::Action::create(
+                "Watch for New Frames",
+                _checkCommand("Watch"));
             _actions["Next"] = ftk::Action::create(
                 "Next",
                 "Next",
@@ -248,6 +268,10 @@ namespace djv
                     _actions["Close"]->setEnabled(!value.empty());
                     _actions["CloseAll"]->setEnabled(!value.empty());
                     _actions["Reload"]->setEnabled(!value.empty());
+                    // The item is written to in place, so a change to it
+                    // is only heard about as the files being announced
+                    // again.
+                    _watchUpdate();
                     _actions["Next"]->setEnabled(value.size() > 1);
                     _actions["Prev"]->setEnabled(value.size() > 1);
                 });
@@ -256,6 +280,7 @@ namespace djv
                 app->getFilesModel()->observeA(),
                 [this](const std::shared_ptr<models::FilesModelItem>& value)
                 {
+                    _watchUpdate();
                     _actions["NextLayer"]->setEnabled(value ? value->videoLayers.size() > 1 : false);
                     _actions["PrevLayer"]->setEnabled(value ? value->videoLayers.size() > 1 : false);
                 });
@@ -271,6 +296,17 @@ namespace djv
                 });
         }
 
+        void FileActions::_watchUpdate()
+        {
+            FTK_P();
+            if (auto app = p.app.lock())
+            {
+                const auto& a = app->getFilesModel()->getA();
+                _actions["Watch"]->setEnabled(a && a->path.isSeq());
+                _actions["Watch"]->setChecked(a && a->watch);
+            }
+        }
+
         FileActions::FileActions() :
             _p(new Private)
         {}
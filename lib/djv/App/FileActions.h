@@ -32,6 +32,8 @@ namespace djv
                 const std::shared_ptr<App>&);
 
         private:
+            void _watchUpdate();
+
             FTK_PRIVATE();
         };
     }
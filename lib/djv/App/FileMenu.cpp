@@ -60,6 +60,7 @@ namespace djv
             addAction(actions["Close"]);
             addAction(actions["CloseAll"]);
             addAction(actions["Reload"]);
+            addAction(actions["Watch"]);
             p.menus["Recent"] = addSubMenu("Recent");
             addDivider();
             p.menus["Current"] = addSubMenu("Current");
@@ -57,6 +57,8 @@ namespace djv
             std::shared_ptr<ftk::ButtonGroup> aButtonGroup;
             std::shared_ptr<ftk::ButtonGroup> bButtonGroup;
             std::vector<FileWidget> widgets;
+            std::shared_ptr<ftk::Spacer> spacer;
+            std::shared_ptr<ftk::Label> emptyLabel;
             std::shared_ptr<ftk::ComboBox> compareComboBox;
             std::shared_ptr<ftk::FloatEditSlider> wipeXSlider;
             std::shared_ptr<ftk::FloatEditSlider> wipeYSlider;
@@ -76,7 +78,7 @@ namespace djv
             std::shared_ptr<models::FilesModelItem> rangeItem;
             ftk::RangeI64 rangeValue;
 
-            std::shared_ptr<ftk::ListObserver<std::shared_ptr<models::FilesModelItem> > > filesObserver;
+            std::shared_ptr<ftk::ListObserver<models::FilesModelChange> > changesObserver;
             std::shared_ptr<ftk::Observer<std::shared_ptr<models::FilesModelItem> > > aObserver;
             std::shared_ptr<ftk::ListObserver<std::shared_ptr<models::FilesModelItem> > > bObserver;
             std::shared_ptr<ftk::ListObserver<int> > layersObserver;
@@ -161,6 +163,14 @@ namespace djv
                 ftk::SizeRole::None);
             p.widgetLayout->setRowBackgroundRole(ftk::ColorRole::Header);
 
+            p.spacer = ftk::Spacer::create(context, ftk::Orientation::Horizontal, p.widgetLayout);
+            p.spacer->setSpacingRole(ftk::SizeRole::SpacingTool);
+            p.widgetLayout->setGridPos(p.spacer, 0, 5);
+
+            p.emptyLabel = ftk::Label::create(context, "No files open", p.widgetLayout);
+            p.emptyLabel->setMarginRole(ftk::SizeRole::Margin);
+            p.widgetLayout->setGridPos(p.emptyLabel, 0, 0);
+
             ftk::Divider::create(context, ftk::Orientation::Vertical, layout);
 
             auto vLayout = ftk::VerticalLayout::create(context);
@@ -288,12 +298,22 @@ namespace djv
                     }
                 });
 
-            p.filesObserver = ftk::ListObserver<std::shared_ptr<models::FilesModelItem> >::create(
-                app->getFilesModel()->observeFiles(),
-                [this](const std::vector<std::shared_ptr<models::FilesModelItem> >& value)
+            // The rows are made once for the files already open, and then
+            // follow the changes, so that opening or closing a file in a
+            // large session does not make every row again.
+            const auto& files = app->getFilesModel()->getFiles();
+            for (size_t i = 0; i < files.size(); ++i)
+            {
+                _addRow(static_cast<int>(i), files[i]);
+            }
+            _rowsUpdate();
+            p.changesObserver = ftk::ListObserver<models::FilesModelChange>::create(
+                app->getFilesModel()->observeChanges(),
+                [this](const std::vector<models::FilesModelChange>& value)
                 {
-                    _filesUpdate(value);
-                });
+                    _changesUpdate(value);
+                },
+                ftk::ObserverAction::Suppress);
 
             p.aObserver = ftk::Observer<std::shared_ptr<models::FilesModelItem> >::create(
                 app->getFilesModel()->observeA(),
@@ -379,150 +399,203 @@ namespace djv
                 });
         }
 
-        void FilesTool::_filesUpdate(const std::vector<std::shared_ptr<models::FilesModelItem> >& value)
+        void FilesTool::_changesUpdate(const std::vector<models::FilesModelChange>& value)
         {
             FTK_P();
-            p.widgets.clear();
-            p.aButtonGroup->clearButtons();
-            p.bButtonGroup->clearButtons();
-            p.widgetLayout->clear();
-            auto appWeak = _app;
-            if (auto app = appWeak.lock())
+            for (const auto& change : value)
             {
-                const auto& a = app->getFilesModel()->getA();
-                const auto& b = app->getFilesModel()->getB();
-                if (auto context = getContext())
+                switch (change.type)
                 {
-                    const std::vector<std::string> seqExts = tl::getExts(
-                        context, static_cast<int>(tl::FileType::Seq));
-                    size_t row = 0;
-                    for (const auto& item : value)
+                case models::FilesModelChangeType::Added:
+                    _addRow(change.index, change.item);
+                    break;
+                case models::FilesModelChangeType::Removed:
+                    _removeRow(change.index);
+                    break;
+                case models::FilesModelChangeType::Moved:
+                    if (change.prevIndex >= 0 &&
+                        change.prevIndex < static_cast<int>(p.widgets.size()))
                     {
-                        FileWidget widget;
-                        widget.item = item;
-
-                        widget.thumbnail = ui::FileThumbnail::create(
-                            context,
-                            item,
-                            app->getSettingsModel()->getIOOptions(),
-                            p.widgetLayout);
-                        p.widgetLayout->setGridPos(widget.thumbnail, row, 0);
-
-                        widget.nameButton = ftk::ToolButton::create(
-                            context,
-                            ftk::elide(item->path.getFileName(), 24),
-                            p.widgetLayout);
-                        widget.nameButton->setChecked(item == a);
-                        widget.nameButton->setHStretch(ftk::Stretch::Expanding);
-                        widget.nameButton->setVAlign(ftk::VAlign::Center);
-                        widget.nameButton->setTooltip(
-                            item->path.get() + "\n\nSet the A file.");
-                        p.aButtonGroup->addButton(widget.nameButton);
-                        p.widgetLayout->setGridPos(widget.nameButton, row, 1);
-
-                        widget.bButton = ftk::ToolButton::create(context, "B", p.widgetLayout);
-                        const auto i = std::find(b.begin(), b.end(), item);
-                        widget.bButton->setChecked(i != b.end());
-                        widget.bButton->setVAlign(ftk::VAlign::Center);
-                        widget.bButton->setTooltip("Set the B file(s).");
-                        p.bButtonGroup->addButton(widget.bButton);
-                        p.widgetLayout->setGridPos(widget.bButton, row, 2);
-
-                        widget.layerComboBox = ftk::ComboBox::create(context, p.widgetLayout);
-                        widget.layerComboBox->setItems(item->videoLayers);
-                        widget.layerComboBox->setCurrentIndex(item->videoLayer);
-                        widget.layerComboBox->setVAlign(ftk::VAlign::Center);
-                        widget.layerComboBox->setTooltip("Set the current layer.");
-                        // Layer names can be long -- and are, in a multi part
-                        // EXR -- and the column is as wide as the longest one
-                        // in it. The menu still shows them whole.
-                        // Kept from the end: layer names share a prefix and
-                        // differ where they finish.
-                        widget.layerComboBox->setElide(12, ftk::ElideMode::Left);
-                        // A file with one layer has nothing to choose, and the
-                        // column is as wide as the longest layer name in it.
-                        widget.layerComboBox->setVisible(
-                            item->videoLayers.size() > 1);
-                        p.widgetLayout->setGridPos(widget.layerComboBox, row, 3);
-
-                        widget.layerComboBox->setIndexCallback(
-                            [appWeak, item](int value)
-                            {
-                                if (auto app = appWeak.lock())
-                                {
-                                    app->getFilesModel()->setLayer(item, value);
-                                }
-                            });
-
-                        // Only an image sequence has a frame range to state.
-                        // The range is what the sequence is meant to cover,
-                        // which need not be what is on disk yet. It is set
-                        // rarely, so the row shows it and the editing is in a
-                        // popup rather than two edits in every row.
-                        if (item->path.hasNum() && item->path.testExt(seqExts))
-                        {
-                            // What the file turned out to be when it opened.
-                            // The path only knows the range once one has been
-                            // stated for it; until then it names one file.
-                            ftk::RangeI64 range(0, 0);
-                            if (item->timeRange.has_value())
-                            {
-                                const int64_t start = static_cast<int64_t>(
-                                    item->timeRange->start_time().value());
-                                range = ftk::RangeI64(
-                                    start,
-                                    start + static_cast<int64_t>(
-                                        item->timeRange->duration().value()) - 1);
-                            }
-                            else if (item->path.getFrames().has_value())
-                            {
-                                range = item->path.getFrames().value();
-                            }
-
-                            widget.rangeButton = ftk::ToolButton::create(
-                                context,
-                                ftk::Format("{0}-{1}").
-                                    arg(range.min()).arg(range.max()),
-                                p.widgetLayout);
-                            widget.rangeButton->setVAlign(ftk::VAlign::Center);
-                            widget.rangeButton->setTooltip(
-                                "The frame range of the sequence.");
-                            p.widgetLayout->setGridPos(widget.rangeButton, row, 4);
-
-                            auto buttonWeak =
-                                std::weak_ptr<ftk::ToolButton>(widget.rangeButton);
-                            widget.rangeButton->setClickedCallback(
-                                [this, item, range, buttonWeak]
-                                {
-                                    _showRangePopup(item, range, buttonWeak.lock());
-                                });
-                        }
+                        const FileWidget widget = p.widgets[change.prevIndex];
+                        p.widgets.erase(p.widgets.begin() + change.prevIndex);
+                        p.widgets.insert(p.widgets.begin() + change.index, widget);
+                    }
+                    break;
+                case models::FilesModelChangeType::Changed:
+                    // What the row shows is made from the item, so it is made
+                    // again; the other rows are left alone.
+                    _removeRow(change.index);
+                    _addRow(change.index, change.item);
+                    break;
+                default: break;
+                }
+            }
+            _rowsUpdate();
+        }
 
-                        p.widgets.push_back(widget);
+        void FilesTool::_addRow(int index, const std::shared_ptr<models::FilesModelItem>& item)
+        {
+            FTK_P();
+            auto appWeak = _app;
+            auto app = appWeak.lock();
+            auto context = getContext();
+            if (!app || !context ||
+                index < 0 || index > static_cast<int>(p.widgets.size()))
+                return;
 
-                        if (0 == row)
-                        {
-                            ftk::setScreenshotTag(
-                                widget.layerComboBox,
-                                "Files.CurrentLayer");
-                            ftk::setScreenshotTag(
-                                widget.rangeButton,
-                                "Files.FrameRange");
-
-                            auto spacer = ftk::Spacer::create(context, ftk::Orientation::Horizontal, p.widgetLayout);
-                            spacer->setSpacingRole(ftk::SizeRole::SpacingTool);
-                            p.widgetLayout->setGridPos(spacer, 0, 5);
-                        }
-                        ++row;
-                    }
-                    if (value.empty())
+            const auto& a = app->getFilesModel()->getA();
+            const auto& b = app->getFilesModel()->getB();
+            const std::vector<std::string> seqExts = tl::getExts(
+                context, static_cast<int>(tl::FileType::Seq));
+
+            FileWidget widget;
+            widget.item = item;
+
+            widget.thumbnail = ui::FileThumbnail::create(
+                context,
+                item,
+                app->getSettingsModel()->getIOOptions(),
+                app->getThumbnailDiskCache(),
+                p.widgetLayout);
+
+            widget.nameButton = ftk::ToolButton::create(
+                context,
+                ftk::elide(item->path.getFileName(), 24),
+                p.widgetLayout);
+            widget.nameButton->setChecked(item == a);
+            widget.nameButton->setHStretch(ftk::Stretch::Expanding);
+            widget.nameButton->setVAlign(ftk::VAlign::Center);
+            widget.nameButton->setTooltip(
+                item->path.get() + "\n\nSet the A file.");
+
+            widget.bButton = ftk::ToolButton::create(context, "B", p.widgetLayout);
+            const auto i = std::find(b.begin(), b.end(), item);
+            widget.bButton->setChecked(i != b.end());
+            widget.bButton->setVAlign(ftk::VAlign::Center);
+            widget.bButton->setTooltip("Set the B file(s).");
+
+            widget.layerComboBox = ftk::ComboBox::create(context, p.widgetLayout);
+            widget.layerComboBox->setItems(item->videoLayers);
+            widget.layerComboBox->setCurrentIndex(item->videoLayer);
+            widget.layerComboBox->setVAlign(ftk::VAlign::Center);
+            widget.layerComboBox->setTooltip("Set the current layer.");
+            // Layer names can be long -- and are, in a multi part
+            // EXR -- and the column is as wide as the longest one
+            // in it. The menu still shows them whole.
+            // Kept from the end: layer names share a prefix and
+            // differ where they finish.
+            widget.layerComboBox->setElide(12, ftk::ElideMode::Left);
+            // A file with one layer has nothing to choose, and the
+            // column is as wide as the longest layer name in it.
+            widget.layerComboBox->setVisible(
+                item->videoLayers.size() > 1);
+
+            widget.layerComboBox->setIndexCallback(
+                [appWeak, item](int value)
+                {
+                    if (auto app = appWeak.lock())
                     {
-                        auto label = ftk::Label::create(context, "No files open", p.widgetLayout);
-                        label->setMarginRole(ftk::SizeRole::Margin);
-                        p.widgetLayout->setGridPos(label, 0, 0);
+                        app->getFilesModel()->setLayer(item, value);
                     }
+                });
+
+            // Only an image sequence has a frame range to state.
+            // The range is what the sequence is meant to cover,
+            // which need not be what is on disk yet. It is set
+            // rarely, so the row shows it and the editing is in a
+            // popup rather than two edits in every row.
+            if (item->path.hasNum() && item->path.testExt(seqExts))
+            {
+                // What the file turned out to be when it opened.
+                // The path only knows the range once one has been
+                // stated for it; until then it names one file.
+                ftk::RangeI64 range(0, 0);
+                if (item->timeRange.has_value())
+                {
+                    const int64_t start = static_cast<int64_t>(
+                        item->timeRange->start_time().value());
+                    range = ftk::RangeI64(
+                        start,
+                        start + static_cast<int64_t>(
+                            item->timeRange->duration().value()) - 1);
+                }
+                else if (item->path.getFrames().has_value())
+                {
+                    range = item->path.getFrames().value();
+                }
+
+                widget.rangeButton = ftk::ToolButton::create(
+                    context,
+                    ftk::Format("{0}-{1}").
+                        arg(range.min()).arg(range.max()),
+                    p.widgetLayout);
+                widget.rangeButton->setVAlign(ftk::VAlign::Center);
+                widget.rangeButton->setTooltip(
+                    "The frame range of the sequence.");
+
+                auto buttonWeak =
+                    std::weak_ptr<ftk::ToolButton>(widget.rangeButton);
+                widget.rangeButton->setClickedCallback(
+                    [this, item, range, buttonWeak]
+                    {
+                        _showRangePopup(item, range, buttonWeak.lock());
+                    });
+            }
+
+            p.widgets.insert(p.widgets.begin() + index, widget);
+        }
+
+        void FilesTool::_removeRow(int index)
+        {
+            FTK_P();
+            if (index < 0 || index >= static_cast<int>(p.widgets.size()))
+                return;
+            const FileWidget& widget = p.widgets[index];
+            for (const std::shared_ptr<ftk::IWidget>& i : std::vector<std::shared_ptr<ftk::IWidget> >{
+                widget.thumbnail,
+                widget.nameButton,
+                widget.bButton,
+                widget.layerComboBox,
+                widget.rangeButton })
+            {
+                if (i)
+                {
+                    i->setParent(nullptr);
+                }
+            }
+            p.widgets.erase(p.widgets.begin() + index);
+        }
+
+        void FilesTool::_rowsUpdate()
+        {
+            FTK_P();
+            // Only the positions in the grid and the button groups follow
+            // the order of the rows; neither makes any widgets.
+            p.aButtonGroup->clearButtons();
+            p.bButtonGroup->clearButtons();
+            for (size_t i = 0; i < p.widgets.size(); ++i)
+            {
+                const FileWidget& widget = p.widgets[i];
+                const int row = static_cast<int>(i);
+                p.widgetLayout->setGridPos(widget.thumbnail, row, 0);
+                p.widgetLayout->setGridPos(widget.nameButton, row, 1);
+                p.aButtonGroup->addButton(widget.nameButton);
+                p.widgetLayout->setGridPos(widget.bButton, row, 2);
+                p.bButtonGroup->addButton(widget.bButton);
+                p.widgetLayout->setGridPos(widget.layerComboBox, row, 3);
+                ftk::setScreenshotTag(
+                    widget.layerComboBox,
+                    0 == i ? "Files.CurrentLayer" : "");
+                if (widget.rangeButton)
+                {
+                    p.widgetLayout->setGridPos(widget.rangeButton, row, 4);
+                    ftk::setScreenshotTag(
+                        widget.rangeButton,
+                        0 == i ? "Files.FrameRange" : "");
                 }
             }
+            p.spacer->setVisible(!p.widgets.empty());
+            p.emptyLabel->setVisible(p.widgets.empty());
         }
 
         void FilesTool::_showRangePopup(
@@ -39,7 +39,10 @@ namespace djv
             void _rangeUpdate(
                 const std::shared_ptr<models::FilesModelItem>&,
                 const ftk::RangeI64&);
-            void _filesUpdate(const std::vector<std::shared_ptr<models::FilesModelItem> >&);
+            void _changesUpdate(const std::vector<models::FilesModelChange>&);
+            void _addRow(int index, const std::shared_ptr<models::FilesModelItem>&);
+            void _removeRow(int index);
+            void _rowsUpdate();
             void _showRangePopup(
                 const std::shared_ptr<models::FilesModelItem>&,
                 const ftk::RangeI64&,
@@ -0,0 +1,705 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djv/App/FrameCache.h>
+
+#include <djv/Models/CompressedImageCache.h>
+#include <djv/Models/ImageDiskCache.h>
+#include <djv/Models/ImageUtil.h>
+#include <djv/Models/ThreadPool.h>
+#include <djv/Models/ThumbnailDiskCache.h>
+
+#include <tlRender/IO/Read.h>
+#include <tlRender/IO/System.h>
+
+#include <ftk/Core/Context.h>
+#include <ftk/Core/LogSystem.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <functional>
+#include <future>
+#include <list>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace djv
+{
+    namespace app
+    {
+        namespace
+        {
+            // Decompressing a 4K half float frame takes a core around a
+            // fifth of a second, several frames at 24 FPS, so the readers
+            // share half of the cores.
+            size_t getThreadCount()
+            {
+                return std::min(
+                    std::max(std::thread::hardware_concurrency() / 2, 2U),
+                    8U);
+            }
+
+            int getDecimation(const tl::IOOptions& options)
+            {
+                int out = 1;
+                const auto i = options.find(decimationOption);
+                if (i != options.end())
+                {
+                    out = std::max(std::atoi(i->second.c_str()), 1);
+                }
+                return out;
+            }
+
+            // Everything that changes what the frame looks like. A
+            // frame whose file cannot be looked at is not cached.
+            std::string getKey(
+                const ftk::Path& path,
+                const OTIO_NS::RationalTime& time,
+                const tl::IOOptions& options)
+            {
+                std::string out;
+                const int64_t frame = time.round().value();
+                const std::string fileName = path.get(frame);
+                std::error_code ec;
+                const auto mtime = std::filesystem::last_write_time(
+                    std::filesystem::u8path(fileName),
+                    ec);
+                if (!ec)
+                {
+                    std::stringstream ss;
+                    ss << fileName << '\n';
+                    ss << mtime.time_since_epoch().count() << '\n';
+                    for (const auto& i : options)
+                    {
+                        ss << i.first << '=' << i.second << '\n';
+                    }
+                    out = ss.str();
+                }
+                return out;
+            }
+
+            // How often the read waiter looks up from the oldest read to see
+            // whether it has been stopped.
+            const std::chrono::milliseconds readWaiterTimeout(100);
+
+            //! Waits for the frames handed on to the wrapped readers, and
+            //! finishes each one on the pool once it is ready, so that no
+            //! thread of the pool is held waiting on a read. The wrapped
+            //! readers mostly finish in the order they were asked, so the
+            //! oldest read is waited on, and every other one that is ready
+            //! by then goes with it.
+            class ReadWaiter
+            {
+            public:
+                ReadWaiter(models::ThreadPool* pool) :
+                    _pool(pool)
+                {
+                    _thread = std::thread([this] { _run(); });
+                }
+
+                ~ReadWaiter()
+                {
+                    stop();
+                }
+
+                void add(
+                    std::future<tl::VideoData> future,
+                    const std::function<void(const tl::VideoData&)>& finish)
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(_mutex);
+                        if (!_running)
+                            return;
+                        _items.push_back({ std::move(future), finish });
+                    }
+                    _cv.notify_one();
+                }
+
+                //! Stop waiting. Reads still being waited for are not
+                //! finished.
+                void stop()
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(_mutex);
+                        _running = false;
+                    }
+                    _cv.notify_one();
+                    if (_thread.joinable())
+                    {
+                        _thread.join();
+                    }
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _items.clear();
+                }
+
+            private:
+                struct Item
+                {
+                    std::future<tl::VideoData> future;
+                    std::function<void(const tl::VideoData&)> finish;
+                };
+
+                void _run()
+                {
+                    while (true)
+                    {
+                        // Only this thread takes items out, and adding to
+                        // the list leaves the ones in it where they are, so
+                        // the oldest can be waited on without the lock.
+                        Item* oldest = nullptr;
+                        {
+                            std::unique_lock<std::mutex> lock(_mutex);
+                            _cv.wait(
+                                lock,
+                                [this] { return !_items.empty() || !_running; });
+                            if (!_running)
+                                break;
+                            oldest = &_items.front();
+                        }
+                        if (oldest->future.wait_for(readWaiterTimeout) != std::future_status::ready)
+                            continue;
+
+                        std::vector<Item> ready;
+                        {
+                            std::unique_lock<std::mutex> lock(_mutex);
+                            for (auto i = _items.begin(); i != _items.end();)
+                            {
+                                if (i->future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                                {
+                                    ready.push_back(std::move(*i));
+                                    i = _items.erase(i);
+                                }
+                                else
+                                {
+                                    ++i;
+                                }
+                            }
+                        }
+                        for (auto& item : ready)
+                        {
+                            // A reader that went away without answering
+                            // leaves the frame empty, as a cancel does.
+                            tl::VideoData data;
+                            try
+                            {
+                                data = item.future.get();
+                            }
+                            catch (const std::exception&)
+                            {}
+                            const auto finish = item.finish;
+                            _pool->add(
+                                [finish, data]
+                                {
+                                    finish(data);
+                                });
+                        }
+                    }
+                }
+
+                models::ThreadPool* _pool = nullptr;
+                std::mutex _mutex;
+                std::condition_variable _cv;
+                std::list<Item> _items;
+                bool _running = true;
+                std::thread _thread;
+            };
+
+            //! Reader that looks for frames in the cache before asking the
+            //! reader it wraps, and adds what that reader gives back. With
+            //! both tiers off and the full size asked for, frames are asked
+            //! for from the wrapped reader directly.
+            class CacheRead : public tl::IRead
+            {
+            protected:
+                void _init(
+                    const ftk::Path& path,
+                    const std::vector<ftk::InMemoryFile>& memory,
+                    const tl::IOOptions& options,
+                    const std::shared_ptr<tl::IRead>& read,
+                    const std::shared_ptr<FrameCache>& cache,
+                    ReadWaiter* readWaiter,
+                    const std::shared_ptr<ftk::LogSystem>& logSystem)
+                {
+                    IRead::_init(path, memory, options, logSystem);
+                    _read = read;
+                    _cache = cache;
+                    _readWaiter = readWaiter;
+                }
+
+                CacheRead() = default;
+
+            public:
+                ~CacheRead() override
+                {
+                    _cancel();
+                }
+
+                static std::shared_ptr<CacheRead> create(
+                    const ftk::Path& path,
+                    const std::vector<ftk::InMemoryFile>& memory,
+                    const tl::IOOptions& options,
+                    const std::shared_ptr<tl::IRead>& read,
+                    const std::shared_ptr<FrameCache>& cache,
+                    ReadWaiter* readWaiter,
+                    const std::shared_ptr<ftk::LogSystem>& logSystem)
+                {
+                    auto out = std::shared_ptr<CacheRead>(new CacheRead);
+                    out->_init(path, memory, options, read, cache, readWaiter, logSystem);
+                    return out;
+                }
+
+                std::future<tl::IOInfo> getInfo() override
+                {
+                    return _read->getInfo();
+                }
+
+                std::future<tl::VideoData> readVideo(
+                    const OTIO_NS::RationalTime& time,
+                    const tl::IOOptions& options) override
+                {
+                    tl::IOOptions mergedOptions = tl::merge(options, _options);
+                    const int decimation = _cache->getDecimation(_path);
+                    if (decimation > getDecimation(mergedOptions))
+                    {
+                        mergedOptions[decimationOption] = std::to_string(decimation);
+                    }
+                    const auto& memoryCache = _cache->getMemoryCache();
+                    const auto diskCache = _cache->getDiskCache();
+                    if (!memoryCache->isEnabled() &&
+                        !diskCache->isEnabled() &&
+                        1 == getDecimation(mergedOptions))
+                    {
+                        return _read->readVideo(time, options);
+                    }
+
+                    auto request = std::make_shared<Request>();
+                    request->time = time;
+                    request->options = mergedOptions;
+                    request->path = _path;
+                    request->read = _read;
+                    request->memoryCache = memoryCache;
+                    request->diskCache = diskCache;
+                    request->frameBufferPool = _cache->getFrameBufferPool();
+                    auto future = request->promise.get_future();
+                    {
+                        std::unique_lock<std::mutex> lock(_mutex);
+                        _requests.remove_if(
+                            [](const std::shared_ptr<Request>& value)
+                            {
+                                return value->claimed.load();
+                            });
+                        _requests.push_back(request);
+                    }
+                    // The waiter outlives any of the pool's functions that
+                    // run, so it is safe to hand on.
+                    ReadWaiter* readWaiter = _readWaiter;
+                    _cache->getThreadPool()->add(
+                        [request, readWaiter]
+                        {
+                            _lookup(request, readWaiter);
+                        });
+                    return future;
+                }
+
+                std::future<tl::AudioData> readAudio(
+                    const OTIO_NS::TimeRange& range,
+                    const tl::IOOptions& options) override
+                {
+                    return _read->readAudio(range, options);
+                }
+
+                void cancelRequests() override
+                {
+                    _cancel();
+                    // What has been handed on already is cancelled there,
+                    // and comes back empty.
+                    _read->cancelRequests();
+                }
+
+            private:
+                // A request is given copies of what it needs, so that it
+                // can be finished on the pool after the reader has gone.
+                struct Request
+                {
+                    OTIO_NS::RationalTime time;
+                    tl::IOOptions options;
+                    ftk::Path path;
+                    std::shared_ptr<tl::IRead> read;
+                    std::shared_ptr<models::CompressedImageCache> memoryCache;
+                    std::shared_ptr<models::ImageDiskCache> diskCache;
+                    std::shared_ptr<models::FrameBufferPool> frameBufferPool;
+                    std::string key;
+                    // Set by whichever of the lookup and a cancel gets to
+                    // the request first.
+                    std::atomic<bool> claimed { false };
+                    std::promise<tl::VideoData> promise;
+                };
+
+                void _cancel()
+                {
+                    std::list<std::shared_ptr<Request> > requests;
+                    {
+                        std::unique_lock<std::mutex> lock(_mutex);
+                        requests.swap(_requests);
+                    }
+                    for (auto& request : requests)
+                    {
+                        if (!request->claimed.exchange(true))
+                        {
+                            request->promise.set_value(tl::VideoData());
+                        }
+                    }
+                }
+
+                static uint16_t _getLayer(const tl::IOOptions& options)
+                {
+                    uint16_t out = 0;
+                    const auto i = options.find("Layer");
+                    if (i != options.end())
+                    {
+                        out = static_cast<uint16_t>(std::atoi(i->second.c_str()));
+                    }
+                    return out;
+                }
+
+                static void _lookup(
+                    const std::shared_ptr<Request>& request,
+                    ReadWaiter* readWaiter)
+                {
+                    if (request->claimed.exchange(true))
+                        return;
+
+                    const auto& memoryCache = request->memoryCache;
+                    const auto& diskCache = request->diskCache;
+                    const bool enabled = memoryCache->isEnabled() || diskCache->isEnabled();
+                    if (enabled)
+                    {
+                        request->key = getKey(request->path, request->time, request->options);
+                    }
+                    std::shared_ptr<ftk::Image> image;
+                    bool fromDisk = false;
+                    if (!request->key.empty())
+                    {
+                        image = memoryCache->get(request->key);
+                        if (!image)
+                        {
+                            image = diskCache->get(request->key);
+                            fromDisk = image.get();
+                        }
+
+                        // A frame that is only cached at the full size is
+                        // reduced from there rather than read again.
+                        const int decimation = getDecimation(request->options);
+                        if (!image && decimation > 1)
+                        {
+                            tl::IOOptions options = request->options;
+                            options.erase(decimationOption);
+                            const std::string fullKey = getKey(request->path, request->time, options);
+                            auto full = memoryCache->get(fullKey);
+                            if (!full)
+                            {
+                                full = diskCache->get(fullKey);
+                            }
+                            if (full)
+                            {
+                                image = models::decimateImage(
+                                    full,
+                                    decimation,
+                                    request->frameBufferPool);
+                                memoryCache->add(request->key, image);
+                            }
+                        }
+                    }
+                    if (image)
+                    {
+                        tl::VideoData data;
+                        data.time = request->time;
+                        data.layer = _getLayer(request->options);
+                        data.image = image;
+                        request->promise.set_value(data);
+                        if (fromDisk)
+                        {
+                            memoryCache->add(request->key, image);
+                        }
+                    }
+                    else
+                    {
+                        // Handed on as soon as it is known not to be cached,
+                        // so the wrapped reader's own threads still read
+                        // several frames at once. The frame is finished on
+                        // the pool once it has been read, which leaves the
+                        // pool's threads free for the lookups meanwhile.
+                        readWaiter->add(
+                            request->read->readVideo(request->time, request->options),
+                            [request](const tl::VideoData& data)
+                            {
+                                _finish(request, data);
+                            });
+                    }
+                }
+
+                static void _finish(
+                    const std::shared_ptr<Request>& request,
+                    tl::VideoData data)
+                {
+                    const int decimation = getDecimation(request->options);
+                    if (decimation > 1 && data.image)
+                    {
+                        data.image = models::decimateImage(
+                            data.image,
+                            decimation,
+                            request->frameBufferPool);
+                    }
+                    request->promise.set_value(data);
+                    if (!request->key.empty() && data.image)
+                    {
+                        request->memoryCache->add(request->key, data.image);
+                        request->diskCache->add(request->key, data.image);
+                    }
+                }
+
+                std::shared_ptr<tl::IRead> _read;
+                std::shared_ptr<FrameCache> _cache;
+                ReadWaiter* _readWaiter = nullptr;
+                std::mutex _mutex;
+                std::list<std::shared_ptr<Request> > _requests;
+            };
+
+            //! Plugin that stands in for an image sequence plugin, under the
+            //! same name and file extensions.
+            class CachePlugin : public tl::IReadPlugin
+            {
+            protected:
+                void _init(
+                    const std::shared_ptr<tl::IReadPlugin>& plugin,
+                    const std::shared_ptr<FrameCache>& cache,
+                    ReadWaiter* readWaiter,
+                    const std::shared_ptr<ftk::LogSystem>& logSystem)
+                {
+                    std::map<std::string, tl::FileType> exts;
+                    for (const auto& ext : plugin->getExts(static_cast<int>(tl::FileType::Media)))
+                    {
+                        exts[ext] = tl::FileType::Media;
+                    }
+                    for (const auto& ext : plugin->getExts(static_cast<int>(tl::FileType::Seq)))
+                    {
+                        exts[ext] = tl::FileType::Seq;
+                    }
+                    IReadPlugin::_init(plugin->getPluginName(), exts, logSystem);
+                    _plugin = plugin;
+                    _cache = cache;
+                    _readWaiter = readWaiter;
+                    _logSystem = logSystem;
+                }
+
+                CachePlugin() = default;
+
+            public:
+                static std::shared_ptr<CachePlugin> create(
+                    const std::shared_ptr<tl::IReadPlugin>& plugin,
+                    const std::shared_ptr<FrameCache>& cache,
+                    ReadWaiter* readWaiter,
+                    const std::shared_ptr<ftk::LogSystem>& logSystem)
+                {
+                    auto out = std::shared_ptr<CachePlugin>(new CachePlugin);
+                    out->_init(plugin, cache, readWaiter, logSystem);
+                    return out;
+                }
+
+                std::shared_ptr<tl::IRead> read(
+                    const ftk::Path& path,
+                    const std::vector<ftk::InMemoryFile>& memory,
+                    const tl::IOOptions& options) override
+                {
+                    std::shared_ptr<tl::IRead> out = _plugin->read(path, memory, options);
+                    // Files read from memory have no modification time to
+                    // tell a new version by, and a single image is read once.
+                    if (out && memory.empty() && path.isSeq())
+                    {
+                        out = CacheRead::create(
+                            path,
+                            memory,
+                            options,
+                            out,
+                            _cache,
+                            _readWaiter,
+                            _logSystem.lock());
+                    }
+                    return out;
+                }
+
+            private:
+                std::shared_ptr<tl::IReadPlugin> _plugin;
+                std::shared_ptr<FrameCache> _cache;
+                ReadWaiter* _readWaiter = nullptr;
+                std::weak_ptr<ftk::LogSystem> _logSystem;
+            };
+        }
+
+        struct FrameCache::Private
+        {
+            std::shared_ptr<models::FrameBufferPool> pool;
+            mutable std::mutex mutex;
+            std::shared_ptr<models::ImageDiskCache> diskCache;
+            float diskMaxGB = 0.F;
+            std::shared_ptr<models::CompressedImageCache> memoryCache;
+            std::string decimationPath;
+            int decimation = 1;
+            std::shared_ptr<models::ThreadPool> threadPool;
+            std::unique_ptr<ReadWaiter> readWaiter;
+        };
+
+        void FrameCache::_init(
+            const std::shared_ptr<ftk::Context>& context,
+            const std::filesystem::path& dir,
+            const std::shared_ptr<models::FrameBufferPool>& pool)
+        {
+            FTK_P();
+            p.pool = pool;
+            p.diskCache = models::ImageDiskCache::create(dir, pool);
+            p.memoryCache = models::CompressedImageCache::create(pool);
+            p.threadPool = models::ThreadPool::create(getThreadCount());
+            p.readWaiter.reset(new ReadWaiter(p.threadPool.get()));
+
+            // The plugins are replaced rather than added to, since the read
+            // system gives a file to the first plugin that has its
+            // extension.
+            auto readSystem = context->getSystem<tl::ReadSystem>();
+            auto logSystem = context->getLogSystem();
+            const auto plugins = readSystem->getPlugins();
+            for (const auto& plugin : plugins)
+            {
+                if (!plugin->getExts(static_cast<int>(tl::FileType::Seq)).empty())
+                {
+                    readSystem->removePlugin(plugin);
+                    readSystem->addPlugin(CachePlugin::create(
+                        plugin,
+                        shared_from_this(),
+                        p.readWaiter.get(),
+                        logSystem));
+                }
+            }
+        }
+
+        FrameCache::FrameCache() :
+            _p(new Private)
+        {}
+
+        FrameCache::~FrameCache()
+        {
+            FTK_P();
+            // Each hands work to the other, so both are stopped before
+            // either goes: the waiter first, so that it hands nothing more
+            // to the pool, then the pool, whose lookups may still hand
+            // reads to the stopped waiter.
+            p.readWaiter->stop();
+            p.threadPool.reset();
+        }
+
+        std::shared_ptr<FrameCache> FrameCache::create(
+            const std::shared_ptr<ftk::Context>& context,
+            const std::filesystem::path& dir,
+            const std::shared_ptr<models::FrameBufferPool>& pool)
+        {
+            auto out = std::shared_ptr<FrameCache>(new FrameCache);
+            out->_init(context, dir, pool);
+            return out;
+        }
+
+        std::filesystem::path FrameCache::getDefaultDir()
+        {
+            return models::ThumbnailDiskCache::getCacheDir() / "Frames";
+        }
+
+        void FrameCache::setDiskDir(const std::filesystem::path& value)
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            if (value == p.diskCache->getDir())
+                return;
+            // Readers that already have the old cache finish with it.
+            p.diskCache = models::ImageDiskCache::create(value, p.pool);
+            p.diskCache->setMaxMB(p.diskMaxGB * 1024.F);
+        }
+
+        void FrameCache::setDiskMaxGB(float value)
+        {
+            FTK_P();
+            std::shared_ptr<models::ImageDiskCache> cache;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.diskMaxGB = value;
+                cache = p.diskCache;
+            }
+            cache->setMaxMB(value * 1024.F);
+        }
+
+        void FrameCache::setMemoryMaxGB(float value)
+        {
+            _p->memoryCache->setMaxMB(value * 1024.F);
+        }
+
+        void FrameCache::setDecimation(const ftk::Path& path, int value)
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.decimationPath = path.get();
+            p.decimation = std::max(value, 1);
+        }
+
+        int FrameCache::getDecimation(const ftk::Path& path) const
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.decimation > 1 && path.get() == p.decimationPath ? p.decimation : 1;
+        }
+
+        bool FrameCache::contains(
+            const ftk::Path& path,
+            const OTIO_NS::RationalTime& time,
+            const tl::IOOptions& options) const
+        {
+            FTK_P();
+            std::shared_ptr<models::ImageDiskCache> diskCache;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                diskCache = p.diskCache;
+            }
+            bool out = false;
+            if (p.memoryCache->isEnabled() || diskCache->isEnabled())
+            {
+                const std::string key = getKey(path, time, options);
+                out = !key.empty() &&
+                    (p.memoryCache->contains(key) || diskCache->contains(key));
+            }
+            return out;
+        }
+
+        std::shared_ptr<models::ImageDiskCache> FrameCache::getDiskCache() const
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.diskCache;
+        }
+
+        const std::shared_ptr<models::CompressedImageCache>& FrameCache::getMemoryCache() const
+        {
+            return _p->memoryCache;
+        }
+
+        const std::shared_ptr<models::FrameBufferPool>& FrameCache::getFrameBufferPool() const
+        {
+            return _p->pool;
+        }
+
+        const std::shared_ptr<models::ThreadPool>& FrameCache::getThreadPool() const
+        {
+            return _p->threadPool;
+        }
+    }
+}
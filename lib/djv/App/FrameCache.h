@@ -0,0 +1,150 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <djv/Models/Export.h>
+
+#include <tlRender/IO/IO.h>
+
+#include <ftk/Core/Path.h>
+#include <ftk/Core/Util.h>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+
+namespace ftk
+{
+    class Context;
+}
+
+namespace djv
+{
+    namespace models
+    {
+        class CompressedImageCache;
+        class FrameBufferPool;
+        class ImageDiskCache;
+        class ThreadPool;
+    }
+
+    namespace app
+    {
+        //! The I/O option that asks for the frames of an image sequence at
+        //! a fraction of their size, such as "2" for half. The frames are
+        //! reduced with models::decimateImage() on their way out of the
+        //! read plugin, and cached apart from the frames at the full size.
+        //! For playing at a reduced resolution, see
+        //! FrameCache::setDecimation(), which leaves the player's cache as
+        //! it is.
+        const std::string decimationOption = "Decimation";
+
+        //! Frame cache.
+        //!
+        //! Tiers behind the player's memory cache, for image sequences:
+        //!
+        //! * Memory: frames compressed with models::compressImage(), for
+        //!   when the cache mode is compressed. The player then keeps only
+        //!   enough uncompressed frames to read ahead with, and the rest of
+        //!   the video cache holds two or three times as many frames
+        //!   compressed. Frames are decompressed by the reader's threads, on
+        //!   their way to the player, so that the work is spread over the
+        //!   spare cores.
+        //! * Disk: every frame read is also written to a directory on local
+        //!   disk, and read back from there the next time it is asked for,
+        //!   whether that is after it fell out of memory, after the file was
+        //!   reloaded or changed to, or in a later run. Plates on a busy file
+        //!   server are then read from it once per review rather than once
+        //!   per pass.
+        //!
+        //! The cache sits between the player and the image sequence read
+        //! plugins, each of which is wrapped in one of its own. A frame is
+        //! found again by its file, the file's modification time, and the
+        //! I/O options it was read with, which include the layer, so a frame
+        //! that is rendered again is read afresh. Movies are not cached:
+        //! decoding one is not what is slow about it.
+        //!
+        //! With both tiers off, frames go straight to the wrapped plugin's
+        //! reader as though the cache were not there, unless they are asked
+        //! for at a reduced size. Otherwise the lookups, decompression, and
+        //! reduction run on one pool of threads shared by every reader. A
+        //! frame that is not cached is read by the wrapped reader, waited
+        //! for by one thread of the cache's own, and finished on the pool
+        //! once it has been read.
+        class DJV_API_TYPE FrameCache : public std::enable_shared_from_this<FrameCache>
+        {
+            FTK_NON_COPYABLE(FrameCache);
+
+        protected:
+            void _init(
+                const std::shared_ptr<ftk::Context>&,
+                const std::filesystem::path&,
+                const std::shared_ptr<models::FrameBufferPool>&);
+
+            FrameCache();
+
+        public:
+            DJV_API ~FrameCache();
+
+            //! Create a new cache, with the disk tier in the given
+            //! directory, and put it in front of the image sequence read
+            //! plugins. The frames that come out of either tier are created
+            //! in the pool.
+            DJV_API static std::shared_ptr<FrameCache> create(
+                const std::shared_ptr<ftk::Context>&,
+                const std::filesystem::path&,
+                const std::shared_ptr<models::FrameBufferPool>&);
+
+            //! Get the default disk cache directory, in the user's cache
+            //! directory.
+            DJV_API static std::filesystem::path getDefaultDir();
+
+            //! Set the disk cache directory.
+            DJV_API void setDiskDir(const std::filesystem::path&);
+
+            //! Set the maximum size of the disk tier in gigabytes. Zero
+            //! turns it off.
+            DJV_API void setDiskMaxGB(float);
+
+            //! Set the maximum size of the memory tier in gigabytes. Zero
+            //! turns it off.
+            DJV_API void setMemoryMaxGB(float);
+
+            //! Read the frames of the given file that are asked for from now
+            //! on at a fraction of their size, such as 2 for half, and 1 for
+            //! the full size. This is for one file at a time, the one being
+            //! played; setting it for another file puts the previous one
+            //! back to the full size. Unlike the I/O option, it does not
+            //! change the options the player reads with, so the frames the
+            //! player has already cached are kept.
+            DJV_API void setDecimation(const ftk::Path&, int);
+
+            //! Get the fraction the frames of the given file are read at.
+            DJV_API int getDecimation(const ftk::Path&) const;
+
+            //! Get whether a frame is in either tier, read with the given
+            //! I/O options. The frame's file is looked at for its
+            //! modification time, but nothing is read.
+            DJV_API bool contains(
+                const ftk::Path&,
+                const OTIO_NS::RationalTime&,
+                const tl::IOOptions&) const;
+
+            //! Get the cache the frames are kept on disk in.
+            DJV_API std::shared_ptr<models::ImageDiskCache> getDiskCache() const;
+
+            //! Get the cache the frames are kept compressed in memory in.
+            DJV_API const std::shared_ptr<models::CompressedImageCache>& getMemoryCache() const;
+
+            //! Get the pool the frames are created in.
+            DJV_API const std::shared_ptr<models::FrameBufferPool>& getFrameBufferPool() const;
+
+            //! Get the threads the readers look up and finish frames on.
+            DJV_API const std::shared_ptr<models::ThreadPool>& getThreadPool() const;
+
+        private:
+            FTK_PRIVATE();
+        };
+    }
+}
@@ -4,10 +4,10 @@
 #include <djv/App/MagnifyTool.h>
 
 #include <djv/App/App.h>
+#include <djv/App/MagnifyWidget.h>
 #include <djv/App/MainWindow.h>
 #include <djv/App/Viewport.h>
 #include <djv/Models/ColorModel.h>
-#include <djv/Models/FilesModel.h>
 #include <djv/Models/ViewportModel.h>
 
 #include <tlRender/Timeline/Player.h>
@@ -50,17 +50,14 @@ namespace djv
 
             MagnifyLevel level = MagnifyLevel::_4X;
             bool viewPosAndZoom = true;
-            ftk::V2I viewPos;
             double viewZoom = 1.0;
             std::optional<ftk::V2I> pick;
-            ftk::V2I samplePos;
-            size_t videoFramesSize = 0;
+            std::optional<ViewportSample> sample;
             std::vector<std::string> ocioInputs;
-            ftk::ImageOptions imageOptions;
             tl::DisplayOptions displayOptions;
-            bool sizeInit = true;
 
-            std::shared_ptr<tl::ui::Viewport> viewport;
+            std::weak_ptr<Viewport> viewport;
+            std::shared_ptr<MagnifyWidget> magnifyWidget;
             std::shared_ptr<ftk::ComboBox> comboBox;
             std::shared_ptr<ftk::Label> pixelLabel;
             std::shared_ptr<ftk::CheckBox> viewPosAndZoomCheckBox;
@@ -71,13 +68,11 @@ namespace djv
             std::shared_ptr<ftk::Observer<std::pair<ftk::V2I, double> > > viewPosAndZoomObserver;
             std::shared_ptr<ftk::Observer<std::optional<ftk::V2I> > > pickObserver;
             std::shared_ptr<ftk::Observer<ftk::V2I> > samplePosObserver;
-            std::shared_ptr<ftk::Observer<tl::CompareOptions> > compareOptionsObserver;
             std::shared_ptr<ftk::Observer<tl::OCIOOptions> > ocioOptionsObserver;
             std::shared_ptr<ftk::Observer<std::vector<std::string> > > resolvedInputsObserver;
             std::shared_ptr<ftk::Observer<tl::LUTOptions> > lutOptionsObserver;
             std::shared_ptr<ftk::Observer<ftk::ImageOptions> > imageOptionsObserver;
             std::shared_ptr<ftk::Observer<tl::DisplayOptions> > displayOptionsObserver;
-            std::shared_ptr<ftk::Observer<tl::BackgroundOptions> > bgOptionsObserver;
             std::shared_ptr<ftk::Observer<ftk::gl::TextureType> > colorBufferObserver;
             std::shared_ptr<ftk::Observer<models::MouseSettings> > settingsObserver;
         };
@@ -104,8 +99,9 @@ namespace djv
             from_string(s, p.level);
             p.settings->get("/Magnify/ViewPosAndZoom", p.viewPosAndZoom);
 
-            p.viewport = tl::ui::Viewport::create(context);
-            p.viewport->setInputEnabled(false);
+            p.viewport = mainWindow->getViewport();
+
+            p.magnifyWidget = MagnifyWidget::create(context);
 
             p.comboBox = ftk::ComboBox::create(context, getMagnifyLevelLabels());
             p.comboBox->setHStretch(ftk::Stretch::Expanding);
@@ -125,7 +121,7 @@ namespace djv
 
             auto layout = ftk::VerticalLayout::create(context);
             layout->setSpacingRole(ftk::SizeRole::None);
-            p.viewport->setParent(layout);
+            p.magnifyWidget->setParent(layout);
             auto formLayout = ftk::FormLayout::create(context, layout);
             formLayout->setMarginRole(ftk::SizeRole::Margin);
             formLayout->setSpacingRole(ftk::SizeRole::SpacingSmall);
@@ -151,10 +147,7 @@ namespace djv
                 {
                     FTK_P();
                     p.viewPosAndZoom = value;
-                    if (value)
-                    {
-                        _widgetUpdate();
-                    }
+                    _widgetUpdate();
                 });
 
             p.playerObserver = ftk::Observer<std::shared_ptr<tl::Player> >::create(
@@ -162,22 +155,19 @@ namespace djv
                 [this](const std::shared_ptr<tl::Player>& value)
                 {
                     FTK_P();
-                    p.viewport->setPlayer(value);
                     if (value)
                     {
                         p.videoObserver = ftk::ListObserver<tl::VideoFrame>::create(
                             value->observeCurrentVideo(),
-                            [this](const std::vector<tl::VideoFrame>& value)
+                            [this](const std::vector<tl::VideoFrame>&)
                             {
-                                _p->videoFramesSize = value.size();
-                                _videoUpdate();
+                                _sampleUpdate();
                             });
                     }
                     else
                     {
-                        p.videoFramesSize = 0;
                         p.videoObserver.reset();
-                        _videoUpdate();
+                        _sampleUpdate();
                     }
                 });
 
@@ -186,37 +176,23 @@ namespace djv
                 [this](const std::pair<ftk::V2I, double>& value)
                 {
                     FTK_P();
-                    p.viewPos = value.first;
                     p.viewZoom = value.second;
-                    if (p.viewPosAndZoom)
-                    {
-                        _widgetUpdate();
-                    }
+                    _sampleUpdate();
                 });
 
             p.pickObserver = ftk::Observer<std::optional<ftk::V2I> >::create(
                 mainWindow->getViewport()->observePick(),
                 [this](const std::optional<ftk::V2I>& value)
                 {
-                    FTK_P();
-                    p.pick = value;
-                    _widgetUpdate();
+                    _p->pick = value;
+                    _sampleUpdate();
                 });
 
             p.samplePosObserver = ftk::Observer<ftk::V2I>::create(
                 mainWindow->getViewport()->observeSamplePos(),
-                [this](const ftk::V2I& value)
+                [this](const ftk::V2I&)
                 {
-                    FTK_P();
-                    p.samplePos = value;
-                    _widgetUpdate();
-                });
-
-            p.compareOptionsObserver = ftk::Observer<tl::CompareOptions>::create(
-                app->getFilesModel()->observeCompareOptions(),
-                [this](const tl::CompareOptions& value)
-                {
-                    _p->viewport->setCompareOptions(value);
+                    _sampleUpdate();
                 });
 
             // The options as written; the per item display options carry
@@ -225,7 +201,7 @@ namespace djv
                 app->getColorModel()->observeOCIOOptions(),
                 [this](const tl::OCIOOptions& value)
                 {
-                    _p->viewport->setOCIOOptions(value);
+                    _p->magnifyWidget->setOCIOOptions(value);
                 });
 
             p.resolvedInputsObserver = ftk::Observer<std::vector<std::string> >::create(
@@ -233,13 +209,13 @@ namespace djv
                 [this](const std::vector<std::string>& value)
                 {
                     _p->ocioInputs = value;
-                    _videoUpdate();
+                    _displayUpdate();
                 });
 
             {
                 // The same per layer resolution as the main viewport.
                 const auto colorModel = app->getColorModel();
-                p.viewport->setOCIOInputResolver(
+                p.magnifyWidget->setOCIOInputResolver(
                     [colorModel](const std::string& path, const ftk::ImageTags& tags)
                     {
                         return colorModel->getOCIOOptions().input.empty() ?
@@ -252,15 +228,14 @@ namespace djv
                 app->getColorModel()->observeLUTOptions(),
                 [this](const tl::LUTOptions& value)
                 {
-                    _p->viewport->setLUTOptions(value);
+                    _p->magnifyWidget->setLUTOptions(value);
                 });
 
             p.imageOptionsObserver = ftk::Observer<ftk::ImageOptions>::create(
                 app->getViewportModel()->observeImageOptions(),
                 [this](const ftk::ImageOptions& value)
                 {
-                    _p->imageOptions = value;
-                    _videoUpdate();
+                    _p->magnifyWidget->setImageOptions(value);
                 });
 
             p.displayOptionsObserver = ftk::Observer<tl::DisplayOptions>::create(
@@ -268,21 +243,14 @@ namespace djv
                 [this](const tl::DisplayOptions& value)
                 {
                     _p->displayOptions = value;
-                    _videoUpdate();
-                });
-
-            p.bgOptionsObserver = ftk::Observer<tl::BackgroundOptions>::create(
-                app->getViewportModel()->observeBackgroundOptions(),
-                [this](const tl::BackgroundOptions& value)
-                {
-                    _p->viewport->setBackgroundOptions(value);
+                    _displayUpdate();
                 });
 
             p.colorBufferObserver = ftk::Observer<ftk::gl::TextureType>::create(
                 app->getViewportModel()->observeColorBuffer(),
                 [this](ftk::gl::TextureType value)
                 {
-                    _p->viewport->setColorBuffer(value);
+                    _p->magnifyWidget->setColorBuffer(value);
                 });
 
             p.settingsObserver = ftk::Observer<models::MouseSettings>::create(
@@ -329,35 +297,26 @@ namespace djv
             return out;
         }
 
-        void MagnifyTool::setGeometry(const ftk::Box2I& value)
+        void MagnifyTool::_sampleUpdate()
         {
-            IToolWidget::setGeometry(value);
             FTK_P();
-            if (p.sizeInit)
-            {
-                p.sizeInit = false;
-                _widgetUpdate();
-            }
+            // Taken from the viewport each time the frame, the view, or
+            // the sample position changes, so that the region follows
+            // the image that is under the sample as it plays.
+            auto viewport = p.viewport.lock();
+            p.sample = viewport ? viewport->getSample() : std::nullopt;
+            _widgetUpdate();
+            _displayUpdate();
         }
 
         void MagnifyTool::_widgetUpdate()
         {
             FTK_P();
-            const ftk::Box2I& g = p.viewport->getGeometry();
+            // Tracking the view magnifies what the viewport shows, and not
+            // tracking it magnifies the pixels of the image.
             const int level = getMagnifyLevel(p.level);
-            ftk::V2I magnifyPos;
-            double magnifyZoom = 1.0;
-            if (p.viewPosAndZoom)
-            {
-                magnifyPos = (p.viewPos - p.samplePos) * level + (center(g) - g.min);
-                magnifyZoom = p.viewZoom * level;
-            }
-            else
-            {
-                magnifyPos = (p.viewPos - p.samplePos) / p.viewZoom * level + (center(g) - g.min);
-                magnifyZoom = level;
-            }
-            p.viewport->setViewPosAndZoom(magnifyPos, magnifyZoom);
+            p.magnifyWidget->setSample(p.sample);
+            p.magnifyWidget->setZoom(p.viewPosAndZoom ? p.viewZoom * level : level);
 
             p.comboBox->setCurrentIndex(static_cast<int>(p.level));
 
@@ -371,20 +330,15 @@ namespace djv
             p.pixelLabel->setText(pixelText);
         }
 
-        void MagnifyTool::_videoUpdate()
+        void MagnifyTool::_displayUpdate()
         {
             FTK_P();
-            std::vector<ftk::ImageOptions> imageOptions;
-            std::vector<tl::DisplayOptions> displayOptions;
-            for (size_t i = 0; i < p.videoFramesSize; ++i)
-            {
-                imageOptions.push_back(p.imageOptions);
-                displayOptions.push_back(p.displayOptions);
-                displayOptions.back().ocioInput =
-                    i < p.ocioInputs.size() ? p.ocioInputs[i] : std::string();
-            }
-            p.viewport->setImageOptions(imageOptions);
-            p.viewport->setDisplayOptions(displayOptions);
+            // The input color space of the file the sample is from.
+            tl::DisplayOptions displayOptions = p.displayOptions;
+            const size_t index = p.sample.has_value() ? p.sample->index : 0;
+            displayOptions.ocioInput =
+                index < p.ocioInputs.size() ? p.ocioInputs[index] : std::string();
+            p.magnifyWidget->setDisplayOptions(displayOptions);
         }
     }
 }
@@ -52,11 +52,10 @@ namespace djv
                 const std::shared_ptr<MainWindow>&,
                 const std::shared_ptr<IWidget>& parent = nullptr);
 
-            DJV_API void setGeometry(const ftk::Box2I&) override;
-
         private:
+            void _sampleUpdate();
             void _widgetUpdate();
-            void _videoUpdate();
+            void _displayUpdate();
 
             FTK_PRIVATE();
         };
@@ -0,0 +1,276 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djv/App/MagnifyWidget.h>
+
+#include <djv/Models/ImageUtil.h>
+
+#include <tlRender/GL/Render.h>
+#include <tlRender/Timeline/CompareOptions.h>
+
+#include <ftk/GL/OffscreenBuffer.h>
+#include <ftk/Core/Context.h>
+#include <ftk/Core/FontSystem.h>
+#include <ftk/Core/Matrix.h>
+#include <ftk/Core/RenderUtil.h>
+
+#include <cmath>
+
+namespace djv
+{
+    namespace app
+    {
+        struct MagnifyWidget::Private
+        {
+            std::optional<ViewportSample> sample;
+            double zoom = 1.0;
+            tl::OCIOOptions ocioOptions;
+            std::function<std::string(const std::string&, const ftk::ImageTags&)> ocioInputResolver;
+            tl::LUTOptions lutOptions;
+            ftk::ImageOptions imageOptions;
+            tl::DisplayOptions displayOptions;
+            ftk::gl::TextureType colorBuffer = ftk::gl::TextureType::RGBA_U8;
+
+            // The region copied out of the frame, and where it is drawn
+            // relative to the widget.
+            std::shared_ptr<ftk::Image> crop;
+            ftk::Box2I cropBox;
+
+            std::shared_ptr<tl::gl::Render> render;
+            std::shared_ptr<ftk::gl::OffscreenBuffer> buffer;
+        };
+
+        void MagnifyWidget::_init(
+            const std::shared_ptr<ftk::Context>& context,
+            const std::shared_ptr<IWidget>& parent)
+        {
+            IWidget::_init(context, "djv::app::MagnifyWidget", parent);
+            setHStretch(ftk::Stretch::Expanding);
+            setVStretch(ftk::Stretch::Expanding);
+        }
+
+        MagnifyWidget::MagnifyWidget() :
+            _p(new Private)
+        {}
+
+        MagnifyWidget::~MagnifyWidget()
+        {}
+
+        std::shared_ptr<MagnifyWidget> MagnifyWidget::create(
+            const std::shared_ptr<ftk::Context>& context,
+            const std::shared_ptr<IWidget>& parent)
+        {
+            auto out = std::shared_ptr<MagnifyWidget>(new MagnifyWidget);
+            out->_init(context, parent);
+            return out;
+        }
+
+        void MagnifyWidget::setSample(const std::optional<ViewportSample>& value)
+        {
+            FTK_P();
+            if (value.has_value() == p.sample.has_value() &&
+                (!value.has_value() ||
+                    (value->image == p.sample->image &&
+                        value->pixel == p.sample->pixel &&
+                        value->pixelSize == p.sample->pixelSize)))
+                return;
+            p.sample = value;
+            _cropUpdate();
+        }
+
+        void MagnifyWidget::setZoom(double value)
+        {
+            FTK_P();
+            if (value == p.zoom)
+                return;
+            p.zoom = value;
+            _cropUpdate();
+        }
+
+        void MagnifyWidget::setOCIOOptions(const tl::OCIOOptions& value)
+        {
+            FTK_P();
+            if (value == p.ocioOptions)
+                return;
+            p.ocioOptions = value;
+            setDrawUpdate();
+        }
+
+        void MagnifyWidget::setOCIOInputResolver(
+            const std::function<std::string(const std::string&, const ftk::ImageTags&)>& value)
+        {
+            FTK_P();
+            p.ocioInputResolver = value;
+            if (p.render)
+            {
+                p.render->setOCIOInputResolver(value);
+            }
+            setDrawUpdate();
+        }
+
+        void MagnifyWidget::setLUTOptions(const tl::LUTOptions& value)
+        {
+            FTK_P();
+            if (value == p.lutOptions)
+                return;
+            p.lutOptions = value;
+            setDrawUpdate();
+        }
+
+        void MagnifyWidget::setImageOptions(const ftk::ImageOptions& value)
+        {
+            FTK_P();
+            if (value == p.imageOptions)
+                return;
+            p.imageOptions = value;
+            setDrawUpdate();
+        }
+
+        void MagnifyWidget::setDisplayOptions(const tl::DisplayOptions& value)
+        {
+            FTK_P();
+            if (value == p.displayOptions)
+                return;
+            p.displayOptions = value;
+            setDrawUpdate();
+        }
+
+        void MagnifyWidget::setColorBuffer(ftk::gl::TextureType value)
+        {
+            FTK_P();
+            if (value == p.colorBuffer)
+                return;
+            p.colorBuffer = value;
+            p.buffer.reset();
+            setDrawUpdate();
+        }
+
+        void MagnifyWidget::setGeometry(const ftk::Box2I& value)
+        {
+            const bool changed = value.size() != getGeometry().size();
+            IWidget::setGeometry(value);
+            if (changed)
+            {
+                _cropUpdate();
+            }
+        }
+
+        void MagnifyWidget::drawEvent(
+            const ftk::Box2I& drawRect,
+            const ftk::DrawEvent& event)
+        {
+            IWidget::drawEvent(drawRect, event);
+            FTK_P();
+            const ftk::Box2I& g = getGeometry();
+            const ftk::Size2I size = g.size();
+            if (!p.crop || !size.isValid())
+                return;
+
+            if (!p.render)
+            {
+                if (auto context = getContext())
+                {
+                    p.render = tl::gl::Render::create(
+                        context->getLogSystem(),
+                        context->getSystem<ftk::FontSystem>());
+                    p.render->setOCIOInputResolver(p.ocioInputResolver);
+                }
+            }
+            if (p.buffer && p.buffer->getSize() != size)
+            {
+                p.buffer.reset();
+            }
+            if (!p.buffer)
+            {
+                p.buffer = ftk::gl::OffscreenBuffer::create(
+                    size,
+                    p.colorBuffer,
+                    ftk::gl::OffscreenBufferOptions());
+            }
+            if (p.render && p.buffer)
+            {
+                {
+                    ftk::RenderSizeState renderSizeState(event.render);
+                    ftk::ViewportState viewportState(event.render);
+                    ftk::ClipRectEnabledState clipRectEnabledState(event.render);
+                    ftk::ClipRectState clipRectState(event.render);
+                    ftk::TransformState transformState(event.render);
+                    ftk::gl::OffscreenBufferBinding binding(p.buffer);
+
+                    // One layer holding the region, drawn the way the
+                    // viewport draws the file it was copied from. The
+                    // crop is new every frame, so it is not worth keeping
+                    // its texture.
+                    tl::VideoLayer layer;
+                    layer.image = p.crop;
+                    tl::VideoFrame videoFrame;
+                    videoFrame.layers.push_back(layer);
+                    ftk::ImageOptions imageOptions = p.imageOptions;
+                    imageOptions.cache = false;
+
+                    p.render->begin(size);
+                    // Flipped, the buffer being drawn as a texture with
+                    // its origin at the bottom.
+                    p.render->setTransform(ftk::ortho(
+                        0.F,
+                        static_cast<float>(size.w),
+                        0.F,
+                        static_cast<float>(size.h),
+                        -1.F,
+                        1.F));
+                    p.render->setOCIOOptions(p.ocioOptions);
+                    p.render->setLUTOptions(p.lutOptions);
+                    p.render->drawVideo(
+                        { videoFrame },
+                        { p.cropBox },
+                        { imageOptions },
+                        { p.displayOptions },
+                        tl::CompareOptions(),
+                        p.colorBuffer);
+                    p.render->end();
+                }
+                event.render->drawTexture(p.buffer->getColorID(), g);
+            }
+        }
+
+        void MagnifyWidget::_cropUpdate()
+        {
+            FTK_P();
+            p.crop.reset();
+            const ftk::Size2I size = getGeometry().size();
+            if (p.sample.has_value() && size.isValid())
+            {
+                // Enough pixels either side of the sample to fill the
+                // widget, plus one for the part of a pixel at each edge.
+                const ViewportSample& sample = p.sample.value();
+                const double sx = p.zoom * sample.pixelSize.x;
+                const double sy = p.zoom * sample.pixelSize.y;
+                if (sx > 0.0 && sy > 0.0)
+                {
+                    const int rx = static_cast<int>(std::ceil(size.w / 2.0 / sx)) + 1;
+                    const int ry = static_cast<int>(std::ceil(size.h / 2.0 / sy)) + 1;
+                    const ftk::V2I min(
+                        std::max(sample.pixel.x - rx, 0),
+                        std::max(sample.pixel.y - ry, 0));
+                    p.crop = models::cropImage(
+                        sample.image,
+                        ftk::Box2I(min, sample.pixel + ftk::V2I(rx, ry)));
+                    if (p.crop)
+                    {
+                        // Placed so that the middle of the sampled pixel is
+                        // in the middle of the widget. The box is clipped to
+                        // the image, so near an edge there is less of the
+                        // region on that side.
+                        const ftk::Size2I& cropSize = p.crop->getInfo().size;
+                        p.cropBox = ftk::Box2I(
+                            std::lround(size.w / 2.0 - (sample.pixel.x - min.x + .5) * sx),
+                            std::lround(size.h / 2.0 - (sample.pixel.y - min.y + .5) * sy),
+                            std::lround(cropSize.w * sx),
+                            std::lround(cropSize.h * sy));
+                    }
+                }
+            }
+            setDrawUpdate();
+        }
+    }
+}
@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <djv/App/Viewport.h>
+
+#include <tlRender/Timeline/ColorOptions.h>
+#include <tlRender/Timeline/DisplayOptions.h>
+
+#include <ftk/GL/Texture.h>
+#include <ftk/UI/IWidget.h>
+
+#include <functional>
+#include <optional>
+
+namespace djv
+{
+    namespace app
+    {
+        //! Magnify widget.
+        //!
+        //! Draws the pixels around the sample position of the viewport,
+        //! magnified, through the same color pipeline as the viewport.
+        //! Only the region that fits in the widget is copied out of the
+        //! frame and drawn, so the cost follows the size of the widget
+        //! rather than the size of the media: a second viewport would
+        //! upload and draw the whole frame again for every frame played.
+        class DJV_API_TYPE MagnifyWidget : public ftk::IWidget
+        {
+            FTK_NON_COPYABLE(MagnifyWidget);
+
+        protected:
+            void _init(
+                const std::shared_ptr<ftk::Context>&,
+                const std::shared_ptr<IWidget>& parent);
+
+            MagnifyWidget();
+
+        public:
+            DJV_API virtual ~MagnifyWidget();
+
+            //! Create a new widget.
+            DJV_API static std::shared_ptr<MagnifyWidget> create(
+                const std::shared_ptr<ftk::Context>&,
+                const std::shared_ptr<IWidget>& parent = nullptr);
+
+            //! Set the image and pixel to draw around, from the viewport.
+            DJV_API void setSample(const std::optional<ViewportSample>&);
+
+            //! Set how many times larger than at a zoom of one the pixels
+            //! are drawn.
+            DJV_API void setZoom(double);
+
+            //! Set the OCIO options.
+            DJV_API void setOCIOOptions(const tl::OCIOOptions&);
+
+            //! Set how each layer's OCIO input color space is resolved.
+            DJV_API void setOCIOInputResolver(
+                const std::function<std::string(const std::string&, const ftk::ImageTags&)>&);
+
+            //! Set the LUT options.
+            DJV_API void setLUTOptions(const tl::LUTOptions&);
+
+            //! Set the image options.
+            DJV_API void setImageOptions(const ftk::ImageOptions&);
+
+            //! Set the display options, with the input color space of the
+            //! file the sample is from.
+            DJV_API void setDisplayOptions(const tl::DisplayOptions&);
+
+            //! Set the color buffer type.
+            DJV_API void setColorBuffer(ftk::gl::TextureType);
+
+            DJV_API void setGeometry(const ftk::Box2I&) override;
+            DJV_API void drawEvent(const ftk::Box2I&, const ftk::DrawEvent&) override;
+
+        private:
+            void _cropUpdate();
+
+            FTK_PRIVATE();
+        };
+    }
+}
@@ -680,10 +680,12 @@ namespace djv
             {
                 if (auto app = p.app.lock())
                 {
+                    std::vector<ftk::Path> paths;
                     for (const auto& i : textData->getText())
                     {
-                        app->open(ftk::Path(i));
+                        paths.push_back(ftk::Path(i));
                     }
+                    app->open(paths);
                 }
             }
         }
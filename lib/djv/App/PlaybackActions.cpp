@@ -5,6 +5,8 @@
 
 #include <djv/App/App.h>
 
+#include <djv/Models/CacheWarmUpModel.h>
+
 #include <tlRender/UI/TimelineWidget.h>
 
 namespace djv
@@ -14,10 +16,12 @@ namespace djv
         struct PlaybackActions::Private
         {
             std::shared_ptr<tl::Player> player;
+            bool warmUp = false;
 
             std::shared_ptr<ftk::Observer<std::shared_ptr<tl::Player> > > playerObserver;
             std::shared_ptr<ftk::Observer<tl::Playback> > playbackObserver;
             std::shared_ptr<ftk::Observer<tl::Loop> > loopObserver;
+            std::shared_ptr<ftk::Observer<models::CacheWarmUp> > warmUpObserver;
         };
 
         void PlaybackActions::_init(
@@ -208,6 +212,42 @@ namespace djv
                     }
                 });
 
+            auto appWeak = std::weak_ptr<App>(app);
+            _addCommand(
+                "WarmUp",
+                "Fill the cache over the in/out range, holding playback at "
+                "the in point until it is cached.",
+                [appWeak](const nlohmann::json&)
+                {
+                    if (auto app = appWeak.lock())
+                    {
+                        app->warmUpCache(false);
+                    }
+                });
+
+            _addCommand(
+                "WarmUpPlay",
+                "Fill the cache over the in/out range, then start playback "
+                "once it is cached.",
+                [appWeak](const nlohmann::json&)
+                {
+                    if (auto app = appWeak.lock())
+                    {
+                        app->warmUpCache(true);
+                    }
+                });
+
+            _addCommand(
+                "CancelWarmUp",
+                "Cancel filling the cache.",
+                [appWeak](const nlohmann::json&)
+                {
+                    if (auto app = appWeak.lock())
+                    {
+                        app->cancelCacheWarmUp();
+                    }
+                });
+
             // Commands without menu actions, for scripting and automation.
             _addCommand(
                 "Seek",
@@ -299,6 +339,15 @@ namespace djv
             _actions["ResetOutPoint"] = ftk::Action::create(
                 "Reset Out Point",
                 _command("ResetOutPoint"));
+            _actions["WarmUp"] = ftk::Action::create(
+                "Warm Up Cache",
+                _command("WarmUp"));
+            _actions["WarmUpPlay"] = ftk::Action::create(
+                "Warm Up Cache and Play",
+                _command("WarmUpPlay"));
+            _actions["CancelWarmUp"] = ftk::Action::create(
+                "Cancel Cache Warm-Up",
+                _command("CancelWarmUp"));
 
             // Register the shortcuts.
             _addShortcut("Stop", ftk::Key::K);
@@ -316,6 +365,9 @@ namespace djv
             _addShortcut("ResetInPoint", ftk::KeyShortcut(ftk::Key::I, static_cast<int>(ftk::KeyModifier::Shift)));
             _addShortcut("SetOutPoint", ftk::Key::O);
             _addShortcut("ResetOutPoint", ftk::KeyShortcut(ftk::Key::O, static_cast<int>(ftk::KeyModifier::Shift)));
+            _addShortcut("WarmUp");
+            _addShortcut("WarmUpPlay");
+            _addShortcut("CancelWarmUp");
 
             _shortcutsUpdate(app->getSettingsModel()->getShortcuts());
             _playbackUpdate(tl::Playback::Stop);
@@ -327,6 +379,15 @@ namespace djv
                 {
                     _setPlayer(value);
                 });
+
+            p.warmUpObserver = ftk::Observer<models::CacheWarmUp>::create(
+                app->getCacheWarmUpModel()->observeWarmUp(),
+                [this](const models::CacheWarmUp& value)
+                {
+                    FTK_P();
+                    p.warmUp = value.active;
+                    _actions["CancelWarmUp"]->setEnabled(p.warmUp);
+                });
         }
 
         PlaybackActions::PlaybackActions() :
@@ -390,6 +451,9 @@ namespace djv
             _actions["ResetInPoint"]->setEnabled(p.player.get());
             _actions["SetOutPoint"]->setEnabled(p.player.get());
             _actions["ResetOutPoint"]->setEnabled(p.player.get());
+            _actions["WarmUp"]->setEnabled(p.player.get());
+            _actions["WarmUpPlay"]->setEnabled(p.player.get());
+            _actions["CancelWarmUp"]->setEnabled(p.warmUp);
         }
 
         void PlaybackActions::_playbackUpdate(tl::Playback value)
@@ -35,6 +35,10 @@ namespace djv
             addAction(actions["ResetInPoint"]);
             addAction(actions["SetOutPoint"]);
             addAction(actions["ResetOutPoint"]);
+            addDivider();
+            addAction(actions["WarmUp"]);
+            addAction(actions["WarmUpPlay"]);
+            addAction(actions["CancelWarmUp"]);
         }
 
         PlaybackMenu::~PlaybackMenu()
@@ -0,0 +1,175 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djv/App/RenderTiming.h>
+
+#include <ftk/GL/GL.h>
+#include <ftk/Core/Error.h>
+#include <ftk/Core/String.h>
+
+#include <chrono>
+#include <deque>
+
+namespace djv
+{
+    namespace app
+    {
+        FTK_ENUM_IMPL(
+            RenderStage,
+            "Video",
+            "Image",
+            "HUD");
+
+        namespace
+        {
+            double toMS(const std::chrono::steady_clock::duration& value)
+            {
+                return std::chrono::duration<double, std::milli>(value).count();
+            }
+        }
+
+        struct RenderTiming::Private
+        {
+            std::optional<std::chrono::steady_clock::time_point> arrived;
+
+            std::optional<RenderStage> stage;
+            std::chrono::steady_clock::time_point start;
+
+            struct Pending
+            {
+                RenderSample sample;
+                unsigned int query = 0;
+            };
+            std::deque<Pending> pending;
+            std::vector<unsigned int> queries;
+
+            std::vector<RenderSample> samples;
+        };
+
+        RenderTiming::RenderTiming() :
+            _p(new Private)
+        {}
+
+        RenderTiming::~RenderTiming()
+        {
+#if defined(FTK_API_GL_4_1)
+            FTK_P();
+            for (const auto& pending : p.pending)
+            {
+                p.queries.push_back(pending.query);
+            }
+            if (!p.queries.empty())
+            {
+                glDeleteQueries(static_cast<GLsizei>(p.queries.size()), p.queries.data());
+            }
+#endif // FTK_API_GL_4_1
+        }
+
+        std::shared_ptr<RenderTiming> RenderTiming::create()
+        {
+            return std::shared_ptr<RenderTiming>(new RenderTiming);
+        }
+
+        void RenderTiming::frameArrived()
+        {
+            FTK_P();
+            // Only the first: when frames replace each other before one is
+            // drawn, the wait is from the first of them.
+            if (!p.arrived.has_value())
+            {
+                p.arrived = std::chrono::steady_clock::now();
+            }
+        }
+
+        void RenderTiming::begin(RenderStage stage)
+        {
+            FTK_P();
+            if (p.stage.has_value())
+            {
+                // A stage whose end was never reached, such as the heads up
+                // display of a drawing that was cut short.
+                end();
+            }
+            const auto now = std::chrono::steady_clock::now();
+            if (p.arrived.has_value())
+            {
+                RenderSample sample;
+                sample.stage = RenderStage::Video;
+                sample.cpu = toMS(now - *p.arrived);
+                p.samples.push_back(sample);
+                p.arrived.reset();
+            }
+
+            _poll();
+
+            p.stage = stage;
+#if defined(FTK_API_GL_4_1)
+            unsigned int query = 0;
+            if (!p.queries.empty())
+            {
+                query = p.queries.back();
+                p.queries.pop_back();
+            }
+            else
+            {
+                glGenQueries(1, &query);
+            }
+            glBeginQuery(GL_TIME_ELAPSED, query);
+            Private::Pending pending;
+            pending.sample.stage = stage;
+            pending.query = query;
+            p.pending.push_back(pending);
+#endif // FTK_API_GL_4_1
+            p.start = std::chrono::steady_clock::now();
+        }
+
+        void RenderTiming::end()
+        {
+            FTK_P();
+            if (!p.stage.has_value())
+                return;
+            const double cpu = toMS(std::chrono::steady_clock::now() - p.start);
+#if defined(FTK_API_GL_4_1)
+            glEndQuery(GL_TIME_ELAPSED);
+            p.pending.back().sample.cpu = cpu;
+#else // FTK_API_GL_4_1
+            RenderSample sample;
+            sample.stage = *p.stage;
+            sample.cpu = cpu;
+            p.samples.push_back(sample);
+#endif // FTK_API_GL_4_1
+            p.stage.reset();
+        }
+
+        std::vector<RenderSample> RenderTiming::take()
+        {
+            FTK_P();
+            std::vector<RenderSample> out;
+            std::swap(out, p.samples);
+            return out;
+        }
+
+        void RenderTiming::_poll()
+        {
+#if defined(FTK_API_GL_4_1)
+            FTK_P();
+            // The queries finish in the order they were issued, so the
+            // first one that is not ready is as far as there is to look.
+            while (!p.pending.empty())
+            {
+                auto& pending = p.pending.front();
+                GLint available = 0;
+                glGetQueryObjectiv(pending.query, GL_QUERY_RESULT_AVAILABLE, &available);
+                if (!available)
+                    break;
+                GLuint64 ns = 0;
+                glGetQueryObjectui64v(pending.query, GL_QUERY_RESULT, &ns);
+                pending.sample.gpu = ns / 1000000.0;
+                p.samples.push_back(pending.sample);
+                p.queries.push_back(pending.query);
+                p.pending.pop_front();
+            }
+#endif // FTK_API_GL_4_1
+        }
+    }
+}
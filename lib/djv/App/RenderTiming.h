@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <djv/Models/Export.h>
+
+#include <ftk/Core/Util.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace djv
+{
+    namespace app
+    {
+        //! Render timing stages.
+        enum class DJV_API_TYPE RenderStage
+        {
+            //! From the player handing over a new frame to the start of the
+            //! drawing that shows it.
+            Video,
+
+            //! Drawing the image: the texture upload, the color shaders, and
+            //! the comparison. These happen in a single call to the
+            //! renderer, so they are timed together; compare runs with
+            //! different options to see what each of them costs.
+            Image,
+
+            //! Drawing the heads up display over the image.
+            HUD,
+
+            Count,
+            First = Video
+        };
+        FTK_ENUM(RenderStage);
+
+        //! Render timing sample, in milliseconds.
+        struct DJV_API_TYPE RenderSample
+        {
+            RenderStage stage = RenderStage::First;
+            double cpu = 0.0;
+
+            //! The time the GPU spent, which is only known for the stages
+            //! that draw, and only with the timer queries of desktop OpenGL.
+            std::optional<double> gpu;
+        };
+
+        //! Render timing.
+        //!
+        //! Times the stages of drawing the viewport on the CPU with the
+        //! steady clock and on the GPU with timer queries. Both are taken
+        //! around the drawing itself, so unlike the frame rate they are not
+        //! held to the display refresh by the buffer swap.
+        //!
+        //! The GPU runs behind the CPU, so a query is not read back until
+        //! it has finished, usually a frame or two later; a sample is
+        //! returned by take() once both of its times are known. Everything
+        //! except frameArrived() must be called with the OpenGL context
+        //! current.
+        class DJV_API_TYPE RenderTiming : public std::enable_shared_from_this<RenderTiming>
+        {
+            FTK_NON_COPYABLE(RenderTiming);
+
+        protected:
+            RenderTiming();
+
+        public:
+            DJV_API ~RenderTiming();
+
+            DJV_API static std::shared_ptr<RenderTiming> create();
+
+            //! Record that a new frame has arrived from the player.
+            DJV_API void frameArrived();
+
+            //! Start timing a stage. Stages cannot be nested.
+            DJV_API void begin(RenderStage);
+
+            //! Stop timing the stage that was started.
+            DJV_API void end();
+
+            //! Take the finished samples.
+            DJV_API std::vector<RenderSample> take();
+
+        private:
+            void _poll();
+
+            FTK_PRIVATE();
+        };
+    }
+}
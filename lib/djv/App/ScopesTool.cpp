@@ -0,0 +1,206 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djv/App/ScopesTool.h>
+
+#include <djv/App/App.h>
+#include <djv/App/ScopesWidget.h>
+#include <djv/Models/ColorModel.h>
+#include <djv/Models/ViewportModel.h>
+
+#include <tlRender/Timeline/Player.h>
+
+#include <ftk/UI/ComboBox.h>
+#include <ftk/UI/FormLayout.h>
+#include <ftk/UI/RowLayout.h>
+#include <ftk/UI/ScreenshotTag.h>
+#include <ftk/UI/Settings.h>
+
+namespace djv
+{
+    namespace app
+    {
+        struct ScopesTool::Private
+        {
+            std::shared_ptr<ftk::Settings> settings;
+
+            models::ScopeType type = models::ScopeType::Histogram;
+            std::vector<std::string> ocioInputs;
+            tl::DisplayOptions displayOptions;
+
+            std::shared_ptr<ScopesWidget> scopesWidget;
+            std::shared_ptr<ftk::ComboBox> typeComboBox;
+
+            std::shared_ptr<ftk::Observer<std::shared_ptr<tl::Player> > > playerObserver;
+            std::shared_ptr<ftk::ListObserver<tl::VideoFrame> > videoObserver;
+            std::shared_ptr<ftk::Observer<tl::OCIOOptions> > ocioOptionsObserver;
+            std::shared_ptr<ftk::Observer<std::vector<std::string> > > resolvedInputsObserver;
+            std::shared_ptr<ftk::Observer<tl::LUTOptions> > lutOptionsObserver;
+            std::shared_ptr<ftk::Observer<ftk::ImageOptions> > imageOptionsObserver;
+            std::shared_ptr<ftk::Observer<tl::DisplayOptions> > displayOptionsObserver;
+        };
+
+        void ScopesTool::_init(
+            const std::shared_ptr<ftk::Context>& context,
+            const std::shared_ptr<App>& app,
+            const std::shared_ptr<MainWindow>& mainWindow,
+            const std::shared_ptr<IWidget>& parent)
+        {
+            IToolWidget::_init(
+                context,
+                app,
+                mainWindow,
+                "Scopes",
+                std::string(),
+                "djv::app::ScopesTool",
+                parent);
+            FTK_P();
+
+            p.settings = app->getSettings();
+            std::string s;
+            p.settings->get("/Scopes/Type", s);
+            from_string(s, p.type);
+
+            p.scopesWidget = ScopesWidget::create(context);
+            p.scopesWidget->setType(p.type);
+
+            p.typeComboBox = ftk::ComboBox::create(context, models::getScopeTypeLabels());
+            p.typeComboBox->setHStretch(ftk::Stretch::Expanding);
+            p.typeComboBox->setCurrentIndex(static_cast<int>(p.type));
+            ftk::setScreenshotTag(p.typeComboBox, "Scopes.Type");
+
+            auto layout = ftk::VerticalLayout::create(context);
+            layout->setSpacingRole(ftk::SizeRole::None);
+            p.scopesWidget->setParent(layout);
+            auto formLayout = ftk::FormLayout::create(context, layout);
+            formLayout->setMarginRole(ftk::SizeRole::Margin);
+            formLayout->setSpacingRole(ftk::SizeRole::SpacingSmall);
+            formLayout->addRow("Scope:", p.typeComboBox);
+            // The scope has no natural size of its own, so this takes what
+            // room is left, the same as the magnify tool.
+            setVStretch(ftk::Stretch::Expanding);
+            _setWidget(layout);
+
+            p.typeComboBox->setIndexCallback(
+                [this](int value)
+                {
+                    FTK_P();
+                    p.type = static_cast<models::ScopeType>(value);
+                    p.scopesWidget->setType(p.type);
+                });
+
+            p.playerObserver = ftk::Observer<std::shared_ptr<tl::Player> >::create(
+                app->observePlayer(),
+                [this](const std::shared_ptr<tl::Player>& value)
+                {
+                    FTK_P();
+                    if (value)
+                    {
+                        // The A file, the same as the viewport's first
+                        // layer.
+                        p.videoObserver = ftk::ListObserver<tl::VideoFrame>::create(
+                            value->observeCurrentVideo(),
+                            [this](const std::vector<tl::VideoFrame>& value)
+                            {
+                                std::shared_ptr<ftk::Image> image;
+                                if (!value.empty())
+                                {
+                                    for (const auto& layer : value.front().layers)
+                                    {
+                                        image = layer.image ? layer.image : layer.imageB;
+                                        if (image)
+                                            break;
+                                    }
+                                }
+                                _p->scopesWidget->setImage(image);
+                            });
+                    }
+                    else
+                    {
+                        p.videoObserver.reset();
+                        p.scopesWidget->setImage(nullptr);
+                    }
+                });
+
+            p.ocioOptionsObserver = ftk::Observer<tl::OCIOOptions>::create(
+                app->getColorModel()->observeOCIOOptions(),
+                [this](const tl::OCIOOptions& value)
+                {
+                    _p->scopesWidget->setOCIOOptions(value);
+                });
+
+            p.resolvedInputsObserver = ftk::Observer<std::vector<std::string> >::create(
+                app->getColorModel()->observeResolvedInputs(),
+                [this](const std::vector<std::string>& value)
+                {
+                    _p->ocioInputs = value;
+                    _displayUpdate();
+                });
+
+            {
+                // The same per layer resolution as the viewport.
+                const auto colorModel = app->getColorModel();
+                p.scopesWidget->setOCIOInputResolver(
+                    [colorModel](const std::string& path, const ftk::ImageTags& tags)
+                    {
+                        return colorModel->getOCIOOptions().input.empty() ?
+                            colorModel->resolveInput(path, tags) :
+                            std::string();
+                    });
+            }
+
+            p.lutOptionsObserver = ftk::Observer<tl::LUTOptions>::create(
+                app->getColorModel()->observeLUTOptions(),
+                [this](const tl::LUTOptions& value)
+                {
+                    _p->scopesWidget->setLUTOptions(value);
+                });
+
+            p.imageOptionsObserver = ftk::Observer<ftk::ImageOptions>::create(
+                app->getViewportModel()->observeImageOptions(),
+                [this](const ftk::ImageOptions& value)
+                {
+                    _p->scopesWidget->setImageOptions(value);
+                });
+
+            p.displayOptionsObserver = ftk::Observer<tl::DisplayOptions>::create(
+                app->getViewportModel()->observeDisplayOptions(),
+                [this](const tl::DisplayOptions& value)
+                {
+                    _p->displayOptions = value;
+                    _displayUpdate();
+                });
+        }
+
+        ScopesTool::ScopesTool() :
+            _p(new Private)
+        {}
+
+        ScopesTool::~ScopesTool()
+        {
+            FTK_P();
+            p.settings->set("/Scopes/Type", to_string(p.type));
+        }
+
+        std::shared_ptr<ScopesTool> ScopesTool::create(
+            const std::shared_ptr<ftk::Context>& context,
+            const std::shared_ptr<App>& app,
+            const std::shared_ptr<MainWindow>& mainWindow,
+            const std::shared_ptr<IWidget>& parent)
+        {
+            auto out = std::shared_ptr<ScopesTool>(new ScopesTool);
+            out->_init(context, app, mainWindow, parent);
+            return out;
+        }
+
+        void ScopesTool::_displayUpdate()
+        {
+            FTK_P();
+            // The input color space of the A file.
+            tl::DisplayOptions displayOptions = p.displayOptions;
+            displayOptions.ocioInput =
+                !p.ocioInputs.empty() ? p.ocioInputs.front() : std::string();
+            p.scopesWidget->setDisplayOptions(displayOptions);
+        }
+    }
+}
@@ -0,0 +1,256 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djv/App/ScopesWidget.h>
+
+#include <djv/Models/ImageUtil.h>
+
+#include <tlRender/GL/Render.h>
+#include <tlRender/Timeline/CompareOptions.h>
+
+#include <ftk/GL/GL.h>
+#include <ftk/GL/OffscreenBuffer.h>
+#include <ftk/Core/Context.h>
+#include <ftk/Core/FontSystem.h>
+#include <ftk/Core/RenderUtil.h>
+
+namespace djv
+{
+    namespace app
+    {
+        namespace
+        {
+            // How wide the frame is reduced to before it is measured. Enough
+            // columns for the waveform to keep the shape of the picture, and
+            // enough pixels for the histogram to fill out, while reading
+            // back a few hundred kilobytes rather than a whole frame.
+            const int scopeWidth = 512;
+        }
+
+        struct ScopesWidget::Private
+        {
+            models::ScopeType type = models::ScopeType::Histogram;
+            std::shared_ptr<ftk::Image> image;
+            tl::OCIOOptions ocioOptions;
+            std::function<std::string(const std::string&, const ftk::ImageTags&)> ocioInputResolver;
+            tl::LUTOptions lutOptions;
+            ftk::ImageOptions imageOptions;
+            tl::DisplayOptions displayOptions;
+
+            bool scopeUpdate = false;
+            std::shared_ptr<ftk::Image> scope;
+
+            std::shared_ptr<tl::gl::Render> render;
+            std::shared_ptr<ftk::gl::OffscreenBuffer> buffer;
+        };
+
+        void ScopesWidget::_init(
+            const std::shared_ptr<ftk::Context>& context,
+            const std::shared_ptr<IWidget>& parent)
+        {
+            IWidget::_init(context, "djv::app::ScopesWidget", parent);
+            setHStretch(ftk::Stretch::Expanding);
+            setVStretch(ftk::Stretch::Expanding);
+        }
+
+        ScopesWidget::ScopesWidget() :
+            _p(new Private)
+        {}
+
+        ScopesWidget::~ScopesWidget()
+        {}
+
+        std::shared_ptr<ScopesWidget> ScopesWidget::create(
+            const std::shared_ptr<ftk::Context>& context,
+            const std::shared_ptr<IWidget>& parent)
+        {
+            auto out = std::shared_ptr<ScopesWidget>(new ScopesWidget);
+            out->_init(context, parent);
+            return out;
+        }
+
+        void ScopesWidget::setType(models::ScopeType value)
+        {
+            FTK_P();
+            if (value == p.type)
+                return;
+            p.type = value;
+            _scopeUpdate();
+        }
+
+        void ScopesWidget::setImage(const std::shared_ptr<ftk::Image>& value)
+        {
+            FTK_P();
+            if (value == p.image)
+                return;
+            p.image = value;
+            _scopeUpdate();
+        }
+
+        void ScopesWidget::setOCIOOptions(const tl::OCIOOptions& value)
+        {
+            FTK_P();
+            if (value == p.ocioOptions)
+                return;
+            p.ocioOptions = value;
+            _scopeUpdate();
+        }
+
+        void ScopesWidget::setOCIOInputResolver(
+            const std::function<std::string(const std::string&, const ftk::ImageTags&)>& value)
+        {
+            FTK_P();
+            p.ocioInputResolver = value;
+            if (p.render)
+            {
+                p.render->setOCIOInputResolver(value);
+            }
+            _scopeUpdate();
+        }
+
+        void ScopesWidget::setLUTOptions(const tl::LUTOptions& value)
+        {
+            FTK_P();
+            if (value == p.lutOptions)
+                return;
+            p.lutOptions = value;
+            _scopeUpdate();
+        }
+
+        void ScopesWidget::setImageOptions(const ftk::ImageOptions& value)
+        {
+            FTK_P();
+            if (value == p.imageOptions)
+                return;
+            p.imageOptions = value;
+            _scopeUpdate();
+        }
+
+        void ScopesWidget::setDisplayOptions(const tl::DisplayOptions& value)
+        {
+            FTK_P();
+            if (value == p.displayOptions)
+                return;
+            p.displayOptions = value;
+            _scopeUpdate();
+        }
+
+        void ScopesWidget::setGeometry(const ftk::Box2I& value)
+        {
+            const bool changed = value.size() != getGeometry().size();
+            IWidget::setGeometry(value);
+            if (changed)
+            {
+                _scopeUpdate();
+            }
+        }
+
+        void ScopesWidget::drawEvent(
+            const ftk::Box2I& drawRect,
+            const ftk::DrawEvent& event)
+        {
+            IWidget::drawEvent(drawRect, event);
+            FTK_P();
+            const ftk::Box2I& g = getGeometry();
+            if (p.scopeUpdate)
+            {
+                p.scopeUpdate = false;
+                p.scope.reset();
+                std::shared_ptr<ftk::Image> image;
+                if (p.image)
+                {
+                    const int w = p.image->getInfo().size.w;
+                    image = models::decimateImage(
+                        p.image,
+                        (w + scopeWidth - 1) / scopeWidth);
+                }
+                if (!p.render)
+                {
+                    if (auto context = getContext())
+                    {
+                        p.render = tl::gl::Render::create(
+                            context->getLogSystem(),
+                            context->getSystem<ftk::FontSystem>());
+                        p.render->setOCIOInputResolver(p.ocioInputResolver);
+                    }
+                }
+                if (image && p.render && g.isValid())
+                {
+                    const ftk::Size2I size = image->getInfo().size;
+                    if (p.buffer && p.buffer->getSize() != size)
+                    {
+                        p.buffer.reset();
+                    }
+                    if (!p.buffer)
+                    {
+                        // Eight bits is all the scopes measure.
+                        p.buffer = ftk::gl::OffscreenBuffer::create(
+                            size,
+                            ftk::gl::TextureType::RGBA_U8,
+                            ftk::gl::OffscreenBufferOptions());
+                    }
+                    auto readback = ftk::Image::create(
+                        ftk::ImageInfo(size, ftk::ImageType::RGBA_U8));
+                    {
+                        ftk::RenderSizeState renderSizeState(event.render);
+                        ftk::ViewportState viewportState(event.render);
+                        ftk::ClipRectEnabledState clipRectEnabledState(event.render);
+                        ftk::ClipRectState clipRectState(event.render);
+                        ftk::TransformState transformState(event.render);
+                        ftk::gl::OffscreenBufferBinding binding(p.buffer);
+
+                        // The reduced frame is new every time, so it is not
+                        // worth keeping its texture.
+                        tl::VideoLayer layer;
+                        layer.image = image;
+                        tl::VideoFrame videoFrame;
+                        videoFrame.layers.push_back(layer);
+                        ftk::ImageOptions imageOptions = p.imageOptions;
+                        imageOptions.cache = false;
+
+                        p.render->begin(size);
+                        p.render->setOCIOOptions(p.ocioOptions);
+                        p.render->setLUTOptions(p.lutOptions);
+                        p.render->drawVideo(
+                            { videoFrame },
+                            { ftk::Box2I(0, 0, size.w, size.h) },
+                            { imageOptions },
+                            { p.displayOptions },
+                            tl::CompareOptions(),
+                            ftk::gl::TextureType::RGBA_U8);
+                        p.render->end();
+
+                        // The rows come back bottom to top, which none of
+                        // the scopes depend on.
+                        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+                        glReadPixels(
+                            0,
+                            0,
+                            size.w,
+                            size.h,
+                            GL_RGBA,
+                            GL_UNSIGNED_BYTE,
+                            readback->getData());
+                    }
+                    p.scope = models::getScope(p.type, readback, g.size());
+                }
+            }
+            if (p.scope)
+            {
+                ftk::ImageOptions imageOptions;
+                imageOptions.cache = false;
+                event.render->drawImage(
+                    p.scope,
+                    g,
+                    ftk::Color4F(1.F, 1.F, 1.F),
+                    imageOptions);
+            }
+        }
+
+        void ScopesWidget::_scopeUpdate()
+        {
+            _p->scopeUpdate = true;
+            setDrawUpdate();
+        }
+    }
+}
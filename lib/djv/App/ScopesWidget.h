@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <djv/Models/Scopes.h>
+
+#include <tlRender/Timeline/ColorOptions.h>
+#include <tlRender/Timeline/DisplayOptions.h>
+
+#include <ftk/UI/IWidget.h>
+
+#include <functional>
+
+namespace djv
+{
+    namespace app
+    {
+        //! Scopes widget.
+        //!
+        //! Draws a scope of the frame as the viewport shows it: the frame is
+        //! drawn again through the same OCIO, LUT, and display options into
+        //! an offscreen buffer a few hundred pixels wide, and the scope is
+        //! measured on what is read back from there. The frame is reduced
+        //! before it is uploaded, so the work for each frame is the same
+        //! however large the media is, and the scope keeps up with
+        //! playback.
+        class DJV_API_TYPE ScopesWidget : public ftk::IWidget
+        {
+            FTK_NON_COPYABLE(ScopesWidget);
+
+        protected:
+            void _init(
+                const std::shared_ptr<ftk::Context>&,
+                const std::shared_ptr<IWidget>& parent);
+
+            ScopesWidget();
+
+        public:
+            DJV_API virtual ~ScopesWidget();
+
+            //! Create a new widget.
+            DJV_API static std::shared_ptr<ScopesWidget> create(
+                const std::shared_ptr<ftk::Context>&,
+                const std::shared_ptr<IWidget>& parent = nullptr);
+
+            //! Set the scope type.
+            DJV_API void setType(models::ScopeType);
+
+            //! Set the image to measure.
+            DJV_API void setImage(const std::shared_ptr<ftk::Image>&);
+
+            //! Set the OCIO options.
+            DJV_API void setOCIOOptions(const tl::OCIOOptions&);
+
+            //! Set how each layer's OCIO input color space is resolved.
+            DJV_API void setOCIOInputResolver(
+                const std::function<std::string(const std::string&, const ftk::ImageTags&)>&);
+
+            //! Set the LUT options.
+            DJV_API void setLUTOptions(const tl::LUTOptions&);
+
+            //! Set the image options.
+            DJV_API void setImageOptions(const ftk::ImageOptions&);
+
+            //! Set the display options, with the input color space of the
+            //! file.
+            DJV_API void setDisplayOptions(const tl::DisplayOptions&);
+
+            DJV_API void setGeometry(const ftk::Box2I&) override;
+            DJV_API void drawEvent(const ftk::Box2I&, const ftk::DrawEvent&) override;
+
+        private:
+            void _scopeUpdate();
+
+            FTK_PRIVATE();
+        };
+    }
+}
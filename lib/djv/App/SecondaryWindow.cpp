@@ -43,6 +43,10 @@ namespace djv
 
             p.viewport = Viewport::create(context, app);
             p.viewport->setParent(shared_from_this());
+            if (auto mainWindow = std::dynamic_pointer_cast<MainWindow>(shared))
+            {
+                p.viewport->setShared(mainWindow->getViewport());
+            }
 
             p.playerObserver = ftk::Observer<std::shared_ptr<tl::Player> >::create(
                 app->observePlayer(),
@@ -59,6 +63,7 @@ namespace djv
         SecondaryWindow::~SecondaryWindow()
         {
             _makeCurrent();
+            _p->viewport->setShared(nullptr);
             _p->viewport->setParent(nullptr);
         }
 
@@ -32,6 +32,8 @@ namespace djv
         public:
             DJV_API virtual ~SecondaryWindow();
 
+            //! Create a new window. Given the main window, the viewport
+            //! shares what work it can with the main window's viewport.
             DJV_API static std::shared_ptr<SecondaryWindow> create(
                 const std::shared_ptr<ftk::Context>&,
                 const std::shared_ptr<App>&,
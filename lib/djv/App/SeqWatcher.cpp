@@ -0,0 +1,325 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djv/App/SeqWatcher.h>
+
+#include <ftk/Core/Timer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <set>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <sys/vfs.h>
+#include <unistd.h>
+#endif // __linux__
+
+namespace djv
+{
+    namespace app
+    {
+        namespace
+        {
+            const std::chrono::milliseconds tickInterval(250);
+
+            // A render writes a frame every few seconds at best, so looking
+            // more often than this only adds load to the file server.
+            const std::chrono::seconds pollInterval(2);
+
+            std::optional<std::filesystem::file_time_type> getTime(const std::string& dir)
+            {
+                std::optional<std::filesystem::file_time_type> out;
+                std::error_code ec;
+                const auto time = std::filesystem::last_write_time(
+                    std::filesystem::u8path(dir),
+                    ec);
+                if (!ec)
+                {
+                    out = time;
+                }
+                return out;
+            }
+
+            // The file most recently written in a directory.
+            struct Newest
+            {
+                std::string name;
+                std::uintmax_t size = 0;
+                std::filesystem::file_time_type time;
+
+                bool operator == (const Newest& other) const
+                {
+                    return
+                        name == other.name &&
+                        size == other.size &&
+                        time == other.time;
+                }
+            };
+
+            std::optional<Newest> getNewest(const std::string& dir)
+            {
+                std::optional<Newest> out;
+                std::error_code ec;
+                for (std::filesystem::directory_iterator i(std::filesystem::u8path(dir), ec);
+                    !ec && i != std::filesystem::directory_iterator();
+                    i.increment(ec))
+                {
+                    const auto& entry = *i;
+                    std::error_code entryEC;
+                    if (!entry.is_regular_file(entryEC))
+                        continue;
+                    const auto time = entry.last_write_time(entryEC);
+                    if (entryEC)
+                        continue;
+                    if (!out.has_value() || time > out->time)
+                    {
+                        const auto size = entry.file_size(entryEC);
+                        if (!entryEC)
+                        {
+                            out = Newest{ entry.path().filename().u8string(), size, time };
+                        }
+                    }
+                }
+                return out;
+            }
+
+#if defined(__linux__)
+            // File systems where a change made by another machine is never
+            // heard about by inotify.
+            bool isRemote(const std::string& dir)
+            {
+                bool out = false;
+                struct statfs info;
+                if (0 == statfs(dir.c_str(), &info))
+                {
+                    switch (static_cast<unsigned long>(info.f_type))
+                    {
+                    case 0x6969:     // NFS
+                    case 0x517B:     // SMB
+                    case 0xFF534D42: // CIFS
+                    case 0xFE534D42: // SMB2
+                    case 0x65735546: // FUSE
+                    case 0x00C36400: // Ceph
+                    case 0x47504653: // GPFS
+                    case 0x0BD00BD0: // Lustre
+                        out = true;
+                        break;
+                    default: break;
+                    }
+                }
+                return out;
+            }
+#endif // __linux__
+        }
+
+        struct SeqWatcher::Private
+        {
+            struct Dir
+            {
+                int wd = -1;
+                std::optional<std::filesystem::file_time_type> time;
+                // Polled directories that have changed wait for the file
+                // written last to stop changing.
+                bool pending = false;
+                std::optional<Newest> newest;
+            };
+            std::map<std::string, Dir> dirs;
+            std::chrono::steady_clock::time_point pollTime;
+            int fd = -1;
+            std::function<void(const std::vector<std::string>&)> callback;
+            std::shared_ptr<ftk::Timer> timer;
+        };
+
+        void SeqWatcher::_init(const std::shared_ptr<ftk::Context>& context)
+        {
+            FTK_P();
+#if defined(__linux__)
+            p.fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif // __linux__
+            p.timer = ftk::Timer::create(context);
+            p.timer->setRepeating(true);
+        }
+
+        SeqWatcher::SeqWatcher() :
+            _p(new Private)
+        {}
+
+        SeqWatcher::~SeqWatcher()
+        {
+            FTK_P();
+#if defined(__linux__)
+            if (p.fd != -1)
+            {
+                close(p.fd);
+            }
+#endif // __linux__
+        }
+
+        std::shared_ptr<SeqWatcher> SeqWatcher::create(
+            const std::shared_ptr<ftk::Context>& context)
+        {
+            auto out = std::shared_ptr<SeqWatcher>(new SeqWatcher);
+            out->_init(context);
+            return out;
+        }
+
+        void SeqWatcher::setDirs(const std::vector<std::string>& value)
+        {
+            FTK_P();
+            const std::set<std::string> dirs(value.begin(), value.end());
+            for (auto i = p.dirs.begin(); i != p.dirs.end();)
+            {
+                if (dirs.find(i->first) == dirs.end())
+                {
+#if defined(__linux__)
+                    if (i->second.wd != -1)
+                    {
+                        inotify_rm_watch(p.fd, i->second.wd);
+                    }
+#endif // __linux__
+                    i = p.dirs.erase(i);
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+            for (const auto& dir : dirs)
+            {
+                if (p.dirs.find(dir) == p.dirs.end())
+                {
+                    Private::Dir item;
+#if defined(__linux__)
+                    if (p.fd != -1 && !isRemote(dir))
+                    {
+                        // A frame has arrived when it has been written and
+                        // closed, or moved into place, not when it is
+                        // created: the range is taken from what is found at
+                        // the change, so a frame heard about half written
+                        // would be read half written, and its finishing
+                        // would not look like a change to the range.
+                        item.wd = inotify_add_watch(
+                            p.fd,
+                            dir.c_str(),
+                            IN_CLOSE_WRITE | IN_MOVED_TO |
+                            IN_DELETE | IN_MOVED_FROM);
+                    }
+#endif // __linux__
+                    if (-1 == item.wd)
+                    {
+                        item.time = getTime(dir);
+                    }
+                    p.dirs[dir] = item;
+                }
+            }
+
+            if (p.dirs.empty())
+            {
+                p.timer->stop();
+            }
+            else if (!p.timer->isActive())
+            {
+                auto weak = std::weak_ptr<SeqWatcher>(shared_from_this());
+                p.timer->start(tickInterval, [weak]
+                    {
+                        if (auto self = weak.lock())
+                            self->_tick();
+                    });
+            }
+        }
+
+        void SeqWatcher::setCallback(
+            const std::function<void(const std::vector<std::string>&)>& value)
+        {
+            _p->callback = value;
+        }
+
+        void SeqWatcher::_tick()
+        {
+            FTK_P();
+            std::set<std::string> changed;
+
+#if defined(__linux__)
+            if (p.fd != -1)
+            {
+                alignas(struct inotify_event) char buf[4096];
+                ssize_t size = 0;
+                while ((size = read(p.fd, buf, sizeof(buf))) > 0)
+                {
+                    for (char* i = buf; i < buf + size;)
+                    {
+                        const auto* event = reinterpret_cast<const struct inotify_event*>(i);
+                        if (event->mask & IN_Q_OVERFLOW)
+                        {
+                            // Too much happened to say what; take it that
+                            // everything changed.
+                            for (const auto& dir : p.dirs)
+                            {
+                                if (dir.second.wd != -1)
+                                {
+                                    changed.insert(dir.first);
+                                }
+                            }
+                        }
+                        for (const auto& dir : p.dirs)
+                        {
+                            if (event->wd == dir.second.wd)
+                            {
+                                changed.insert(dir.first);
+                                break;
+                            }
+                        }
+                        i += sizeof(struct inotify_event) + event->len;
+                    }
+                }
+            }
+#endif // __linux__
+
+            const auto now = std::chrono::steady_clock::now();
+            if (now - p.pollTime >= pollInterval)
+            {
+                p.pollTime = now;
+                for (auto& dir : p.dirs)
+                {
+                    if (-1 == dir.second.wd)
+                    {
+                        // A frame being written changes the directory when
+                        // it is created, and only then, so the frame is
+                        // counted once its size and time have held across
+                        // two polls rather than when the directory changes.
+                        const auto time = getTime(dir.first);
+                        if (time != dir.second.time)
+                        {
+                            dir.second.time = time;
+                            dir.second.pending = true;
+                            dir.second.newest = getNewest(dir.first);
+                        }
+                        else if (dir.second.pending)
+                        {
+                            const auto newest = getNewest(dir.first);
+                            if (newest == dir.second.newest)
+                            {
+                                dir.second.pending = false;
+                                changed.insert(dir.first);
+                            }
+                            else
+                            {
+                                dir.second.newest = newest;
+                            }
+                        }
+                    }
+                }
+            }
+
+            if (!changed.empty() && p.callback)
+            {
+                p.callback(std::vector<std::string>(changed.begin(), changed.end()));
+            }
+        }
+    }
+}
@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <djv/Models/Export.h>
+
+#include <ftk/Core/Util.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ftk
+{
+    class Context;
+}
+
+namespace djv
+{
+    namespace app
+    {
+        //! Image sequence watcher.
+        //!
+        //! Watches the directories of sequences that are being rendered and
+        //! says which of them have changed. On Linux the directories are
+        //! watched with inotify, which costs nothing while a render is not
+        //! writing. inotify only hears about changes made on this machine,
+        //! so a directory on network storage -- where the render farm is
+        //! writing from other machines -- is polled instead, by its
+        //! modification time, as is every directory elsewhere.
+        //!
+        //! With inotify a frame is reported once it has been written and
+        //! closed, or moved into place, and not while it is being written.
+        //! When polling, a changed directory is reported once the size and
+        //! time of the file written last in it have held across two polls.
+        //! Changes are reported from the event loop, a few at once rather
+        //! than one per file.
+        class DJV_API_TYPE SeqWatcher : public std::enable_shared_from_this<SeqWatcher>
+        {
+            FTK_NON_COPYABLE(SeqWatcher);
+
+        protected:
+            void _init(const std::shared_ptr<ftk::Context>&);
+
+            SeqWatcher();
+
+        public:
+            DJV_API ~SeqWatcher();
+
+            //! Create a new watcher.
+            DJV_API static std::shared_ptr<SeqWatcher> create(
+                const std::shared_ptr<ftk::Context>&);
+
+            //! Set the directories to watch.
+            DJV_API void setDirs(const std::vector<std::string>&);
+
+            //! Set the callback for directories that have changed.
+            DJV_API void setCallback(
+                const std::function<void(const std::vector<std::string>&)>&);
+
+        private:
+            void _tick();
+
+            FTK_PRIVATE();
+        };
+    }
+}
@@ -0,0 +1,201 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djv/App/StartupTrace.h>
+
+#include <ftk/Core/Context.h>
+#include <ftk/Core/Format.h>
+
+#include <nlohmann/json.hpp>
+
+#include <atomic>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace djv
+{
+    namespace app
+    {
+        namespace
+        {
+            struct Event
+            {
+                std::string name;
+                std::string category;
+                std::chrono::steady_clock::time_point start;
+                std::optional<std::chrono::steady_clock::time_point> end;
+                int thread = 0;
+            };
+        }
+
+        struct StartupTrace::Private
+        {
+            std::weak_ptr<ftk::Context> context;
+            std::chrono::steady_clock::time_point origin;
+            std::atomic<bool> recording = true;
+            std::filesystem::path output;
+
+            std::mutex mutex;
+            std::vector<Event> events;
+            // Small numbers in the order the threads turn up, which read
+            // better in a trace viewer than the system's thread ids.
+            std::map<std::thread::id, int> threads;
+        };
+
+        void StartupTrace::_init(const std::shared_ptr<ftk::Context>& context)
+        {
+            FTK_P();
+            p.context = context;
+            p.origin = std::chrono::steady_clock::now();
+        }
+
+        StartupTrace::StartupTrace() :
+            _p(new Private)
+        {}
+
+        StartupTrace::~StartupTrace()
+        {}
+
+        std::shared_ptr<StartupTrace> StartupTrace::create(
+            const std::shared_ptr<ftk::Context>& context)
+        {
+            auto out = std::shared_ptr<StartupTrace>(new StartupTrace);
+            out->_init(context);
+            return out;
+        }
+
+        void StartupTrace::setOutput(const std::filesystem::path& value)
+        {
+            FTK_P();
+            p.output = value;
+            if (value.empty())
+            {
+                p.recording = false;
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.events.clear();
+            }
+        }
+
+        bool StartupTrace::isRecording() const
+        {
+            return _p->recording;
+        }
+
+        void StartupTrace::addSpan(
+            const std::string& name,
+            const std::string& category,
+            const std::chrono::steady_clock::time_point& start,
+            const std::chrono::steady_clock::time_point& end)
+        {
+            FTK_P();
+            if (!p.recording)
+                return;
+            std::unique_lock<std::mutex> lock(p.mutex);
+            const auto i = p.threads.insert(std::make_pair(
+                std::this_thread::get_id(),
+                static_cast<int>(p.threads.size()) + 1));
+            p.events.push_back({ name, category, start, end, i.first->second });
+        }
+
+        void StartupTrace::addInstant(
+            const std::string& name,
+            const std::string& category)
+        {
+            FTK_P();
+            if (!p.recording)
+                return;
+            const auto now = std::chrono::steady_clock::now();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            const auto i = p.threads.insert(std::make_pair(
+                std::this_thread::get_id(),
+                static_cast<int>(p.threads.size()) + 1));
+            p.events.push_back({ name, category, now, std::nullopt, i.first->second });
+        }
+
+        void StartupTrace::finish()
+        {
+            FTK_P();
+            if (!p.recording.exchange(false) || p.output.empty())
+                return;
+
+            std::vector<Event> events;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                std::swap(events, p.events);
+            }
+            nlohmann::json traceEvents = nlohmann::json::array();
+            for (const auto& event : events)
+            {
+                nlohmann::json json = {
+                    { "name", event.name },
+                    { "cat", event.category },
+                    { "pid", 1 },
+                    { "tid", event.thread },
+                    { "ts", std::chrono::duration<double, std::micro>(
+                        event.start - p.origin).count() } };
+                if (event.end.has_value())
+                {
+                    json["ph"] = "X";
+                    json["dur"] = std::chrono::duration<double, std::micro>(
+                        *event.end - event.start).count();
+                }
+                else
+                {
+                    // Drawn across every thread, since a first frame is a
+                    // point in the whole launch rather than in one thread.
+                    json["ph"] = "i";
+                    json["s"] = "g";
+                }
+                traceEvents.push_back(json);
+            }
+            const nlohmann::json doc = {
+                { "traceEvents", traceEvents },
+                { "displayTimeUnit", "ms" } };
+
+            std::ofstream f(p.output);
+            f << doc.dump() << std::endl;
+            if (auto context = p.context.lock())
+            {
+                if (f)
+                {
+                    context->log(
+                        "djv::app::StartupTrace",
+                        ftk::Format("Wrote the startup trace: {0}").arg(p.output.u8string()));
+                }
+                else
+                {
+                    context->log(
+                        "djv::app::StartupTrace",
+                        ftk::Format("Cannot write the startup trace: {0}").arg(p.output.u8string()),
+                        ftk::LogType::Error);
+                }
+            }
+        }
+
+        StartupSpan::StartupSpan(
+            const std::shared_ptr<StartupTrace>& trace,
+            const std::string& name,
+            const std::string& category)
+        {
+            if (trace && trace->isRecording())
+            {
+                _trace = trace;
+                _name = name;
+                _category = category;
+                _start = std::chrono::steady_clock::now();
+            }
+        }
+
+        StartupSpan::~StartupSpan()
+        {
+            if (_trace)
+            {
+                _trace->addSpan(_name, _category, _start, std::chrono::steady_clock::now());
+            }
+        }
+    }
+}
@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <djv/Models/Export.h>
+
+#include <ftk/Core/Util.h>
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+namespace ftk
+{
+    class Context;
+}
+
+namespace djv
+{
+    namespace app
+    {
+        //! Startup trace.
+        //!
+        //! Records how long each part of starting up takes -- reading the
+        //! settings, finding the plugins' file extensions, loading fonts,
+        //! opening each file, and the first frame decoded and drawn -- and
+        //! writes them as a Chrome trace event file, which chrome://tracing
+        //! and Perfetto both open.
+        //!
+        //! Recording starts with the application, before the command line
+        //! is read, so that the time spent reading it is in the trace too;
+        //! without an output file it is turned off as soon as the command
+        //! line has been read. Recording finishes at the first frame drawn,
+        //! which is where a launch ends as far as the artist is concerned,
+        //! and the file is written then. Spans may be recorded from any
+        //! thread.
+        class DJV_API_TYPE StartupTrace : public std::enable_shared_from_this<StartupTrace>
+        {
+            FTK_NON_COPYABLE(StartupTrace);
+
+        protected:
+            void _init(const std::shared_ptr<ftk::Context>&);
+
+            StartupTrace();
+
+        public:
+            DJV_API ~StartupTrace();
+
+            DJV_API static std::shared_ptr<StartupTrace> create(
+                const std::shared_ptr<ftk::Context>&);
+
+            //! Set the output file. An empty path turns recording off.
+            DJV_API void setOutput(const std::filesystem::path&);
+
+            //! Get whether the trace is recording.
+            DJV_API bool isRecording() const;
+
+            //! Add a span.
+            DJV_API void addSpan(
+                const std::string& name,
+                const std::string& category,
+                const std::chrono::steady_clock::time_point& start,
+                const std::chrono::steady_clock::time_point& end);
+
+            //! Add an event with no duration.
+            DJV_API void addInstant(
+                const std::string& name,
+                const std::string& category);
+
+            //! Stop recording and write the file. Only the first call
+            //! writes anything.
+            DJV_API void finish();
+
+        private:
+            FTK_PRIVATE();
+        };
+
+        //! Startup trace span, from construction to destruction.
+        class DJV_API_TYPE StartupSpan
+        {
+            FTK_NON_COPYABLE(StartupSpan);
+
+        public:
+            DJV_API StartupSpan(
+                const std::shared_ptr<StartupTrace>&,
+                const std::string& name,
+                const std::string& category = "startup");
+
+            DJV_API ~StartupSpan();
+
+        private:
+            std::shared_ptr<StartupTrace> _trace;
+            std::string _name;
+            std::string _category;
+            std::chrono::steady_clock::time_point _start;
+        };
+    }
+}
@@ -4,6 +4,7 @@
 #include <djv/App/StatusBar.h>
 
 #include <djv/App/App.h>
+#include <djv/Models/CacheWarmUpModel.h>
 #include <djv/Models/SettingsModel.h>
 #include <djv/Models/ToolsModel.h>
 
@@ -25,6 +26,8 @@ namespace djv
             std::weak_ptr<App> app;
 
             std::shared_ptr<ftk::Label> messagesLabel;
+            std::shared_ptr<ftk::Label> warmUpLabel;
+            std::shared_ptr<ftk::Divider> warmUpDivider;
             std::shared_ptr<ftk::Label> infoLabel;
             std::shared_ptr<ftk::HorizontalLayout> layout;
 
@@ -35,6 +38,7 @@ namespace djv
             std::shared_ptr<ftk::ListObserver<ftk::LogItem> > messagesObserver;
             std::shared_ptr<ftk::Observer<std::shared_ptr<tl::Player> > > playerObserver;
             std::shared_ptr<ftk::Observer<std::string> > mediaReferenceKeyObserver;
+            std::shared_ptr<ftk::Observer<models::CacheWarmUp> > warmUpObserver;
         };
 
         void StatusBar::_init(
@@ -63,6 +67,11 @@ namespace djv
                 "\n"
                 "Click to open messages tool.");
 
+            p.warmUpLabel = ftk::Label::create(context);
+            p.warmUpLabel->setMarginRole(ftk::SizeRole::MarginSmall, ftk::SizeRole::MarginInside);
+            p.warmUpLabel->setTooltip("Progress filling the cache over the in/out range.");
+            p.warmUpLabel->setVisible(false);
+
             p.infoLabel = ftk::Label::create(context);
             p.infoLabel->setMarginRole(ftk::SizeRole::MarginSmall, ftk::SizeRole::MarginInside);
             p.infoLabel->setClipText(true);
@@ -71,6 +80,9 @@ namespace djv
             p.layout->setSpacingRole(ftk::SizeRole::SpacingTool);
             p.messagesLabel->setParent(p.layout);
             ftk::Divider::create(context, ftk::Orientation::Horizontal, p.layout);
+            p.warmUpLabel->setParent(p.layout);
+            p.warmUpDivider = ftk::Divider::create(context, ftk::Orientation::Horizontal, p.layout);
+            p.warmUpDivider->setVisible(false);
             p.infoLabel->setParent(p.layout);
 
             p.messagesTimer = ftk::Timer::create(context);
@@ -130,6 +142,17 @@ namespace djv
                         _infoUpdate(ftk::Path(), tl::IOInfo());
                     }
                 });
+
+            p.warmUpObserver = ftk::Observer<models::CacheWarmUp>::create(
+                app->getCacheWarmUpModel()->observeWarmUp(),
+                [this](const models::CacheWarmUp& value)
+                {
+                    FTK_P();
+                    const std::string text = models::getText(value);
+                    p.warmUpLabel->setText(text);
+                    p.warmUpLabel->setVisible(!text.empty());
+                    p.warmUpDivider->setVisible(!text.empty());
+                });
         }
 
         StatusBar::StatusBar() :
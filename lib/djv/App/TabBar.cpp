@@ -16,8 +16,9 @@ namespace djv
         struct TabBar::Private
         {
             int aIndex = -1;
+            std::vector<std::string> names;
             std::shared_ptr<ftk::TabBar> tabBar;
-            std::shared_ptr<ftk::ListObserver<std::shared_ptr<models::FilesModelItem> > > filesObserver;
+            std::shared_ptr<ftk::ListObserver<models::FilesModelChange> > changesObserver;
             std::shared_ptr<ftk::Observer<int> > aIndexObserver;
         };
 
@@ -52,20 +53,60 @@ namespace djv
                     }
                 });
 
-            p.filesObserver = ftk::ListObserver<std::shared_ptr<models::FilesModelItem> >::create(
-                app->getFilesModel()->observeFiles(),
-                [this](const std::vector<std::shared_ptr<models::FilesModelItem> >& value)
+            _tabsUpdate(app->getFilesModel()->getFiles());
+            p.changesObserver = ftk::ListObserver<models::FilesModelChange>::create(
+                app->getFilesModel()->observeChanges(),
+                [this, appWeak](const std::vector<models::FilesModelChange>& value)
                 {
                     FTK_P();
-                    p.tabBar->clear();
-                    for (const auto& item : value)
+                    // Files opened at the end are added on, and a file whose
+                    // name has not changed is left alone. Anything else moves
+                    // the tabs about, and the tab bar has no way to do that
+                    // short of starting again.
+                    bool rebuild = false;
+                    for (const auto& change : value)
                     {
-                        p.tabBar->addTab(
-                            item->path.getFileName(),
-                            item->path.get());
+                        const std::string name = change.item->path.getFileName();
+                        switch (change.type)
+                        {
+                        case models::FilesModelChangeType::Added:
+                            if (!rebuild && change.index == static_cast<int>(p.names.size()))
+                            {
+                                p.tabBar->addTab(name, change.item->path.get());
+                                p.names.push_back(name);
+                            }
+                            else
+                            {
+                                rebuild = true;
+                            }
+                            break;
+                        case models::FilesModelChangeType::Changed:
+                            if (rebuild ||
+                                change.index < 0 ||
+                                change.index >= static_cast<int>(p.names.size()) ||
+                                name != p.names[change.index])
+                            {
+                                rebuild = true;
+                            }
+                            break;
+                        default:
+                            rebuild = true;
+                            break;
+                        }
                     }
-                    p.tabBar->setCurrent(p.aIndex);
-                });
+                    if (rebuild)
+                    {
+                        if (auto app = appWeak.lock())
+                        {
+                            _tabsUpdate(app->getFilesModel()->getFiles());
+                        }
+                    }
+                    else
+                    {
+                        p.tabBar->setCurrent(p.aIndex);
+                    }
+                },
+                ftk::ObserverAction::Suppress);
 
             p.aIndexObserver = ftk::Observer<int>::create(
                 app->getFilesModel()->observeAIndex(),
@@ -84,6 +125,20 @@ namespace djv
         TabBar::~TabBar()
         {}
 
+        void TabBar::_tabsUpdate(const std::vector<std::shared_ptr<models::FilesModelItem> >& value)
+        {
+            FTK_P();
+            p.tabBar->clear();
+            p.names.clear();
+            for (const auto& item : value)
+            {
+                const std::string name = item->path.getFileName();
+                p.tabBar->addTab(name, item->path.get());
+                p.names.push_back(name);
+            }
+            p.tabBar->setCurrent(p.aIndex);
+        }
+
         std::shared_ptr<TabBar> TabBar::create(
             const std::shared_ptr<ftk::Context>& context,
             const std::shared_ptr<App>& app,
@@ -5,6 +5,8 @@
 
 #include <djv/Models/Export.h>
 
+#include <djv/Models/FilesModel.h>
+
 #include <ftk/UI/IContainer.h>
 #include <ftk/UI/ToolBar.h>
 
@@ -35,6 +37,8 @@ namespace djv
                 const std::shared_ptr<App>&,
                 const std::shared_ptr<IWidget>& parent = nullptr);
         private:
+            void _tabsUpdate(const std::vector<std::shared_ptr<models::FilesModelItem> >&);
+
             FTK_PRIVATE();
         };
     }
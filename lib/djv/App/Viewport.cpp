@@ -4,25 +4,41 @@
 #include <djv/App/Viewport.h>
 
 #include <djv/App/App.h>
+#include <djv/App/FrameCache.h>
+#include <djv/App/StartupTrace.h>
+#include <djv/Models/CacheWarmUpModel.h>
 #include <djv/Models/ColorModel.h>
+#include <djv/Models/CompressedImageCache.h>
 #include <djv/Models/FilesModel.h>
 #include <djv/Models/SettingsModel.h>
+#include <djv/Models/ThreadPool.h>
 #include <djv/Models/TimeUnitsModel.h>
 #include <djv/Models/ViewportModel.h>
 
+#include <tlRender/GL/Render.h>
+#include <tlRender/Timeline/CompareOptions.h>
 #include <tlRender/Timeline/Util.h>
+#include <tlRender/UI/ThumbnailSystem.h>
 
 #include <ftk/UI/ColorSwatch.h>
+#include <ftk/UI/DrawUtil.h>
 #include <ftk/UI/Label.h>
 #include <ftk/UI/SysLogModel.h>
 #include <ftk/UI/RowLayout.h>
 #include <ftk/UI/ScreenshotTag.h>
 #include <ftk/UI/Spacer.h>
+#include <ftk/GL/OffscreenBuffer.h>
+#include <ftk/Core/FontSystem.h>
 #include <ftk/Core/Format.h>
+#include <ftk/Core/Matrix.h>
+#include <ftk/Core/RenderUtil.h>
 #include <ftk/Core/String.h>
 #include <ftk/Core/Timer.h>
 
 #include <algorithm>
+#include <cmath>
+#include <future>
+#include <map>
 
 #include <regex>
 
@@ -39,6 +55,18 @@ namespace djv
 
             const std::chrono::seconds toastTimeout(5);
 
+            // Scrub proxies are read at this height, which is enough to
+            // follow the motion by and quick to read back, and at most this
+            // many are kept, those furthest from the current frame going
+            // first.
+            const int proxyHeight = 270;
+            const size_t proxyMax = 64;
+
+            // How often the color under the picker is read back while
+            // playing. Reading it back waits for the GPU to finish drawing,
+            // which a pointer moving on every event makes a stall per frame.
+            const std::chrono::milliseconds sampleInterval(100);
+
             // A position inside a box, in the coordinates of what the box
             // holds. Clamped because a box and its contents are different
             // sizes whenever the image is scaled, and the far edge rounds up
@@ -71,14 +99,20 @@ namespace djv
             std::optional<OTIO_NS::RationalTime> currentTime;
             double fps = 0.0;
             size_t droppedFrames = 0;
+            int decimation = 1;
+            models::CacheWarmUp warmUp;
             size_t videoFramesSize = 0;
             std::vector<std::string> ocioInputs;
             // Whether the picture stands in for a frame the media does not
             // have, and the frame it repeats when there is one.
             bool missing = false;
             std::optional<int64_t> heldFrom;
+            tl::OCIOOptions ocioOptions;
+            std::function<std::string(const std::string&, const ftk::ImageTags&)> ocioInputResolver;
+            tl::LUTOptions lutOptions;
             ftk::ImageOptions imageOptions;
             tl::DisplayOptions displayOptions;
+            ftk::gl::TextureType colorBuffer = ftk::gl::TextureType::RGBA_U8;
             tl::PlayerCacheInfo cacheInfo;
             double viewZoom = 0.0;
             models::MouseActionBinding pickBinding =
@@ -86,10 +120,34 @@ namespace djv
             models::MouseActionBinding frameShuttleBinding =
                 models::MouseActionBinding(ftk::MouseButton::Left, ftk::KeyModifier::Shift);
             float frameShuttleScale = 1.F;
+            // The color is read back on a tick rather than when it is
+            // asked for: Wait holds it until the picture it is for has been
+            // drawn, and Read is however many requests arrived since the
+            // last tick, resolved by one readback.
             enum class Resample { None, Wait, Read };
             bool picked = false;
             Resample resample = Resample::None;
             bool resampleOnFrames = false;
+            std::chrono::steady_clock::time_point sampleTime;
+            // The region color statistics are measured over, and the
+            // corner a dragged box starts from. They are measured on a
+            // tick as well, as often as the color is read while playing.
+            int statsArea = 1;
+            std::optional<ftk::V2I> statsAnchor;
+            std::optional<ftk::Box2I> statsBox;
+            bool statsUpdate = false;
+            std::chrono::steady_clock::time_point statsTime;
+            // A dragged box can cover most of a large frame, so the
+            // statistics are measured on a thread of their own, one box at
+            // a time, and shown with the box once they are ready.
+            struct StatsResult
+            {
+                std::optional<ftk::Box2I> box;
+                std::optional<models::ImageStats> stats;
+            };
+            std::shared_ptr<models::ThreadPool> statsThreadPool;
+            std::future<StatsResult> statsFuture;
+            std::shared_ptr<ftk::Observable<std::optional<models::ImageStats> > > colorStats;
             std::shared_ptr<ftk::Observable<std::optional<ftk::V2I> > > pick;
             std::shared_ptr<ftk::Observable<ftk::V2I> > samplePos;
             std::shared_ptr<ftk::Observable<std::optional<ftk::Color4F> > > colorSample;
@@ -111,6 +169,10 @@ namespace djv
             bool toastActive = false;
             bool hudActive = true;
             std::shared_ptr<ftk::Label> toastLabel;
+            bool renderTimingEnabled = false;
+            bool startupDecoded = false;
+            bool startupPresented = false;
+            std::shared_ptr<RenderTiming> renderTiming;
             std::shared_ptr<ftk::Timer> toastTimer;
             std::shared_ptr<ftk::VerticalLayout> hudLayout;
             std::map<models::HUDPos, std::shared_ptr<ftk::VerticalLayout> > hudLayouts;
@@ -121,6 +183,8 @@ namespace djv
             std::shared_ptr<ftk::Observer<tl::PlayerCacheInfo> > cacheObserver;
             std::shared_ptr<ftk::Observer<double> > fpsObserver;
             std::shared_ptr<ftk::Observer<size_t> > droppedFramesObserver;
+            std::shared_ptr<ftk::Observer<int> > decimationObserver;
+            std::shared_ptr<ftk::Observer<models::CacheWarmUp> > warmUpObserver;
             std::shared_ptr<ftk::Observer<std::shared_ptr<models::FilesModelItem> > > aObserver;
             std::shared_ptr<ftk::ListObserver<std::shared_ptr<models::FilesModelItem> > > bObserver;
             std::shared_ptr<ftk::Observer<tl::CompareOptions> > compareOptionsObserver;
@@ -137,6 +201,48 @@ namespace djv
             std::shared_ptr<ftk::Observer<models::HUDOptions> > hudOptionsObserver;
             std::shared_ptr<ftk::Observer<tl::TimeUnits> > timeUnitsObserver;
             std::shared_ptr<ftk::Observer<models::MouseSettings> > mouseSettingsObserver;
+            std::shared_ptr<ftk::Observer<models::PlaybackSettings> > playbackSettingsObserver;
+            std::shared_ptr<ftk::Observer<tl::Playback> > playbackObserver;
+
+            // Small versions of the frames, shown in place of the picture
+            // while the frame the current time was moved to is read. The
+            // frame being shown is the time of the player's current video,
+            // which lags the current time until the read finishes.
+            bool scrubProxies = true;
+            tl::Playback playback = tl::Playback::Stop;
+            std::optional<OTIO_NS::RationalTime> videoTime;
+            struct ProxyData
+            {
+                std::map<int64_t, std::shared_ptr<ftk::Image> > images;
+                std::shared_ptr<ftk::Image> image;
+                tl::ui::ThumbnailRequest request;
+                int64_t requestFrame = 0;
+
+                // Drawn with a renderer of its own, as the magnify tool
+                // draws its region, so that the proxy goes through the
+                // same color transforms as the frame it stands in for.
+                std::shared_ptr<tl::gl::Render> render;
+                std::shared_ptr<ftk::gl::OffscreenBuffer> buffer;
+            };
+            ProxyData proxy;
+            std::shared_ptr<ftk::Observable<std::shared_ptr<ftk::Image> > > proxyImage;
+            std::shared_ptr<ftk::Observer<std::shared_ptr<ftk::Image> > > sharedProxyObserver;
+            std::weak_ptr<Viewport> shared;
+
+            // While another window presents what is shown here, the frames
+            // played are reduced to about the size of the viewport on a
+            // thread, and drawn through the proxy's renderer in place of
+            // the picture. The frame waiting is the newest one to arrive
+            // while the one before it was being reduced.
+            struct PresentedData
+            {
+                bool enabled = false;
+                std::shared_ptr<models::ThreadPool> threadPool;
+                std::shared_ptr<ftk::Image> frame;
+                std::future<std::shared_ptr<ftk::Image> > future;
+                std::shared_ptr<ftk::Image> image;
+            };
+            PresentedData presented;
 
             enum class MouseMode
             {
@@ -167,6 +273,9 @@ namespace djv
             p.pick = ftk::Observable<std::optional<ftk::V2I> >::create();
             p.samplePos = ftk::Observable<ftk::V2I>::create();
             p.colorSample = ftk::Observable<std::optional<ftk::Color4F> >::create();
+            p.colorStats = ftk::Observable<std::optional<models::ImageStats> >::create();
+            p.statsThreadPool = models::ThreadPool::create(1);
+            p.proxyImage = ftk::Observable<std::shared_ptr<ftk::Image> >::create();
 
             p.fileNameLabel = ftk::Label::create(context);
             p.fileNameLabel->setFont(ftk::FontType::Mono);
@@ -301,6 +410,22 @@ namespace djv
                     _hudUpdate();
                 });
 
+            p.decimationObserver = ftk::Observer<int>::create(
+                app->observeDecimation(),
+                [this](int value)
+                {
+                    _p->decimation = value;
+                    _hudUpdate();
+                });
+
+            p.warmUpObserver = ftk::Observer<models::CacheWarmUp>::create(
+                app->getCacheWarmUpModel()->observeWarmUp(),
+                [this](const models::CacheWarmUp& value)
+                {
+                    _p->warmUp = value;
+                    _hudUpdate();
+                });
+
             p.aObserver = ftk::Observer<std::shared_ptr<models::FilesModelItem> >::create(
                 app->getFilesModel()->observeA(),
                 [this](const std::shared_ptr<models::FilesModelItem>& value)
@@ -339,6 +464,7 @@ namespace djv
                 app->getColorModel()->observeOCIOOptions(),
                 [this](const tl::OCIOOptions& value)
                 {
+                   _p->ocioOptions = value;
                    setOCIOOptions(value);
                 });
 
@@ -355,18 +481,20 @@ namespace djv
             // the input is automatic; one the user chose applies to every
             // layer.
             const auto colorModel = app->getColorModel();
-            setOCIOInputResolver(
+            p.ocioInputResolver =
                 [colorModel](const std::string& path, const ftk::ImageTags& tags)
                 {
                     return colorModel->getOCIOOptions().input.empty() ?
                         colorModel->resolveInput(path, tags) :
                         std::string();
-                });
+                };
+            setOCIOInputResolver(p.ocioInputResolver);
 
             p.lutOptionsObserver = ftk::Observer<tl::LUTOptions>::create(
                 app->getColorModel()->observeLUTOptions(),
                 [this](const tl::LUTOptions& value)
                 {
+                   _p->lutOptions = value;
                    setLUTOptions(value);
                 });
 
@@ -410,6 +538,8 @@ namespace djv
                 app->getViewportModel()->observeColorBuffer(),
                 [this](ftk::gl::TextureType value)
                 {
+                    _p->colorBuffer = value;
+                    _p->proxy.buffer.reset();
                     setColorBuffer(value);
                     _hudUpdate();
                 });
@@ -497,6 +627,14 @@ namespace djv
                     p.frameShuttleBinding = i != value.bindings.end() ? i->second : models::MouseActionBinding();
                     p.frameShuttleScale = value.frameShuttleScale;
                 });
+
+            p.playbackSettingsObserver = ftk::Observer<models::PlaybackSettings>::create(
+                app->getSettingsModel()->observePlayback(),
+                [this](const models::PlaybackSettings& value)
+                {
+                    _p->scrubProxies = value.scrubProxies;
+                    _proxyUpdate();
+                });
         }
 
         Viewport::Viewport() :
@@ -531,6 +669,21 @@ namespace djv
             return _p->colorSample;
         }
 
+        void Viewport::setColorStatsArea(int value)
+        {
+            FTK_P();
+            if (value == p.statsArea)
+                return;
+            p.statsArea = value;
+            p.statsUpdate = true;
+            setDrawUpdate();
+        }
+
+        std::shared_ptr<ftk::IObservable<std::optional<models::ImageStats> > > Viewport::observeColorStats() const
+        {
+            return _p->colorStats;
+        }
+
         bool Viewport::_getSourceBox(ftk::Box2I& box, ftk::Size2I& size) const
         {
             // With OTIO spatial coordinates the render space is the timeline
@@ -574,7 +727,9 @@ namespace djv
             return false;
         }
 
-        std::optional<ftk::V2I> Viewport::_toSourcePixel(const ftk::V2I& renderPos) const
+        std::optional<ftk::V2I> Viewport::_toSourcePixel(
+            const ftk::V2I& renderPos,
+            ViewportSample* sampleOut) const
         {
             // Which image the position is over, and where in it. Side by side
             // comparisons give every image its own box, so a position has to
@@ -623,8 +778,20 @@ namespace djv
                                 aspectRatio);
                             if (ftk::contains(box, canvasPos))
                             {
-                                return mapInto(
-                                    canvasPos, box, image->getInfo().size);
+                                const ftk::Size2I& size = image->getInfo().size;
+                                const ftk::V2I out = mapInto(canvasPos, box, size);
+                                if (sampleOut)
+                                {
+                                    sampleOut->image = image;
+                                    sampleOut->index = i;
+                                    sampleOut->pixel = out;
+                                    sampleOut->pixelSize = ftk::V2F(
+                                        boxes[i].w() / static_cast<float>(videoFrame[i].canvasSize.w) *
+                                        box.w() / static_cast<float>(size.w),
+                                        boxes[i].h() / static_cast<float>(videoFrame[i].canvasSize.h) *
+                                        box.h() / static_cast<float>(size.h));
+                                }
+                                return out;
                             }
                         }
                     }
@@ -635,8 +802,18 @@ namespace djv
                     const auto& image = layer.image ? layer.image : layer.imageB;
                     if (image)
                     {
-                        return mapInto(
-                            renderPos, boxes[i], image->getInfo().size);
+                        const ftk::Size2I& size = image->getInfo().size;
+                        const ftk::V2I out = mapInto(renderPos, boxes[i], size);
+                        if (sampleOut)
+                        {
+                            sampleOut->image = image;
+                            sampleOut->index = i;
+                            sampleOut->pixel = out;
+                            sampleOut->pixelSize = ftk::V2F(
+                                boxes[i].w() / static_cast<float>(size.w),
+                                boxes[i].h() / static_cast<float>(size.h));
+                        }
+                        return out;
                     }
                 }
             }
@@ -671,18 +848,30 @@ namespace djv
             const ftk::V2I pos = fromRenderPos(_fromSourcePixel(imagePos));
             p.samplePos->setIfChanged(pos);
             p.picked = true;
+            p.statsAnchor = imagePos;
             _sampleUpdate();
             // The pixel asked for rather than the one that comes back from
             // converting it to a position and then converting it again, which
             // is a pixel out at some zooms.
             p.pick->setIfChanged(imagePos);
+            _statsUpdate();
             _hudUpdate();
         }
 
+        std::optional<ViewportSample> Viewport::getSample() const
+        {
+            ViewportSample out;
+            return _toSourcePixel(toRenderPos(_p->samplePos->get()), &out).has_value() ?
+                std::optional<ViewportSample>(out) :
+                std::nullopt;
+        }
+
         void Viewport::setPlayer(const std::shared_ptr<tl::Player>& player)
         {
             tl::ui::Viewport::setPlayer(player);
             FTK_P();
+            _proxyClear();
+            p.videoTime.reset();
             if (player)
             {
                 p.path = player->getPath();
@@ -708,15 +897,32 @@ namespace djv
                     [this](const OTIO_NS::RationalTime& value)
                     {
                         _p->currentTime = value;
+                        _proxyUpdate();
                         _hudUpdate();
                     });
 
+                p.playbackObserver = ftk::Observer<tl::Playback>::create(
+                    player->observePlayback(),
+                    [this](tl::Playback value)
+                    {
+                        _p->playback = value;
+                        if (tl::Playback::Stop == value)
+                        {
+                            _presentedClear();
+                        }
+                        _proxyUpdate();
+                    });
+
                 p.videoObserver = ftk::ListObserver<tl::VideoFrame>::create(
                     player->observeCurrentVideo(),
                     [this](const std::vector<tl::VideoFrame>& value)
                     {
                         FTK_P();
                         p.videoFramesSize = value.size();
+                        if (p.renderTiming)
+                        {
+                            p.renderTiming->frameArrived();
+                        }
                         if (p.resampleOnFrames)
                         {
                             // The frames a comparison had to read to be shown,
@@ -724,7 +930,29 @@ namespace djv
                             p.resampleOnFrames = false;
                             p.resample = Private::Resample::Wait;
                         }
+                        if (p.statsArea != 1)
+                        {
+                            p.statsUpdate = true;
+                        }
                         _compareUpdate();
+                        p.videoTime.reset();
+                        if (!value.empty())
+                        {
+                            p.videoTime = value.front().time;
+                        }
+                        _proxyUpdate();
+                        if (p.presented.enabled &&
+                            p.playback != tl::Playback::Stop &&
+                            1 == value.size() &&
+                            1 == value.front().layers.size())
+                        {
+                            p.presented.frame = value.front().layers.front().image;
+                            _presentedUpdate();
+                        }
+                        else
+                        {
+                            _presentedClear();
+                        }
                         p.missing = false;
                         p.heldFrom.reset();
                         // The first source, which is the one the time in the
@@ -745,6 +973,14 @@ namespace djv
                         }
                         _videoUpdate();
                         _hudUpdate();
+                        if (!p.startupDecoded && !value.empty() && !value.front().layers.empty())
+                        {
+                            p.startupDecoded = true;
+                            if (auto app = p.app.lock())
+                            {
+                                app->getStartupTrace()->addInstant("First decoded frame", "startup");
+                            }
+                        }
                     });
 
                 p.cacheObserver = ftk::Observer<tl::PlayerCacheInfo>::create(
@@ -763,6 +999,9 @@ namespace djv
                 p.mediaReferenceKeyObserver.reset();
                 p.currentTime.reset();
                 p.currentTimeObserver.reset();
+                p.playback = tl::Playback::Stop;
+                p.playbackObserver.reset();
+                _presentedClear();
                 p.videoObserver.reset();
                 p.cacheInfo = tl::PlayerCacheInfo();
                 p.cacheObserver.reset();
@@ -770,6 +1009,59 @@ namespace djv
             }
         }
 
+        void Viewport::setShared(const std::shared_ptr<Viewport>& value)
+        {
+            FTK_P();
+            _proxyClear();
+            p.sharedProxyObserver.reset();
+            if (auto shared = p.shared.lock())
+            {
+                shared->setPresented(false);
+            }
+            p.shared = value;
+            if (value)
+            {
+                value->setPresented(true);
+
+                // Both viewports show the same player, so the proxy the other
+                // one picked for the current time is the one this one would
+                // have picked.
+                p.sharedProxyObserver = ftk::Observer<std::shared_ptr<ftk::Image> >::create(
+                    value->observeProxyImage(),
+                    [this](const std::shared_ptr<ftk::Image>& value)
+                    {
+                        FTK_P();
+                        if (value != p.proxy.image)
+                        {
+                            p.proxy.image = value;
+                            setDrawUpdate();
+                        }
+                    });
+            }
+            else
+            {
+                _proxyUpdate();
+            }
+        }
+
+        void Viewport::setPresented(bool value)
+        {
+            FTK_P();
+            if (value == p.presented.enabled)
+                return;
+            p.presented.enabled = value;
+            if (value && !p.presented.threadPool)
+            {
+                p.presented.threadPool = models::ThreadPool::create(1);
+            }
+            _presentedClear();
+        }
+
+        std::shared_ptr<ftk::IObservable<std::shared_ptr<ftk::Image> > > Viewport::observeProxyImage() const
+        {
+            return _p->proxyImage;
+        }
+
         void Viewport::setHUDActive(bool value)
         {
             FTK_P();
@@ -788,6 +1080,24 @@ namespace djv
             _toastUpdate();
         }
 
+        void Viewport::setRenderTimingEnabled(bool value)
+        {
+            FTK_P();
+            p.renderTimingEnabled = value;
+            if (!value && p.renderTiming)
+            {
+                // Dropped at the next drawing, where the context that owns
+                // its queries is current.
+                p.renderTiming->take();
+            }
+        }
+
+        std::vector<RenderSample> Viewport::takeRenderTimings()
+        {
+            FTK_P();
+            return p.renderTiming ? p.renderTiming->take() : std::vector<RenderSample>();
+        }
+
         ftk::Size2I Viewport::getSizeHint() const
         {
             return _p->hudLayout->getSizeHint();
@@ -802,10 +1112,60 @@ namespace djv
             FTK_P();
             if (Private::Resample::Read == p.resample)
             {
-                p.resample = Private::Resample::None;
                 // Through the same path as a pick: a comparison can bring a
-                // different image under the position, or none at all.
-                _sampleUpdate();
+                // different image under the position, or none at all. The
+                // color shown is the last one read until then.
+                const auto now = std::chrono::steady_clock::now();
+                if (tl::Playback::Stop == p.playback ||
+                    now - p.sampleTime >= sampleInterval)
+                {
+                    p.resample = Private::Resample::None;
+                    p.sampleTime = now;
+                    _sampleUpdate();
+                }
+            }
+            if (p.presented.future.valid() &&
+                p.presented.future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+            {
+                p.presented.image = p.presented.future.get();
+                setDrawUpdate();
+                _presentedUpdate();
+            }
+            if (p.statsFuture.valid() &&
+                p.statsFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+            {
+                const Private::StatsResult result = p.statsFuture.get();
+                _statsSet(result.box, result.stats);
+            }
+            if (p.statsUpdate && !p.statsFuture.valid())
+            {
+                const auto now = std::chrono::steady_clock::now();
+                if (tl::Playback::Stop == p.playback ||
+                    now - p.statsTime >= sampleInterval)
+                {
+                    p.statsUpdate = false;
+                    p.statsTime = now;
+                    _statsUpdate();
+                }
+            }
+            if (p.proxy.request.future.valid() &&
+                p.proxy.request.future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+            {
+                if (auto image = p.proxy.request.future.get())
+                {
+                    p.proxy.images[p.proxy.requestFrame] = image;
+                    const int64_t frame = p.currentTime.has_value() ?
+                        p.currentTime->round().value() :
+                        p.proxy.requestFrame;
+                    while (p.proxy.images.size() > proxyMax)
+                    {
+                        const auto first = p.proxy.images.begin();
+                        const auto last = std::prev(p.proxy.images.end());
+                        p.proxy.images.erase(
+                            frame - first->first > last->first - frame ? first : last);
+                    }
+                }
+                _proxyUpdate();
             }
         }
 
@@ -813,8 +1173,96 @@ namespace djv
             const ftk::Box2I& drawRect,
             const ftk::DrawEvent& event)
         {
-            tl::ui::Viewport::drawEvent(drawRect, event);
             FTK_P();
+            if (p.renderTimingEnabled && !p.renderTiming)
+            {
+                p.renderTiming = RenderTiming::create();
+            }
+            else if (!p.renderTimingEnabled && p.renderTiming)
+            {
+                p.renderTiming.reset();
+            }
+            if (p.renderTiming)
+            {
+                p.renderTiming->begin(RenderStage::Image);
+            }
+            // The reduced copy of a frame presented by another window is
+            // drawn instead of the frame, not over it, which is what saves
+            // uploading and transforming the frame here as well.
+            std::shared_ptr<ftk::Image> proxyImage = p.proxy.image;
+            if (p.presented.image)
+            {
+                proxyImage = p.presented.image;
+            }
+            else
+            {
+                tl::ui::Viewport::drawEvent(drawRect, event);
+            }
+            if (proxyImage && !p.ioInfo.video.empty())
+            {
+                // Drawn into the box the frame itself is drawn into, which
+                // is the media's render size unless OTIO spatial coordinates
+                // place it on a canvas.
+                ftk::Box2I box;
+                ftk::Size2I size;
+                if (!_getSourceBox(box, size))
+                {
+                    const ftk::Size2I renderSize = tl::getRenderSize(
+                        p.ioInfo.video[0],
+                        p.displayOptions.aspectRatio);
+                    box = ftk::Box2I(0, 0, renderSize.w, renderSize.h);
+                }
+                const ftk::V2I a = fromRenderPos(box.min);
+                const ftk::V2I b = fromRenderPos(box.max);
+                _proxyDraw(
+                    proxyImage,
+                    ftk::Box2I(
+                        ftk::V2I(std::min(a.x, b.x), std::min(a.y, b.y)),
+                        ftk::V2I(std::max(a.x, b.x), std::max(a.y, b.y))),
+                    event);
+            }
+            if (p.statsBox.has_value())
+            {
+                // The outline of the region the statistics are measured
+                // over, around the edges of its pixels.
+                const ftk::Box2I& box = p.statsBox.value();
+                const ftk::Box2I& g = getGeometry();
+                const ftk::V2I a = fromRenderPos(_fromSourcePixel(box.min));
+                const ftk::V2I b = fromRenderPos(_fromSourcePixel(
+                    ftk::V2I(box.max.x + 1, box.max.y + 1)));
+                event.render->drawMesh(
+                    ftk::border(
+                        ftk::Box2I(
+                            ftk::V2I(g.min.x + std::min(a.x, b.x), g.min.y + std::min(a.y, b.y)),
+                            ftk::V2I(g.min.x + std::max(a.x, b.x), g.min.y + std::max(a.y, b.y))),
+                        1),
+                    event.style->getColorRole(ftk::ColorRole::Checked));
+            }
+            if (!p.startupPresented)
+            {
+                // The end of starting up: the first frame of the media, or
+                // the first drawing at all when there is no media to wait
+                // for.
+                if (auto app = p.app.lock())
+                {
+                    if (p.videoFramesSize > 0 || app->getFilesModel()->getFiles().empty())
+                    {
+                        p.startupPresented = true;
+                        const auto& trace = app->getStartupTrace();
+                        trace->addInstant(
+                            p.videoFramesSize > 0 ? "First presented frame" : "First window frame",
+                            "startup");
+                        trace->finish();
+                    }
+                }
+            }
+            if (p.renderTiming)
+            {
+                p.renderTiming->end();
+                // The heads up display is drawn by the children, between
+                // here and the overlay.
+                p.renderTiming->begin(RenderStage::HUD);
+            }
             if (Private::Resample::Wait == p.resample)
             {
                 // This drawing carries the new picture; the next tick reads it.
@@ -822,6 +1270,18 @@ namespace djv
             }
         }
 
+        void Viewport::drawOverlayEvent(
+            const ftk::Box2I& drawRect,
+            const ftk::DrawEvent& event)
+        {
+            tl::ui::Viewport::drawOverlayEvent(drawRect, event);
+            FTK_P();
+            if (p.renderTiming)
+            {
+                p.renderTiming->end();
+            }
+        }
+
         void Viewport::setGeometry(const ftk::Box2I& value)
         {
             tl::ui::Viewport::setGeometry(value);
@@ -867,7 +1327,7 @@ namespace djv
                     p.picked = true;
                     if (p.samplePos->setIfChanged(pos))
                     {
-                        _sampleUpdate();
+                        _sampleRequest();
                     }
                 }
                 break;
@@ -897,9 +1357,12 @@ namespace djv
                 p.mouse.mode = Private::MouseMode::Picker;
                 const ftk::V2I pos = toViewportPos(event.pos);
                 p.picked = true;
+                // A box starts from where the picker is pressed.
+                p.statsAnchor = _toSourcePixel(toRenderPos(pos));
+                p.statsUpdate = p.statsArea != 1;
                 if (p.samplePos->setIfChanged(pos))
                 {
-                    _sampleUpdate();
+                    _sampleRequest();
                 }
             }
             else if (p.frameShuttleBinding.button == event.button &&
@@ -923,6 +1386,241 @@ namespace djv
             p.mouse = Private::MouseData();
         }
 
+        void Viewport::_proxyUpdate()
+        {
+            FTK_P();
+            if (p.sharedProxyObserver)
+                return;
+
+            // Only while stopped, with one picture, and the frame shown is
+            // not the current one: a frame that is cached arrives before a
+            // proxy could, and one being played is read ahead of time.
+            std::shared_ptr<ftk::Image> image;
+            const bool wanted =
+                p.scrubProxies &&
+                tl::Playback::Stop == p.playback &&
+                p.currentTime.has_value() &&
+                p.videoFramesSize <= 1 &&
+                !p.ioInfo.video.empty() &&
+                (!p.videoTime.has_value() ||
+                    p.videoTime->round().value() != p.currentTime->round().value());
+            if (wanted)
+            {
+                const int64_t frame = p.currentTime->round().value();
+                const auto i = p.proxy.images.lower_bound(frame);
+                if (i != p.proxy.images.end() && i->first == frame)
+                {
+                    image = i->second;
+                    _proxyCancel();
+                }
+                else
+                {
+                    // The nearest frame that has a proxy stands in until
+                    // this one's arrives.
+                    if (i != p.proxy.images.end())
+                    {
+                        image = i->second;
+                    }
+                    if (i != p.proxy.images.begin())
+                    {
+                        const auto j = std::prev(i);
+                        if (!image || frame - j->first < i->first - frame)
+                        {
+                            image = j->second;
+                        }
+                    }
+
+                    // What was asked for the frame the current time has
+                    // moved on from is no longer wanted. A proxy is only
+                    // made from a frame in the frame cache's tiers: one
+                    // made from the media would be read from storage as
+                    // well as the frame itself, which is what is slow.
+                    if (!p.proxy.request.future.valid() || p.proxy.requestFrame != frame)
+                    {
+                        _proxyCancel();
+                        auto context = getContext();
+                        auto app = p.app.lock();
+                        auto player = getPlayer();
+                        const tl::IOOptions ioOptions = player ?
+                            player->getIOOptions() :
+                            tl::IOOptions();
+                        if (context && app &&
+                            app->getFrameCache()->contains(p.path, *p.currentTime, ioOptions))
+                        {
+                            auto thumbnailSystem = context->getSystem<tl::ui::ThumbnailSystem>();
+                            p.proxy.request = thumbnailSystem->getThumbnail(
+                                p.path,
+                                proxyHeight,
+                                p.currentTime,
+                                ioOptions);
+                            p.proxy.requestFrame = frame;
+                        }
+                    }
+                }
+            }
+            else
+            {
+                _proxyCancel();
+            }
+            if (image != p.proxy.image)
+            {
+                p.proxy.image = image;
+                p.proxyImage->setIfChanged(image);
+                setDrawUpdate();
+            }
+        }
+
+        void Viewport::_proxyDraw(
+            const std::shared_ptr<ftk::Image>& image,
+            const ftk::Box2I& box,
+            const ftk::DrawEvent& event)
+        {
+            FTK_P();
+            const ftk::Box2I& g = getGeometry();
+            const ftk::Size2I size = g.size();
+            if (!size.isValid())
+                return;
+
+            if (!p.proxy.render)
+            {
+                if (auto context = getContext())
+                {
+                    p.proxy.render = tl::gl::Render::create(
+                        context->getLogSystem(),
+                        context->getSystem<ftk::FontSystem>());
+                    p.proxy.render->setOCIOInputResolver(p.ocioInputResolver);
+                }
+            }
+            if (p.proxy.buffer && p.proxy.buffer->getSize() != size)
+            {
+                p.proxy.buffer.reset();
+            }
+            if (!p.proxy.buffer)
+            {
+                p.proxy.buffer = ftk::gl::OffscreenBuffer::create(
+                    size,
+                    p.colorBuffer,
+                    ftk::gl::OffscreenBufferOptions());
+            }
+            if (p.proxy.render && p.proxy.buffer)
+            {
+                {
+                    ftk::RenderSizeState renderSizeState(event.render);
+                    ftk::ViewportState viewportState(event.render);
+                    ftk::ClipRectEnabledState clipRectEnabledState(event.render);
+                    ftk::ClipRectState clipRectState(event.render);
+                    ftk::TransformState transformState(event.render);
+                    ftk::gl::OffscreenBufferBinding binding(p.proxy.buffer);
+
+                    // The display options of the first item, with the
+                    // input color space resolved for its file, as the
+                    // frame itself is drawn with.
+                    tl::VideoLayer layer;
+                    layer.image = image;
+                    tl::VideoFrame videoFrame;
+                    videoFrame.layers.push_back(layer);
+                    tl::DisplayOptions displayOptions = p.displayOptions;
+                    displayOptions.ocioInput =
+                        !p.ocioInputs.empty() ? p.ocioInputs.front() : std::string();
+
+                    p.proxy.render->begin(size);
+                    // Flipped, the buffer being drawn as a texture with
+                    // its origin at the bottom.
+                    p.proxy.render->setTransform(ftk::ortho(
+                        0.F,
+                        static_cast<float>(size.w),
+                        0.F,
+                        static_cast<float>(size.h),
+                        -1.F,
+                        1.F));
+                    p.proxy.render->setOCIOOptions(p.ocioOptions);
+                    p.proxy.render->setLUTOptions(p.lutOptions);
+                    p.proxy.render->drawVideo(
+                        { videoFrame },
+                        { box },
+                        { p.imageOptions },
+                        { displayOptions },
+                        tl::CompareOptions(),
+                        p.colorBuffer);
+                    p.proxy.render->end();
+                }
+                event.render->drawTexture(p.proxy.buffer->getColorID(), g);
+            }
+        }
+
+        void Viewport::_proxyCancel()
+        {
+            FTK_P();
+            if (p.proxy.request.future.valid())
+            {
+                if (auto context = getContext())
+                {
+                    context->getSystem<tl::ui::ThumbnailSystem>()->cancelRequests(
+                        { p.proxy.request.id });
+                }
+                p.proxy.request = tl::ui::ThumbnailRequest();
+            }
+        }
+
+        void Viewport::_proxyClear()
+        {
+            FTK_P();
+            _proxyCancel();
+            p.proxy.images.clear();
+            if (p.proxy.image)
+            {
+                p.proxy.image.reset();
+                p.proxyImage->setIfChanged(nullptr);
+                setDrawUpdate();
+            }
+        }
+
+        void Viewport::_presentedUpdate()
+        {
+            FTK_P();
+            if (!p.presented.frame || p.presented.future.valid())
+                return;
+            auto frame = p.presented.frame;
+            p.presented.frame.reset();
+
+            // Reduced to no less than the size of the viewport, so that the
+            // frame fitted to the view looks the same. A frame that is not
+            // larger than that is drawn as it is.
+            const ftk::Size2I size = getGeometry().size();
+            const ftk::ImageInfo& info = frame->getInfo();
+            const int factor = size.isValid() ?
+                std::min(info.size.w / size.w, info.size.h / size.h) :
+                1;
+            if (factor < 2)
+            {
+                if (p.presented.image)
+                {
+                    p.presented.image.reset();
+                    setDrawUpdate();
+                }
+                return;
+            }
+            auto task = std::make_shared<std::packaged_task<std::shared_ptr<ftk::Image>()> >(
+                [frame, factor]
+                {
+                    return models::decimateImage(frame, factor);
+                });
+            p.presented.future = task->get_future();
+            p.presented.threadPool->add([task] { (*task)(); });
+        }
+
+        void Viewport::_presentedClear()
+        {
+            FTK_P();
+            p.presented.frame.reset();
+            p.presented.future = std::future<std::shared_ptr<ftk::Image> >();
+            if (p.presented.image)
+            {
+                p.presented.image.reset();
+                setDrawUpdate();
+            }
+        }
+
         void Viewport::_videoUpdate()
         {
             FTK_P();
@@ -1028,6 +1726,13 @@ namespace djv
                         s += ftk::Format(", PAR: {0}").
                             arg(pixelAspectRatio, 2);
                     }
+                    // Playing at a reduced resolution is said, so that the
+                    // softer picture is not taken for the media.
+                    if (p.decimation > 1)
+                    {
+                        s += ftk::Format(", playing at 1/{0}").
+                            arg(p.decimation);
+                    }
                 }
             }
             p.renderLabel->setText(s);
@@ -1122,6 +1827,34 @@ namespace djv
                 cache.push_back(std::string(ftk::Format("{0}% A").
                     arg(static_cast<int>(p.cacheInfo.audioPercentage), 3)));
             }
+            if (!p.ioInfo.video.empty())
+            {
+                // The frames kept compressed, which the video percentage
+                // does not count; they are shared by every file open.
+                if (auto app = p.app.lock())
+                {
+                    const auto stats = app->getFrameCache()->getMemoryCache()->getStats();
+                    if (stats.count > 0 && stats.size > 0)
+                    {
+                        cache.push_back(std::string(ftk::Format("{0} frames compressed {1}:1").
+                            arg(static_cast<int>(stats.count)).
+                            arg(stats.uncompressedSize / static_cast<double>(stats.size), 1)));
+                    }
+                }
+            }
+            if (p.warmUp.active)
+            {
+                // How much of the in/out range is cached while it is warmed
+                // up, and how long is left.
+                std::string warmUp = ftk::Format("{0}% in/out").
+                    arg(static_cast<int>(p.warmUp.percentage), 3);
+                if (p.warmUp.eta.has_value())
+                {
+                    warmUp += ftk::Format(" ETA {0}s").
+                        arg(static_cast<int>(std::ceil(p.warmUp.eta.value())));
+                }
+                cache.push_back(warmUp);
+            }
             s = !cache.empty() ?
                 std::string(ftk::Format("Cache: {0}").arg(ftk::join(cache, ", "))) :
                 std::string();
@@ -1130,6 +1863,20 @@ namespace djv
             ftk::setScreenshotTag(p.cacheLabel, "View.HUD.Cache");
         }
 
+        void Viewport::_sampleRequest()
+        {
+            FTK_P();
+            // The position follows the pointer straight away; the color is
+            // read on the next tick.
+            p.pick->setIfChanged(_toSourcePixel(toRenderPos(p.samplePos->get())));
+            if (Private::Resample::None == p.resample)
+            {
+                p.resample = Private::Resample::Read;
+            }
+            p.statsUpdate = p.statsArea != 1;
+            _hudUpdate();
+        }
+
         void Viewport::_sampleUpdate()
         {
             FTK_P();
@@ -1145,6 +1892,78 @@ namespace djv
             _hudUpdate();
         }
 
+        void Viewport::_statsUpdate()
+        {
+            FTK_P();
+            std::shared_ptr<ftk::Image> image;
+            ftk::Box2I box;
+            if (p.statsArea != 1 && p.picked)
+            {
+                ViewportSample sample;
+                const auto pixel = _toSourcePixel(toRenderPos(p.samplePos->get()), &sample);
+                if (pixel.has_value() && sample.image)
+                {
+                    image = sample.image;
+                    if (p.statsArea > 1)
+                    {
+                        const int r = p.statsArea / 2;
+                        box = ftk::Box2I(
+                            pixel->x - r,
+                            pixel->y - r,
+                            p.statsArea,
+                            p.statsArea);
+                    }
+                    else
+                    {
+                        const ftk::V2I a = p.statsAnchor.value_or(pixel.value());
+                        box = ftk::Box2I(
+                            ftk::V2I(std::min(a.x, pixel->x), std::min(a.y, pixel->y)),
+                            ftk::V2I(std::max(a.x, pixel->x), std::max(a.y, pixel->y)));
+                    }
+                }
+            }
+            if (!image)
+            {
+                // What is still being measured is for a box that is gone.
+                p.statsFuture = std::future<Private::StatsResult>();
+                _statsSet(std::nullopt, std::nullopt);
+                return;
+            }
+            if (p.statsFuture.valid())
+            {
+                // Measured once the one before it is done.
+                p.statsUpdate = true;
+                return;
+            }
+            auto task = std::make_shared<std::packaged_task<Private::StatsResult()> >(
+                [image, box]
+                {
+                    Private::StatsResult out;
+                    const models::ImageStats stats = models::getImageStats(image, box);
+                    if (stats.count > 0)
+                    {
+                        out.box = box;
+                        out.stats = stats;
+                    }
+                    return out;
+                });
+            p.statsFuture = task->get_future();
+            p.statsThreadPool->add([task] { (*task)(); });
+        }
+
+        void Viewport::_statsSet(
+            const std::optional<ftk::Box2I>& box,
+            const std::optional<models::ImageStats>& stats)
+        {
+            FTK_P();
+            p.colorStats->setIfChanged(stats);
+            if (box != p.statsBox)
+            {
+                p.statsBox = box;
+                setDrawUpdate();
+            }
+        }
+
         void Viewport::_toastUpdate()
         {
             FTK_P();
@@ -3,7 +3,9 @@
 
 #pragma once
 
-#include <djv/Models/Export.h>
+#include <djv/App/RenderTiming.h>
+
+#include <djv/Models/ImageUtil.h>
 
 #include <tlRender/UI/Viewport.h>
 
@@ -13,6 +15,25 @@ namespace djv
     {
         class App;
 
+        //! The image under the sample position.
+        struct DJV_API_TYPE ViewportSample
+        {
+            //! The image, which is one layer of the frame.
+            std::shared_ptr<ftk::Image> image;
+
+            //! The index of the file the image belongs to: zero for the A
+            //! file, and one on for the files it is compared with.
+            size_t index = 0;
+
+            //! The pixel of the image the position is over.
+            ftk::V2I pixel;
+
+            //! The size of a pixel of the image at a zoom of one, which is
+            //! wider than it is tall for anamorphic media, and other than
+            //! one for media scaled onto an OTIO canvas.
+            ftk::V2F pixelSize = ftk::V2F(1.F, 1.F);
+        };
+
         //! Viewport.
         class DJV_API_TYPE Viewport : public tl::ui::Viewport
         {
@@ -45,12 +66,46 @@ namespace djv
             //! an image.
             TL_API std::shared_ptr<ftk::IObservable<std::optional<ftk::Color4F> > > observeColorSample() const;
 
+            //! Set the region color statistics are measured over: the size
+            //! of the square of pixels centered on the pick, or zero for a
+            //! box dragged out with the picker from where it was pressed.
+            //! The default of one measures nothing, the color sample being
+            //! all there is to say about one pixel.
+            DJV_API void setColorStatsArea(int);
+
+            //! Observe the color statistics of the region, measured on the
+            //! image data of the frame under the pick and kept up to date
+            //! as it plays. Unset when there is no region.
+            TL_API std::shared_ptr<ftk::IObservable<std::optional<models::ImageStats> > > observeColorStats() const;
+
             //! Sample the image at the given image pixel, as the pick mouse
             //! action would. Used by the documentation screenshot capture.
             DJV_API void pick(const ftk::V2I& imagePos);
 
+            //! Get the image under the sample position and the pixel of it
+            //! the position is over, for drawing the region around it.
+            //! Unset when the position is not over an image.
+            DJV_API std::optional<ViewportSample> getSample() const;
+
             DJV_API void setPlayer(const std::shared_ptr<tl::Player>&) override;
 
+            //! Set a viewport showing the same player to share work with,
+            //! for a second window that presents what the first shows. The
+            //! proxies shown while scrubbing are then taken from it rather
+            //! than read and kept a second time, and it is set as presented
+            //! by this one.
+            DJV_API void setShared(const std::shared_ptr<Viewport>&);
+
+            //! Set whether another window presents what this viewport
+            //! shows. While playing, the frames are then drawn here from a
+            //! reduced copy, so that the full frame is uploaded and color
+            //! transformed once, by the window presenting it.
+            DJV_API void setPresented(bool);
+
+            //! Observe the proxy shown in place of the picture while
+            //! scrubbing.
+            DJV_API std::shared_ptr<ftk::IObservable<std::shared_ptr<ftk::Image> > > observeProxyImage() const;
+
             //! Set whether the toast stands in for the status bar.
             DJV_API void setToastActive(bool);
 
@@ -59,9 +114,16 @@ namespace djv
             //! presentation does not forget what was being shown.
             DJV_API void setHUDActive(bool);
 
+            //! Set whether the drawing is timed. Used by the benchmark.
+            DJV_API void setRenderTimingEnabled(bool);
+
+            //! Take the render timing samples collected since the last call.
+            DJV_API std::vector<RenderSample> takeRenderTimings();
+
             DJV_API ftk::Size2I getSizeHint() const override;
             DJV_API void tickEvent(bool, bool, const ftk::TickEvent&) override;
             DJV_API void drawEvent(const ftk::Box2I&, const ftk::DrawEvent&) override;
+            DJV_API void drawOverlayEvent(const ftk::Box2I&, const ftk::DrawEvent&) override;
             DJV_API void setGeometry(const ftk::Box2I&) override;
             DJV_API void mouseMoveEvent(ftk::MouseMoveEvent&) override;
             DJV_API void mousePressEvent(ftk::MouseClickEvent&) override;
@@ -69,9 +131,25 @@ namespace djv
 
         private:
             bool _getSourceBox(ftk::Box2I&, ftk::Size2I&) const;
-            std::optional<ftk::V2I> _toSourcePixel(const ftk::V2I&) const;
+            std::optional<ftk::V2I> _toSourcePixel(
+                const ftk::V2I&,
+                ViewportSample* = nullptr) const;
             ftk::V2I _fromSourcePixel(const ftk::V2I&) const;
+            void _sampleRequest();
             void _sampleUpdate();
+            void _statsUpdate();
+            void _statsSet(
+                const std::optional<ftk::Box2I>&,
+                const std::optional<models::ImageStats>&);
+            void _proxyUpdate();
+            void _proxyDraw(
+                const std::shared_ptr<ftk::Image>&,
+                const ftk::Box2I&,
+                const ftk::DrawEvent&);
+            void _proxyCancel();
+            void _proxyClear();
+            void _presentedUpdate();
+            void _presentedClear();
             void _videoUpdate();
             void _toastUpdate();
             void _compareUpdate();
@@ -0,0 +1,168 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djv/Models/CacheWarmUpModel.h>
+
+#include <ftk/Core/Format.h>
+
+#include <algorithm>
+#include <cmath>
+#include <list>
+#include <utility>
+
+namespace djv
+{
+    namespace models
+    {
+        namespace
+        {
+            // How far back the fill rate is measured. Long enough to smooth
+            // over frames that arrive in bursts from the read threads,
+            // short enough to follow storage that slows down.
+            const double rateSeconds = 3.0;
+
+            // How much has to be measured before there is a rate to go by.
+            const double rateSecondsMin = .5;
+
+            // How long a full cache has to stop growing before the rest of
+            // the range is given up on. Reads that were in flight when it
+            // filled can still land.
+            const double stallSeconds = 1.0;
+        }
+
+        bool CacheWarmUp::operator == (const CacheWarmUp& other) const
+        {
+            return
+                active == other.active &&
+                play == other.play &&
+                percentage == other.percentage &&
+                eta == other.eta;
+        }
+
+        bool CacheWarmUp::operator != (const CacheWarmUp& other) const
+        {
+            return !(*this == other);
+        }
+
+        std::string getText(const CacheWarmUp& value)
+        {
+            std::string out;
+            if (value.active)
+            {
+                out = ftk::Format("Warming up the cache: {0}%").
+                    arg(static_cast<int>(value.percentage));
+                if (value.eta.has_value())
+                {
+                    const int seconds = static_cast<int>(std::ceil(value.eta.value()));
+                    out += seconds >= 60 ?
+                        std::string(ftk::Format(", {0}m {1}s left").
+                            arg(seconds / 60).
+                            arg(seconds % 60)) :
+                        std::string(ftk::Format(", {0}s left").
+                            arg(seconds));
+                }
+            }
+            return out;
+        }
+
+        struct CacheWarmUpModel::Private
+        {
+            std::list<std::pair<std::chrono::steady_clock::time_point, double> > samples;
+            std::chrono::steady_clock::time_point grown;
+            std::shared_ptr<ftk::Observable<CacheWarmUp> > warmUp;
+        };
+
+        void CacheWarmUpModel::_init()
+        {
+            FTK_P();
+            p.warmUp = ftk::Observable<CacheWarmUp>::create();
+        }
+
+        CacheWarmUpModel::CacheWarmUpModel() :
+            _p(new Private)
+        {}
+
+        CacheWarmUpModel::~CacheWarmUpModel()
+        {}
+
+        std::shared_ptr<CacheWarmUpModel> CacheWarmUpModel::create()
+        {
+            auto out = std::shared_ptr<CacheWarmUpModel>(new CacheWarmUpModel);
+            out->_init();
+            return out;
+        }
+
+        std::shared_ptr<ftk::IObservable<CacheWarmUp> > CacheWarmUpModel::observeWarmUp() const
+        {
+            return _p->warmUp;
+        }
+
+        void CacheWarmUpModel::start(bool play)
+        {
+            FTK_P();
+            p.samples.clear();
+            CacheWarmUp warmUp;
+            warmUp.active = true;
+            warmUp.play = play;
+            p.warmUp->setIfChanged(warmUp);
+        }
+
+        void CacheWarmUpModel::cancel()
+        {
+            FTK_P();
+            p.samples.clear();
+            CacheWarmUp warmUp = p.warmUp->get();
+            warmUp.active = false;
+            warmUp.eta.reset();
+            p.warmUp->setIfChanged(warmUp);
+        }
+
+        bool CacheWarmUpModel::update(
+            double cached,
+            double total,
+            bool full,
+            const std::chrono::steady_clock::time_point& now)
+        {
+            FTK_P();
+            CacheWarmUp warmUp = p.warmUp->get();
+            if (!warmUp.active)
+                return false;
+
+            cached = std::min(std::max(cached, 0.0), total);
+            warmUp.percentage = total > 0.0 ?
+                static_cast<float>(cached / total * 100.0) :
+                100.F;
+
+            if (p.samples.empty() || cached > p.samples.back().second)
+            {
+                p.grown = now;
+            }
+            p.samples.push_back({ now, cached });
+            while (p.samples.size() > 2 &&
+                std::chrono::duration<double>(now - p.samples.front().first).count() > rateSeconds)
+            {
+                p.samples.pop_front();
+            }
+            warmUp.eta.reset();
+            const double seconds = std::chrono::duration<double>(
+                now - p.samples.front().first).count();
+            const double frames = cached - p.samples.front().second;
+            if (seconds >= rateSecondsMin && frames > 0.0)
+            {
+                warmUp.eta = (total - cached) / (frames / seconds);
+            }
+
+            const bool out =
+                cached >= total ||
+                (full && std::chrono::duration<double>(now - p.grown).count() >= stallSeconds);
+            if (out)
+            {
+                p.samples.clear();
+                warmUp.active = false;
+                warmUp.eta.reset();
+            }
+            p.warmUp->setIfChanged(warmUp);
+            return out;
+        }
+    }
+}
@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <djv/Models/Export.h>
+
+#include <ftk/Core/Observable.h>
+#include <ftk/Core/Util.h>
+
+#include <chrono>
+#include <optional>
+#include <string>
+
+namespace djv
+{
+    namespace models
+    {
+        //! Cache warm-up.
+        struct DJV_API_TYPE CacheWarmUp
+        {
+            //! Whether the cache is being filled.
+            bool active = false;
+
+            //! Whether to start playback once the cache is filled.
+            bool play = false;
+
+            //! How much of the range is cached, from zero to one hundred.
+            float percentage = 0.F;
+
+            //! The seconds left, once enough of the range has been read to
+            //! tell how fast it is filling.
+            std::optional<double> eta;
+
+            DJV_API bool operator == (const CacheWarmUp&) const;
+            DJV_API bool operator != (const CacheWarmUp&) const;
+        };
+
+        //! Get the text describing a warm-up in progress, such as
+        //! "Warming up the cache: 40%, 12s left", or nothing when there is
+        //! none.
+        DJV_API std::string getText(const CacheWarmUp&);
+
+        //! Cache warm-up model.
+        //!
+        //! Follows filling the cache over a range before it is played, so
+        //! that the range plays in real time from its first loop rather
+        //! than dropping frames while it is read. Whoever owns the player
+        //! holds playback, starts the warm-up, and updates it with how much
+        //! of the range is cached each time the cache changes; the model
+        //! works out the percentage and how long is left from how fast the
+        //! cache has been filling over the last few seconds, and says when
+        //! the warm-up is finished.
+        class DJV_API_TYPE CacheWarmUpModel : public std::enable_shared_from_this<CacheWarmUpModel>
+        {
+            FTK_NON_COPYABLE(CacheWarmUpModel);
+
+        protected:
+            void _init();
+
+            CacheWarmUpModel();
+
+        public:
+            DJV_API ~CacheWarmUpModel();
+
+            //! Create a new model.
+            DJV_API static std::shared_ptr<CacheWarmUpModel> create();
+
+            //! Observe the warm-up.
+            DJV_API std::shared_ptr<ftk::IObservable<CacheWarmUp> > observeWarmUp() const;
+
+            //! Start a warm-up, and whether to start playback once the
+            //! cache is filled.
+            DJV_API void start(bool play);
+
+            //! Cancel the warm-up.
+            DJV_API void cancel();
+
+            //! Update the warm-up with the frames of the range that are
+            //! cached, the frames in the range, and whether the cache has
+            //! no more room. Returns true when the warm-up has finished:
+            //! the whole range is cached, or the cache is full and has
+            //! stopped growing, so none of the rest will fit.
+            DJV_API bool update(
+                double cached,
+                double total,
+                bool full,
+                const std::chrono::steady_clock::time_point& =
+                    std::chrono::steady_clock::now());
+
+        private:
+            FTK_PRIVATE();
+        };
+    }
+}
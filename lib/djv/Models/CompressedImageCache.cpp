@@ -0,0 +1,483 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djv/Models/CompressedImageCache.h>
+
+#include <djv/Models/FrameBufferPool.h>
+
+#include <algorithm>
+#include <cstring>
+#include <list>
+#include <map>
+#include <mutex>
+
+namespace djv
+{
+    namespace models
+    {
+        namespace
+        {
+            enum class Mode : uint8_t
+            {
+                Raw,
+                Coded
+            };
+
+            struct Layout
+            {
+                size_t wordSize = 1;
+                size_t channels = 1;
+                size_t words = 0;
+                size_t rowWords = 0;
+                size_t tail = 0;
+            };
+
+            // The pixels are taken as words of the channel size, so that the
+            // difference from one value to the next is the difference in
+            // what the value means. Types that do not pack into whole words,
+            // such as 10-bit, are taken a byte at a time; that is still
+            // lossless, only less compressed.
+            Layout getLayout(const ftk::ImageInfo& info, size_t byteCount)
+            {
+                Layout out;
+                switch (ftk::getBitDepth(info.type))
+                {
+                case 16: out.wordSize = 2; break;
+                case 32: out.wordSize = 4; break;
+                default: break;
+                }
+                out.channels = std::max(static_cast<int>(ftk::getChannelCount(info.type)), 1);
+                out.words = byteCount / out.wordSize;
+                out.tail = byteCount - out.words * out.wordSize;
+                const size_t h = info.size.h > 0 ? info.size.h : 1;
+                out.rowWords = 0 == out.words % h ? out.words / h : out.words;
+                if (0 == out.rowWords)
+                {
+                    out.rowWords = 1;
+                }
+                return out;
+            }
+
+            template<typename T>
+            T getWord(const uint8_t* p)
+            {
+                T out;
+                memcpy(&out, p, sizeof(T));
+                return out;
+            }
+
+            // Returns false when the output would not be smaller than the
+            // input, which is then stored as it is.
+            template<typename T>
+            bool encode(
+                const uint8_t* in,
+                const Layout& layout,
+                const std::vector<bool>& constant,
+                uint8_t*& out,
+                const uint8_t* end)
+            {
+                std::vector<T> prev(layout.channels);
+                const size_t rows = layout.words / layout.rowWords;
+                for (size_t y = 0; y < rows; ++y)
+                {
+                    // At most ten bytes are written for one value.
+                    if (end - out < static_cast<std::ptrdiff_t>(layout.rowWords * 10))
+                        return false;
+                    std::fill(prev.begin(), prev.end(), 0);
+                    size_t c = 0;
+                    for (size_t x = 0; x < layout.rowWords; ++x, in += sizeof(T))
+                    {
+                        if (!constant[c])
+                        {
+                            const T v = getWord<T>(in);
+                            const int64_t d = static_cast<int64_t>(v) - static_cast<int64_t>(prev[c]);
+                            prev[c] = v;
+                            // Zig-zag, so that small negative differences are
+                            // small numbers too, then seven bits a byte.
+                            uint64_t z = (static_cast<uint64_t>(d) << 1) ^ static_cast<uint64_t>(d >> 63);
+                            while (z >= 0x80)
+                            {
+                                *out++ = static_cast<uint8_t>(z) | 0x80;
+                                z >>= 7;
+                            }
+                            *out++ = static_cast<uint8_t>(z);
+                        }
+                        if (++c == layout.channels)
+                        {
+                            c = 0;
+                        }
+                    }
+                }
+                return true;
+            }
+
+            template<typename T>
+            bool decode(
+                const uint8_t*& in,
+                const uint8_t* end,
+                const Layout& layout,
+                const std::vector<bool>& constant,
+                const std::vector<T>& values,
+                uint8_t* out)
+            {
+                std::vector<T> prev(layout.channels);
+                const size_t rows = layout.words / layout.rowWords;
+                for (size_t y = 0; y < rows; ++y)
+                {
+                    std::fill(prev.begin(), prev.end(), 0);
+                    size_t c = 0;
+                    for (size_t x = 0; x < layout.rowWords; ++x, out += sizeof(T))
+                    {
+                        T v = values[c];
+                        if (!constant[c])
+                        {
+                            uint64_t z = 0;
+                            int shift = 0;
+                            while (true)
+                            {
+                                if (in >= end || shift > 63)
+                                    return false;
+                                const uint8_t b = *in++;
+                                z |= static_cast<uint64_t>(b & 0x7f) << shift;
+                                if (!(b & 0x80))
+                                    break;
+                                shift += 7;
+                            }
+                            const int64_t d = static_cast<int64_t>(z >> 1) ^ -static_cast<int64_t>(z & 1);
+                            v = static_cast<T>(static_cast<int64_t>(prev[c]) + d);
+                            prev[c] = v;
+                        }
+                        memcpy(out, &v, sizeof(T));
+                        if (++c == layout.channels)
+                        {
+                            c = 0;
+                        }
+                    }
+                }
+                return true;
+            }
+
+            template<typename T>
+            std::vector<uint8_t> compress(const uint8_t* data, size_t byteCount, const Layout& layout)
+            {
+                // Channels that have one value all over. The channels are
+                // counted from the start of each row, as they are coded.
+                std::vector<bool> constant(layout.channels, layout.rowWords >= layout.channels);
+                std::vector<T> values(layout.channels, 0);
+                for (size_t i = 0; i < layout.channels && i < layout.rowWords; ++i)
+                {
+                    values[i] = getWord<T>(data + i * sizeof(T));
+                }
+                const uint8_t* in = data;
+                const size_t rows = layout.words / layout.rowWords;
+                for (size_t y = 0; y < rows; ++y)
+                {
+                    size_t c = 0;
+                    for (size_t x = 0; x < layout.rowWords; ++x, in += sizeof(T))
+                    {
+                        if (constant[c] && getWord<T>(in) != values[c])
+                        {
+                            constant[c] = false;
+                        }
+                        if (++c == layout.channels)
+                        {
+                            c = 0;
+                        }
+                    }
+                }
+
+                std::vector<uint8_t> out(1 + byteCount);
+                uint8_t* p = out.data();
+                const uint8_t* end = p + out.size() - layout.tail;
+                *p++ = static_cast<uint8_t>(Mode::Coded);
+                for (size_t i = 0; i < layout.channels; ++i)
+                {
+                    if (end - p < static_cast<std::ptrdiff_t>(1 + sizeof(T)))
+                        return std::vector<uint8_t>();
+                    *p++ = constant[i] ? 1 : 0;
+                    memcpy(p, &values[i], sizeof(T));
+                    p += sizeof(T);
+                }
+                if (!encode<T>(data, layout, constant, p, end))
+                    return std::vector<uint8_t>();
+                memcpy(p, data + layout.words * sizeof(T), layout.tail);
+                p += layout.tail;
+                out.resize(p - out.data());
+                out.shrink_to_fit();
+                return out;
+            }
+
+            template<typename T>
+            bool decompress(
+                const std::vector<uint8_t>& in,
+                uint8_t* data,
+                size_t byteCount,
+                const Layout& layout)
+            {
+                const uint8_t* p = in.data() + 1;
+                const uint8_t* end = in.data() + in.size();
+                std::vector<bool> constant(layout.channels);
+                std::vector<T> values(layout.channels);
+                for (size_t c = 0; c < layout.channels; ++c)
+                {
+                    if (end - p < static_cast<std::ptrdiff_t>(1 + sizeof(T)))
+                        return false;
+                    constant[c] = *p++ != 0;
+                    values[c] = getWord<T>(p);
+                    p += sizeof(T);
+                }
+                if (!decode<T>(p, end, layout, constant, values, data))
+                    return false;
+                if (end - p != static_cast<std::ptrdiff_t>(layout.tail))
+                    return false;
+                memcpy(data + layout.words * sizeof(T), p, layout.tail);
+                return true;
+            }
+        }
+
+        std::vector<uint8_t> compressImage(const std::shared_ptr<ftk::Image>& image)
+        {
+            std::vector<uint8_t> out;
+            if (image)
+            {
+                const uint8_t* data = image->getData();
+                const size_t byteCount = image->getByteCount();
+                const Layout layout = getLayout(image->getInfo(), byteCount);
+                switch (layout.wordSize)
+                {
+                case 1: out = compress<uint8_t>(data, byteCount, layout); break;
+                case 2: out = compress<uint16_t>(data, byteCount, layout); break;
+                case 4: out = compress<uint32_t>(data, byteCount, layout); break;
+                default: break;
+                }
+                if (out.empty() || out.size() >= byteCount + 1)
+                {
+                    out.resize(byteCount + 1);
+                    out[0] = static_cast<uint8_t>(Mode::Raw);
+                    memcpy(out.data() + 1, data, byteCount);
+                }
+            }
+            return out;
+        }
+
+        bool decompressImage(
+            const std::vector<uint8_t>& in,
+            const std::shared_ptr<ftk::Image>& image)
+        {
+            bool out = false;
+            if (image && !in.empty())
+            {
+                uint8_t* data = image->getData();
+                const size_t byteCount = image->getByteCount();
+                switch (static_cast<Mode>(in[0]))
+                {
+                case Mode::Raw:
+                    if (in.size() == byteCount + 1)
+                    {
+                        memcpy(data, in.data() + 1, byteCount);
+                        out = true;
+                    }
+                    break;
+                case Mode::Coded:
+                {
+                    const Layout layout = getLayout(image->getInfo(), byteCount);
+                    switch (layout.wordSize)
+                    {
+                    case 1: out = decompress<uint8_t>(in, data, byteCount, layout); break;
+                    case 2: out = decompress<uint16_t>(in, data, byteCount, layout); break;
+                    case 4: out = decompress<uint32_t>(in, data, byteCount, layout); break;
+                    default: break;
+                    }
+                    break;
+                }
+                default: break;
+                }
+            }
+            return out;
+        }
+
+        bool CompressedImageCacheStats::operator == (const CompressedImageCacheStats& other) const
+        {
+            return
+                count == other.count &&
+                size == other.size &&
+                uncompressedSize == other.uncompressedSize;
+        }
+
+        bool CompressedImageCacheStats::operator != (const CompressedImageCacheStats& other) const
+        {
+            return !(*this == other);
+        }
+
+        struct CompressedImageCache::Private
+        {
+            struct Entry
+            {
+                std::string key;
+                ftk::ImageInfo info;
+                ftk::ImageTags tags;
+                std::shared_ptr<const std::vector<uint8_t> > data;
+                uint64_t uncompressedSize = 0;
+            };
+            std::shared_ptr<FrameBufferPool> pool;
+            mutable std::mutex mutex;
+            float maxMB = 0.F;
+            std::list<Entry> entries;
+            std::map<std::string, std::list<Entry>::iterator> index;
+            CompressedImageCacheStats stats;
+        };
+
+        void CompressedImageCache::_init(const std::shared_ptr<FrameBufferPool>& pool)
+        {
+            FTK_P();
+            p.pool = pool;
+        }
+
+        CompressedImageCache::CompressedImageCache() :
+            _p(new Private)
+        {}
+
+        CompressedImageCache::~CompressedImageCache()
+        {}
+
+        std::shared_ptr<CompressedImageCache> CompressedImageCache::create(
+            const std::shared_ptr<FrameBufferPool>& pool)
+        {
+            auto out = std::shared_ptr<CompressedImageCache>(new CompressedImageCache);
+            out->_init(pool);
+            return out;
+        }
+
+        void CompressedImageCache::setMaxMB(float value)
+        {
+            FTK_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                if (value == p.maxMB)
+                    return;
+                p.maxMB = value;
+            }
+            _trim();
+        }
+
+        bool CompressedImageCache::isEnabled() const
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.maxMB > 0.F;
+        }
+
+        CompressedImageCacheStats CompressedImageCache::getStats() const
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.stats;
+        }
+
+        bool CompressedImageCache::contains(const std::string& key) const
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.index.find(key) != p.index.end();
+        }
+
+        std::shared_ptr<ftk::Image> CompressedImageCache::get(const std::string& key)
+        {
+            FTK_P();
+            ftk::ImageInfo info;
+            ftk::ImageTags tags;
+            std::shared_ptr<const std::vector<uint8_t> > data;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                const auto i = p.index.find(key);
+                if (i == p.index.end())
+                    return nullptr;
+                p.entries.splice(p.entries.begin(), p.entries, i->second);
+                info = i->second->info;
+                tags = i->second->tags;
+                data = i->second->data;
+            }
+            // Decompressed outside of the lock, so that several threads can
+            // be doing it at once.
+            auto out = p.pool ?
+                p.pool->createImage(info) :
+                ftk::Image::create(info);
+            if (!decompressImage(*data, out))
+                return nullptr;
+            out->setTags(tags);
+            return out;
+        }
+
+        void CompressedImageCache::add(
+            const std::string& key,
+            const std::shared_ptr<ftk::Image>& image)
+        {
+            FTK_P();
+            if (!image)
+                return;
+            {
+                // Compressing takes longer than reading some files, so an
+                // image that is already here is not compressed again.
+                std::unique_lock<std::mutex> lock(p.mutex);
+                if (p.maxMB <= 0.F)
+                    return;
+                const auto i = p.index.find(key);
+                if (i != p.index.end())
+                {
+                    p.entries.splice(p.entries.begin(), p.entries, i->second);
+                    return;
+                }
+            }
+            auto data = std::make_shared<const std::vector<uint8_t> >(compressImage(image));
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                const auto i = p.index.find(key);
+                if (i != p.index.end())
+                {
+                    p.stats.count -= 1;
+                    p.stats.size -= i->second->data->size();
+                    p.stats.uncompressedSize -= i->second->uncompressedSize;
+                    p.entries.erase(i->second);
+                    p.index.erase(i);
+                }
+                Private::Entry entry;
+                entry.key = key;
+                entry.info = image->getInfo();
+                entry.tags = image->getTags();
+                entry.data = data;
+                entry.uncompressedSize = image->getByteCount();
+                p.entries.push_front(entry);
+                p.index[key] = p.entries.begin();
+                p.stats.count += 1;
+                p.stats.size += data->size();
+                p.stats.uncompressedSize += entry.uncompressedSize;
+            }
+            _trim();
+        }
+
+        void CompressedImageCache::clear()
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.entries.clear();
+            p.index.clear();
+            p.stats = CompressedImageCacheStats();
+        }
+
+        void CompressedImageCache::_trim()
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            const uint64_t max = static_cast<uint64_t>(p.maxMB * 1024.0 * 1024.0);
+            while (!p.entries.empty() && p.stats.size > max)
+            {
+                const auto& entry = p.entries.back();
+                p.stats.count -= 1;
+                p.stats.size -= entry.data->size();
+                p.stats.uncompressedSize -= entry.uncompressedSize;
+                p.index.erase(entry.key);
+                p.entries.pop_back();
+            }
+        }
+    }
+}
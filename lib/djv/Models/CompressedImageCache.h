@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <djv/Models/Export.h>
+
+#include <ftk/Core/Image.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace djv
+{
+    namespace models
+    {
+        //! Compress the pixels of an image, losslessly.
+        //!
+        //! The codec is made to be fast rather than small, since frames are
+        //! decompressed during playback: a channel that is the same all
+        //! over, such as the alpha of an opaque plate, is stored once, and
+        //! the rest is stored as the difference of each value from the one
+        //! to its left, in as few bytes as the difference needs. Photographic
+        //! half float and 16-bit images come out at around half their size.
+        //! Pixels that do not get smaller are stored as they are.
+        DJV_API std::vector<uint8_t> compressImage(const std::shared_ptr<ftk::Image>&);
+
+        //! Decompress the pixels of an image into an image created with the
+        //! same information. Returns false when the data is not valid.
+        DJV_API bool decompressImage(
+            const std::vector<uint8_t>&,
+            const std::shared_ptr<ftk::Image>&);
+
+        class FrameBufferPool;
+
+        //! Compressed image cache statistics.
+        struct DJV_API_TYPE CompressedImageCacheStats
+        {
+            size_t count = 0;
+            uint64_t size = 0;
+            uint64_t uncompressedSize = 0;
+
+            DJV_API bool operator == (const CompressedImageCacheStats&) const;
+            DJV_API bool operator != (const CompressedImageCacheStats&) const;
+        };
+
+        //! Compressed image cache.
+        //!
+        //! Keeps images in memory compressed with compressImage(), so that
+        //! more of a sequence fits in the same memory; a 4K half float
+        //! frame is 64 megabytes as it is. Images are compressed when they
+        //! are added and decompressed when they are got, on the calling
+        //! thread, so that the work is spread over the threads that read
+        //! the frames. The least recently used images are removed once the
+        //! cache is bigger than its maximum size.
+        //!
+        //! The cache may be used from any thread.
+        class DJV_API_TYPE CompressedImageCache : public std::enable_shared_from_this<CompressedImageCache>
+        {
+            FTK_NON_COPYABLE(CompressedImageCache);
+
+        protected:
+            void _init(const std::shared_ptr<FrameBufferPool>&);
+
+            CompressedImageCache();
+
+        public:
+            DJV_API ~CompressedImageCache();
+
+            //! Create a new cache. Images are decompressed into the pool
+            //! when one is given.
+            DJV_API static std::shared_ptr<CompressedImageCache> create(
+                const std::shared_ptr<FrameBufferPool>& = nullptr);
+
+            //! Set the maximum size in megabytes. Zero turns the cache off.
+            DJV_API void setMaxMB(float);
+
+            //! Get whether the cache is on.
+            DJV_API bool isEnabled() const;
+
+            //! Get the statistics.
+            DJV_API CompressedImageCacheStats getStats() const;
+
+            //! Get whether there is an image, without decompressing it.
+            DJV_API bool contains(const std::string& key) const;
+
+            //! Get an image, or nothing when there is none.
+            DJV_API std::shared_ptr<ftk::Image> get(const std::string& key);
+
+            //! Add an image.
+            DJV_API void add(
+                const std::string& key,
+                const std::shared_ptr<ftk::Image>&);
+
+            //! Remove every image.
+            DJV_API void clear();
+
+        private:
+            void _trim();
+
+            FTK_PRIVATE();
+        };
+    }
+}
@@ -4,17 +4,48 @@
 #include <djv/Models/FilesModel.h>
 
 #include <ftk/UI/Settings.h>
+#include <ftk/Core/Error.h>
 #include <ftk/Core/Math.h>
+#include <ftk/Core/String.h>
+
+#include <sstream>
+#include <unordered_map>
 
 namespace djv
 {
     namespace models
     {
+        FTK_ENUM_IMPL(
+            FilesModelChangeType,
+            "Added",
+            "Removed",
+            "Moved",
+            "Changed");
+
+        bool FilesModelChange::operator == (const FilesModelChange& other) const
+        {
+            return
+                type == other.type &&
+                item == other.item &&
+                index == other.index &&
+                prevIndex == other.prevIndex;
+        }
+
+        bool FilesModelChange::operator != (const FilesModelChange& other) const
+        {
+            return !(*this == other);
+        }
+
         struct FilesModel::Private
         {
             std::shared_ptr<ftk::Settings> settings;
 
+            uint64_t nextID = 1;
+            // Where each file is in the list, by its ID.
+            std::unordered_map<uint64_t, size_t> index;
+
             std::shared_ptr<ftk::ObservableList<std::shared_ptr<FilesModelItem> > > files;
+            std::shared_ptr<ftk::ObservableList<FilesModelChange> > changes;
             std::shared_ptr<ftk::Observable<std::shared_ptr<FilesModelItem> > > a;
             std::shared_ptr<ftk::Observable<int> > aIndex;
             std::shared_ptr<ftk::ObservableList<std::shared_ptr<FilesModelItem> > > b;
@@ -33,6 +64,7 @@ namespace djv
             p.settings = settings;
 
             p.files = ftk::ObservableList<std::shared_ptr<FilesModelItem> >::create();
+            p.changes = ftk::ObservableList<FilesModelChange>::create();
             p.a = ftk::Observable<std::shared_ptr<FilesModelItem> >::create();
             p.reload = ftk::Observable<std::shared_ptr<FilesModelItem> >::create();
             p.aIndex = ftk::Observable<int>::create();
@@ -89,6 +121,18 @@ namespace djv
             return _p->files;
         }
 
+        std::shared_ptr<ftk::IObservableList<FilesModelChange> > FilesModel::observeChanges() const
+        {
+            return _p->changes;
+        }
+
+        std::shared_ptr<FilesModelItem> FilesModel::getItem(uint64_t id) const
+        {
+            FTK_P();
+            const auto i = p.index.find(id);
+            return i != p.index.end() ? p.files->getItem(i->second) : nullptr;
+        }
+
         const std::shared_ptr<FilesModelItem>& FilesModel::getA() const
         {
             return _p->a->get();
@@ -143,10 +187,39 @@ namespace djv
         {
             FTK_P();
 
+            const int index = static_cast<int>(p.files->getSize());
+            item->id = p.nextID++;
+            p.index[item->id] = index;
             p.files->pushBack(item);
+            p.changes->setAlways({ { FilesModelChangeType::Added, item, index } });
 
             p.a->setIfChanged(p.files->getItem(p.files->getSize() - 1));
-            p.aIndex->setIfChanged(_getIndex(p.a->get()));
+            p.aIndex->setIfChanged(getIndex(p.a->get()));
+
+            p.active->setIfChanged(_getActive());
+            p.layers->setIfChanged(_getLayers());
+        }
+
+        void FilesModel::add(const std::vector<std::shared_ptr<FilesModelItem> >& items)
+        {
+            FTK_P();
+            if (items.empty())
+                return;
+
+            auto files = p.files->get();
+            std::vector<FilesModelChange> changes;
+            for (const auto& item : items)
+            {
+                item->id = p.nextID++;
+                p.index[item->id] = files.size();
+                changes.push_back({ FilesModelChangeType::Added, item, static_cast<int>(files.size()) });
+                files.push_back(item);
+            }
+            p.files->setIfChanged(files);
+            p.changes->setAlways(changes);
+
+            p.a->setIfChanged(items.back());
+            p.aIndex->setIfChanged(getIndex(p.a->get()));
 
             p.active->setIfChanged(_getActive());
             p.layers->setIfChanged(_getLayers());
@@ -157,7 +230,7 @@ namespace djv
             FTK_P();
             if (p.a->get())
             {
-                close(_getIndex(p.a->get()));
+                close(getIndex(p.a->get()));
             }
         }
 
@@ -167,24 +240,27 @@ namespace djv
             auto files = p.files->get();
             if (index >= 0 && index < static_cast<int>(files.size()))
             {
-                const int aPrevIndex = _getIndex(p.a->get());
+                const int aPrevIndex = getIndex(p.a->get());
 
+                const auto item = files[index];
                 files.erase(files.begin() + index);
+                p.index.erase(item->id);
+                _reindex(files, index);
                 p.files->setIfChanged(files);
+                p.changes->setAlways({ { FilesModelChangeType::Removed, item, index } });
 
                 if (aPrevIndex == index)
                 {
                     const int aNewIndex = ftk::clamp(aPrevIndex, 0, static_cast<int>(files.size()) - 1);
                     p.a->setIfChanged(aNewIndex != -1 ? files[aNewIndex] : nullptr);
                 }
-                p.aIndex->setIfChanged(_getIndex(p.a->get()));
+                p.aIndex->setIfChanged(getIndex(p.a->get()));
 
                 auto b = p.b->get();
                 auto j = b.begin();
                 while (j != b.end())
                 {
-                    const auto k = std::find(files.begin(), files.end(), *j);
-                    if (k == files.end())
+                    if (-1 == getIndex(*j))
                     {
                         j = b.erase(j);
                     }
@@ -212,7 +288,17 @@ namespace djv
         {
             FTK_P();
 
+            // From the end, so that each index is still right when the
+            // changes are applied in order.
+            std::vector<FilesModelChange> changes;
+            const auto& files = p.files->get();
+            for (int i = static_cast<int>(files.size()) - 1; i >= 0; --i)
+            {
+                changes.push_back({ FilesModelChangeType::Removed, files[i], i });
+            }
+            p.index.clear();
             p.files->clear();
+            p.changes->setAlways(changes);
 
             p.a->setIfChanged(nullptr);
             p.aIndex->setIfChanged(-1);
@@ -224,14 +310,36 @@ namespace djv
             p.layers->setIfChanged(_getLayers());
         }
 
+        void FilesModel::move(int index, int newIndex)
+        {
+            FTK_P();
+            const int size = static_cast<int>(p.files->getSize());
+            if (index >= 0 && index < size &&
+                newIndex >= 0 && newIndex < size &&
+                index != newIndex)
+            {
+                auto files = p.files->get();
+                const auto item = files[index];
+                files.erase(files.begin() + index);
+                files.insert(files.begin() + newIndex, item);
+                _reindex(files, std::min(index, newIndex));
+                p.files->setIfChanged(files);
+                p.changes->setAlways({ { FilesModelChangeType::Moved, item, newIndex, index } });
+
+                p.aIndex->setIfChanged(getIndex(p.a->get()));
+                p.bIndexes->setIfChanged(_getBIndexes());
+                p.layers->setIfChanged(_getLayers());
+            }
+        }
+
         void FilesModel::setA(int index)
         {
             FTK_P();
-            const int prevIndex = _getIndex(p.a->get());
+            const int prevIndex = getIndex(p.a->get());
             if (index >= 0 && index < static_cast<int>(p.files->getSize()) && index != prevIndex)
             {
                 p.a->setIfChanged(p.files->getItem(index));
-                p.aIndex->setIfChanged(_getIndex(p.a->get()));
+                p.aIndex->setIfChanged(getIndex(p.a->get()));
 
                 p.active->setIfChanged(_getActive());
                 p.layers->setIfChanged(_getLayers());
@@ -305,11 +413,11 @@ namespace djv
         void FilesModel::first()
         {
             FTK_P();
-            const int prevIndex = _getIndex(p.a->get());
+            const int prevIndex = getIndex(p.a->get());
             if (!p.files->isEmpty() && prevIndex != 0)
             {
                 p.a->setIfChanged(p.files->getItem(0));
-                p.aIndex->setIfChanged(_getIndex(p.a->get()));
+                p.aIndex->setIfChanged(getIndex(p.a->get()));
 
                 p.active->setIfChanged(_getActive());
                 p.layers->setIfChanged(_getLayers());
@@ -320,11 +428,11 @@ namespace djv
         {
             FTK_P();
             const int index = static_cast<int>(p.files->getSize()) - 1;
-            const int prevIndex = _getIndex(p.a->get());
+            const int prevIndex = getIndex(p.a->get());
             if (!p.files->isEmpty() && index != prevIndex)
             {
                 p.a->setIfChanged(p.files->getItem(index));
-                p.aIndex->setIfChanged(_getIndex(p.a->get()));
+                p.aIndex->setIfChanged(getIndex(p.a->get()));
 
                 p.active->setIfChanged(_getActive());
                 p.layers->setIfChanged(_getLayers());
@@ -336,14 +444,14 @@ namespace djv
             FTK_P();
             if (!p.files->isEmpty())
             {
-                const int prevIndex = _getIndex(p.a->get());
+                const int prevIndex = getIndex(p.a->get());
                 int index = prevIndex + 1;
                 if (index >= static_cast<int>(p.files->getSize()))
                 {
                     index = 0;
                 }
                 p.a->setIfChanged(p.files->getItem(index));
-                p.aIndex->setIfChanged(_getIndex(p.a->get()));
+                p.aIndex->setIfChanged(getIndex(p.a->get()));
 
                 p.active->setIfChanged(_getActive());
                 p.layers->setIfChanged(_getLayers());
@@ -355,14 +463,14 @@ namespace djv
             FTK_P();
             if (!p.files->isEmpty())
             {
-                const int prevIndex = _getIndex(p.a->get());
+                const int prevIndex = getIndex(p.a->get());
                 int index = prevIndex - 1;
                 if (index < 0)
                 {
                     index = p.files->getSize() - 1;
                 }
                 p.a->setIfChanged(p.files->getItem(index));
-                p.aIndex->setIfChanged(_getIndex(p.a->get()));
+                p.aIndex->setIfChanged(getIndex(p.a->get()));
 
                 p.active->setIfChanged(_getActive());
                 p.layers->setIfChanged(_getLayers());
@@ -461,7 +569,7 @@ namespace djv
             const ftk::RangeI64& value)
         {
             FTK_P();
-            const int index = _getIndex(item);
+            const int index = getIndex(item);
             if (index != -1)
             {
                 const auto& file = p.files->getItem(index);
@@ -502,10 +610,40 @@ namespace djv
             }
         }
 
+        void FilesModel::setWatch(
+            const std::shared_ptr<FilesModelItem>& item,
+            bool value)
+        {
+            FTK_P();
+            const int index = getIndex(item);
+            if (index != -1 && value != item->watch)
+            {
+                item->watch = value;
+                refresh(item);
+            }
+        }
+
         void FilesModel::refresh()
         {
             FTK_P();
             p.files->setAlways(p.files->get());
+            std::vector<FilesModelChange> changes;
+            const auto& files = p.files->get();
+            for (size_t i = 0; i < files.size(); ++i)
+            {
+                changes.push_back({ FilesModelChangeType::Changed, files[i], static_cast<int>(i) });
+            }
+            p.changes->setAlways(changes);
+        }
+
+        void FilesModel::refresh(const std::shared_ptr<FilesModelItem>& item)
+        {
+            FTK_P();
+            const int index = getIndex(item);
+            if (index != -1)
+            {
+                p.changes->setAlways({ { FilesModelChangeType::Changed, item, index } });
+            }
         }
 
         std::shared_ptr<ftk::IObservable<std::shared_ptr<FilesModelItem> > > FilesModel::observeReload() const
@@ -516,7 +654,7 @@ namespace djv
         void FilesModel::setLayer(const std::shared_ptr<FilesModelItem>& item, int layer)
         {
             FTK_P();
-            const int index = _getIndex(item);
+            const int index = getIndex(item);
             if (index != -1 && layer >= 0)
             {
                 const auto& file = p.files->getItem(index);
@@ -532,7 +670,7 @@ namespace djv
         void FilesModel::nextLayer()
         {
             FTK_P();
-            const int index = _getIndex(p.a->get());
+            const int index = getIndex(p.a->get());
             if (index != -1)
             {
                 auto item = p.files->getItem(index);
@@ -549,7 +687,7 @@ namespace djv
         void FilesModel::prevLayer()
         {
             FTK_P();
-            const int index = _getIndex(p.a->get());
+            const int index = getIndex(p.a->get());
             if (index != -1)
             {
                 auto item = p.files->getItem(index);
@@ -611,7 +749,7 @@ namespace djv
                 {
                     if (b.empty() && p.files->getSize() > 1)
                     {
-                        int index = _getIndex(p.a->get());
+                        int index = getIndex(p.a->get());
                         if (index != -1)
                         {
                             index = index - 1;
@@ -652,11 +790,32 @@ namespace djv
             p.compareTime->setIfChanged(value);
         }
 
-        int FilesModel::_getIndex(const std::shared_ptr<FilesModelItem>& item) const
+        int FilesModel::getIndex(const std::shared_ptr<FilesModelItem>& item) const
         {
             FTK_P();
-            const size_t index = p.files->indexOf(item);
-            return index != ftk::ObservableListInvalidIndex ? index : -1;
+            int out = -1;
+            if (item)
+            {
+                const auto i = p.index.find(item->id);
+                if (i != p.index.end() && p.files->getItem(i->second) == item)
+                {
+                    out = static_cast<int>(i->second);
+                }
+            }
+            return out;
+        }
+
+        void FilesModel::_reindex(
+            const std::vector<std::shared_ptr<FilesModelItem> >& files,
+            size_t index)
+        {
+            FTK_P();
+            // Before the list is announced, so that whoever observes it
+            // can look the files up.
+            for (size_t i = index; i < files.size(); ++i)
+            {
+                p.index[files[i]->id] = i;
+            }
         }
 
         std::vector<int> FilesModel::_getBIndexes() const
@@ -665,7 +824,7 @@ namespace djv
             std::vector<int> out;
             for (const auto& b : p.b->get())
             {
-                out.push_back(_getIndex(b));
+                out.push_back(getIndex(b));
             }
             return out;
         }
@@ -23,6 +23,11 @@ namespace djv
         //! Files model item.
         struct DJV_API_TYPE FilesModelItem
         {
+            //! Given by the model when the item is added, and not used again
+            //! for another item while the model lasts, so that the item can
+            //! be looked up without searching the list for it.
+            uint64_t                 id          = 0;
+
             ftk::Path                path;
             ftk::Path                audioPath;
 
@@ -48,10 +53,51 @@ namespace djv
             //! since last time are picked up.
             bool                     framesStated = false;
 
+            //! Whether the image sequence is watched for new frames, such as
+            //! a render in progress.
+            bool                     watch = false;
+
             bool                     newFile = true;
         };
 
+        //! Files model change types.
+        enum class DJV_API_TYPE FilesModelChangeType
+        {
+            Added,
+            Removed,
+            Moved,
+            Changed,
+
+            Count,
+            First = Added
+        };
+        FTK_ENUM(FilesModelChangeType);
+
+        //! A change to the files. The changes are listed in the order they
+        //! were made, and each index is where the item is once the changes
+        //! before it have been made, so they can be applied to a copy of
+        //! the list one after the other.
+        struct DJV_API_TYPE FilesModelChange
+        {
+            FilesModelChangeType             type  = FilesModelChangeType::Changed;
+            std::shared_ptr<FilesModelItem>  item;
+
+            //! Where the item is, or was for one that was removed.
+            int                              index = -1;
+
+            //! Where an item that was moved was.
+            int                              prevIndex = -1;
+
+            DJV_API bool operator == (const FilesModelChange&) const;
+            DJV_API bool operator != (const FilesModelChange&) const;
+        };
+
         //! Files model.
+        //!
+        //! The files are announced both as the whole list and as the changes
+        //! that were made to it. Sessions can hold a thousand files or more,
+        //! so what shows one row per file follows the changes rather than
+        //! making every row again each time a file is opened or closed.
         class DJV_API_TYPE FilesModel : public std::enable_shared_from_this<FilesModel>
         {
             FTK_NON_COPYABLE(FilesModel);
@@ -74,6 +120,17 @@ namespace djv
             //! Observe the files.
             DJV_API std::shared_ptr<ftk::IObservableList<std::shared_ptr<FilesModelItem> > > observeFiles() const;
 
+            //! Observe the changes to the files. Announced after the list of
+            //! files, each time something changes, with what changed.
+            DJV_API std::shared_ptr<ftk::IObservableList<FilesModelChange> > observeChanges() const;
+
+            //! Get the index of a file, or -1 when it is not one of the
+            //! files.
+            DJV_API int getIndex(const std::shared_ptr<FilesModelItem>&) const;
+
+            //! Get a file by its ID, or nothing when there is none.
+            DJV_API std::shared_ptr<FilesModelItem> getItem(uint64_t id) const;
+
             //! Get the "A" file.
             DJV_API const std::shared_ptr<FilesModelItem>& getA() const;
 
@@ -109,6 +166,12 @@ namespace djv
             //! Add a file.
             DJV_API void add(const std::shared_ptr<FilesModelItem>&);
 
+            //! Add several files at once. The last becomes the "A" file, as
+            //! though they had been added one after the other, but the files
+            //! are only observed to change once, so that the application can
+            //! open them all together.
+            DJV_API void add(const std::vector<std::shared_ptr<FilesModelItem> >&);
+
             //! Close the current "A" file.
             DJV_API void close();
 
@@ -118,6 +181,9 @@ namespace djv
             //! Close all the files.
             DJV_API void closeAll();
 
+            //! Move a file to a new index.
+            DJV_API void move(int index, int newIndex);
+
             //! Set the "A" file.
             DJV_API void setA(int index);
 
@@ -169,6 +235,11 @@ namespace djv
                 const std::shared_ptr<FilesModelItem>&,
                 const ftk::RangeI64&);
 
+            //! Set whether an image sequence is watched for new frames.
+            DJV_API void setWatch(
+                const std::shared_ptr<FilesModelItem>&,
+                bool);
+
             //! Observe files that have to be reopened.
             DJV_API std::shared_ptr<ftk::IObservable<std::shared_ptr<FilesModelItem> > > observeReload() const;
 
@@ -179,6 +250,10 @@ namespace djv
             //! does not change when they are, so nothing else says so.
             DJV_API void refresh();
 
+            //! Announce a change to what one item holds. Only the change is
+            //! announced; the list of files is not, since it is the same.
+            DJV_API void refresh(const std::shared_ptr<FilesModelItem>&);
+
             //! Set the "A" file to the next layer.
             DJV_API void nextLayer();
 
@@ -204,7 +279,9 @@ namespace djv
             DJV_API void setCompareTime(tl::CompareTime);
 
         private:
-            int _getIndex(const std::shared_ptr<FilesModelItem>&) const;
+            void _reindex(
+                const std::vector<std::shared_ptr<FilesModelItem> >&,
+                size_t);
             std::vector<int> _getBIndexes() const;
             std::vector<std::shared_ptr<FilesModelItem> > _getActive() const;
             std::vector<int> _getLayers() const;
@@ -0,0 +1,270 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djv/Models/FrameBufferPool.h>
+
+#include <list>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#if defined(_WINDOWS)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif // WIN32_LEAN_AND_MEAN
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // NOMINMAX
+#include <windows.h>
+#else // _WINDOWS
+#include <sys/mman.h>
+#endif // _WINDOWS
+
+namespace djv
+{
+    namespace models
+    {
+        namespace
+        {
+            // Smaller images are left to the allocator, which is quick
+            // enough with them and keeps them in its own pools anyway.
+            const size_t minSize = 1024 * 1024;
+
+            // Transparent huge pages are only used for mappings at least
+            // this big.
+            const size_t hugePageSize = 2 * 1024 * 1024;
+
+            // Quarter steps between powers of two, so a buffer is at most a
+            // quarter bigger than it was asked for.
+            size_t getSizeClass(size_t size)
+            {
+                size_t power = minSize;
+                while (power * 2 < size)
+                {
+                    power *= 2;
+                }
+                const size_t step = power / 4;
+                return (size + step - 1) / step * step;
+            }
+
+            void* map(size_t size)
+            {
+#if defined(_WINDOWS)
+                return VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else // _WINDOWS
+                void* out = mmap(
+                    nullptr,
+                    size,
+                    PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS,
+                    -1,
+                    0);
+                if (MAP_FAILED == out)
+                    return nullptr;
+#if defined(__linux__)
+                // Only a hint: the kernel falls back to normal pages when
+                // it has no huge ones to give, or they are turned off.
+                if (size >= hugePageSize)
+                {
+                    madvise(out, size, MADV_HUGEPAGE);
+                }
+#endif // __linux__
+                return out;
+#endif // _WINDOWS
+            }
+
+            void unmap(void* data, size_t size)
+            {
+#if defined(_WINDOWS)
+                VirtualFree(data, 0, MEM_RELEASE);
+#else // _WINDOWS
+                munmap(data, size);
+#endif // _WINDOWS
+            }
+        }
+
+        bool FrameBufferPoolStats::operator == (const FrameBufferPoolStats& other) const
+        {
+            return
+                used == other.used &&
+                free == other.free &&
+                released == other.released &&
+                hits == other.hits &&
+                misses == other.misses;
+        }
+
+        bool FrameBufferPoolStats::operator != (const FrameBufferPoolStats& other) const
+        {
+            return !(*this == other);
+        }
+
+        struct FrameBufferPool::Private
+        {
+            struct Buffer
+            {
+                void* data = nullptr;
+                size_t size = 0;
+            };
+            mutable std::mutex mutex;
+            float maxFreeMB = 512.F;
+            // The most recently returned at the front.
+            std::list<Buffer> free;
+            FrameBufferPoolStats stats;
+        };
+
+        FrameBufferPool::FrameBufferPool() :
+            _p(new Private)
+        {}
+
+        FrameBufferPool::~FrameBufferPool()
+        {
+            FTK_P();
+            // Images still in use give their memory straight back to the
+            // system when they are let go of.
+            for (const auto& buffer : p.free)
+            {
+                unmap(buffer.data, buffer.size);
+            }
+        }
+
+        std::shared_ptr<FrameBufferPool> FrameBufferPool::create()
+        {
+            return std::shared_ptr<FrameBufferPool>(new FrameBufferPool);
+        }
+
+        void FrameBufferPool::setMaxFreeMB(float value)
+        {
+            FTK_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                if (value == p.maxFreeMB)
+                    return;
+                p.maxFreeMB = value;
+            }
+            _trim();
+        }
+
+        FrameBufferPoolStats FrameBufferPool::getStats() const
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.stats;
+        }
+
+        std::shared_ptr<ftk::Image> FrameBufferPool::createImage(const ftk::ImageInfo& info)
+        {
+            FTK_P();
+            const size_t byteCount = info.getByteCount();
+            if (byteCount < minSize)
+                return ftk::Image::create(info);
+
+            const size_t size = getSizeClass(byteCount);
+            void* data = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                for (auto i = p.free.begin(); i != p.free.end(); ++i)
+                {
+                    if (size == i->size)
+                    {
+                        data = i->data;
+                        p.free.erase(i);
+                        p.stats.free -= size;
+                        break;
+                    }
+                }
+                if (data)
+                {
+                    ++p.stats.hits;
+                }
+                else
+                {
+                    ++p.stats.misses;
+                }
+            }
+            if (!data)
+            {
+                data = map(size);
+                if (!data)
+                    return ftk::Image::create(info);
+            }
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.stats.used += size;
+            }
+
+            std::weak_ptr<FrameBufferPool> weak(shared_from_this());
+            std::shared_ptr<uint8_t> buffer(
+                static_cast<uint8_t*>(data),
+                [weak, size](uint8_t* value)
+                {
+                    if (auto pool = weak.lock())
+                    {
+                        pool->_return(value, size);
+                    }
+                    else
+                    {
+                        unmap(value, size);
+                    }
+                });
+            auto image = ftk::Image::create(info, buffer.get());
+
+            // The image does not own its data, so what is handed out holds
+            // on to both, and lets go of the image first.
+            auto holder = std::make_shared<std::pair<
+                std::shared_ptr<uint8_t>,
+                std::shared_ptr<ftk::Image> > >(buffer, image);
+            return std::shared_ptr<ftk::Image>(holder, image.get());
+        }
+
+        void FrameBufferPool::release()
+        {
+            FTK_P();
+            std::list<Private::Buffer> free;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                free.swap(p.free);
+                p.stats.released += p.stats.free;
+                p.stats.free = 0;
+            }
+            for (const auto& buffer : free)
+            {
+                unmap(buffer.data, buffer.size);
+            }
+        }
+
+        void FrameBufferPool::_return(void* data, size_t size)
+        {
+            FTK_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.stats.used -= size;
+                p.free.push_front({ data, size });
+                p.stats.free += size;
+            }
+            _trim();
+        }
+
+        void FrameBufferPool::_trim()
+        {
+            FTK_P();
+            // Unmapped outside of the lock, which is not quick for large
+            // buffers.
+            std::vector<Private::Buffer> buffers;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                const uint64_t maxFree = static_cast<uint64_t>(p.maxFreeMB * 1024.0 * 1024.0);
+                while (p.stats.free > maxFree && !p.free.empty())
+                {
+                    buffers.push_back(p.free.back());
+                    p.free.pop_back();
+                    p.stats.free -= buffers.back().size;
+                    p.stats.released += buffers.back().size;
+                }
+            }
+            for (const auto& buffer : buffers)
+            {
+                unmap(buffer.data, buffer.size);
+            }
+        }
+    }
+}
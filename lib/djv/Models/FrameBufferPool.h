@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <djv/Models/Export.h>
+
+#include <ftk/Core/Image.h>
+
+#include <cstdint>
+#include <memory>
+
+namespace djv
+{
+    namespace models
+    {
+        //! Frame buffer pool statistics.
+        struct DJV_API_TYPE FrameBufferPoolStats
+        {
+            //! Bytes in images that have been handed out.
+            uint64_t used = 0;
+
+            //! Bytes kept for the next images.
+            uint64_t free = 0;
+
+            //! Bytes given back to the system since the pool was created.
+            uint64_t released = 0;
+
+            //! Images whose memory was reused, and those that needed new
+            //! memory.
+            size_t hits = 0;
+            size_t misses = 0;
+
+            DJV_API bool operator == (const FrameBufferPoolStats&) const;
+            DJV_API bool operator != (const FrameBufferPoolStats&) const;
+        };
+
+        //! Frame buffer pool.
+        //!
+        //! Keeps the memory of large images once they are let go of, and
+        //! hands it out again for the next image of about the same size,
+        //! rather than each frame allocating and freeing several megabytes.
+        //! Sizes are rounded up to a quarter of a power of two, so that
+        //! frames of the same format share memory and a buffer is never
+        //! much bigger than it needs to be.
+        //!
+        //! The memory is mapped from the system directly, in huge pages on
+        //! Linux when the kernel has them, so that it is given back as soon
+        //! as the pool lets go of it rather than whenever the allocator gets
+        //! round to it. The pool keeps up to a maximum of memory that is not
+        //! in use, the least recently used first to go, and gives the rest
+        //! back straight away.
+        //!
+        //! Images smaller than a megabyte are allocated as usual. The pool
+        //! may be used from any thread.
+        class DJV_API_TYPE FrameBufferPool : public std::enable_shared_from_this<FrameBufferPool>
+        {
+            FTK_NON_COPYABLE(FrameBufferPool);
+
+        protected:
+            FrameBufferPool();
+
+        public:
+            DJV_API ~FrameBufferPool();
+
+            //! Create a new pool.
+            DJV_API static std::shared_ptr<FrameBufferPool> create();
+
+            //! Set the most memory kept that is not in use, in megabytes.
+            DJV_API void setMaxFreeMB(float);
+
+            //! Get the statistics.
+            DJV_API FrameBufferPoolStats getStats() const;
+
+            //! Create an image. The memory goes back to the pool when the
+            //! last reference to the image is let go of.
+            DJV_API std::shared_ptr<ftk::Image> createImage(const ftk::ImageInfo&);
+
+            //! Give the memory that is not in use back to the system.
+            DJV_API void release();
+
+        private:
+            void _return(void*, size_t);
+            void _trim();
+
+            FTK_PRIVATE();
+        };
+    }
+}
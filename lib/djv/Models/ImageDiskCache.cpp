@@ -0,0 +1,454 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djv/Models/ImageDiskCache.h>
+
+#include <djv/Models/FrameBufferPool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <vector>
+
+namespace djv
+{
+    namespace models
+    {
+        namespace
+        {
+            const std::string magic = "djvImage3";
+            const std::string fileExt = ".image";
+
+            // Trimmed to a little under the maximum, so that the files are
+            // not listed again for every image added after that.
+            const double trimRatio = .9;
+
+            std::filesystem::path getFileName(
+                const std::filesystem::path& dir,
+                const std::string& key)
+            {
+                std::stringstream ss;
+                ss << std::hex << std::hash<std::string>()(key);
+                return dir / (ss.str() + fileExt);
+            }
+
+            // A temporary file name that no other writer uses: other
+            // instances may be writing into the same directory, and thread
+            // IDs are only unique within a process, so the process is
+            // picked out by a random number instead.
+            std::filesystem::path getTmpFileName(const std::filesystem::path& fileName)
+            {
+                static const uint64_t process = []
+                {
+                    std::random_device rd;
+                    return (static_cast<uint64_t>(rd()) << 32) | rd();
+                }();
+                static std::atomic<uint64_t> count(0);
+                std::stringstream ss;
+                ss << ".tmp" << std::hex << process << '.' << ++count;
+                std::filesystem::path out = fileName;
+                out += ss.str();
+                return out;
+            }
+
+            template<typename T>
+            void write(std::ostream& s, T value)
+            {
+                s.write(reinterpret_cast<const char*>(&value), sizeof(T));
+            }
+
+            template<typename T>
+            bool read(std::istream& s, T& value)
+            {
+                s.read(reinterpret_cast<char*>(&value), sizeof(T));
+                return static_cast<bool>(s);
+            }
+
+            void write(std::ostream& s, const std::string& value)
+            {
+                write(s, static_cast<uint32_t>(value.size()));
+                s.write(value.data(), value.size());
+            }
+
+            bool read(std::istream& s, std::string& value)
+            {
+                uint32_t size = 0;
+                if (!read(s, size))
+                    return false;
+                value.resize(size);
+                s.read(&value[0], size);
+                return static_cast<bool>(s);
+            }
+
+            // All of the information goes with the pixels: the layout says
+            // which way up the rows are, how they are padded and the order
+            // of their bytes, and the video levels and YUV coefficients
+            // how their values are taken.
+            void write(std::ostream& s, const ftk::ImageInfo& value)
+            {
+                write(s, value.name);
+                write(s, static_cast<int32_t>(value.size.w));
+                write(s, static_cast<int32_t>(value.size.h));
+                write(s, value.pixelAspectRatio);
+                write(s, static_cast<int32_t>(value.type));
+                write(s, static_cast<int32_t>(value.videoLevels));
+                write(s, static_cast<int32_t>(value.yuvCoefficients));
+                write(s, static_cast<uint8_t>(value.layout.mirror.x));
+                write(s, static_cast<uint8_t>(value.layout.mirror.y));
+                write(s, static_cast<int32_t>(value.layout.alignment));
+                write(s, static_cast<int32_t>(value.layout.endian));
+            }
+
+            bool read(std::istream& s, ftk::ImageInfo& value)
+            {
+                int32_t w = 0;
+                int32_t h = 0;
+                int32_t type = 0;
+                int32_t videoLevels = 0;
+                int32_t yuvCoefficients = 0;
+                uint8_t mirrorX = 0;
+                uint8_t mirrorY = 0;
+                int32_t alignment = 0;
+                int32_t endian = 0;
+                if (!read(s, value.name) ||
+                    !read(s, w) ||
+                    !read(s, h) ||
+                    !read(s, value.pixelAspectRatio) ||
+                    !read(s, type) ||
+                    !read(s, videoLevels) ||
+                    !read(s, yuvCoefficients) ||
+                    !read(s, mirrorX) ||
+                    !read(s, mirrorY) ||
+                    !read(s, alignment) ||
+                    !read(s, endian))
+                    return false;
+                if (w <= 0 || h <= 0 ||
+                    type <= 0 || type >= static_cast<int32_t>(ftk::ImageType::Count) ||
+                    videoLevels < 0 || videoLevels >= static_cast<int32_t>(ftk::VideoLevels::Count) ||
+                    yuvCoefficients < 0 || yuvCoefficients >= static_cast<int32_t>(ftk::YUVCoefficients::Count) ||
+                    alignment <= 0 ||
+                    (endian != static_cast<int32_t>(ftk::Endian::MSB) &&
+                        endian != static_cast<int32_t>(ftk::Endian::LSB)))
+                    return false;
+                value.size = ftk::Size2I(w, h);
+                value.type = static_cast<ftk::ImageType>(type);
+                value.videoLevels = static_cast<ftk::VideoLevels>(videoLevels);
+                value.yuvCoefficients = static_cast<ftk::YUVCoefficients>(yuvCoefficients);
+                value.layout.mirror.x = mirrorX;
+                value.layout.mirror.y = mirrorY;
+                value.layout.alignment = alignment;
+                value.layout.endian = static_cast<ftk::Endian>(endian);
+                return true;
+            }
+
+            // The tags go with the pixels: the input color space of a
+            // frame is found from them, so a frame without them would be
+            // shown in different colors than when it is read from the file.
+            void write(std::ostream& s, const ftk::ImageTags& value)
+            {
+                write(s, static_cast<uint32_t>(value.size()));
+                for (const auto& i : value)
+                {
+                    write(s, i.first);
+                    write(s, i.second);
+                }
+            }
+
+            bool read(std::istream& s, ftk::ImageTags& value)
+            {
+                uint32_t size = 0;
+                if (!read(s, size))
+                    return false;
+                for (uint32_t i = 0; i < size; ++i)
+                {
+                    std::string k;
+                    std::string v;
+                    if (!read(s, k) || !read(s, v))
+                        return false;
+                    value[k] = v;
+                }
+                return true;
+            }
+        }
+
+        struct ImageDiskCache::Private
+        {
+            std::filesystem::path dir;
+            std::shared_ptr<FrameBufferPool> pool;
+            mutable std::mutex mutex;
+            float maxMB = 0.F;
+            // How much is on disk, found the first time an image is added
+            // rather than when the cache is made.
+            std::optional<uint64_t> size;
+            bool trimming = false;
+        };
+
+        void ImageDiskCache::_init(
+            const std::filesystem::path& dir,
+            const std::shared_ptr<FrameBufferPool>& pool)
+        {
+            FTK_P();
+            p.dir = dir;
+            p.pool = pool;
+            std::error_code ec;
+            std::filesystem::create_directories(dir, ec);
+        }
+
+        ImageDiskCache::ImageDiskCache() :
+            _p(new Private)
+        {}
+
+        ImageDiskCache::~ImageDiskCache()
+        {}
+
+        std::shared_ptr<ImageDiskCache> ImageDiskCache::create(
+            const std::filesystem::path& dir,
+            const std::shared_ptr<FrameBufferPool>& pool)
+        {
+            auto out = std::shared_ptr<ImageDiskCache>(new ImageDiskCache);
+            out->_init(dir, pool);
+            return out;
+        }
+
+        const std::filesystem::path& ImageDiskCache::getDir() const
+        {
+            return _p->dir;
+        }
+
+        void ImageDiskCache::setMaxMB(float value)
+        {
+            FTK_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                if (value == p.maxMB)
+                    return;
+                p.maxMB = value;
+                // Not known until something is added, and then it is
+                // trimmed anyway; not listing the files here keeps them
+                // off the startup time.
+                if (!p.size.has_value())
+                    return;
+            }
+            _trim();
+        }
+
+        bool ImageDiskCache::isEnabled() const
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.maxMB > 0.F;
+        }
+
+        uint64_t ImageDiskCache::getSize() const
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.size.has_value() ? p.size.value() : 0;
+        }
+
+        bool ImageDiskCache::contains(const std::string& key) const
+        {
+            FTK_P();
+            if (!isEnabled())
+                return false;
+            std::error_code ec;
+            return std::filesystem::is_regular_file(getFileName(p.dir, key), ec);
+        }
+
+        std::shared_ptr<ftk::Image> ImageDiskCache::get(const std::string& key)
+        {
+            FTK_P();
+            if (!isEnabled())
+                return nullptr;
+            const std::filesystem::path fileName = getFileName(p.dir, key);
+            std::ifstream s(fileName, std::ios::binary);
+            if (!s)
+                return nullptr;
+
+            std::shared_ptr<ftk::Image> out;
+            std::string fileMagic(magic.size(), 0);
+            s.read(&fileMagic[0], fileMagic.size());
+            uint32_t keySize = 0;
+            if (s && magic == fileMagic && read(s, keySize) && keySize == key.size())
+            {
+                std::string fileKey(keySize, 0);
+                s.read(&fileKey[0], keySize);
+                ftk::ImageInfo info;
+                ftk::ImageTags tags;
+                if (s && key == fileKey && read(s, info) && read(s, tags))
+                {
+                    auto image = p.pool ?
+                        p.pool->createImage(info) :
+                        ftk::Image::create(info);
+                    s.read(reinterpret_cast<char*>(image->getData()), image->getByteCount());
+                    if (s)
+                    {
+                        image->setTags(tags);
+                        out = image;
+                    }
+                }
+            }
+            s.close();
+
+            std::error_code ec;
+            if (out)
+            {
+                // The modification time stands for when the image was last
+                // used, which is what the oldest are removed by.
+                std::filesystem::last_write_time(
+                    fileName,
+                    std::filesystem::file_time_type::clock::now(),
+                    ec);
+            }
+            else
+            {
+                // Written by another version, cut short, or someone else's
+                // under the same name.
+                std::filesystem::remove(fileName, ec);
+            }
+            return out;
+        }
+
+        void ImageDiskCache::add(
+            const std::string& key,
+            const std::shared_ptr<ftk::Image>& image)
+        {
+            FTK_P();
+            if (!isEnabled())
+                return;
+            if (!image || image->getInfo().size.w <= 0 || image->getInfo().size.h <= 0)
+                return;
+
+            // Written to one side and moved into place, so that another
+            // instance reading the cache never sees half a file.
+            const std::filesystem::path fileName = getFileName(p.dir, key);
+            const std::filesystem::path tmpFileName = getTmpFileName(fileName);
+            {
+                std::ofstream s(tmpFileName, std::ios::binary);
+                s.write(magic.data(), magic.size());
+                write(s, static_cast<uint32_t>(key.size()));
+                s.write(key.data(), key.size());
+                write(s, image->getInfo());
+                write(s, image->getTags());
+                s.write(reinterpret_cast<const char*>(image->getData()), image->getByteCount());
+                if (!s)
+                {
+                    s.close();
+                    std::error_code ec;
+                    std::filesystem::remove(tmpFileName, ec);
+                    return;
+                }
+            }
+            std::error_code ec;
+            std::filesystem::rename(tmpFileName, fileName, ec);
+            if (ec)
+            {
+                std::filesystem::remove(tmpFileName, ec);
+                return;
+            }
+
+            bool trim = false;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                if (p.size.has_value())
+                {
+                    const auto fileSize = std::filesystem::file_size(fileName, ec);
+                    p.size = p.size.value() + (ec ? 0 : fileSize);
+                    trim = p.size.value() > p.maxMB * 1024.0 * 1024.0;
+                }
+                else
+                {
+                    trim = true;
+                }
+            }
+            if (trim)
+            {
+                _trim();
+            }
+        }
+
+        void ImageDiskCache::clear()
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            std::error_code ec;
+            for (const auto& entry : std::filesystem::directory_iterator(p.dir, ec))
+            {
+                if (entry.path().extension() == fileExt)
+                {
+                    std::filesystem::remove(entry.path(), ec);
+                }
+            }
+            p.size = 0;
+        }
+
+        void ImageDiskCache::_trim()
+        {
+            FTK_P();
+
+            // The directory is listed without the lock, so that getting and
+            // adding images does not wait for it, and by one thread at a
+            // time; the others leave it to that one.
+            float maxMB = 0.F;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                if (p.trimming)
+                    return;
+                p.trimming = true;
+                maxMB = p.maxMB;
+            }
+
+            struct File
+            {
+                std::filesystem::path path;
+                uint64_t size = 0;
+                std::filesystem::file_time_type time;
+            };
+            std::vector<File> files;
+            uint64_t size = 0;
+            std::error_code ec;
+            for (const auto& entry : std::filesystem::directory_iterator(p.dir, ec))
+            {
+                if (entry.path().extension() == fileExt)
+                {
+                    File file;
+                    file.path = entry.path();
+                    file.size = entry.file_size(ec);
+                    file.time = entry.last_write_time(ec);
+                    size += file.size;
+                    files.push_back(file);
+                }
+            }
+
+            const uint64_t max = static_cast<uint64_t>(maxMB * 1024.0 * 1024.0);
+            if (size > max)
+            {
+                std::sort(
+                    files.begin(),
+                    files.end(),
+                    [](const File& a, const File& b)
+                    {
+                        return a.time < b.time;
+                    });
+                const uint64_t target = static_cast<uint64_t>(max * trimRatio);
+                for (const auto& file : files)
+                {
+                    if (size <= target)
+                        break;
+                    if (std::filesystem::remove(file.path, ec))
+                    {
+                        size -= file.size;
+                    }
+                }
+            }
+
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.size = size;
+            p.trimming = false;
+        }
+    }
+}
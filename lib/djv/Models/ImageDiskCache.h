@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <djv/Models/Export.h>
+
+#include <ftk/Core/Image.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+namespace djv
+{
+    namespace models
+    {
+        class FrameBufferPool;
+
+        //! Image disk cache.
+        //!
+        //! Keeps images in files in a directory, each found again by a key
+        //! the caller makes from whatever decides what the image looks
+        //! like. The key is written into the file and checked when it is
+        //! read back, so two keys that hash to the same file name cannot be
+        //! confused. The image's information and tags are kept with its
+        //! pixels. The least recently used images are removed once the
+        //! directory is bigger than its maximum size.
+        //!
+        //! More than one process may use the same directory: files are
+        //! written to one side and moved into place, so a reader never sees
+        //! half of one.
+        //!
+        //! The cache may be used from any thread.
+        class DJV_API_TYPE ImageDiskCache : public std::enable_shared_from_this<ImageDiskCache>
+        {
+            FTK_NON_COPYABLE(ImageDiskCache);
+
+        protected:
+            void _init(
+                const std::filesystem::path&,
+                const std::shared_ptr<FrameBufferPool>&);
+
+            ImageDiskCache();
+
+        public:
+            DJV_API ~ImageDiskCache();
+
+            //! Create a new cache in the given directory, which is made if
+            //! it does not exist. Images that are read back are created in
+            //! the pool when one is given.
+            DJV_API static std::shared_ptr<ImageDiskCache> create(
+                const std::filesystem::path&,
+                const std::shared_ptr<FrameBufferPool>& = nullptr);
+
+            //! Get the directory.
+            DJV_API const std::filesystem::path& getDir() const;
+
+            //! Set the maximum size in megabytes. Zero turns the cache off.
+            DJV_API void setMaxMB(float);
+
+            //! Get whether the cache is on.
+            DJV_API bool isEnabled() const;
+
+            //! Get how much is on disk in bytes, if it has been counted yet.
+            DJV_API uint64_t getSize() const;
+
+            //! Get whether there is a file for an image, without reading
+            //! it. A file that turns out to be unreadable is only found
+            //! out by getting it.
+            DJV_API bool contains(const std::string& key) const;
+
+            //! Get an image, or nothing when there is none.
+            DJV_API std::shared_ptr<ftk::Image> get(const std::string& key);
+
+            //! Add an image.
+            DJV_API void add(
+                const std::string& key,
+                const std::shared_ptr<ftk::Image>&);
+
+            //! Remove every image.
+            DJV_API void clear();
+
+        private:
+            void _trim();
+
+            FTK_PRIVATE();
+        };
+    }
+}
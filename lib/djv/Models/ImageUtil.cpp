@@ -0,0 +1,348 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djv/Models/ImageUtil.h>
+
+#include <djv/Models/FrameBufferPool.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace djv
+{
+    namespace models
+    {
+        namespace
+        {
+            // Half floats are converted through a table: there are only
+            // 65536 of them, and a lookup keeps the loop over the pixels
+            // free of the branches the conversion needs.
+            float halfToFloat(uint16_t value)
+            {
+                const uint32_t sign = (value & 0x8000) << 16;
+                uint32_t exponent = (value >> 10) & 0x1f;
+                uint32_t mantissa = value & 0x3ff;
+                uint32_t bits = 0;
+                if (0 == exponent)
+                {
+                    if (mantissa != 0)
+                    {
+                        // Denormalized: normalized for the larger exponent.
+                        exponent = 127 - 15 + 1;
+                        while (0 == (mantissa & 0x400))
+                        {
+                            mantissa <<= 1;
+                            --exponent;
+                        }
+                        mantissa &= 0x3ff;
+                        bits = sign | (exponent << 23) | (mantissa << 13);
+                    }
+                    else
+                    {
+                        bits = sign;
+                    }
+                }
+                else if (0x1f == exponent)
+                {
+                    bits = sign | 0x7f800000 | (mantissa << 13);
+                }
+                else
+                {
+                    bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+                }
+                float out = 0.F;
+                memcpy(&out, &bits, sizeof(float));
+                return out;
+            }
+
+            const std::vector<float>& getHalfTable()
+            {
+                static const std::vector<float> table = []
+                    {
+                        std::vector<float> out(65536);
+                        for (size_t i = 0; i < out.size(); ++i)
+                        {
+                            out[i] = halfToFloat(static_cast<uint16_t>(i));
+                        }
+                        return out;
+                    }();
+                return table;
+            }
+
+            // The sums of a row are kept in single precision, which a row
+            // does not run out of, so that the loop vectorizes; they are
+            // added up in double precision over the rows.
+            template<typename T, int C, typename F>
+            void addStats(
+                const uint8_t* data,
+                size_t rowBytes,
+                const ftk::Box2I& box,
+                const F& convert,
+                std::array<float, 4>& min,
+                std::array<float, 4>& max,
+                std::array<double, 4>& sum,
+                std::array<double, 4>& sum2)
+            {
+                const size_t w = box.w();
+                for (int y = box.min.y; y <= box.max.y; ++y)
+                {
+                    const T* row = reinterpret_cast<const T*>(data + y * rowBytes) +
+                        static_cast<size_t>(box.min.x) * C;
+                    float rowMin[C];
+                    float rowMax[C];
+                    float rowSum[C];
+                    float rowSum2[C];
+                    for (int c = 0; c < C; ++c)
+                    {
+                        rowMin[c] = min[c];
+                        rowMax[c] = max[c];
+                        rowSum[c] = 0.F;
+                        rowSum2[c] = 0.F;
+                    }
+                    for (size_t x = 0; x < w; ++x)
+                    {
+                        for (int c = 0; c < C; ++c)
+                        {
+                            const float v = convert(row[x * C + c]);
+                            rowMin[c] = std::min(rowMin[c], v);
+                            rowMax[c] = std::max(rowMax[c], v);
+                            rowSum[c] += v;
+                            rowSum2[c] += v * v;
+                        }
+                    }
+                    for (int c = 0; c < C; ++c)
+                    {
+                        min[c] = rowMin[c];
+                        max[c] = rowMax[c];
+                        sum[c] += rowSum[c];
+                        sum2[c] += rowSum2[c];
+                    }
+                }
+            }
+
+            template<typename T, typename F>
+            int addStats(
+                int channels,
+                const uint8_t* data,
+                size_t rowBytes,
+                const ftk::Box2I& box,
+                const F& convert,
+                std::array<float, 4>& min,
+                std::array<float, 4>& max,
+                std::array<double, 4>& sum,
+                std::array<double, 4>& sum2)
+            {
+                switch (channels)
+                {
+                case 1: addStats<T, 1>(data, rowBytes, box, convert, min, max, sum, sum2); break;
+                case 2: addStats<T, 2>(data, rowBytes, box, convert, min, max, sum, sum2); break;
+                case 3: addStats<T, 3>(data, rowBytes, box, convert, min, max, sum, sum2); break;
+                case 4: addStats<T, 4>(data, rowBytes, box, convert, min, max, sum, sum2); break;
+                default: break;
+                }
+                return channels;
+            }
+        }
+
+        std::shared_ptr<ftk::Image> decimateImage(
+            const std::shared_ptr<ftk::Image>& image,
+            int factor,
+            const std::shared_ptr<FrameBufferPool>& pool)
+        {
+            if (!image || factor <= 1)
+                return image;
+            const ftk::ImageInfo& info = image->getInfo();
+            if (info.size.w <= 0 || info.size.h <= 0)
+                return image;
+
+            // The rows may be padded to an alignment, so the size of a pixel
+            // is taken from the size of a row. More left over than any
+            // alignment pads with means the pixels are not whole bytes.
+            const size_t w = info.size.w;
+            const size_t h = info.size.h;
+            const size_t rowBytes = image->getByteCount() / h;
+            const size_t pixelBytes = rowBytes / w;
+            if (0 == pixelBytes || rowBytes - pixelBytes * w >= 8)
+                return image;
+
+            ftk::ImageInfo outInfo = info;
+            outInfo.size.w = static_cast<int>((w + factor - 1) / factor);
+            outInfo.size.h = static_cast<int>((h + factor - 1) / factor);
+            auto out = pool ? pool->createImage(outInfo) : ftk::Image::create(outInfo);
+            const size_t outW = outInfo.size.w;
+            const size_t outH = outInfo.size.h;
+            const size_t outRowBytes = out->getByteCount() / outH;
+            const uint8_t* in = image->getData();
+            uint8_t* outP = out->getData();
+            for (size_t y = 0; y < outH; ++y)
+            {
+                const uint8_t* inRow = in + y * factor * rowBytes;
+                uint8_t* outRow = outP + y * outRowBytes;
+                switch (pixelBytes)
+                {
+                // The common sizes are copied a whole pixel at a time.
+                case 4:
+                    for (size_t x = 0; x < outW; ++x)
+                    {
+                        memcpy(outRow + x * 4, inRow + x * factor * 4, 4);
+                    }
+                    break;
+                case 8:
+                    for (size_t x = 0; x < outW; ++x)
+                    {
+                        memcpy(outRow + x * 8, inRow + x * factor * 8, 8);
+                    }
+                    break;
+                default:
+                    for (size_t x = 0; x < outW; ++x)
+                    {
+                        memcpy(
+                            outRow + x * pixelBytes,
+                            inRow + x * factor * pixelBytes,
+                            pixelBytes);
+                    }
+                    break;
+                }
+            }
+            out->setTags(image->getTags());
+            return out;
+        }
+
+        std::shared_ptr<ftk::Image> cropImage(
+            const std::shared_ptr<ftk::Image>& image,
+            const ftk::Box2I& value,
+            const std::shared_ptr<FrameBufferPool>& pool)
+        {
+            if (!image)
+                return nullptr;
+            const ftk::ImageInfo& info = image->getInfo();
+            if (info.size.w <= 0 || info.size.h <= 0)
+                return nullptr;
+            const ftk::Box2I box(
+                ftk::V2I(std::max(value.min.x, 0), std::max(value.min.y, 0)),
+                ftk::V2I(
+                    std::min(value.max.x, info.size.w - 1),
+                    std::min(value.max.y, info.size.h - 1)));
+            if (box.max.x < box.min.x || box.max.y < box.min.y)
+                return nullptr;
+
+            // The same test for whole byte pixels as decimating.
+            const size_t rowBytes = image->getByteCount() / info.size.h;
+            const size_t pixelBytes = rowBytes / info.size.w;
+            if (0 == pixelBytes || rowBytes - pixelBytes * info.size.w >= 8)
+                return nullptr;
+
+            ftk::ImageInfo outInfo = info;
+            outInfo.size.w = box.w();
+            outInfo.size.h = box.h();
+            auto out = pool ? pool->createImage(outInfo) : ftk::Image::create(outInfo);
+            const size_t outRowBytes = out->getByteCount() / outInfo.size.h;
+            const uint8_t* in = image->getData() +
+                box.min.y * rowBytes +
+                box.min.x * pixelBytes;
+            uint8_t* outP = out->getData();
+            for (int y = 0; y < outInfo.size.h; ++y)
+            {
+                memcpy(
+                    outP + y * outRowBytes,
+                    in + y * rowBytes,
+                    outInfo.size.w * pixelBytes);
+            }
+            out->setTags(image->getTags());
+            return out;
+        }
+
+        bool ImageStats::operator == (const ImageStats& other) const
+        {
+            return
+                count == other.count &&
+                channels == other.channels &&
+                min == other.min &&
+                max == other.max &&
+                mean == other.mean &&
+                stdDev == other.stdDev;
+        }
+
+        bool ImageStats::operator != (const ImageStats& other) const
+        {
+            return !(*this == other);
+        }
+
+        ImageStats getImageStats(
+            const std::shared_ptr<ftk::Image>& image,
+            const ftk::Box2I& value)
+        {
+            ImageStats out;
+            if (!image)
+                return out;
+            const ftk::ImageInfo& info = image->getInfo();
+            if (info.size.w <= 0 || info.size.h <= 0)
+                return out;
+            const ftk::Box2I box(
+                ftk::V2I(std::max(value.min.x, 0), std::max(value.min.y, 0)),
+                ftk::V2I(
+                    std::min(value.max.x, info.size.w - 1),
+                    std::min(value.max.y, info.size.h - 1)));
+            if (box.max.x < box.min.x || box.max.y < box.min.y)
+                return out;
+
+            std::array<float, 4> min;
+            std::array<float, 4> max;
+            min.fill(std::numeric_limits<float>::max());
+            max.fill(std::numeric_limits<float>::lowest());
+            std::array<double, 4> sum = { 0.0, 0.0, 0.0, 0.0 };
+            std::array<double, 4> sum2 = { 0.0, 0.0, 0.0, 0.0 };
+            const uint8_t* data = image->getData();
+            const size_t rowBytes = image->getByteCount() / info.size.h;
+            const auto u8 = [](uint8_t v) { return v / 255.F; };
+            const auto u16 = [](uint16_t v) { return v / 65535.F; };
+            const auto u32 = [](uint32_t v) { return static_cast<float>(v / 4294967295.0); };
+            const float* halfTable = getHalfTable().data();
+            const auto f16 = [halfTable](uint16_t v) { return halfTable[v]; };
+            const auto f32 = [](float v) { return v; };
+            int channels = 0;
+            switch (info.type)
+            {
+            case ftk::ImageType::L_U8: channels = addStats<uint8_t>(1, data, rowBytes, box, u8, min, max, sum, sum2); break;
+            case ftk::ImageType::L_U16: channels = addStats<uint16_t>(1, data, rowBytes, box, u16, min, max, sum, sum2); break;
+            case ftk::ImageType::L_U32: channels = addStats<uint32_t>(1, data, rowBytes, box, u32, min, max, sum, sum2); break;
+            case ftk::ImageType::L_F16: channels = addStats<uint16_t>(1, data, rowBytes, box, f16, min, max, sum, sum2); break;
+            case ftk::ImageType::L_F32: channels = addStats<float>(1, data, rowBytes, box, f32, min, max, sum, sum2); break;
+            case ftk::ImageType::LA_U8: channels = addStats<uint8_t>(2, data, rowBytes, box, u8, min, max, sum, sum2); break;
+            case ftk::ImageType::LA_U16: channels = addStats<uint16_t>(2, data, rowBytes, box, u16, min, max, sum, sum2); break;
+            case ftk::ImageType::LA_U32: channels = addStats<uint32_t>(2, data, rowBytes, box, u32, min, max, sum, sum2); break;
+            case ftk::ImageType::LA_F16: channels = addStats<uint16_t>(2, data, rowBytes, box, f16, min, max, sum, sum2); break;
+            case ftk::ImageType::LA_F32: channels = addStats<float>(2, data, rowBytes, box, f32, min, max, sum, sum2); break;
+            case ftk::ImageType::RGB_U8: channels = addStats<uint8_t>(3, data, rowBytes, box, u8, min, max, sum, sum2); break;
+            case ftk::ImageType::RGB_U16: channels = addStats<uint16_t>(3, data, rowBytes, box, u16, min, max, sum, sum2); break;
+            case ftk::ImageType::RGB_U32: channels = addStats<uint32_t>(3, data, rowBytes, box, u32, min, max, sum, sum2); break;
+            case ftk::ImageType::RGB_F16: channels = addStats<uint16_t>(3, data, rowBytes, box, f16, min, max, sum, sum2); break;
+            case ftk::ImageType::RGB_F32: channels = addStats<float>(3, data, rowBytes, box, f32, min, max, sum, sum2); break;
+            case ftk::ImageType::RGBA_U8: channels = addStats<uint8_t>(4, data, rowBytes, box, u8, min, max, sum, sum2); break;
+            case ftk::ImageType::RGBA_U16: channels = addStats<uint16_t>(4, data, rowBytes, box, u16, min, max, sum, sum2); break;
+            case ftk::ImageType::RGBA_U32: channels = addStats<uint32_t>(4, data, rowBytes, box, u32, min, max, sum, sum2); break;
+            case ftk::ImageType::RGBA_F16: channels = addStats<uint16_t>(4, data, rowBytes, box, f16, min, max, sum, sum2); break;
+            case ftk::ImageType::RGBA_F32: channels = addStats<float>(4, data, rowBytes, box, f32, min, max, sum, sum2); break;
+            default: break;
+            }
+            if (0 == channels)
+                return out;
+
+            out.count = static_cast<size_t>(box.w()) * box.h();
+            out.channels = channels;
+            for (int c = 0; c < channels; ++c)
+            {
+                const double mean = sum[c] / out.count;
+                out.min[c] = min[c];
+                out.max[c] = max[c];
+                out.mean[c] = static_cast<float>(mean);
+                out.stdDev[c] = static_cast<float>(
+                    std::sqrt(std::max(sum2[c] / out.count - mean * mean, 0.0)));
+            }
+            return out;
+        }
+    }
+}
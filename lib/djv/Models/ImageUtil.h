@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <djv/Models/Export.h>
+
+#include <ftk/Core/Box.h>
+#include <ftk/Core/Image.h>
+
+#include <array>
+#include <memory>
+
+namespace djv
+{
+    namespace models
+    {
+        class FrameBufferPool;
+
+        //! Reduce an image to a fraction of its size, for playing at a
+        //! reduced resolution: a factor of two gives half the width and
+        //! half the height.
+        //!
+        //! Every second or fourth pixel is taken rather than averaged, which
+        //! costs no more than copying the smaller image. The picture is
+        //! aliased, but it is only meant to be seen while it moves. The
+        //! image is created in the pool when one is given, and keeps the
+        //! tags of the original. An image whose pixels are not whole bytes
+        //! is given back as it is.
+        DJV_API std::shared_ptr<ftk::Image> decimateImage(
+            const std::shared_ptr<ftk::Image>&,
+            int factor,
+            const std::shared_ptr<FrameBufferPool>& = nullptr);
+
+        //! Copy a box of pixels out of an image, for drawing a small region
+        //! of a large frame without uploading the rest of it. The box is
+        //! clipped to the image; nothing is returned when none of it is
+        //! left, or when the pixels are not whole bytes. The image is
+        //! created in the pool when one is given, and keeps the tags of
+        //! the original so that it resolves to the same color space.
+        DJV_API std::shared_ptr<ftk::Image> cropImage(
+            const std::shared_ptr<ftk::Image>&,
+            const ftk::Box2I&,
+            const std::shared_ptr<FrameBufferPool>& = nullptr);
+
+        //! Statistics of the channels of an image over a region.
+        struct DJV_API_TYPE ImageStats
+        {
+            //! The number of pixels.
+            size_t count = 0;
+
+            //! The number of channels: one for luminance up to four for
+            //! RGBA.
+            int channels = 0;
+
+            std::array<float, 4> min = { 0.F, 0.F, 0.F, 0.F };
+            std::array<float, 4> max = { 0.F, 0.F, 0.F, 0.F };
+            std::array<float, 4> mean = { 0.F, 0.F, 0.F, 0.F };
+            std::array<float, 4> stdDev = { 0.F, 0.F, 0.F, 0.F };
+
+            DJV_API bool operator == (const ImageStats&) const;
+            DJV_API bool operator != (const ImageStats&) const;
+        };
+
+        //! Get the statistics of the channels of an image over a box of
+        //! pixels, for checking black levels and noise over a region
+        //! rather than one pixel at a time. The values are those of the
+        //! image data, before any color transform, with integer types
+        //! normalized to the range zero to one. The box is clipped to the
+        //! image. Packed and planar types, which have no whole channels to
+        //! read, give no pixels.
+        DJV_API ImageStats getImageStats(
+            const std::shared_ptr<ftk::Image>&,
+            const ftk::Box2I&);
+    }
+}
@@ -0,0 +1,280 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djv/Models/MemoryModel.h>
+
+#include <ftk/Core/Error.h>
+#include <ftk/Core/String.h>
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <sstream>
+
+namespace djv
+{
+    namespace models
+    {
+        FTK_ENUM_IMPL(
+            MemoryPriority,
+            "Low",
+            "Normal",
+            "High");
+
+        bool MemoryAccount::operator == (const MemoryAccount& other) const
+        {
+            return
+                name == other.name &&
+                file == other.file &&
+                priority == other.priority &&
+                min == other.min &&
+                max == other.max;
+        }
+
+        bool MemoryAccount::operator != (const MemoryAccount& other) const
+        {
+            return !(*this == other);
+        }
+
+        bool MemoryUsage::operator == (const MemoryUsage& other) const
+        {
+            return
+                id == other.id &&
+                account == other.account &&
+                budget == other.budget &&
+                used == other.used;
+        }
+
+        bool MemoryUsage::operator != (const MemoryUsage& other) const
+        {
+            return !(*this == other);
+        }
+
+        std::vector<uint64_t> allocateMemory(
+            uint64_t budget,
+            const std::vector<MemoryAccount>& accounts)
+        {
+            std::vector<uint64_t> out(accounts.size(), 0);
+            if (0 == budget)
+            {
+                for (size_t i = 0; i < accounts.size(); ++i)
+                {
+                    out[i] = accounts[i].max;
+                }
+                return out;
+            }
+
+            // The minimums, then the rest of the maximums, highest priority
+            // first. An account that asks for a minimum larger than its
+            // maximum gets the minimum.
+            uint64_t left = budget;
+            for (int pass = 0; pass < 2; ++pass)
+            {
+                for (int priority = static_cast<int>(MemoryPriority::Count) - 1; priority >= 0; --priority)
+                {
+                    std::vector<uint64_t> wants(accounts.size(), 0);
+                    uint64_t total = 0;
+                    for (size_t i = 0; i < accounts.size(); ++i)
+                    {
+                        if (static_cast<int>(accounts[i].priority) == priority)
+                        {
+                            const uint64_t want = 0 == pass ?
+                                accounts[i].min :
+                                std::max(accounts[i].min, accounts[i].max);
+                            wants[i] = want - out[i];
+                            total += wants[i];
+                        }
+                    }
+                    if (total <= left)
+                    {
+                        for (size_t i = 0; i < accounts.size(); ++i)
+                        {
+                            out[i] += wants[i];
+                        }
+                        left -= total;
+                    }
+                    else
+                    {
+                        for (size_t i = 0; i < accounts.size(); ++i)
+                        {
+                            out[i] += static_cast<uint64_t>(
+                                wants[i] * (left / static_cast<double>(total)));
+                        }
+                        left = 0;
+                    }
+                }
+            }
+            return out;
+        }
+
+        struct MemoryModel::Private
+        {
+            uint64_t budget = 0;
+            struct Account
+            {
+                std::string id;
+                MemoryAccount account;
+                std::optional<uint64_t> used;
+                std::shared_ptr<ftk::Observable<uint64_t> > budget;
+            };
+            std::vector<Account> accounts;
+            std::shared_ptr<ftk::ObservableList<MemoryUsage> > usage;
+        };
+
+        void MemoryModel::_init()
+        {
+            FTK_P();
+            p.usage = ftk::ObservableList<MemoryUsage>::create();
+        }
+
+        MemoryModel::MemoryModel() :
+            _p(new Private)
+        {}
+
+        MemoryModel::~MemoryModel()
+        {}
+
+        std::shared_ptr<MemoryModel> MemoryModel::create()
+        {
+            auto out = std::shared_ptr<MemoryModel>(new MemoryModel);
+            out->_init();
+            return out;
+        }
+
+        uint64_t MemoryModel::getBudget() const
+        {
+            return _p->budget;
+        }
+
+        void MemoryModel::setBudget(uint64_t value)
+        {
+            FTK_P();
+            if (value == p.budget)
+                return;
+            p.budget = value;
+            _update();
+        }
+
+        void MemoryModel::setAccount(const std::string& id, const MemoryAccount& value)
+        {
+            FTK_P();
+            const auto i = std::find_if(
+                p.accounts.begin(),
+                p.accounts.end(),
+                [id](const Private::Account& account)
+                {
+                    return id == account.id;
+                });
+            if (i != p.accounts.end())
+            {
+                if (value == i->account)
+                    return;
+                i->account = value;
+            }
+            else
+            {
+                p.accounts.push_back({ id, value, std::nullopt, ftk::Observable<uint64_t>::create(0) });
+            }
+            _update();
+        }
+
+        void MemoryModel::removeAccount(const std::string& id)
+        {
+            FTK_P();
+            const auto i = std::find_if(
+                p.accounts.begin(),
+                p.accounts.end(),
+                [id](const Private::Account& account)
+                {
+                    return id == account.id;
+                });
+            if (i != p.accounts.end())
+            {
+                // Anything still observing it is told it has nothing.
+                i->budget->setIfChanged(0);
+                p.accounts.erase(i);
+                _update();
+            }
+        }
+
+        void MemoryModel::setUsed(const std::string& id, uint64_t value)
+        {
+            FTK_P();
+            const auto i = std::find_if(
+                p.accounts.begin(),
+                p.accounts.end(),
+                [id](const Private::Account& account)
+                {
+                    return id == account.id;
+                });
+            if (i != p.accounts.end() && value != i->used)
+            {
+                i->used = value;
+                // Nothing is given differently, so only the usage changes.
+                auto usage = p.usage->get();
+                usage[i - p.accounts.begin()].used = value;
+                p.usage->setIfChanged(usage);
+            }
+        }
+
+        uint64_t MemoryModel::getAccountBudget(const std::string& id) const
+        {
+            FTK_P();
+            for (const auto& account : p.accounts)
+            {
+                if (id == account.id)
+                {
+                    return account.budget->get();
+                }
+            }
+            return 0;
+        }
+
+        std::shared_ptr<ftk::IObservable<uint64_t> > MemoryModel::observeAccountBudget(const std::string& id)
+        {
+            FTK_P();
+            for (const auto& account : p.accounts)
+            {
+                if (id == account.id)
+                {
+                    return account.budget;
+                }
+            }
+            MemoryAccount account;
+            account.name = id;
+            setAccount(id, account);
+            return p.accounts.back().budget;
+        }
+
+        std::shared_ptr<ftk::IObservableList<MemoryUsage> > MemoryModel::observeUsage() const
+        {
+            return _p->usage;
+        }
+
+        void MemoryModel::_update()
+        {
+            FTK_P();
+            std::vector<MemoryAccount> accounts;
+            for (const auto& account : p.accounts)
+            {
+                accounts.push_back(account.account);
+            }
+            const std::vector<uint64_t> budgets = allocateMemory(p.budget, accounts);
+
+            // The budgets are set after the usage, and from a copy, since an
+            // observer can change its account in turn.
+            std::vector<MemoryUsage> usage;
+            std::vector<std::shared_ptr<ftk::Observable<uint64_t> > > observables;
+            for (size_t i = 0; i < p.accounts.size(); ++i)
+            {
+                usage.push_back({ p.accounts[i].id, p.accounts[i].account, budgets[i], p.accounts[i].used });
+                observables.push_back(p.accounts[i].budget);
+            }
+            p.usage->setIfChanged(usage);
+            for (size_t i = 0; i < observables.size(); ++i)
+            {
+                observables[i]->setIfChanged(budgets[i]);
+            }
+        }
+    }
+}
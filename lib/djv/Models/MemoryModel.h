@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <djv/Models/Export.h>
+
+#include <ftk/Core/Observable.h>
+#include <ftk/Core/ObservableList.h>
+#include <ftk/Core/Util.h>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace djv
+{
+    namespace models
+    {
+        //! Memory priorities. When the budget does not cover everything,
+        //! the lowest priorities are cut back first.
+        enum class DJV_API_TYPE MemoryPriority
+        {
+            Low,
+            Normal,
+            High,
+
+            Count,
+            First = Low
+        };
+        FTK_ENUM(MemoryPriority);
+
+        //! Something that uses memory: a player's cache, the thumbnails, an
+        //! export in progress.
+        struct DJV_API_TYPE MemoryAccount
+        {
+            std::string name;
+
+            //! The file the memory is for, or empty when it is shared.
+            std::string file;
+
+            MemoryPriority priority = MemoryPriority::Normal;
+
+            //! What it needs to work at all, in bytes. This is given before
+            //! anything else has more than its own minimum.
+            uint64_t min = 0;
+
+            //! What it would use given the room, in bytes.
+            uint64_t max = 0;
+
+            DJV_API bool operator == (const MemoryAccount&) const;
+            DJV_API bool operator != (const MemoryAccount&) const;
+        };
+
+        //! The memory given to an account, and what it is using when that
+        //! is known.
+        struct DJV_API_TYPE MemoryUsage
+        {
+            std::string id;
+            MemoryAccount account;
+            uint64_t budget = 0;
+            std::optional<uint64_t> used;
+
+            DJV_API bool operator == (const MemoryUsage&) const;
+            DJV_API bool operator != (const MemoryUsage&) const;
+        };
+
+        //! Share a budget between accounts. Every account gets its minimum,
+        //! highest priority first, then what is left goes to the rest of
+        //! what they would use, again highest priority first; accounts of
+        //! the same priority are cut back in proportion. A budget of zero
+        //! is no limit, and every account gets its maximum.
+        DJV_API std::vector<uint64_t> allocateMemory(
+            uint64_t budget,
+            const std::vector<MemoryAccount>&);
+
+        //! Memory model.
+        //!
+        //! Owns the budget for the memory of the whole process, so that the
+        //! caches of every file, the thumbnails, and an export share one
+        //! limit rather than each having one of its own that adds up to
+        //! more than the machine has. Whatever uses memory adds an account
+        //! saying what it would like, and observes the budget it is given,
+        //! which changes as accounts come and go.
+        class DJV_API_TYPE MemoryModel : public std::enable_shared_from_this<MemoryModel>
+        {
+            FTK_NON_COPYABLE(MemoryModel);
+
+        protected:
+            void _init();
+
+            MemoryModel();
+
+        public:
+            DJV_API ~MemoryModel();
+
+            //! Create a new model.
+            DJV_API static std::shared_ptr<MemoryModel> create();
+
+            //! Get the budget in bytes. Zero is no limit.
+            DJV_API uint64_t getBudget() const;
+
+            //! Set the budget in bytes. Zero is no limit.
+            DJV_API void setBudget(uint64_t);
+
+            //! Add an account, or change one that has been added.
+            DJV_API void setAccount(const std::string& id, const MemoryAccount&);
+
+            //! Remove an account.
+            DJV_API void removeAccount(const std::string& id);
+
+            //! Set how much of its budget an account is using.
+            DJV_API void setUsed(const std::string& id, uint64_t);
+
+            //! Get the budget of an account, or zero when there is no such
+            //! account.
+            DJV_API uint64_t getAccountBudget(const std::string& id) const;
+
+            //! Observe the budget of an account. The account is added, with
+            //! nothing asked for, if it has not been.
+            DJV_API std::shared_ptr<ftk::IObservable<uint64_t> > observeAccountBudget(const std::string& id);
+
+            //! Observe the accounts, in the order they were added.
+            DJV_API std::shared_ptr<ftk::IObservableList<MemoryUsage> > observeUsage() const;
+
+        private:
+            void _update();
+
+            FTK_PRIVATE();
+        };
+    }
+}
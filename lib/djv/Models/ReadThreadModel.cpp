@@ -0,0 +1,266 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djv/Models/ReadThreadModel.h>
+
+#include <ftk/UI/Settings.h>
+
+#include <ftk/Core/Math.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace djv
+{
+    namespace models
+    {
+        namespace
+        {
+            const size_t countMin = 1;
+            const size_t countMax = 64;
+
+            // How close to the fastest a smaller number of threads has to be
+            // to be chosen over it. Measurements vary by more than a few
+            // percent from one file to the next.
+            const float tolerance = .9F;
+
+            bool isSeparator(char c)
+            {
+                return '/' == c || '\\' == c;
+            }
+
+            size_t chooseCount(const std::map<size_t, float>& samples, size_t count)
+            {
+                if (samples.empty())
+                    return count;
+
+                // The fewest threads within the tolerance of the fastest.
+                float max = 0.F;
+                for (const auto& i : samples)
+                {
+                    max = std::max(max, i.second);
+                }
+                size_t best = samples.rbegin()->first;
+                for (const auto& i : samples)
+                {
+                    if (i.second >= max * tolerance)
+                    {
+                        best = i.first;
+                        break;
+                    }
+                }
+
+                // Then the numbers either side of it that have not been
+                // tried, more first.
+                const size_t up = std::min(best * 2, countMax);
+                if (up != best && samples.find(up) == samples.end())
+                    return up;
+                const size_t down = std::max(best / 2, countMin);
+                if (down != best && samples.find(down) == samples.end())
+                    return down;
+                return best;
+            }
+        }
+
+        std::vector<std::string> getMounts()
+        {
+            std::vector<std::string> out;
+#if defined(__linux__)
+            std::ifstream file("/proc/self/mounts");
+            std::string line;
+            while (std::getline(file, line))
+            {
+                std::stringstream ss(line);
+                std::string device;
+                std::string mount;
+                ss >> device >> mount;
+                // Spaces in the mount point are written as octal escapes.
+                std::string unescaped;
+                for (size_t i = 0; i < mount.size(); ++i)
+                {
+                    if ('\\' == mount[i] && i + 3 < mount.size())
+                    {
+                        unescaped.push_back(static_cast<char>(
+                            std::stoi(mount.substr(i + 1, 3), nullptr, 8)));
+                        i += 3;
+                    }
+                    else
+                    {
+                        unescaped.push_back(mount[i]);
+                    }
+                }
+                if (!unescaped.empty())
+                {
+                    out.push_back(unescaped);
+                }
+            }
+#endif // __linux__
+            return out;
+        }
+
+        std::string getStorage(
+            const std::string& fileName,
+            const std::vector<std::string>& mounts)
+        {
+            std::string out;
+            for (const auto& mount : mounts)
+            {
+                const size_t size = mount.size();
+                if (size > out.size() &&
+                    0 == fileName.compare(0, size, mount) &&
+                    (fileName.size() == size ||
+                        isSeparator(fileName[size]) ||
+                        isSeparator(mount.back())))
+                {
+                    out = mount;
+                }
+            }
+            if (out.empty())
+            {
+                if (fileName.size() > 2 &&
+                    isSeparator(fileName[0]) &&
+                    isSeparator(fileName[1]))
+                {
+                    // A server and share: everything on a share is on the
+                    // same storage as far as can be told from here.
+                    size_t i = 2;
+                    for (int part = 0; part < 2 && i < fileName.size(); ++part)
+                    {
+                        i = std::min(fileName.size(), fileName.find_first_of("/\\", i + 1));
+                    }
+                    out = fileName.substr(0, i);
+                }
+                else if (fileName.size() > 1 && ':' == fileName[1])
+                {
+                    out = fileName.substr(0, 2);
+                }
+                else if (!fileName.empty() && isSeparator(fileName[0]))
+                {
+                    out = fileName.substr(0, 1);
+                }
+            }
+            return out;
+        }
+
+        struct ReadThreadModel::Private
+        {
+            std::shared_ptr<ftk::Settings> settings;
+            size_t count = 0;
+            std::map<std::string, std::map<size_t, float> > samples;
+        };
+
+        void ReadThreadModel::_init(
+            const std::shared_ptr<ftk::Settings>& settings,
+            size_t count)
+        {
+            FTK_P();
+            p.settings = settings;
+            p.count = ftk::clamp(count, countMin, countMax);
+            nlohmann::json json;
+            if (p.settings && p.settings->get("/ReadThreads", json) && json.is_object())
+            {
+                for (auto i = json.begin(); i != json.end(); ++i)
+                {
+                    try
+                    {
+                        std::map<size_t, float> samples;
+                        for (auto j = i.value().begin(); j != i.value().end(); ++j)
+                        {
+                            samples[std::stoul(j.key())] = j.value().get<float>();
+                        }
+                        p.samples[i.key()] = samples;
+                    }
+                    catch (const std::exception&)
+                    {
+                        // Only measurements: losing one means measuring
+                        // again, not starting without the rest.
+                    }
+                }
+            }
+        }
+
+        ReadThreadModel::ReadThreadModel() :
+            _p(new Private)
+        {}
+
+        ReadThreadModel::~ReadThreadModel()
+        {
+            FTK_P();
+            if (p.settings)
+            {
+                nlohmann::json json = nlohmann::json::object();
+                for (const auto& i : p.samples)
+                {
+                    nlohmann::json samples = nlohmann::json::object();
+                    for (const auto& j : i.second)
+                    {
+                        samples[std::to_string(j.first)] = j.second;
+                    }
+                    json[i.first] = samples;
+                }
+                p.settings->set("/ReadThreads", json);
+            }
+        }
+
+        std::shared_ptr<ReadThreadModel> ReadThreadModel::create(
+            const std::shared_ptr<ftk::Settings>& settings,
+            size_t count)
+        {
+            auto out = std::shared_ptr<ReadThreadModel>(new ReadThreadModel);
+            out->_init(settings, count);
+            return out;
+        }
+
+        void ReadThreadModel::setDefault(size_t value)
+        {
+            _p->count = ftk::clamp(value, countMin, countMax);
+        }
+
+        size_t ReadThreadModel::getCount(const std::string& storage) const
+        {
+            FTK_P();
+            const auto i = p.samples.find(storage);
+            return i != p.samples.end() ?
+                chooseCount(i->second, p.count) :
+                p.count;
+        }
+
+        std::map<size_t, float> ReadThreadModel::getSamples(const std::string& storage) const
+        {
+            FTK_P();
+            const auto i = p.samples.find(storage);
+            return i != p.samples.end() ? i->second : std::map<size_t, float>();
+        }
+
+        bool ReadThreadModel::addSample(
+            const std::string& storage,
+            size_t count,
+            float framesPerSecond)
+        {
+            FTK_P();
+            if (framesPerSecond <= 0.F)
+                return false;
+            const size_t prev = getCount(storage);
+            auto& samples = p.samples[storage];
+            const auto i = samples.find(count);
+            if (i != samples.end())
+            {
+                // Averaged with what was measured before, so that one slow
+                // file does not decide it, but a storage that has become
+                // slower is followed.
+                i->second = (i->second + framesPerSecond) / 2.F;
+            }
+            else
+            {
+                samples[count] = framesPerSecond;
+            }
+            return getCount(storage) != prev;
+        }
+
+        void ReadThreadModel::clear()
+        {
+            _p->samples.clear();
+        }
+    }
+}
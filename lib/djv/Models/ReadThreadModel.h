@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <djv/Models/Export.h>
+
+#include <ftk/Core/Util.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ftk
+{
+    class Settings;
+}
+
+namespace djv
+{
+    namespace models
+    {
+        //! Get the mount points of the system, or nothing where they cannot
+        //! be listed.
+        DJV_API std::vector<std::string> getMounts();
+
+        //! Get the storage a file is on: the longest of the mount points
+        //! the file is under, or the root of its path -- a drive, or a
+        //! server and share -- when it is under none of them.
+        DJV_API std::string getStorage(
+            const std::string& fileName,
+            const std::vector<std::string>& mounts);
+
+        //! Read thread model.
+        //!
+        //! Finds the number of frames of an image sequence to decode at once
+        //! for each storage. The right number for a local flash drive is
+        //! not the right one for a share over the network, and nobody sets
+        //! it by hand for each. While a file plays, how fast its cache fills
+        //! is measured and added as a sample for the number it was opened
+        //! with; the model then tries double and half that number for the
+        //! files opened after, and settles on the fewest threads that come
+        //! within a tenth of the fastest, since more threads than that only
+        //! load the storage for nothing.
+        //!
+        //! What has been measured is kept in the settings, so the numbers
+        //! found carry over to the next session.
+        class DJV_API_TYPE ReadThreadModel : public std::enable_shared_from_this<ReadThreadModel>
+        {
+            FTK_NON_COPYABLE(ReadThreadModel);
+
+        protected:
+            void _init(const std::shared_ptr<ftk::Settings>&, size_t count);
+
+            ReadThreadModel();
+
+        public:
+            DJV_API ~ReadThreadModel();
+
+            //! Create a new model. The number of threads given is where the
+            //! search starts for a storage that has not been measured. The
+            //! settings may be null, for a model that is not kept.
+            DJV_API static std::shared_ptr<ReadThreadModel> create(
+                const std::shared_ptr<ftk::Settings>&,
+                size_t count);
+
+            //! Set the number of threads the search starts from.
+            DJV_API void setDefault(size_t);
+
+            //! Get the number of threads to open a file with.
+            DJV_API size_t getCount(const std::string& storage) const;
+
+            //! Get the frames per second measured for each number of
+            //! threads.
+            DJV_API std::map<size_t, float> getSamples(const std::string& storage) const;
+
+            //! Add how many frames per second were read with a number of
+            //! threads. Returns whether the number to open files with has
+            //! changed.
+            DJV_API bool addSample(
+                const std::string& storage,
+                size_t count,
+                float framesPerSecond);
+
+            //! Forget what has been measured.
+            DJV_API void clear();
+
+        private:
+            FTK_PRIVATE();
+        };
+    }
+}
@@ -0,0 +1,243 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djv/Models/Scopes.h>
+
+#include <ftk/Core/Error.h>
+#include <ftk/Core/String.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+namespace djv
+{
+    namespace models
+    {
+        FTK_ENUM_IMPL(
+            ScopeType,
+            "Histogram",
+            "Waveform",
+            "Parade",
+            "Vectorscope");
+
+        namespace
+        {
+            // Rec. 709 luma and chroma, in fixed point with a unit of 8192,
+            // so that the loop over the pixels stays in integers.
+            const std::array<int, 3> luma = { 1742, 5859, 591 };
+            const std::array<int, 3> cb = { -939, -3157, 4096 };
+            const std::array<int, 3> cr = { 4096, -3721, -375 };
+            const int unit = 8192;
+
+            // Draw the counts of a scope as brightness in the given color.
+            void drawCounts(
+                const std::vector<uint32_t>& counts,
+                const std::array<uint8_t, 3>& color,
+                size_t x0,
+                size_t x1,
+                uint32_t max,
+                const std::shared_ptr<ftk::Image>& out)
+            {
+                const ftk::Size2I& size = out->getInfo().size;
+                const size_t rowBytes = out->getByteCount() / size.h;
+                uint8_t* data = out->getData();
+                for (size_t y = 0; y < static_cast<size_t>(size.h); ++y)
+                {
+                    uint8_t* p = data + y * rowBytes + x0 * 4;
+                    const uint32_t* c = counts.data() + y * size.w + x0;
+                    for (size_t x = x0; x < x1; ++x, p += 4, ++c)
+                    {
+                        if (*c > 0)
+                        {
+                            p[0] = color[0];
+                            p[1] = color[1];
+                            p[2] = color[2];
+                            p[3] = static_cast<uint8_t>(std::max(
+                                std::sqrt(*c / static_cast<float>(max)) * 255.F,
+                                32.F));
+                        }
+                    }
+                }
+            }
+        }
+
+        std::shared_ptr<ftk::Image> getScope(
+            ScopeType type,
+            const std::shared_ptr<ftk::Image>& image,
+            const ftk::Size2I& size)
+        {
+            if (!image || size.w <= 0 || size.h <= 0)
+                return nullptr;
+            const ftk::ImageInfo& info = image->getInfo();
+            size_t channels = 0;
+            switch (info.type)
+            {
+            case ftk::ImageType::RGB_U8: channels = 3; break;
+            case ftk::ImageType::RGBA_U8: channels = 4; break;
+            default: break;
+            }
+            if (0 == channels || info.size.w <= 0 || info.size.h <= 0)
+                return nullptr;
+
+            auto out = ftk::Image::create(ftk::ImageInfo(size, ftk::ImageType::RGBA_U8));
+            memset(out->getData(), 0, out->getByteCount());
+            const size_t w = info.size.w;
+            const size_t h = info.size.h;
+            const size_t rowBytes = image->getByteCount() / h;
+            const uint8_t* data = image->getData();
+            const size_t outW = size.w;
+            const size_t outH = size.h;
+            switch (type)
+            {
+            case ScopeType::Histogram:
+            {
+                std::array<std::array<uint32_t, 256>, 3> counts;
+                for (auto& i : counts)
+                {
+                    i.fill(0);
+                }
+                for (size_t y = 0; y < h; ++y)
+                {
+                    const uint8_t* p = data + y * rowBytes;
+                    for (size_t x = 0; x < w; ++x, p += channels)
+                    {
+                        ++counts[0][p[0]];
+                        ++counts[1][p[1]];
+                        ++counts[2][p[2]];
+                    }
+                }
+                uint32_t max = 0;
+                for (const auto& i : counts)
+                {
+                    max = std::max(max, *std::max_element(i.begin(), i.end()));
+                }
+                // Each channel is added in where its bar is, so that where
+                // they overlap the colors mix to white.
+                const size_t outRowBytes = out->getByteCount() / outH;
+                uint8_t* outP = out->getData();
+                for (size_t x = 0; x < outW; ++x)
+                {
+                    // The most of the levels that fall in the column, so
+                    // that a narrow scope does not skip any.
+                    const size_t bin0 = x * 256 / outW;
+                    const size_t bin1 = std::max((x + 1) * 256 / outW, bin0 + 1);
+                    for (size_t c = 0; c < 3; ++c)
+                    {
+                        const uint32_t count = *std::max_element(
+                            counts[c].begin() + bin0,
+                            counts[c].begin() + bin1);
+                        const size_t bar = static_cast<size_t>(std::ceil(
+                            count / static_cast<double>(max) * outH));
+                        for (size_t y = outH - bar; y < outH; ++y)
+                        {
+                            uint8_t* p = outP + y * outRowBytes + x * 4;
+                            p[c] = 255;
+                            p[3] = 255;
+                        }
+                    }
+                }
+                break;
+            }
+            case ScopeType::Waveform:
+            case ScopeType::Parade:
+            {
+                // The parade gives each channel a third of the width.
+                const bool parade = ScopeType::Parade == type;
+                const size_t sections = parade ? 3 : 1;
+                const size_t sectionW = outW / sections;
+                if (0 == sectionW)
+                    break;
+                std::vector<uint32_t> counts(outW * outH, 0);
+                std::vector<size_t> columns(w);
+                for (size_t x = 0; x < w; ++x)
+                {
+                    columns[x] = x * sectionW / w;
+                }
+                for (size_t y = 0; y < h; ++y)
+                {
+                    const uint8_t* p = data + y * rowBytes;
+                    for (size_t x = 0; x < w; ++x, p += channels)
+                    {
+                        if (parade)
+                        {
+                            for (size_t c = 0; c < 3; ++c)
+                            {
+                                const size_t row = (255 - p[c]) * (outH - 1) / 255;
+                                ++counts[row * outW + c * sectionW + columns[x]];
+                            }
+                        }
+                        else
+                        {
+                            const int v =
+                                (luma[0] * p[0] + luma[1] * p[1] + luma[2] * p[2]) / unit;
+                            const size_t row = (255 - v) * (outH - 1) / 255;
+                            ++counts[row * outW + columns[x]];
+                        }
+                    }
+                }
+                const uint32_t max = *std::max_element(counts.begin(), counts.end());
+                if (parade)
+                {
+                    const std::array<std::array<uint8_t, 3>, 3> colors =
+                    { {
+                        { 255, 64, 64 },
+                        { 64, 255, 64 },
+                        { 64, 128, 255 }
+                    } };
+                    for (size_t c = 0; c < 3; ++c)
+                    {
+                        drawCounts(
+                            counts,
+                            colors[c],
+                            std::min(c * sectionW, outW),
+                            std::min((c + 1) * sectionW, outW),
+                            max,
+                            out);
+                    }
+                }
+                else
+                {
+                    drawCounts(counts, { 255, 255, 255 }, 0, outW, max, out);
+                }
+                break;
+            }
+            case ScopeType::Vectorscope:
+            {
+                // A square in the middle, with the full range of each
+                // chroma axis across it.
+                const int side = static_cast<int>(std::min(outW, outH)) - 1;
+                const int cx = static_cast<int>(outW) / 2;
+                const int cy = static_cast<int>(outH) / 2;
+                std::vector<uint32_t> counts(outW * outH, 0);
+                for (size_t y = 0; y < h; ++y)
+                {
+                    const uint8_t* p = data + y * rowBytes;
+                    for (size_t x = 0; x < w; ++x, p += channels)
+                    {
+                        const int64_t u = cb[0] * p[0] + cb[1] * p[1] + cb[2] * p[2];
+                        const int64_t v = cr[0] * p[0] + cr[1] * p[1] + cr[2] * p[2];
+                        const int ox = std::clamp(
+                            cx + static_cast<int>(u * side / (unit * 255)),
+                            0,
+                            static_cast<int>(outW) - 1);
+                        const int oy = std::clamp(
+                            cy - static_cast<int>(v * side / (unit * 255)),
+                            0,
+                            static_cast<int>(outH) - 1);
+                        ++counts[oy * outW + ox];
+                    }
+                }
+                const uint32_t max = *std::max_element(counts.begin(), counts.end());
+                drawCounts(counts, { 255, 255, 255 }, 0, outW, max, out);
+                break;
+            }
+            default: break;
+            }
+            return out;
+        }
+    }
+}
@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <djv/Models/Export.h>
+
+#include <ftk/Core/Image.h>
+#include <ftk/Core/Util.h>
+
+#include <memory>
+
+namespace djv
+{
+    namespace models
+    {
+        //! Scope types.
+        enum class DJV_API_TYPE ScopeType
+        {
+            Histogram,
+            Waveform,
+            Parade,
+            Vectorscope,
+
+            Count,
+            First = Histogram
+        };
+        FTK_ENUM(ScopeType);
+
+        //! Draw a scope of an image into an image of the given size, for
+        //! showing as it is:
+        //!
+        //! * Histogram: how many pixels have each level, for the red,
+        //!   green, and blue channels overlaid, from black on the left to
+        //!   white on the right.
+        //! * Waveform: the luma of each column of the image, from black at
+        //!   the bottom to white at the top.
+        //! * Parade: the waveforms of the red, green, and blue channels
+        //!   side by side.
+        //! * Vectorscope: the Rec. 709 chroma of the pixels, with blue to
+        //!   the right and red to the top.
+        //!
+        //! The scope is measured on 8-bit RGB or RGBA data, which is what a
+        //! frame drawn through the display transform is read back as; for
+        //! any other type nothing is returned. The scope is RGBA 8-bit,
+        //! with nothing drawn where it has no pixels. The bars of the
+        //! histogram are relative to the level with the most pixels; in
+        //! the other scopes, how bright a point is follows the square root
+        //! of how many pixels it has, so that a few pixels still show.
+        DJV_API std::shared_ptr<ftk::Image> getScope(
+            ScopeType,
+            const std::shared_ptr<ftk::Image>&,
+            const ftk::Size2I&);
+    }
+}
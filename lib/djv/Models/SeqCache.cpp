@@ -0,0 +1,231 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djv/Models/SeqCache.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <list>
+#include <mutex>
+#include <optional>
+
+namespace djv
+{
+    namespace models
+    {
+        namespace
+        {
+            // Enough for the directories of a large session, and small
+            // enough that the listings held do not matter.
+            const size_t entriesMax = 256;
+
+            const std::chrono::seconds settleTime(2);
+
+            enum class Kind
+            {
+                Seq,
+                Paths
+            };
+
+            struct Entry
+            {
+                Kind kind = Kind::Seq;
+                std::string dir;
+                std::string path;
+                size_t seqMaxDigits = 0;
+                ftk::DirListOptions dirListOptions;
+                std::filesystem::file_time_type time;
+                ftk::Path seq;
+                std::vector<ftk::Path> paths;
+            };
+
+            // The directory's modification time, or nothing when it cannot
+            // be trusted to say whether the directory has changed.
+            std::optional<std::filesystem::file_time_type> getTime(const std::string& dir)
+            {
+                std::optional<std::filesystem::file_time_type> out;
+                std::error_code ec;
+                const auto time = std::filesystem::last_write_time(
+                    std::filesystem::u8path(dir),
+                    ec);
+                if (!ec &&
+                    std::filesystem::file_time_type::clock::now() - time > settleTime)
+                {
+                    out = time;
+                }
+                return out;
+            }
+        }
+
+        std::string getSeqDir(const ftk::Path& path)
+        {
+            std::string out = path.getDir();
+            if (out.empty())
+            {
+                out = ".";
+            }
+            return out;
+        }
+
+        struct SeqCache::Private
+        {
+            std::mutex mutex;
+            // Most recently used first.
+            std::list<Entry> entries;
+
+            template<typename T>
+            std::optional<Entry> find(const T& match)
+            {
+                std::optional<Entry> out;
+                std::unique_lock<std::mutex> lock(mutex);
+                const auto i = std::find_if(entries.begin(), entries.end(), match);
+                if (i != entries.end())
+                {
+                    entries.splice(entries.begin(), entries, i);
+                    out = entries.front();
+                }
+                return out;
+            }
+
+            template<typename T>
+            void add(Entry&& entry, const T& match)
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                entries.remove_if(match);
+                entries.push_front(std::move(entry));
+                while (entries.size() > entriesMax)
+                {
+                    entries.pop_back();
+                }
+            }
+        };
+
+        void SeqCache::_init()
+        {}
+
+        SeqCache::SeqCache() :
+            _p(new Private)
+        {}
+
+        SeqCache::~SeqCache()
+        {}
+
+        std::shared_ptr<SeqCache> SeqCache::create()
+        {
+            auto out = std::shared_ptr<SeqCache>(new SeqCache);
+            out->_init();
+            return out;
+        }
+
+        ftk::Path SeqCache::findSeq(
+            const ftk::Path& path,
+            const ftk::PathOptions& options)
+        {
+            FTK_P();
+            const std::string dir = getSeqDir(path);
+            const auto match = [&dir, &path, &options](const Entry& entry)
+            {
+                return
+                    Kind::Seq == entry.kind &&
+                    dir == entry.dir &&
+                    path.get() == entry.path &&
+                    options.seqMaxDigits == entry.seqMaxDigits;
+            };
+
+            const auto time = getTime(dir);
+            if (time.has_value())
+            {
+                const auto entry = p.find(match);
+                if (entry.has_value() && entry->time == time.value())
+                {
+                    return entry->seq;
+                }
+            }
+
+            // Listed without holding the lock, so that files in other
+            // directories are not kept waiting for this one.
+            ftk::Path out = path;
+            const auto seq = ftk::findSeq(path, options);
+            if (!seq.empty())
+            {
+                out.setSeq(seq);
+            }
+            if (time.has_value())
+            {
+                Entry entry;
+                entry.kind = Kind::Seq;
+                entry.dir = dir;
+                entry.path = path.get();
+                entry.seqMaxDigits = options.seqMaxDigits;
+                entry.time = time.value();
+                entry.seq = out;
+                p.add(std::move(entry), match);
+            }
+            return out;
+        }
+
+        std::vector<ftk::Path> SeqCache::getPaths(
+            const std::shared_ptr<ftk::Context>& context,
+            const ftk::Path& path,
+            const ftk::DirListOptions& options)
+        {
+            FTK_P();
+            std::error_code ec;
+            const std::string dir =
+                std::filesystem::is_directory(std::filesystem::u8path(path.get()), ec) ?
+                path.get() :
+                getSeqDir(path);
+            const auto match = [&dir, &path, &options](const Entry& entry)
+            {
+                return
+                    Kind::Paths == entry.kind &&
+                    dir == entry.dir &&
+                    path.get() == entry.path &&
+                    options == entry.dirListOptions;
+            };
+
+            const auto time = getTime(dir);
+            if (time.has_value())
+            {
+                const auto entry = p.find(match);
+                if (entry.has_value() && entry->time == time.value())
+                {
+                    return entry->paths;
+                }
+            }
+
+            const auto out = tl::getPaths(context, path, options);
+            if (time.has_value())
+            {
+                Entry entry;
+                entry.kind = Kind::Paths;
+                entry.dir = dir;
+                entry.path = path.get();
+                entry.dirListOptions = options;
+                entry.time = time.value();
+                entry.paths = out;
+                p.add(std::move(entry), match);
+            }
+            return out;
+        }
+
+        void SeqCache::invalidate(const std::string& dir)
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.entries.remove_if(
+                [&dir](const Entry& entry)
+                {
+                    return dir == entry.dir;
+                });
+        }
+
+        void SeqCache::clear()
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.entries.clear();
+        }
+    }
+}
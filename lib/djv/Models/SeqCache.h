@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <djv/Models/Export.h>
+
+#include <tlRender/Timeline/Util.h>
+
+#include <ftk/Core/Path.h>
+
+#include <memory>
+#include <vector>
+
+namespace ftk
+{
+    class Context;
+}
+
+namespace djv
+{
+    namespace models
+    {
+        //! Get the directory an image sequence is found in, named the way
+        //! the cache names it.
+        DJV_API std::string getSeqDir(const ftk::Path&);
+
+        //! Image sequence cache.
+        //!
+        //! Remembers what was found on disk when a sequence's frames were
+        //! looked for, or when a directory was gathered into sequences, so
+        //! that reopening and reloading do not list the directory again.
+        //! A directory of twenty thousand frames on network storage takes
+        //! seconds to list, and reloading a file that has not changed is
+        //! the common case.
+        //!
+        //! An entry is kept for as long as its directory's modification
+        //! time stays the same, since adding, removing, or renaming a frame
+        //! is what changes it. A directory that was modified in the last
+        //! couple of seconds is listed again regardless: some file systems
+        //! keep the time to the second, and a frame written in the same
+        //! second as the listing would otherwise go unseen.
+        //!
+        //! The cache may be used from any thread.
+        class DJV_API_TYPE SeqCache : public std::enable_shared_from_this<SeqCache>
+        {
+            FTK_NON_COPYABLE(SeqCache);
+
+        protected:
+            void _init();
+
+            SeqCache();
+
+        public:
+            DJV_API ~SeqCache();
+
+            //! Create a new cache.
+            DJV_API static std::shared_ptr<SeqCache> create();
+
+            //! Get the path with the frames of its sequence found on disk,
+            //! as ftk::findSeq() does. A sequence with no frames on disk
+            //! is given back as it is.
+            DJV_API ftk::Path findSeq(
+                const ftk::Path&,
+                const ftk::PathOptions&);
+
+            //! Get the paths to open for a path, as tl::getPaths() does.
+            DJV_API std::vector<ftk::Path> getPaths(
+                const std::shared_ptr<ftk::Context>&,
+                const ftk::Path&,
+                const ftk::DirListOptions&);
+
+            //! Forget everything found in a directory.
+            DJV_API void invalidate(const std::string& dir);
+
+            //! Forget everything.
+            DJV_API void clear();
+
+        private:
+            FTK_PRIVATE();
+        };
+    }
+}
@@ -25,6 +25,19 @@ namespace djv
             return !(*this == other);
         }
 
+        bool DiskCacheSettings::operator == (const DiskCacheSettings& other) const
+        {
+            return
+                thumbnailMB == other.thumbnailMB &&
+                frameGB == other.frameGB &&
+                frameDir == other.frameDir;
+        }
+
+        bool DiskCacheSettings::operator != (const DiskCacheSettings& other) const
+        {
+            return !(*this == other);
+        }
+
         TL_ENUM_IMPL(
             ExportRenderSize,
             "Default",
@@ -93,6 +106,21 @@ namespace djv
             return !(*this == other);
         }
 
+        FTK_ENUM_IMPL(
+            FrameCacheMode,
+            "Uncompressed",
+            "Compressed");
+
+        bool FrameCacheSettings::operator == (const FrameCacheSettings& other) const
+        {
+            return mode == other.mode;
+        }
+
+        bool FrameCacheSettings::operator != (const FrameCacheSettings& other) const
+        {
+            return !(*this == other);
+        }
+
         bool ImageSeqSettings::operator == (const ImageSeqSettings& other) const
         {
             return
@@ -101,6 +129,7 @@ namespace djv
                 audioFileName == other.audioFileName &&
                 maxDigits == other.maxDigits &&
                 readThreadCount == other.readThreadCount &&
+                readThreadAuto == other.readThreadAuto &&
                 io == other.io;
         }
 
@@ -134,6 +163,16 @@ namespace djv
             return !(*this == other);
         }
 
+        bool MemorySettings::operator == (const MemorySettings& other) const
+        {
+            return budgetGB == other.budgetGB;
+        }
+
+        bool MemorySettings::operator != (const MemorySettings& other) const
+        {
+            return !(*this == other);
+        }
+
         bool MiscSettings::operator == (const MiscSettings& other) const
         {
             return
@@ -187,7 +226,10 @@ namespace djv
 
         bool PlaybackSettings::operator == (const PlaybackSettings& other) const
         {
-            return startPlayback == other.startPlayback;
+            return
+                startPlayback == other.startPlayback &&
+                adaptiveResolution == other.adaptiveResolution &&
+                scrubProxies == other.scrubProxies;
         }
 
         bool PlaybackSettings::operator != (const PlaybackSettings& other) const
@@ -195,6 +237,20 @@ namespace djv
             return !(*this == other);
         }
 
+        bool PrefetchSettings::operator == (const PrefetchSettings& other) const
+        {
+            return
+                files == other.files &&
+                videoGB == other.videoGB &&
+                lazyOpen == other.lazyOpen &&
+                openInBackground == other.openInBackground;
+        }
+
+        bool PrefetchSettings::operator != (const PrefetchSettings& other) const
+        {
+            return !(*this == other);
+        }
+
         StyleSettings::StyleSettings()
         {
             for (const auto font : ftk::getFontTypeEnums())
@@ -301,6 +357,10 @@ namespace djv
             std::shared_ptr<ftk::Observable<AudioSettings> > audio;
             std::shared_ptr<ftk::Observable<tl::PlayerCacheOptions> > cache;
             std::shared_ptr<ftk::Observable<tl::ui::ThumbnailCacheOptions> > thumbnailCache;
+            std::shared_ptr<ftk::Observable<DiskCacheSettings> > diskCache;
+            std::shared_ptr<ftk::Observable<PrefetchSettings> > prefetch;
+            std::shared_ptr<ftk::Observable<FrameCacheSettings> > frameCache;
+            std::shared_ptr<ftk::Observable<MemorySettings> > memory;
             std::shared_ptr<ftk::Observable<ExportSettings> > exportSettings;
             std::shared_ptr<ftk::Observable<FileBrowserSettings> > fileBrowser;
             std::shared_ptr<ftk::Observable<ImageSeqSettings> > imageSeq;
@@ -330,6 +390,10 @@ namespace djv
                 { "Audio", "/Audio.1" },
                 { "Cache", "/Cache" },
                 { "ThumbnailCache", "/ThumbnailCache" },
+                { "DiskCache", "/DiskCache" },
+                { "Prefetch", "/Prefetch" },
+                { "FrameCache", "/FrameCache" },
+                { "Memory", "/Memory" },
                 { "Export", "/Export" },
                 { "FileBrowser", "/FileBrowser" },
                 { "ImageSeq", "/ImageSeq.1" },
@@ -368,8 +432,18 @@ namespace djv
             tl::ui::ThumbnailCacheOptions thumbnailCache;
             settings->getT(keys["ThumbnailCache"], thumbnailCache);
             p.thumbnailCache = ftk::Observable<tl::ui::ThumbnailCacheOptions>::create(thumbnailCache);
-            auto thumbnailSystem = context->getSystem<tl::ui::ThumbnailSystem>();
-            thumbnailSystem->setCacheOptions(thumbnailCache);
+            DiskCacheSettings diskCache;
+            settings->getT(keys["DiskCache"], diskCache);
+            p.diskCache = ftk::Observable<DiskCacheSettings>::create(diskCache);
+            PrefetchSettings prefetch;
+            settings->getT(keys["Prefetch"], prefetch);
+            p.prefetch = ftk::Observable<PrefetchSettings>::create(prefetch);
+            FrameCacheSettings frameCache;
+            settings->getT(keys["FrameCache"], frameCache);
+            p.frameCache = ftk::Observable<FrameCacheSettings>::create(frameCache);
+            MemorySettings memory;
+            settings->getT(keys["Memory"], memory);
+            p.memory = ftk::Observable<MemorySettings>::create(memory);
 
             ExportSettings exportSettings;
             settings->getT(keys["Export"], exportSettings);
@@ -503,6 +577,10 @@ namespace djv
             p.settings->setT(keys["Audio"], p.audio->get());
             p.settings->setT(keys["Cache"], p.cache->get());
             p.settings->setT(keys["ThumbnailCache"], p.thumbnailCache->get());
+            p.settings->setT(keys["DiskCache"], p.diskCache->get());
+            p.settings->setT(keys["Prefetch"], p.prefetch->get());
+            p.settings->setT(keys["FrameCache"], p.frameCache->get());
+            p.settings->setT(keys["Memory"], p.memory->get());
             p.settings->setT(keys["Export"], p.exportSettings->get());
 
             FileBrowserSettings fileBrowser = p.fileBrowser->get();
@@ -564,6 +642,10 @@ namespace djv
             setAudio(AudioSettings());
             setCache(tl::PlayerCacheOptions());
             setThumbnailCache(tl::ui::ThumbnailCacheOptions());
+            setDiskCache(DiskCacheSettings());
+            setPrefetch(PrefetchSettings());
+            setFrameCache(FrameCacheSettings());
+            setMemory(MemorySettings());
             setExport(ExportSettings());
             setFileBrowser(FileBrowserSettings());
             setImageSeq(ImageSeqSettings());
@@ -632,13 +714,67 @@ namespace djv
 
         void SettingsModel::setThumbnailCache(const tl::ui::ThumbnailCacheOptions& value)
         {
-            FTK_P();
-            if (p.thumbnailCache->setIfChanged(value))
-            {
-                auto context = p.context.lock();
-                auto thumbnailSystem = context->getSystem<tl::ui::ThumbnailSystem>();
-                thumbnailSystem->setCacheOptions(value);
-            }
+            _p->thumbnailCache->setIfChanged(value);
+        }
+
+        const DiskCacheSettings& SettingsModel::getDiskCache() const
+        {
+            return _p->diskCache->get();
+        }
+
+        std::shared_ptr<ftk::IObservable<DiskCacheSettings> > SettingsModel::observeDiskCache() const
+        {
+            return _p->diskCache;
+        }
+
+        void SettingsModel::setDiskCache(const DiskCacheSettings& value)
+        {
+            _p->diskCache->setIfChanged(value);
+        }
+
+        const PrefetchSettings& SettingsModel::getPrefetch() const
+        {
+            return _p->prefetch->get();
+        }
+
+        std::shared_ptr<ftk::IObservable<PrefetchSettings> > SettingsModel::observePrefetch() const
+        {
+            return _p->prefetch;
+        }
+
+        void SettingsModel::setPrefetch(const PrefetchSettings& value)
+        {
+            _p->prefetch->setIfChanged(value);
+        }
+
+        const FrameCacheSettings& SettingsModel::getFrameCache() const
+        {
+            return _p->frameCache->get();
+        }
+
+        std::shared_ptr<ftk::IObservable<FrameCacheSettings> > SettingsModel::observeFrameCache() const
+        {
+            return _p->frameCache;
+        }
+
+        void SettingsModel::setFrameCache(const FrameCacheSettings& value)
+        {
+            _p->frameCache->setIfChanged(value);
+        }
+
+        const MemorySettings& SettingsModel::getMemory() const
+        {
+            return _p->memory->get();
+        }
+
+        std::shared_ptr<ftk::IObservable<MemorySettings> > SettingsModel::observeMemory() const
+        {
+            return _p->memory;
+        }
+
+        void SettingsModel::setMemory(const MemorySettings& value)
+        {
+            _p->memory->setIfChanged(value);
         }
 
         const ExportSettings& SettingsModel::getExport() const
@@ -910,6 +1046,13 @@ namespace djv
             json["BufferFrameCount"] = value.bufferFrameCount;
         }
 
+        void to_json(nlohmann::json& json, const DiskCacheSettings& value)
+        {
+            json["ThumbnailMB"] = value.thumbnailMB;
+            json["FrameGB"] = value.frameGB;
+            json["FrameDir"] = value.frameDir;
+        }
+
         void to_json(nlohmann::json& json, const ExportSettings& value)
         {
             json["Dir"] = value.dir;
@@ -939,6 +1082,11 @@ namespace djv
             json["Ext"] = value.ext;
         }
 
+        void to_json(nlohmann::json& json, const FrameCacheSettings& value)
+        {
+            json["Mode"] = to_string(value.mode);
+        }
+
         void to_json(nlohmann::json& json, const ImageSeqSettings& value)
         {
             json["Audio"] = tl::to_string(value.audio);
@@ -946,9 +1094,15 @@ namespace djv
             json["AudioFileName"] = value.audioFileName;
             json["MaxDigits"] = value.maxDigits;
             json["ReadThreadCount"] = value.readThreadCount;
+            json["ReadThreadAuto"] = value.readThreadAuto;
             json["IO"] = value.io;
         }
 
+        void to_json(nlohmann::json& json, const MemorySettings& value)
+        {
+            json["BudgetGB"] = value.budgetGB;
+        }
+
         void to_json(nlohmann::json& json, const OTIOSettings& value)
         {
             json["Spatial"] = tl::to_string(value.spatial);
@@ -988,6 +1142,16 @@ namespace djv
         void to_json(nlohmann::json& json, const PlaybackSettings& value)
         {
             json["StartPlayback"] = value.startPlayback;
+            json["AdaptiveResolution"] = value.adaptiveResolution;
+            json["ScrubProxies"] = value.scrubProxies;
+        }
+
+        void to_json(nlohmann::json& json, const PrefetchSettings& value)
+        {
+            json["Files"] = value.files;
+            json["VideoGB"] = value.videoGB;
+            json["LazyOpen"] = value.lazyOpen;
+            json["OpenInBackground"] = value.openInBackground;
         }
 
         void to_json(nlohmann::json& json, const StyleSettings& value)
@@ -1045,6 +1209,13 @@ namespace djv
             json.at("BufferFrameCount").get_to(value.bufferFrameCount);
         }
 
+        void from_json(const nlohmann::json& json, DiskCacheSettings& value)
+        {
+            json.at("ThumbnailMB").get_to(value.thumbnailMB);
+            json.at("FrameGB").get_to(value.frameGB);
+            json.at("FrameDir").get_to(value.frameDir);
+        }
+
         void from_json(const nlohmann::json& json, ExportSettings& value)
         {
             json.at("Dir").get_to(value.dir);
@@ -1117,6 +1288,11 @@ namespace djv
             json.at("Ext").get_to(value.ext);
         }
 
+        void from_json(const nlohmann::json& json, FrameCacheSettings& value)
+        {
+            from_string(json.at("Mode").get<std::string>(), value.mode);
+        }
+
         void from_json(const nlohmann::json& json, ImageSeqSettings& value)
         {
             tl::from_string(json.at("Audio").get<std::string>(), value.audio);
@@ -1124,9 +1300,20 @@ namespace djv
             json.at("AudioFileName").get_to(value.audioFileName);
             json.at("MaxDigits").get_to(value.maxDigits);
             json.at("ReadThreadCount").get_to(value.readThreadCount);
+            // Asked for rather than required, so settings written before this
+            // still load the rest of the sequence settings.
+            if (json.contains("ReadThreadAuto"))
+            {
+                json.at("ReadThreadAuto").get_to(value.readThreadAuto);
+            }
             json.at("IO").get_to(value.io);
         }
 
+        void from_json(const nlohmann::json& json, MemorySettings& value)
+        {
+            json.at("BudgetGB").get_to(value.budgetGB);
+        }
+
         void from_json(const nlohmann::json& json, OTIOSettings& value)
         {
             tl::from_string(json.at("Spatial").get<std::string>(), value.spatial);
@@ -1160,6 +1347,30 @@ namespace djv
         void from_json(const nlohmann::json& json, PlaybackSettings& value)
         {
             json.at("StartPlayback").get_to(value.startPlayback);
+            if (json.contains("AdaptiveResolution"))
+            {
+                json.at("AdaptiveResolution").get_to(value.adaptiveResolution);
+            }
+            if (json.contains("ScrubProxies"))
+            {
+                json.at("ScrubProxies").get_to(value.scrubProxies);
+            }
+        }
+
+        void from_json(const nlohmann::json& json, PrefetchSettings& value)
+        {
+            json.at("Files").get_to(value.files);
+            json.at("VideoGB").get_to(value.videoGB);
+            // Asked for rather than required, so settings written before this
+            // still load the rest of the prefetch settings.
+            if (json.contains("LazyOpen"))
+            {
+                json.at("LazyOpen").get_to(value.lazyOpen);
+            }
+            if (json.contains("OpenInBackground"))
+            {
+                json.at("OpenInBackground").get_to(value.openInBackground);
+            }
         }
 
         void from_json(const nlohmann::json& json, ShortcutsSettings& value)
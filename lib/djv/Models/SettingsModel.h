@@ -49,6 +49,26 @@ namespace djv
             DJV_API bool operator != (const AudioSettings&) const;
         };
 
+        //! Disk cache settings.
+        struct DJV_API_TYPE DiskCacheSettings
+        {
+            //! The most the thumbnails kept on disk between runs may take
+            //! up, in megabytes. Zero turns the thumbnail disk cache off.
+            float thumbnailMB = 512.F;
+
+            //! The most the image sequence frames kept on disk may take up,
+            //! in gigabytes. Zero turns the frame disk cache off.
+            float frameGB = 0.F;
+
+            //! The directory the frames are kept in, which should be on fast
+            //! local storage. Empty for the default, in the user's cache
+            //! directory.
+            std::string frameDir;
+
+            DJV_API bool operator == (const DiskCacheSettings&) const;
+            DJV_API bool operator != (const DiskCacheSettings&) const;
+        };
+
         //! Export render width. Only the width, because the height follows
         //! the aspect ratio of what is being exported.
         enum class DJV_API_TYPE ExportRenderSize
@@ -125,6 +145,32 @@ namespace djv
             DJV_API bool operator != (const FileBrowserSettings&) const;
         };
 
+        //! How the video cache keeps frames.
+        enum class DJV_API_TYPE FrameCacheMode
+        {
+            //! As they are read, ready to be shown.
+            Uncompressed,
+
+            //! Compressed, which fits two or three times as many half float
+            //! or 16-bit frames in the same memory, at the cost of the cores
+            //! that decompress them during playback. Only image sequences
+            //! are compressed.
+            Compressed,
+
+            Count,
+            First = Uncompressed
+        };
+        FTK_ENUM(FrameCacheMode);
+
+        //! Frame cache settings.
+        struct DJV_API_TYPE FrameCacheSettings
+        {
+            FrameCacheMode mode = FrameCacheMode::Uncompressed;
+
+            DJV_API bool operator == (const FrameCacheSettings&) const;
+            DJV_API bool operator != (const FrameCacheSettings&) const;
+        };
+
         //! Image sequence settings.
         struct DJV_API_TYPE ImageSeqSettings
         {
@@ -138,6 +184,12 @@ namespace djv
             //! decodes sequences.
             size_t readThreadCount = tl::getDefaultReadThreadCount();
 
+            //! Find the number of frames decoded at once for each storage
+            //! by measuring how fast the cache fills while stopped, with
+            //! the frame cache tiers off, starting from the number above.
+            //! Local flash and a network share want very different numbers.
+            bool readThreadAuto = true;
+
             tl::SeqOptions io;
 
             DJV_API bool operator == (const ImageSeqSettings&) const;
@@ -154,6 +206,20 @@ namespace djv
             DJV_API bool operator != (const OTIOSettings&) const;
         };
 
+        //! Memory settings.
+        struct DJV_API_TYPE MemorySettings
+        {
+            //! The most memory the caches of every open file, the
+            //! thumbnails, and an export may take up between them, in
+            //! gigabytes. When they would take more, the files kept ready
+            //! are cut back first and the current file last. Zero leaves
+            //! each with the size it is set to.
+            float budgetGB = 0.F;
+
+            DJV_API bool operator == (const MemorySettings&) const;
+            DJV_API bool operator != (const MemorySettings&) const;
+        };
+
         //! Miscellaneous settings.
         struct DJV_API_TYPE MiscSettings
         {
@@ -227,10 +293,53 @@ namespace djv
         {
             bool startPlayback = false;
 
+            //! Play image sequences at a reduced resolution when they cannot
+            //! be read as fast as they play, and go back to the full
+            //! resolution once playback stops. Keeping the frame rate
+            //! matters more than the detail while the picture moves.
+            bool adaptiveResolution = false;
+
+            //! While the frame shuttle or the timeline moves the current
+            //! frame, show a small proxy of it -- or of the nearest frame
+            //! that has one -- until the frame itself has been read.
+            //! Proxies are made from the frames in the frame cache's tiers.
+            bool scrubProxies = true;
+
             DJV_API bool operator == (const PlaybackSettings&) const;
             DJV_API bool operator != (const PlaybackSettings&) const;
         };
 
+        //! File prefetch settings.
+        //!
+        //! The files either side of the current one in the list can be kept
+        //! open with their first frames read, so that stepping through a
+        //! list of shots shows each one straight away rather than waiting
+        //! for the cache to fill.
+        struct DJV_API_TYPE PrefetchSettings
+        {
+            //! How many files either side of the current one to keep ready.
+            //! Zero turns prefetching off.
+            int files = 0;
+
+            //! The video cache the prefetched files share, in gigabytes. It
+            //! is taken from the video cache of the current file rather than
+            //! added to it.
+            float videoGB = 2.F;
+
+            //! Leave opening a file until it is first looked at, or kept
+            //! ready as a neighbour of the current one, rather than when it
+            //! is added. A list of hundreds of files then shows straight
+            //! away, and only what is looked at is read.
+            bool lazyOpen = false;
+
+            //! With lazy opening, open the rest of the files one at a time
+            //! in the background while nothing is playing.
+            bool openInBackground = true;
+
+            DJV_API bool operator == (const PrefetchSettings&) const;
+            DJV_API bool operator != (const PrefetchSettings&) const;
+        };
+
         //! Keyboard shortcuts settings.
         struct DJV_API_TYPE ShortcutsSettings
         {
@@ -366,6 +475,22 @@ namespace djv
             DJV_API std::shared_ptr<ftk::IObservable<tl::ui::ThumbnailCacheOptions> > observeThumbnailCache() const;
             DJV_API void setThumbnailCache(const tl::ui::ThumbnailCacheOptions&);
 
+            DJV_API const DiskCacheSettings& getDiskCache() const;
+            DJV_API std::shared_ptr<ftk::IObservable<DiskCacheSettings> > observeDiskCache() const;
+            DJV_API void setDiskCache(const DiskCacheSettings&);
+
+            DJV_API const PrefetchSettings& getPrefetch() const;
+            DJV_API std::shared_ptr<ftk::IObservable<PrefetchSettings> > observePrefetch() const;
+            DJV_API void setPrefetch(const PrefetchSettings&);
+
+            DJV_API const FrameCacheSettings& getFrameCache() const;
+            DJV_API std::shared_ptr<ftk::IObservable<FrameCacheSettings> > observeFrameCache() const;
+            DJV_API void setFrameCache(const FrameCacheSettings&);
+
+            DJV_API const MemorySettings& getMemory() const;
+            DJV_API std::shared_ptr<ftk::IObservable<MemorySettings> > observeMemory() const;
+            DJV_API void setMemory(const MemorySettings&);
+
             ///@}
 
             //! \name Export
@@ -519,28 +644,36 @@ namespace djv
         ///@{
 
         DJV_API void to_json(nlohmann::json&, const AudioSettings&);
+        DJV_API void to_json(nlohmann::json&, const DiskCacheSettings&);
         DJV_API void to_json(nlohmann::json&, const ExportSettings&);
         DJV_API void to_json(nlohmann::json&, const FileBrowserSettings&);
+        DJV_API void to_json(nlohmann::json&, const FrameCacheSettings&);
         DJV_API void to_json(nlohmann::json&, const ImageSeqSettings&);
+        DJV_API void to_json(nlohmann::json&, const MemorySettings&);
         DJV_API void to_json(nlohmann::json&, const OTIOSettings&);
         DJV_API void to_json(nlohmann::json&, const MiscSettings&);
         DJV_API void to_json(nlohmann::json&, const MouseActionBinding&);
         DJV_API void to_json(nlohmann::json&, const MouseSettings&);
         DJV_API void to_json(nlohmann::json&, const PlaybackSettings&);
+        DJV_API void to_json(nlohmann::json&, const PrefetchSettings&);
         DJV_API void to_json(nlohmann::json&, const ShortcutsSettings&);
         DJV_API void to_json(nlohmann::json&, const StyleSettings&);
         DJV_API void to_json(nlohmann::json&, const TimelineSettings&);
         DJV_API void to_json(nlohmann::json&, const WindowSettings&);
 
         DJV_API void from_json(const nlohmann::json&, AudioSettings&);
+        DJV_API void from_json(const nlohmann::json&, DiskCacheSettings&);
         DJV_API void from_json(const nlohmann::json&, ExportSettings&);
         DJV_API void from_json(const nlohmann::json&, FileBrowserSettings&);
+        DJV_API void from_json(const nlohmann::json&, FrameCacheSettings&);
         DJV_API void from_json(const nlohmann::json&, ImageSeqSettings&);
+        DJV_API void from_json(const nlohmann::json&, MemorySettings&);
         DJV_API void from_json(const nlohmann::json&, OTIOSettings&);
         DJV_API void from_json(const nlohmann::json&, MiscSettings&);
         DJV_API void from_json(const nlohmann::json&, MouseActionBinding&);
         DJV_API void from_json(const nlohmann::json&, MouseSettings&);
         DJV_API void from_json(const nlohmann::json&, PlaybackSettings&);
+        DJV_API void from_json(const nlohmann::json&, PrefetchSettings&);
         DJV_API void from_json(const nlohmann::json&, ShortcutsSettings&);
         DJV_API void from_json(const nlohmann::json&, StyleSettings&);
         DJV_API void from_json(const nlohmann::json&, TimelineSettings&);
@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djv/Models/ThreadPool.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace djv
+{
+    namespace models
+    {
+        struct ThreadPool::Private
+        {
+            mutable std::mutex mutex;
+            std::condition_variable cv;
+            std::list<std::function<void()> > queue;
+            bool running = true;
+            std::vector<std::thread> threads;
+        };
+
+        void ThreadPool::_init(size_t threadCount)
+        {
+            FTK_P();
+            for (size_t i = 0; i < std::max(threadCount, size_t(1)); ++i)
+            {
+                p.threads.push_back(std::thread([this] { _run(); }));
+            }
+        }
+
+        ThreadPool::ThreadPool() :
+            _p(new Private)
+        {}
+
+        ThreadPool::~ThreadPool()
+        {
+            FTK_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.running = false;
+                p.queue.clear();
+            }
+            p.cv.notify_all();
+            for (auto& thread : p.threads)
+            {
+                if (thread.joinable())
+                {
+                    thread.join();
+                }
+            }
+        }
+
+        std::shared_ptr<ThreadPool> ThreadPool::create(size_t threadCount)
+        {
+            auto out = std::shared_ptr<ThreadPool>(new ThreadPool);
+            out->_init(threadCount);
+            return out;
+        }
+
+        size_t ThreadPool::getThreadCount() const
+        {
+            return _p->threads.size();
+        }
+
+        void ThreadPool::add(const std::function<void()>& value)
+        {
+            FTK_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.queue.push_back(value);
+            }
+            p.cv.notify_one();
+        }
+
+        size_t ThreadPool::getQueueSize() const
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.queue.size();
+        }
+
+        void ThreadPool::_run()
+        {
+            FTK_P();
+            while (true)
+            {
+                std::function<void()> function;
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex);
+                    p.cv.wait(
+                        lock,
+                        [this] { return !_p->queue.empty() || !_p->running; });
+                    if (!p.running)
+                        break;
+                    function = std::move(p.queue.front());
+                    p.queue.pop_front();
+                }
+                function();
+            }
+        }
+    }
+}
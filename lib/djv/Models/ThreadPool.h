@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <djv/Models/Export.h>
+
+#include <ftk/Core/Util.h>
+
+#include <functional>
+#include <memory>
+
+namespace djv
+{
+    namespace models
+    {
+        //! Thread pool.
+        //!
+        //! A fixed number of threads that run the functions given to them,
+        //! in the order they were given, for work that would otherwise
+        //! start a thread of its own each time. The threads wait on a
+        //! condition variable while there is nothing to do.
+        //!
+        //! Functions that have not started when the pool is destroyed are
+        //! not run; those that have are finished first. The pool may be
+        //! added to from any thread, but must not be destroyed from one of
+        //! its own.
+        class DJV_API_TYPE ThreadPool : public std::enable_shared_from_this<ThreadPool>
+        {
+            FTK_NON_COPYABLE(ThreadPool);
+
+        protected:
+            void _init(size_t);
+
+            ThreadPool();
+
+        public:
+            DJV_API ~ThreadPool();
+
+            //! Create a new pool with the given number of threads, at least
+            //! one.
+            DJV_API static std::shared_ptr<ThreadPool> create(size_t threadCount);
+
+            //! Get the number of threads.
+            DJV_API size_t getThreadCount() const;
+
+            //! Add a function to run.
+            DJV_API void add(const std::function<void()>&);
+
+            //! Get the number of functions that have not started yet.
+            DJV_API size_t getQueueSize() const;
+
+        private:
+            void _run();
+
+            FTK_PRIVATE();
+        };
+    }
+}
@@ -0,0 +1,268 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djv/Models/ThumbnailDiskCache.h>
+
+#include <djv/Models/ImageDiskCache.h>
+#include <djv/Models/ThreadPool.h>
+
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+
+namespace djv
+{
+    namespace models
+    {
+        namespace
+        {
+            // Everything that changes what the thumbnail looks like.
+            std::optional<std::string> getKey(
+                const ftk::Path& path,
+                int height,
+                const tl::IOOptions& ioOptions)
+            {
+                std::optional<std::string> out;
+                std::error_code ec;
+                const auto time = std::filesystem::last_write_time(
+                    std::filesystem::u8path(path.get()),
+                    ec);
+                if (!ec)
+                {
+                    std::stringstream ss;
+                    ss << path.get() << '\n';
+                    if (path.getFrames().has_value())
+                    {
+                        ss << path.getFrames()->min() << '-' << path.getFrames()->max();
+                    }
+                    ss << '\n';
+                    ss << time.time_since_epoch().count() << '\n';
+                    ss << height << '\n';
+                    for (const auto& i : ioOptions)
+                    {
+                        ss << i.first << '=' << i.second << '\n';
+                    }
+                    out = ss.str();
+                }
+                return out;
+            }
+
+            std::shared_ptr<ftk::Image> getThumbnail(
+                const std::shared_ptr<ImageDiskCache>& cache,
+                const ftk::Path& path,
+                int height,
+                const tl::IOOptions& ioOptions)
+            {
+                std::shared_ptr<ftk::Image> out;
+                if (cache->isEnabled())
+                {
+                    const auto key = getKey(path, height, ioOptions);
+                    if (key.has_value())
+                    {
+                        out = cache->get(key.value());
+                    }
+                }
+                return out;
+            }
+
+            void addThumbnail(
+                const std::shared_ptr<ImageDiskCache>& cache,
+                const ftk::Path& path,
+                int height,
+                const tl::IOOptions& ioOptions,
+                const std::shared_ptr<ftk::Image>& image)
+            {
+                if (cache->isEnabled())
+                {
+                    const auto key = getKey(path, height, ioOptions);
+                    if (key.has_value())
+                    {
+                        cache->add(key.value(), image);
+                    }
+                }
+            }
+
+            // Reading a thumbnail is small, but the cache may be on slow
+            // storage too; a couple of threads keep one slow file from
+            // holding up the rest.
+            const size_t threadCount = 2;
+
+            // Shared with the work on the threads, which may finish after
+            // the cache has gone.
+            struct Requests
+            {
+                std::mutex mutex;
+                uint64_t id = 0;
+                std::set<uint64_t> pending;
+                std::map<uint64_t, std::shared_ptr<ftk::Image> > results;
+            };
+        }
+
+        struct ThumbnailDiskCache::Private
+        {
+            std::shared_ptr<ImageDiskCache> cache;
+            std::shared_ptr<Requests> requests;
+            // Last, so that the threads are stopped first.
+            std::shared_ptr<ThreadPool> threadPool;
+        };
+
+        void ThumbnailDiskCache::_init(const std::filesystem::path& dir)
+        {
+            FTK_P();
+            p.cache = ImageDiskCache::create(dir);
+            p.requests = std::make_shared<Requests>();
+            p.threadPool = ThreadPool::create(threadCount);
+        }
+
+        ThumbnailDiskCache::ThumbnailDiskCache() :
+            _p(new Private)
+        {}
+
+        ThumbnailDiskCache::~ThumbnailDiskCache()
+        {}
+
+        std::shared_ptr<ThumbnailDiskCache> ThumbnailDiskCache::create(
+            const std::filesystem::path& dir)
+        {
+            auto out = std::shared_ptr<ThumbnailDiskCache>(new ThumbnailDiskCache);
+            out->_init(dir);
+            return out;
+        }
+
+        std::filesystem::path ThumbnailDiskCache::getCacheDir()
+        {
+            std::filesystem::path out;
+#if defined(_WINDOWS)
+            if (const char* env = std::getenv("LOCALAPPDATA"))
+            {
+                out = std::filesystem::u8path(env) / "DJV" / "Cache";
+            }
+#elif defined(__APPLE__)
+            if (const char* env = std::getenv("HOME"))
+            {
+                out = std::filesystem::u8path(env) / "Library" / "Caches" / "DJV";
+            }
+#else
+            if (const char* env = std::getenv("XDG_CACHE_HOME"))
+            {
+                out = std::filesystem::u8path(env) / "djv";
+            }
+            else if (const char* env = std::getenv("HOME"))
+            {
+                out = std::filesystem::u8path(env) / ".cache" / "djv";
+            }
+#endif
+            if (out.empty())
+            {
+                std::error_code ec;
+                out = std::filesystem::temp_directory_path(ec) / "djv";
+            }
+            return out;
+        }
+
+        std::filesystem::path ThumbnailDiskCache::getDefaultDir()
+        {
+            return getCacheDir() / "Thumbnails";
+        }
+
+        void ThumbnailDiskCache::setMaxMB(float value)
+        {
+            _p->cache->setMaxMB(value);
+        }
+
+        std::shared_ptr<ftk::Image> ThumbnailDiskCache::get(
+            const ftk::Path& path,
+            int height,
+            const tl::IOOptions& ioOptions)
+        {
+            return getThumbnail(_p->cache, path, height, ioOptions);
+        }
+
+        void ThumbnailDiskCache::add(
+            const ftk::Path& path,
+            int height,
+            const tl::IOOptions& ioOptions,
+            const std::shared_ptr<ftk::Image>& image)
+        {
+            addThumbnail(_p->cache, path, height, ioOptions, image);
+        }
+
+        uint64_t ThumbnailDiskCache::getAsync(
+            const ftk::Path& path,
+            int height,
+            const tl::IOOptions& ioOptions)
+        {
+            FTK_P();
+            uint64_t id = 0;
+            {
+                std::unique_lock<std::mutex> lock(p.requests->mutex);
+                id = ++p.requests->id;
+                p.requests->pending.insert(id);
+            }
+            auto cache = p.cache;
+            auto requests = p.requests;
+            p.threadPool->add(
+                [cache, requests, id, path, height, ioOptions]
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(requests->mutex);
+                        if (requests->pending.find(id) == requests->pending.end())
+                        {
+                            return;
+                        }
+                    }
+                    auto image = getThumbnail(cache, path, height, ioOptions);
+                    std::unique_lock<std::mutex> lock(requests->mutex);
+                    if (requests->pending.erase(id) > 0)
+                    {
+                        requests->results[id] = image;
+                    }
+                });
+            return id;
+        }
+
+        std::optional<std::shared_ptr<ftk::Image> > ThumbnailDiskCache::getResult(uint64_t id)
+        {
+            FTK_P();
+            std::optional<std::shared_ptr<ftk::Image> > out;
+            std::unique_lock<std::mutex> lock(p.requests->mutex);
+            const auto i = p.requests->results.find(id);
+            if (i != p.requests->results.end())
+            {
+                out = i->second;
+                p.requests->results.erase(i);
+            }
+            return out;
+        }
+
+        void ThumbnailDiskCache::cancelRequest(uint64_t id)
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.requests->mutex);
+            p.requests->pending.erase(id);
+            p.requests->results.erase(id);
+        }
+
+        void ThumbnailDiskCache::addAsync(
+            const ftk::Path& path,
+            int height,
+            const tl::IOOptions& ioOptions,
+            const std::shared_ptr<ftk::Image>& image)
+        {
+            FTK_P();
+            auto cache = p.cache;
+            p.threadPool->add(
+                [cache, path, height, ioOptions, image]
+                {
+                    addThumbnail(cache, path, height, ioOptions, image);
+                });
+        }
+
+        void ThumbnailDiskCache::clear()
+        {
+            _p->cache->clear();
+        }
+    }
+}
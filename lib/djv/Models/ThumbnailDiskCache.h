@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <djv/Models/Export.h>
+
+#include <tlRender/IO/IO.h>
+
+#include <ftk/Core/Image.h>
+#include <ftk/Core/Path.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+
+namespace djv
+{
+    namespace models
+    {
+        //! Thumbnail disk cache.
+        //!
+        //! Keeps the thumbnails of files on disk from one run to the next,
+        //! so that reopening a session does not decode the first frame of
+        //! every file again; on network storage that is most of the time
+        //! a large session takes to show its thumbnails.
+        //!
+        //! A thumbnail is found again by the file, its modification time,
+        //! the thumbnail height, and the I/O options it was read with, so
+        //! a file that has been written over since is read afresh rather
+        //! than shown as it was. The thumbnails are kept in an
+        //! ImageDiskCache.
+        //!
+        //! The cache has threads of its own for the user interface to hand
+        //! the disk work to, so that a widget never waits on the disk, not
+        //! even when it is destroyed with a request still going.
+        //!
+        //! The cache may be used from any thread.
+        class DJV_API_TYPE ThumbnailDiskCache : public std::enable_shared_from_this<ThumbnailDiskCache>
+        {
+            FTK_NON_COPYABLE(ThumbnailDiskCache);
+
+        protected:
+            void _init(const std::filesystem::path&);
+
+            ThumbnailDiskCache();
+
+        public:
+            DJV_API ~ThumbnailDiskCache();
+
+            //! Create a new cache in the given directory, which is made if
+            //! it does not exist.
+            DJV_API static std::shared_ptr<ThumbnailDiskCache> create(
+                const std::filesystem::path&);
+
+            //! Get the user's cache directory for DJV.
+            DJV_API static std::filesystem::path getCacheDir();
+
+            //! Get the default thumbnail cache directory, in the user's
+            //! cache directory.
+            DJV_API static std::filesystem::path getDefaultDir();
+
+            //! Set the maximum size in megabytes. Zero turns the cache off.
+            DJV_API void setMaxMB(float);
+
+            //! Get a thumbnail, or nothing when there is none.
+            DJV_API std::shared_ptr<ftk::Image> get(
+                const ftk::Path&,
+                int height,
+                const tl::IOOptions&);
+
+            //! Add a thumbnail.
+            DJV_API void add(
+                const ftk::Path&,
+                int height,
+                const tl::IOOptions&,
+                const std::shared_ptr<ftk::Image>&);
+
+            //! Look for a thumbnail on the cache's threads. The returned ID
+            //! is for getResult() and cancelRequest().
+            DJV_API uint64_t getAsync(
+                const ftk::Path&,
+                int height,
+                const tl::IOOptions&);
+
+            //! Get the result of getAsync(): nothing while it is still
+            //! being looked for, and then the thumbnail, or a null image
+            //! when there is none. A result is only given once.
+            DJV_API std::optional<std::shared_ptr<ftk::Image> > getResult(uint64_t);
+
+            //! Cancel a request made with getAsync() whose result is no
+            //! longer wanted.
+            DJV_API void cancelRequest(uint64_t);
+
+            //! Add a thumbnail on the cache's threads.
+            DJV_API void addAsync(
+                const ftk::Path&,
+                int height,
+                const tl::IOOptions&,
+                const std::shared_ptr<ftk::Image>&);
+
+            //! Remove every thumbnail.
+            DJV_API void clear();
+
+        private:
+            FTK_PRIVATE();
+        };
+    }
+}
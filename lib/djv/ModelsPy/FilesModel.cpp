@@ -11,6 +11,7 @@
 
 #include <pybind11/stl.h>
 #include <pybind11/functional.h>
+#include <pybind11/operators.h>
 
 namespace py = pybind11;
 
@@ -24,6 +25,7 @@ namespace djv
 
             py::class_<FilesModelItem, std::shared_ptr<FilesModelItem> >(m, "FilesModelItem")
                 .def(py::init<>())
+                .def_readonly("id", &FilesModelItem::id)
                 .def_readwrite("path", &FilesModelItem::path)
                 .def_readwrite("audioPath", &FilesModelItem::audioPath)
                 .def_readwrite("videoLayers", &FilesModelItem::videoLayers)
@@ -35,8 +37,25 @@ namespace djv
                 .def_readwrite("framesStated", &FilesModelItem::framesStated)
                 .def_readwrite("newFile", &FilesModelItem::newFile);
 
+            py::enum_<FilesModelChangeType>(m, "FilesModelChangeType")
+                .value("Added", FilesModelChangeType::Added)
+                .value("Removed", FilesModelChangeType::Removed)
+                .value("Moved", FilesModelChangeType::Moved)
+                .value("Changed", FilesModelChangeType::Changed);
+            FTK_ENUM_BIND(m, FilesModelChangeType);
+
+            py::class_<FilesModelChange>(m, "FilesModelChange")
+                .def(py::init())
+                .def_readwrite("type", &FilesModelChange::type)
+                .def_readwrite("item", &FilesModelChange::item)
+                .def_readwrite("index", &FilesModelChange::index)
+                .def_readwrite("prevIndex", &FilesModelChange::prevIndex)
+                .def(pybind11::self == pybind11::self)
+                .def(pybind11::self != pybind11::self);
+
             ftk::python::observable<std::shared_ptr<FilesModelItem> >(m, "FilesModelItem");
             ftk::python::observableList<std::shared_ptr<FilesModelItem> >(m, "FilesModelItem");
+            ftk::python::observableList<FilesModelChange>(m, "FilesModelChange");
             ftk::python::observable<tl::CompareOptions>(m, "CompareOptions");
             ftk::python::observable<tl::CompareTime>(m, "CompareTime");
 
@@ -47,6 +66,9 @@ namespace djv
 
                 .def_property_readonly("files", &FilesModel::getFiles)
                 .def_property_readonly("observeFiles", &FilesModel::observeFiles)
+                .def_property_readonly("observeChanges", &FilesModel::observeChanges)
+                .def("getIndex", &FilesModel::getIndex, py::arg("item"))
+                .def("getItem", &FilesModel::getItem, py::arg("id"))
                 .def_property_readonly("a", &FilesModel::getA)
                 .def_property_readonly("observeA", &FilesModel::observeA)
                 .def_property_readonly("aIndex", &FilesModel::getAIndex)
@@ -62,6 +84,7 @@ namespace djv
                 .def("close", py::overload_cast<>(&FilesModel::close))
                 .def("close", py::overload_cast<int>(&FilesModel::close), py::arg("index"))
                 .def("closeAll", &FilesModel::closeAll)
+                .def("move", &FilesModel::move, py::arg("index"), py::arg("newIndex"))
                 .def("setA", &FilesModel::setA, py::arg("index"))
                 .def("setB", &FilesModel::setB, py::arg("index"), py::arg("value"))
                 .def("toggleB", &FilesModel::toggleB, py::arg("index"))
@@ -79,7 +102,8 @@ namespace djv
                 .def("setLayer", &FilesModel::setLayer, py::arg("item"), py::arg("layer"))
                 .def("setFrames", &FilesModel::setFrames, py::arg("item"), py::arg("range"))
                 .def_property_readonly("observeReload", &FilesModel::observeReload)
-                .def("refresh", &FilesModel::refresh)
+                .def("refresh", py::overload_cast<>(&FilesModel::refresh))
+                .def("refresh", py::overload_cast<const std::shared_ptr<FilesModelItem>&>(&FilesModel::refresh), py::arg("item"))
                 .def("nextLayer", &FilesModel::nextLayer)
                 .def("prevLayer", &FilesModel::prevLayer)
 
@@ -29,6 +29,14 @@ namespace djv
                 .def(pybind11::self == pybind11::self)
                 .def(pybind11::self != pybind11::self);
 
+            py::class_<DiskCacheSettings>(m, "DiskCacheSettings")
+                .def(py::init())
+                .def_readwrite("thumbnailMB", &DiskCacheSettings::thumbnailMB)
+                .def_readwrite("frameGB", &DiskCacheSettings::frameGB)
+                .def_readwrite("frameDir", &DiskCacheSettings::frameDir)
+                .def(pybind11::self == pybind11::self)
+                .def(pybind11::self != pybind11::self);
+
             py::enum_<ExportRenderSize>(m, "ExportRenderSize")
                 .value("Default", ExportRenderSize::Default)
                 .value("_1920", ExportRenderSize::_1920)
@@ -73,6 +81,17 @@ namespace djv
                 .def(pybind11::self == pybind11::self)
                 .def(pybind11::self != pybind11::self);
 
+            py::enum_<FrameCacheMode>(m, "FrameCacheMode")
+                .value("Uncompressed", FrameCacheMode::Uncompressed)
+                .value("Compressed", FrameCacheMode::Compressed);
+            FTK_ENUM_BIND(m, FrameCacheMode);
+
+            py::class_<FrameCacheSettings>(m, "FrameCacheSettings")
+                .def(py::init())
+                .def_readwrite("mode", &FrameCacheSettings::mode)
+                .def(pybind11::self == pybind11::self)
+                .def(pybind11::self != pybind11::self);
+
             // The "io" field is omitted: tl::SeqOptions is not bound.
             py::class_<ImageSeqSettings>(m, "ImageSeqSettings")
                 .def(py::init())
@@ -81,6 +100,7 @@ namespace djv
                 .def_readwrite("audioFileName", &ImageSeqSettings::audioFileName)
                 .def_readwrite("maxDigits", &ImageSeqSettings::maxDigits)
                 .def_readwrite("readThreadCount", &ImageSeqSettings::readThreadCount)
+                .def_readwrite("readThreadAuto", &ImageSeqSettings::readThreadAuto)
                 .def(pybind11::self == pybind11::self)
                 .def(pybind11::self != pybind11::self);
 
@@ -91,6 +111,12 @@ namespace djv
                 .def(pybind11::self == pybind11::self)
                 .def(pybind11::self != pybind11::self);
 
+            py::class_<MemorySettings>(m, "MemorySettings")
+                .def(py::init())
+                .def_readwrite("budgetGB", &MemorySettings::budgetGB)
+                .def(pybind11::self == pybind11::self)
+                .def(pybind11::self != pybind11::self);
+
             py::class_<MiscSettings>(m, "MiscSettings")
                 .def(py::init())
                 .def_readwrite("tooltipsEnabled", &MiscSettings::tooltipsEnabled)
@@ -127,6 +153,17 @@ namespace djv
             py::class_<PlaybackSettings>(m, "PlaybackSettings")
                 .def(py::init())
                 .def_readwrite("startPlayback", &PlaybackSettings::startPlayback)
+                .def_readwrite("adaptiveResolution", &PlaybackSettings::adaptiveResolution)
+                .def_readwrite("scrubProxies", &PlaybackSettings::scrubProxies)
+                .def(pybind11::self == pybind11::self)
+                .def(pybind11::self != pybind11::self);
+
+            py::class_<PrefetchSettings>(m, "PrefetchSettings")
+                .def(py::init())
+                .def_readwrite("files", &PrefetchSettings::files)
+                .def_readwrite("videoGB", &PrefetchSettings::videoGB)
+                .def_readwrite("lazyOpen", &PrefetchSettings::lazyOpen)
+                .def_readwrite("openInBackground", &PrefetchSettings::openInBackground)
                 .def(pybind11::self == pybind11::self)
                 .def(pybind11::self != pybind11::self);
 
@@ -190,13 +227,17 @@ namespace djv
                 .def(pybind11::self != pybind11::self);
 
             ftk::python::observable<AudioSettings>(m, "AudioSettings");
+            ftk::python::observable<DiskCacheSettings>(m, "DiskCacheSettings");
             ftk::python::observable<ExportSettings>(m, "ExportSettings");
             ftk::python::observable<FileBrowserSettings>(m, "FileBrowserSettings");
+            ftk::python::observable<FrameCacheSettings>(m, "FrameCacheSettings");
             ftk::python::observable<ImageSeqSettings>(m, "ImageSeqSettings");
+            ftk::python::observable<MemorySettings>(m, "MemorySettings");
             ftk::python::observable<OTIOSettings>(m, "OTIOSettings");
             ftk::python::observable<MiscSettings>(m, "MiscSettings");
             ftk::python::observable<MouseSettings>(m, "MouseSettings");
             ftk::python::observable<PlaybackSettings>(m, "PlaybackSettings");
+            ftk::python::observable<PrefetchSettings>(m, "PrefetchSettings");
             ftk::python::observable<ShortcutsSettings>(m, "ShortcutsSettings");
             ftk::python::observable<StyleSettings>(m, "StyleSettings");
             ftk::python::observable<TimelineSettings>(m, "TimelineSettings");
@@ -218,6 +259,18 @@ namespace djv
                 .def_property("cache", &SettingsModel::getCache, &SettingsModel::setCache, py::return_value_policy::copy)
                 .def_property_readonly("observeCache", &SettingsModel::observeCache)
 
+                .def_property("diskCache", &SettingsModel::getDiskCache, &SettingsModel::setDiskCache, py::return_value_policy::copy)
+                .def_property_readonly("observeDiskCache", &SettingsModel::observeDiskCache)
+
+                .def_property("prefetch", &SettingsModel::getPrefetch, &SettingsModel::setPrefetch, py::return_value_policy::copy)
+                .def_property_readonly("observePrefetch", &SettingsModel::observePrefetch)
+
+                .def_property("frameCache", &SettingsModel::getFrameCache, &SettingsModel::setFrameCache, py::return_value_policy::copy)
+                .def_property_readonly("observeFrameCache", &SettingsModel::observeFrameCache)
+
+                .def_property("memory", &SettingsModel::getMemory, &SettingsModel::setMemory, py::return_value_policy::copy)
+                .def_property_readonly("observeMemory", &SettingsModel::observeMemory)
+
                 .def_property("export", &SettingsModel::getExport, &SettingsModel::setExport, py::return_value_policy::copy)
                 .def_property_readonly("observeExport", &SettingsModel::observeExport)
 
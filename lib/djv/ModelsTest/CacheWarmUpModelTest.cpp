@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djv/ModelsTest/CacheWarmUpModelTest.h>
+
+#include <djv/Models/CacheWarmUpModel.h>
+
+#include <ftk/Core/Assert.h>
+
+#include <cmath>
+
+namespace djv
+{
+    namespace models_tests
+    {
+        CacheWarmUpModelTest::CacheWarmUpModelTest(const std::shared_ptr<ftk::Context>& context) :
+            ITest(context, "models_tests::CacheWarmUpModelTest")
+        {}
+
+        std::shared_ptr<CacheWarmUpModelTest> CacheWarmUpModelTest::create(
+            const std::shared_ptr<ftk::Context>& context)
+        {
+            return std::shared_ptr<CacheWarmUpModelTest>(new CacheWarmUpModelTest(context));
+        }
+
+        void CacheWarmUpModelTest::run()
+        {
+            _text();
+            _model();
+        }
+
+        void CacheWarmUpModelTest::_text()
+        {
+            models::CacheWarmUp warmUp;
+            FTK_CHECK(models::getText(warmUp).empty());
+            warmUp.active = true;
+            warmUp.percentage = 40.F;
+            FTK_CHECK("Warming up the cache: 40%" == models::getText(warmUp));
+            warmUp.eta = 11.5;
+            FTK_CHECK("Warming up the cache: 40%, 12s left" == models::getText(warmUp));
+            warmUp.eta = 75.0;
+            FTK_CHECK("Warming up the cache: 40%, 1m 15s left" == models::getText(warmUp));
+        }
+
+        void CacheWarmUpModelTest::_model()
+        {
+            auto model = models::CacheWarmUpModel::create();
+            FTK_CHECK(!model->observeWarmUp()->get().active);
+            const auto t = std::chrono::steady_clock::now();
+
+            // Not started: nothing to finish.
+            FTK_CHECK(!model->update(100.0, 100.0, false, t));
+
+            // No rate until enough has been measured.
+            model->start(true);
+            FTK_CHECK(model->observeWarmUp()->get().active);
+            FTK_CHECK(model->observeWarmUp()->get().play);
+            FTK_CHECK(!model->update(0.0, 100.0, false, t));
+            FTK_CHECK(!model->observeWarmUp()->get().eta.has_value());
+
+            // Twenty frames a second, with sixty frames left.
+            FTK_CHECK(!model->update(40.0, 100.0, false, t + std::chrono::seconds(2)));
+            auto warmUp = model->observeWarmUp()->get();
+            FTK_CHECK(40.F == warmUp.percentage);
+            FTK_CHECK(warmUp.eta.has_value());
+            FTK_CHECK(std::abs(warmUp.eta.value() - 3.0) < .001);
+
+            // Finished when the whole range is cached.
+            FTK_CHECK(model->update(100.0, 100.0, false, t + std::chrono::seconds(5)));
+            warmUp = model->observeWarmUp()->get();
+            FTK_CHECK(!warmUp.active);
+            FTK_CHECK(100.F == warmUp.percentage);
+            FTK_CHECK(warmUp.play);
+
+            // A full cache finishes once it stops growing.
+            model->start(false);
+            FTK_CHECK(!model->update(50.0, 100.0, true, t));
+            FTK_CHECK(!model->update(50.0, 100.0, true, t + std::chrono::milliseconds(500)));
+            FTK_CHECK(model->update(50.0, 100.0, true, t + std::chrono::seconds(2)));
+            FTK_CHECK(50.F == model->observeWarmUp()->get().percentage);
+
+            // Cancelled.
+            model->start(false);
+            model->cancel();
+            FTK_CHECK(!model->observeWarmUp()->get().active);
+            FTK_CHECK(!model->update(100.0, 100.0, false, t));
+        }
+    }
+}
@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djv/ModelsTest/CompressedImageCacheTest.h>
+
+#include <djv/Models/CompressedImageCache.h>
+
+#include <ftk/Core/Assert.h>
+
+#include <cstring>
+
+namespace djv
+{
+    namespace models_tests
+    {
+        CompressedImageCacheTest::CompressedImageCacheTest(const std::shared_ptr<ftk::Context>& context) :
+            ITest(context, "models_tests::CompressedImageCacheTest")
+        {}
+
+        std::shared_ptr<CompressedImageCacheTest> CompressedImageCacheTest::create(
+            const std::shared_ptr<ftk::Context>& context)
+        {
+            return std::shared_ptr<CompressedImageCacheTest>(new CompressedImageCacheTest(context));
+        }
+
+        void CompressedImageCacheTest::run()
+        {
+            _compress();
+            _cache();
+        }
+
+        void CompressedImageCacheTest::_compress()
+        {
+            // An odd width, so that rows of 8-bit images are padded, and a
+            // gradient with an opaque alpha, which should get smaller.
+            for (const auto type : {
+                ftk::ImageType::L_U8,
+                ftk::ImageType::RGB_U8,
+                ftk::ImageType::RGBA_U16,
+                ftk::ImageType::RGBA_F16,
+                ftk::ImageType::RGB_F32 })
+            {
+                const ftk::ImageInfo info(ftk::Size2I(61, 17), type);
+                auto image = ftk::Image::create(info);
+                uint8_t* data = image->getData();
+                const size_t byteCount = image->getByteCount();
+                for (size_t i = 0; i < byteCount; ++i)
+                {
+                    data[i] = static_cast<uint8_t>(i / 7);
+                }
+                const auto compressed = models::compressImage(image);
+                FTK_CHECK(!compressed.empty());
+                FTK_CHECK(compressed.size() <= byteCount + 1);
+                auto out = ftk::Image::create(info);
+                FTK_CHECK(models::decompressImage(compressed, out));
+                FTK_CHECK(0 == memcmp(data, out->getData(), byteCount));
+
+                // Noise, which is stored as it is.
+                uint32_t seed = 1;
+                for (size_t i = 0; i < byteCount; ++i)
+                {
+                    seed = seed * 1664525 + 1013904223;
+                    data[i] = static_cast<uint8_t>(seed >> 24);
+                }
+                const auto raw = models::compressImage(image);
+                FTK_CHECK(models::decompressImage(raw, out));
+                FTK_CHECK(0 == memcmp(data, out->getData(), byteCount));
+            }
+
+            // Data that does not match the image.
+            auto image = ftk::Image::create(ftk::ImageInfo(
+                ftk::Size2I(16, 16),
+                ftk::ImageType::RGBA_U8));
+            FTK_CHECK(!models::decompressImage(std::vector<uint8_t>(), image));
+            FTK_CHECK(!models::decompressImage(std::vector<uint8_t>(3, 0), image));
+        }
+
+        void CompressedImageCacheTest::_cache()
+        {
+            auto image = ftk::Image::create(ftk::ImageInfo(
+                ftk::Size2I(64, 64),
+                ftk::ImageType::RGBA_U16));
+            for (size_t i = 0; i < image->getByteCount(); ++i)
+            {
+                image->getData()[i] = static_cast<uint8_t>(i % 251);
+            }
+            ftk::ImageTags tags;
+            tags["Name"] = "a";
+            image->setTags(tags);
+
+            // Nothing is kept until the cache is given a size.
+            auto cache = models::CompressedImageCache::create();
+            cache->add("a", image);
+            FTK_CHECK(!cache->contains("a"));
+            FTK_CHECK(!cache->get("a"));
+            FTK_CHECK(0 == cache->getStats().count);
+
+            cache->setMaxMB(1.F);
+            cache->add("a", image);
+            FTK_CHECK(cache->contains("a"));
+            FTK_CHECK(!cache->contains("b"));
+            auto out = cache->get("a");
+            FTK_CHECK(out);
+            FTK_CHECK(image->getInfo() == out->getInfo());
+            FTK_CHECK(image->getTags() == out->getTags());
+            FTK_CHECK(0 == memcmp(image->getData(), out->getData(), image->getByteCount()));
+            FTK_CHECK(!cache->get("b"));
+            auto stats = cache->getStats();
+            FTK_CHECK(1 == stats.count);
+            FTK_CHECK(image->getByteCount() == stats.uncompressedSize);
+
+            // The least recently used images are removed first; each image
+            // is at most 32 KB, so a 1 MB cache keeps at least thirty.
+            for (int i = 0; i < 100; ++i)
+            {
+                cache->get("a");
+                cache->add(std::to_string(i), image);
+            }
+            stats = cache->getStats();
+            FTK_CHECK(stats.size <= 1024 * 1024);
+            FTK_CHECK(stats.count < 101);
+            FTK_CHECK(cache->get("a"));
+            FTK_CHECK(!cache->get("0"));
+
+            cache->setMaxMB(0.F);
+            FTK_CHECK(0 == cache->getStats().count);
+            cache->setMaxMB(1.F);
+            cache->add("a", image);
+            cache->clear();
+            FTK_CHECK(!cache->get("a"));
+            FTK_CHECK(models::CompressedImageCacheStats() == cache->getStats());
+        }
+    }
+}
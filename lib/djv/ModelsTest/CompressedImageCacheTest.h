@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <ftk/TestLib/ITest.h>
+
+namespace djv
+{
+    namespace models_tests
+    {
+        class CompressedImageCacheTest : public ftk::test::ITest
+        {
+        protected:
+            CompressedImageCacheTest(const std::shared_ptr<ftk::Context>&);
+
+        public:
+            static std::shared_ptr<CompressedImageCacheTest> create(
+                const std::shared_ptr<ftk::Context>&);
+
+            void run() override;
+
+        private:
+            void _compress();
+            void _cache();
+        };
+    }
+}
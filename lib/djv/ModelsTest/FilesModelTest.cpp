@@ -52,6 +52,7 @@ namespace djv
             _compare();
             _frames();
             _refresh();
+            _changes();
             _persistence();
         }
 
@@ -89,6 +90,18 @@ namespace djv
             FTK_CHECK(item2 == model->getA());
             FTK_CHECK(2 == model->getAIndex());
 
+            // Adding several at once appends them all, with the last as the
+            // "A" file.
+            auto item3 = makeItem("file3.exr");
+            auto item4 = makeItem("file4.exr");
+            model->add(Items{ item3, item4 });
+            FTK_CHECK(5 == model->getFiles().size());
+            FTK_CHECK(item4 == model->getA());
+            FTK_CHECK(4 == model->getAIndex());
+            FTK_CHECK(5 == count);
+            model->close(4);
+            model->close(3);
+
             // Closing a file removes it and re-clamps the "A" index.
             model->close(1);
             FTK_CHECK(2 == model->getFiles().size());
@@ -302,6 +315,89 @@ namespace djv
             FTK_CHECK(observed.empty());
         }
 
+        void FilesModelTest::_changes()
+        {
+            typedef std::vector<std::shared_ptr<models::FilesModelItem> > Items;
+            typedef std::vector<models::FilesModelChange> Changes;
+
+            auto settings = createTestSettings(_context);
+            auto model = models::FilesModel::create(settings);
+
+            Changes changes;
+            auto observer = ftk::ListObserver<models::FilesModelChange>::create(
+                model->observeChanges(),
+                [&changes](const Changes& value)
+                {
+                    changes = value;
+                },
+                ftk::ObserverAction::Suppress);
+
+            // Each file is given an ID of its own, and is found by it.
+            auto item0 = makeItem("file0.exr");
+            auto item1 = makeItem("file1.exr");
+            auto item2 = makeItem("file2.exr");
+            model->add(item0);
+            FTK_CHECK(Changes({ { models::FilesModelChangeType::Added, item0, 0 } }) == changes);
+            model->add(Items({ item1, item2 }));
+            FTK_CHECK(Changes({
+                { models::FilesModelChangeType::Added, item1, 1 },
+                { models::FilesModelChangeType::Added, item2, 2 } }) == changes);
+            FTK_CHECK(item0->id != 0);
+            FTK_CHECK(item0->id != item1->id);
+            FTK_CHECK(item1->id != item2->id);
+            FTK_CHECK(item1 == model->getItem(item1->id));
+            FTK_CHECK(1 == model->getIndex(item1));
+            FTK_CHECK(-1 == model->getIndex(makeItem("other.exr")));
+            FTK_CHECK(-1 == model->getIndex(nullptr));
+
+            // Moving a file moves the "A" file index with it.
+            model->move(2, 0);
+            FTK_CHECK(Changes({ { models::FilesModelChangeType::Moved, item2, 0, 2 } }) == changes);
+            FTK_CHECK(Items({ item2, item0, item1 }) == model->getFiles());
+            FTK_CHECK(item2 == model->getA());
+            FTK_CHECK(0 == model->getAIndex());
+            FTK_CHECK(2 == model->getIndex(item1));
+
+            // A change to one item is announced for that item alone, and the
+            // list is not announced again.
+            size_t count = 0;
+            auto filesObserver = ftk::ListObserver<std::shared_ptr<models::FilesModelItem> >::create(
+                model->observeFiles(),
+                [&count](const Items&)
+                {
+                    ++count;
+                },
+                ftk::ObserverAction::Suppress);
+            model->refresh(item0);
+            FTK_CHECK(Changes({ { models::FilesModelChangeType::Changed, item0, 1 } }) == changes);
+            FTK_CHECK(0 == count);
+            model->setWatch(item1, true);
+            FTK_CHECK(Changes({ { models::FilesModelChangeType::Changed, item1, 2 } }) == changes);
+            FTK_CHECK(0 == count);
+
+            // The files after one that is closed are found where they are
+            // now.
+            model->close(0);
+            FTK_CHECK(Changes({ { models::FilesModelChangeType::Removed, item2, 0 } }) == changes);
+            FTK_CHECK(-1 == model->getIndex(item2));
+            FTK_CHECK(!model->getItem(item2->id));
+            FTK_CHECK(0 == model->getIndex(item0));
+            FTK_CHECK(1 == model->getIndex(item1));
+
+            // Closing everything removes from the end, so the indexes hold
+            // when the changes are applied in order.
+            model->closeAll();
+            FTK_CHECK(Changes({
+                { models::FilesModelChangeType::Removed, item1, 1 },
+                { models::FilesModelChangeType::Removed, item0, 0 } }) == changes);
+            FTK_CHECK(-1 == model->getIndex(item0));
+
+            // IDs are not used again.
+            const uint64_t id = item1->id;
+            model->add(item0);
+            FTK_CHECK(item0->id > id);
+        }
+
         void FilesModelTest::_persistence()
         {
             // FilesModel persists the compare options and compare time (not the
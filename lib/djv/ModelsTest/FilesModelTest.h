@@ -26,6 +26,7 @@ namespace djv
             void _compare();
             void _frames();
             void _refresh();
+            void _changes();
             void _persistence();
         };
     }
@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djv/ModelsTest/FrameBufferPoolTest.h>
+
+#include <djv/Models/FrameBufferPool.h>
+
+#include <ftk/Core/Assert.h>
+
+#include <cstring>
+
+namespace djv
+{
+    namespace models_tests
+    {
+        FrameBufferPoolTest::FrameBufferPoolTest(const std::shared_ptr<ftk::Context>& context) :
+            ITest(context, "models_tests::FrameBufferPoolTest")
+        {}
+
+        std::shared_ptr<FrameBufferPoolTest> FrameBufferPoolTest::create(
+            const std::shared_ptr<ftk::Context>& context)
+        {
+            return std::shared_ptr<FrameBufferPoolTest>(new FrameBufferPoolTest(context));
+        }
+
+        void FrameBufferPoolTest::run()
+        {
+            _reuse();
+            _release();
+        }
+
+        void FrameBufferPoolTest::_reuse()
+        {
+            auto pool = models::FrameBufferPool::create();
+            const ftk::ImageInfo info(ftk::Size2I(1024, 512), ftk::ImageType::RGBA_U16);
+            {
+                auto image = pool->createImage(info);
+                FTK_CHECK(image->getInfo() == info);
+                FTK_CHECK(image->getByteCount() == info.getByteCount());
+                std::memset(image->getData(), 1, image->getByteCount());
+                const auto stats = pool->getStats();
+                FTK_CHECK(stats.used >= info.getByteCount());
+                FTK_CHECK(0 == stats.free);
+                FTK_CHECK(0 == stats.hits);
+                FTK_CHECK(1 == stats.misses);
+            }
+
+            // Let go of, the memory is kept for the next image.
+            auto stats = pool->getStats();
+            FTK_CHECK(0 == stats.used);
+            FTK_CHECK(stats.free >= info.getByteCount());
+
+            // An image a little smaller falls in the same size class.
+            auto image = pool->createImage(ftk::ImageInfo(ftk::Size2I(1024, 500), ftk::ImageType::RGBA_U16));
+            stats = pool->getStats();
+            FTK_CHECK(0 == stats.free);
+            FTK_CHECK(1 == stats.hits);
+
+            // One twice the size does not.
+            auto image2 = pool->createImage(ftk::ImageInfo(ftk::Size2I(1024, 1024), ftk::ImageType::RGBA_U16));
+            stats = pool->getStats();
+            FTK_CHECK(1 == stats.hits);
+            FTK_CHECK(2 == stats.misses);
+
+            // Small images are left to the allocator.
+            auto image3 = pool->createImage(ftk::ImageInfo(ftk::Size2I(64, 64), ftk::ImageType::RGBA_U8));
+            FTK_CHECK(stats == pool->getStats());
+
+            // Images may outlive the pool.
+            pool.reset();
+            std::memset(image->getData(), 2, image->getByteCount());
+        }
+
+        void FrameBufferPoolTest::_release()
+        {
+            auto pool = models::FrameBufferPool::create();
+            const ftk::ImageInfo info(ftk::Size2I(1024, 512), ftk::ImageType::RGBA_U16);
+            pool->createImage(info);
+            auto stats = pool->getStats();
+            FTK_CHECK(stats.free > 0);
+            FTK_CHECK(0 == stats.released);
+
+            // Lowering the maximum gives back what does not fit.
+            const uint64_t free = stats.free;
+            pool->setMaxFreeMB(0.F);
+            stats = pool->getStats();
+            FTK_CHECK(0 == stats.free);
+            FTK_CHECK(free == stats.released);
+
+            // Nothing is kept while the maximum is zero.
+            pool->createImage(info);
+            stats = pool->getStats();
+            FTK_CHECK(0 == stats.free);
+            FTK_CHECK(2 * free == stats.released);
+
+            pool->setMaxFreeMB(512.F);
+            pool->createImage(info);
+            FTK_CHECK(free == pool->getStats().free);
+            pool->release();
+            stats = pool->getStats();
+            FTK_CHECK(0 == stats.free);
+            FTK_CHECK(3 * free == stats.released);
+        }
+    }
+}
@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <ftk/TestLib/ITest.h>
+
+namespace djv
+{
+    namespace models_tests
+    {
+        class FrameBufferPoolTest : public ftk::test::ITest
+        {
+        protected:
+            FrameBufferPoolTest(const std::shared_ptr<ftk::Context>&);
+
+        public:
+            static std::shared_ptr<FrameBufferPoolTest> create(
+                const std::shared_ptr<ftk::Context>&);
+
+            void run() override;
+
+        private:
+            void _reuse();
+            void _release();
+        };
+    }
+}
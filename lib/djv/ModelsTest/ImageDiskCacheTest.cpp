@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djv/ModelsTest/ImageDiskCacheTest.h>
+
+#include <djv/Models/ImageDiskCache.h>
+
+#include <ftk/Core/Assert.h>
+
+#include <cstring>
+#include <filesystem>
+
+namespace djv
+{
+    namespace models_tests
+    {
+        ImageDiskCacheTest::ImageDiskCacheTest(const std::shared_ptr<ftk::Context>& context) :
+            ITest(context, "models_tests::ImageDiskCacheTest")
+        {}
+
+        std::shared_ptr<ImageDiskCacheTest> ImageDiskCacheTest::create(
+            const std::shared_ptr<ftk::Context>& context)
+        {
+            return std::shared_ptr<ImageDiskCacheTest>(new ImageDiskCacheTest(context));
+        }
+
+        void ImageDiskCacheTest::run()
+        {
+            _cache();
+        }
+
+        void ImageDiskCacheTest::_cache()
+        {
+            const std::filesystem::path dir =
+                std::filesystem::temp_directory_path() / "djvImageDiskCacheTest";
+            std::filesystem::remove_all(dir);
+
+            auto image = ftk::Image::create(ftk::ImageInfo(
+                ftk::Size2I(64, 32),
+                ftk::ImageType::RGBA_U8));
+            for (size_t i = 0; i < image->getByteCount(); ++i)
+            {
+                image->getData()[i] = static_cast<uint8_t>(i);
+            }
+            ftk::ImageTags tags;
+            tags["Chromaticities"] = "0.64 0.33 0.3 0.6 0.15 0.06 0.3127 0.329";
+            tags["Empty"] = std::string();
+            image->setTags(tags);
+
+            // Nothing is kept until the cache is given a size.
+            auto cache = models::ImageDiskCache::create(dir);
+            cache->add("a", image);
+            FTK_CHECK(!cache->contains("a"));
+            FTK_CHECK(!cache->get("a"));
+
+            cache->setMaxMB(1.F);
+            cache->add("a", image);
+            FTK_CHECK(cache->contains("a"));
+            FTK_CHECK(!cache->contains("b"));
+            auto out = cache->get("a");
+            FTK_CHECK(out);
+            FTK_CHECK(image->getInfo() == out->getInfo());
+            FTK_CHECK(0 == memcmp(image->getData(), out->getData(), image->getByteCount()));
+            FTK_CHECK(tags == out->getTags());
+            FTK_CHECK(!cache->get("b"));
+
+            // Everything about how the pixels are laid out and taken comes
+            // back too: rows padded to four bytes, bottom up, in the other
+            // byte order, with legal range video levels.
+            ftk::ImageInfo info(ftk::Size2I(63, 31), ftk::ImageType::RGB_U16);
+            info.name = "DPX";
+            info.pixelAspectRatio = 2.F;
+            info.videoLevels = ftk::VideoLevels::LegalRange;
+            info.yuvCoefficients = ftk::YUVCoefficients::BT2020;
+            info.layout.mirror.y = true;
+            info.layout.alignment = 4;
+            info.layout.endian = ftk::Endian::MSB == ftk::getEndian() ?
+                ftk::Endian::LSB :
+                ftk::Endian::MSB;
+            auto image2 = ftk::Image::create(info);
+            for (size_t i = 0; i < image2->getByteCount(); ++i)
+            {
+                image2->getData()[i] = static_cast<uint8_t>(i * 3);
+            }
+            cache->add("c", image2);
+            out = cache->get("c");
+            FTK_CHECK(out);
+            const ftk::ImageInfo& outInfo = out->getInfo();
+            FTK_CHECK(info == outInfo);
+            FTK_CHECK(info.name == outInfo.name);
+            FTK_CHECK(info.pixelAspectRatio == outInfo.pixelAspectRatio);
+            FTK_CHECK(info.videoLevels == outInfo.videoLevels);
+            FTK_CHECK(info.yuvCoefficients == outInfo.yuvCoefficients);
+            FTK_CHECK(info.layout.mirror.x == outInfo.layout.mirror.x);
+            FTK_CHECK(info.layout.mirror.y == outInfo.layout.mirror.y);
+            FTK_CHECK(info.layout.alignment == outInfo.layout.alignment);
+            FTK_CHECK(info.layout.endian == outInfo.layout.endian);
+            FTK_CHECK(image2->getByteCount() == out->getByteCount());
+            FTK_CHECK(0 == memcmp(image2->getData(), out->getData(), image2->getByteCount()));
+
+            // A second cache on the same directory, as another instance
+            // would have, finds what the first one added.
+            auto cache2 = models::ImageDiskCache::create(dir);
+            cache2->setMaxMB(1.F);
+            FTK_CHECK(cache2->get("a"));
+
+            // Each image is 8 KB, so a 1 MB cache keeps about a hundred of
+            // them. Which ones depends on the file times, which are too
+            // coarse on some file systems to test here.
+            for (int i = 0; i < 200; ++i)
+            {
+                cache->add(std::to_string(i), image);
+            }
+            FTK_CHECK(cache->getSize() > 0);
+            FTK_CHECK(cache->getSize() <= 1024 * 1024);
+
+            cache->clear();
+            FTK_CHECK(!cache->get("a"));
+            FTK_CHECK(0 == cache->getSize());
+
+            std::filesystem::remove_all(dir);
+        }
+    }
+}
@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <ftk/TestLib/ITest.h>
+
+namespace djv
+{
+    namespace models_tests
+    {
+        class ImageDiskCacheTest : public ftk::test::ITest
+        {
+        protected:
+            ImageDiskCacheTest(const std::shared_ptr<ftk::Context>&);
+
+        public:
+            static std::shared_ptr<ImageDiskCacheTest> create(
+                const std::shared_ptr<ftk::Context>&);
+
+            void run() override;
+
+        private:
+            void _cache();
+        };
+    }
+}
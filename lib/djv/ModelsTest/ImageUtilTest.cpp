@@ -0,0 +1,205 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djv/ModelsTest/ImageUtilTest.h>
+
+#include <djv/Models/FrameBufferPool.h>
+#include <djv/Models/ImageUtil.h>
+
+#include <ftk/Core/Assert.h>
+
+#include <cmath>
+#include <cstring>
+
+namespace djv
+{
+    namespace models_tests
+    {
+        ImageUtilTest::ImageUtilTest(const std::shared_ptr<ftk::Context>& context) :
+            ITest(context, "models_tests::ImageUtilTest")
+        {}
+
+        std::shared_ptr<ImageUtilTest> ImageUtilTest::create(
+            const std::shared_ptr<ftk::Context>& context)
+        {
+            return std::shared_ptr<ImageUtilTest>(new ImageUtilTest(context));
+        }
+
+        void ImageUtilTest::run()
+        {
+            _decimate();
+            _crop();
+            _stats();
+        }
+
+        void ImageUtilTest::_decimate()
+        {
+            for (const auto type : {
+                ftk::ImageType::L_U8,
+                ftk::ImageType::RGB_U8,
+                ftk::ImageType::RGBA_U8,
+                ftk::ImageType::RGBA_F16 })
+            {
+                const ftk::ImageInfo info(ftk::Size2I(5, 3), type);
+                auto image = ftk::Image::create(info);
+                const size_t rowBytes = image->getByteCount() / 3;
+                const size_t pixelBytes = rowBytes / 5;
+                for (size_t y = 0; y < 3; ++y)
+                {
+                    for (size_t x = 0; x < 5 * pixelBytes; ++x)
+                    {
+                        image->getData()[y * rowBytes + x] =
+                            static_cast<uint8_t>(y * 5 + x / pixelBytes);
+                    }
+                }
+                ftk::ImageTags tags;
+                tags["Name"] = "Value";
+                image->setTags(tags);
+
+                // A factor of one, or less, is the image itself.
+                FTK_CHECK(models::decimateImage(image, 1) == image);
+                FTK_CHECK(models::decimateImage(image, 0) == image);
+
+                // Odd sizes round up, so the last row and column are kept.
+                auto pool = models::FrameBufferPool::create();
+                auto out = models::decimateImage(image, 2, pool);
+                FTK_CHECK(out->getInfo().type == type);
+                FTK_CHECK(ftk::Size2I(3, 2) == out->getInfo().size);
+                FTK_CHECK(out->getTags() == tags);
+                const size_t outRowBytes = out->getByteCount() / 2;
+                for (int y = 0; y < 2; ++y)
+                {
+                    for (int x = 0; x < 3; ++x)
+                    {
+                        const uint8_t* p = out->getData() + y * outRowBytes + x * pixelBytes;
+                        const uint8_t pixel = static_cast<uint8_t>(y * 2 * 5 + x * 2);
+                        for (size_t c = 0; c < pixelBytes; ++c)
+                        {
+                            FTK_CHECK(pixel == p[c]);
+                        }
+                    }
+                }
+
+                out = models::decimateImage(image, 4);
+                FTK_CHECK(ftk::Size2I(2, 1) == out->getInfo().size);
+                FTK_CHECK(4 == out->getData()[pixelBytes]);
+            }
+        }
+
+        void ImageUtilTest::_crop()
+        {
+            for (const auto type : {
+                ftk::ImageType::L_U8,
+                ftk::ImageType::RGB_U8,
+                ftk::ImageType::RGBA_F16 })
+            {
+                const ftk::ImageInfo info(ftk::Size2I(5, 3), type);
+                auto image = ftk::Image::create(info);
+                const size_t rowBytes = image->getByteCount() / 3;
+                const size_t pixelBytes = rowBytes / 5;
+                for (size_t y = 0; y < 3; ++y)
+                {
+                    for (size_t x = 0; x < 5 * pixelBytes; ++x)
+                    {
+                        image->getData()[y * rowBytes + x] =
+                            static_cast<uint8_t>(y * 5 + x / pixelBytes);
+                    }
+                }
+                ftk::ImageTags tags;
+                tags["Name"] = "Value";
+                image->setTags(tags);
+
+                auto out = models::cropImage(image, ftk::Box2I(1, 1, 3, 2));
+                FTK_CHECK(out->getInfo().type == type);
+                FTK_CHECK(ftk::Size2I(3, 2) == out->getInfo().size);
+                FTK_CHECK(out->getTags() == tags);
+                const size_t outRowBytes = out->getByteCount() / 2;
+                for (int y = 0; y < 2; ++y)
+                {
+                    for (int x = 0; x < 3; ++x)
+                    {
+                        const uint8_t* p = out->getData() + y * outRowBytes + x * pixelBytes;
+                        const uint8_t pixel = static_cast<uint8_t>((y + 1) * 5 + x + 1);
+                        for (size_t c = 0; c < pixelBytes; ++c)
+                        {
+                            FTK_CHECK(pixel == p[c]);
+                        }
+                    }
+                }
+
+                // The box is clipped to the image.
+                out = models::cropImage(
+                    image,
+                    ftk::Box2I(ftk::V2I(-2, -2), ftk::V2I(1, 0)),
+                    models::FrameBufferPool::create());
+                FTK_CHECK(ftk::Size2I(2, 1) == out->getInfo().size);
+                FTK_CHECK(1 == out->getData()[pixelBytes]);
+                FTK_CHECK(!models::cropImage(image, ftk::Box2I(5, 0, 2, 2)));
+            }
+            FTK_CHECK(!models::cropImage(nullptr, ftk::Box2I(0, 0, 1, 1)));
+        }
+
+        void ImageUtilTest::_stats()
+        {
+            // Nothing to measure.
+            FTK_CHECK(0 == models::getImageStats(nullptr, ftk::Box2I(0, 0, 1, 1)).count);
+
+            // Eight bit RGBA: red counts along the row, green is fixed, blue
+            // and alpha are black and white.
+            {
+                auto image = ftk::Image::create(ftk::ImageInfo(ftk::Size2I(4, 2), ftk::ImageType::RGBA_U8));
+                const size_t rowBytes = image->getByteCount() / 2;
+                for (size_t y = 0; y < 2; ++y)
+                {
+                    for (size_t x = 0; x < 4; ++x)
+                    {
+                        uint8_t* p = image->getData() + y * rowBytes + x * 4;
+                        p[0] = static_cast<uint8_t>(x * 85);
+                        p[1] = 51;
+                        p[2] = 0;
+                        p[3] = 255;
+                    }
+                }
+                const auto stats = models::getImageStats(image, ftk::Box2I(0, 0, 4, 2));
+                FTK_CHECK(8 == stats.count);
+                FTK_CHECK(4 == stats.channels);
+                FTK_CHECK(0.F == stats.min[0]);
+                FTK_CHECK(1.F == stats.max[0]);
+                FTK_CHECK(std::fabs(stats.mean[0] - .5F) < .0001F);
+                FTK_CHECK(std::fabs(stats.stdDev[0] - std::sqrt(5.F) / 6.F) < .0001F);
+                FTK_CHECK(std::fabs(stats.mean[1] - .2F) < .0001F);
+                FTK_CHECK(stats.stdDev[1] < .0001F);
+                FTK_CHECK(0.F == stats.max[2]);
+                FTK_CHECK(1.F == stats.min[3]);
+
+                // Clipped to the image.
+                const auto clipped = models::getImageStats(image, ftk::Box2I(2, -1, 10, 10));
+                FTK_CHECK(4 == clipped.count);
+                FTK_CHECK(std::fabs(clipped.min[0] - 170.F / 255.F) < .0001F);
+
+                // Outside the image.
+                FTK_CHECK(0 == models::getImageStats(image, ftk::Box2I(4, 0, 1, 1)).count);
+            }
+
+            // Half floats, including values outside zero to one.
+            {
+                auto image = ftk::Image::create(ftk::ImageInfo(ftk::Size2I(2, 1), ftk::ImageType::RGBA_F16));
+                const uint16_t data[] =
+                {
+                    0x3c00, 0xc000, 0x3800, 0x0000,
+                    0x4200, 0x4000, 0x3800, 0x3c00
+                };
+                memcpy(image->getData(), data, sizeof(data));
+                const auto stats = models::getImageStats(image, ftk::Box2I(0, 0, 2, 1));
+                FTK_CHECK(2 == stats.count);
+                FTK_CHECK(1.F == stats.min[0]);
+                FTK_CHECK(3.F == stats.max[0]);
+                FTK_CHECK(2.F == stats.mean[0]);
+                FTK_CHECK(1.F == stats.stdDev[0]);
+                FTK_CHECK(-2.F == stats.min[1]);
+                FTK_CHECK(.5F == stats.mean[2]);
+                FTK_CHECK(.5F == stats.mean[3]);
+            }
+        }
+    }
+}
@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <ftk/TestLib/ITest.h>
+
+namespace djv
+{
+    namespace models_tests
+    {
+        class ImageUtilTest : public ftk::test::ITest
+        {
+        protected:
+            ImageUtilTest(const std::shared_ptr<ftk::Context>&);
+
+        public:
+            static std::shared_ptr<ImageUtilTest> create(
+                const std::shared_ptr<ftk::Context>&);
+
+            void run() override;
+
+        private:
+            void _decimate();
+            void _crop();
+            void _stats();
+        };
+    }
+}
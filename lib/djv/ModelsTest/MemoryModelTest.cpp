@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djv/ModelsTest/MemoryModelTest.h>
+
+#include <djv/Models/MemoryModel.h>
+
+#include <ftk/Core/Assert.h>
+#include <ftk/Core/Observable.h>
+#include <ftk/Core/ObservableList.h>
+
+namespace djv
+{
+    namespace models_tests
+    {
+        namespace
+        {
+            models::MemoryAccount makeAccount(
+                const std::string& name,
+                models::MemoryPriority priority,
+                uint64_t min,
+                uint64_t max)
+            {
+                models::MemoryAccount out;
+                out.name = name;
+                out.priority = priority;
+                out.min = min;
+                out.max = max;
+                return out;
+            }
+        }
+
+        MemoryModelTest::MemoryModelTest(const std::shared_ptr<ftk::Context>& context) :
+            ITest(context, "models_tests::MemoryModelTest")
+        {}
+
+        std::shared_ptr<MemoryModelTest> MemoryModelTest::create(
+            const std::shared_ptr<ftk::Context>& context)
+        {
+            return std::shared_ptr<MemoryModelTest>(new MemoryModelTest(context));
+        }
+
+        void MemoryModelTest::run()
+        {
+            _allocate();
+            _model();
+        }
+
+        void MemoryModelTest::_allocate()
+        {
+            const std::vector<models::MemoryAccount> accounts =
+            {
+                makeAccount("Player", models::MemoryPriority::High, 10, 100),
+                makeAccount("Prefetch 0", models::MemoryPriority::Low, 0, 50),
+                makeAccount("Prefetch 1", models::MemoryPriority::Low, 0, 50),
+                makeAccount("Thumbnails", models::MemoryPriority::Normal, 0, 20)
+            };
+
+            // No limit.
+            FTK_CHECK(std::vector<uint64_t>({ 100, 50, 50, 20 }) == models::allocateMemory(0, accounts));
+
+            // Less than the minimums.
+            FTK_CHECK(std::vector<uint64_t>({ 5, 0, 0, 0 }) == models::allocateMemory(5, accounts));
+
+            // The highest priority first, then the next.
+            FTK_CHECK(std::vector<uint64_t>({ 50, 0, 0, 0 }) == models::allocateMemory(50, accounts));
+            FTK_CHECK(std::vector<uint64_t>({ 100, 0, 0, 20 }) == models::allocateMemory(120, accounts));
+
+            // The same priority is cut back in proportion.
+            FTK_CHECK(std::vector<uint64_t>({ 100, 25, 25, 20 }) == models::allocateMemory(170, accounts));
+
+            // More than is asked for.
+            FTK_CHECK(std::vector<uint64_t>({ 100, 50, 50, 20 }) == models::allocateMemory(1000, accounts));
+        }
+
+        void MemoryModelTest::_model()
+        {
+            auto model = models::MemoryModel::create();
+            FTK_CHECK(0 == model->getBudget());
+
+            // Observe the usage.
+            std::vector<models::MemoryUsage> usage;
+            auto usageObserver = ftk::ListObserver<models::MemoryUsage>::create(
+                model->observeUsage(),
+                [&usage](const std::vector<models::MemoryUsage>& value)
+                {
+                    usage = value;
+                });
+
+            // Without a limit, an account is given what it asks for.
+            uint64_t budget = 0;
+            auto budgetObserver = ftk::Observer<uint64_t>::create(
+                model->observeAccountBudget("Player"),
+                [&budget](uint64_t value)
+                {
+                    budget = value;
+                });
+            FTK_CHECK(1 == usage.size());
+            model->setAccount("Player", makeAccount("Player", models::MemoryPriority::High, 10, 100));
+            FTK_CHECK(100 == budget);
+            model->setAccount("Prefetch", makeAccount("Prefetch", models::MemoryPriority::Low, 0, 50));
+            FTK_CHECK(2 == usage.size());
+            FTK_CHECK(50 == usage[1].budget);
+            FTK_CHECK(!usage[1].used.has_value());
+
+            // With a limit, the lower priority is cut back.
+            model->setBudget(120);
+            FTK_CHECK(120 == model->getBudget());
+            FTK_CHECK(100 == budget);
+            FTK_CHECK(20 == model->getAccountBudget("Prefetch"));
+            model->setBudget(60);
+            FTK_CHECK(60 == budget);
+            FTK_CHECK(0 == model->getAccountBudget("Prefetch"));
+
+            // Usage.
+            model->setUsed("Player", 42);
+            FTK_CHECK(usage[0].used.has_value());
+            FTK_CHECK(42 == usage[0].used.value());
+
+            // Removing an account gives its memory to the others.
+            model->removeAccount("Player");
+            FTK_CHECK(0 == budget);
+            FTK_CHECK(1 == usage.size());
+            FTK_CHECK(50 == model->getAccountBudget("Prefetch"));
+            FTK_CHECK(0 == model->getAccountBudget("Player"));
+        }
+    }
+}
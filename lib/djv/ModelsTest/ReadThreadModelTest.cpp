@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djv/ModelsTest/ReadThreadModelTest.h>
+
+#include <djv/ModelsTest/ModelsTestUtil.h>
+
+#include <djv/Models/ReadThreadModel.h>
+
+#include <ftk/Core/Assert.h>
+
+namespace djv
+{
+    namespace models_tests
+    {
+        ReadThreadModelTest::ReadThreadModelTest(const std::shared_ptr<ftk::Context>& context) :
+            ITest(context, "models_tests::ReadThreadModelTest")
+        {}
+
+        std::shared_ptr<ReadThreadModelTest> ReadThreadModelTest::create(
+            const std::shared_ptr<ftk::Context>& context)
+        {
+            return std::shared_ptr<ReadThreadModelTest>(new ReadThreadModelTest(context));
+        }
+
+        void ReadThreadModelTest::run()
+        {
+            _storage();
+            _model();
+        }
+
+        void ReadThreadModelTest::_storage()
+        {
+            const std::vector<std::string> mounts = { "/", "/mnt/nfs", "/mnt/nfs/shots" };
+
+            // The longest mount point the file is under.
+            FTK_CHECK("/mnt/nfs/shots" == models::getStorage("/mnt/nfs/shots/a/a.0001.exr", mounts));
+            FTK_CHECK("/mnt/nfs" == models::getStorage("/mnt/nfs/plates/a.0001.exr", mounts));
+            FTK_CHECK("/" == models::getStorage("/home/user/a.0001.exr", mounts));
+
+            // A name that only starts the same is not under it.
+            FTK_CHECK("/" == models::getStorage("/mnt/nfs2/a.0001.exr", mounts));
+
+            // Without mount points, the root of the path.
+            FTK_CHECK("C:" == models::getStorage("C:\\shots\\a.0001.exr", {}));
+            FTK_CHECK("\\\\server\\share" == models::getStorage("\\\\server\\share\\shots\\a.0001.exr", {}));
+            FTK_CHECK("//server/share" == models::getStorage("//server/share/a.0001.exr", {}));
+            FTK_CHECK("/" == models::getStorage("/shots/a.0001.exr", {}));
+            FTK_CHECK(models::getStorage("a.0001.exr", {}).empty());
+        }
+
+        void ReadThreadModelTest::_model()
+        {
+            auto model = models::ReadThreadModel::create(createTestSettings(_context), 8);
+
+            // Nothing measured: the default.
+            FTK_CHECK(8 == model->getCount("/mnt/nfs"));
+
+            // More threads are tried first.
+            FTK_CHECK(model->addSample("/mnt/nfs", 8, 100.F));
+            FTK_CHECK(16 == model->getCount("/mnt/nfs"));
+
+            // More is barely faster, so fewer are tried.
+            FTK_CHECK(model->addSample("/mnt/nfs", 16, 105.F));
+            FTK_CHECK(4 == model->getCount("/mnt/nfs"));
+
+            // Fewer is slower: it settles on the fewest that are close to
+            // the fastest.
+            FTK_CHECK(model->addSample("/mnt/nfs", 4, 60.F));
+            FTK_CHECK(8 == model->getCount("/mnt/nfs"));
+            FTK_CHECK(!model->addSample("/mnt/nfs", 8, 100.F));
+            FTK_CHECK(3 == model->getSamples("/mnt/nfs").size());
+
+            // Another storage is measured separately.
+            FTK_CHECK(8 == model->getCount("/"));
+            FTK_CHECK(model->addSample("/", 8, 400.F));
+            FTK_CHECK(model->addSample("/", 16, 800.F));
+            FTK_CHECK(32 == model->getCount("/"));
+            FTK_CHECK(8 == model->getCount("/mnt/nfs"));
+
+            // Nothing was read.
+            FTK_CHECK(!model->addSample("/", 32, 0.F));
+
+            model->clear();
+            model->setDefault(4);
+            FTK_CHECK(4 == model->getCount("/"));
+        }
+    }
+}
@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <ftk/TestLib/ITest.h>
+
+namespace djv
+{
+    namespace models_tests
+    {
+        class ReadThreadModelTest : public ftk::test::ITest
+        {
+        protected:
+            ReadThreadModelTest(const std::shared_ptr<ftk::Context>&);
+
+        public:
+            static std::shared_ptr<ReadThreadModelTest> create(
+                const std::shared_ptr<ftk::Context>&);
+
+            void run() override;
+
+        private:
+            void _storage();
+            void _model();
+        };
+    }
+}
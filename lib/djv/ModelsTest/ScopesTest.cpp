@@ -0,0 +1,123 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djv/ModelsTest/ScopesTest.h>
+
+#include <djv/Models/Scopes.h>
+
+#include <ftk/Core/Assert.h>
+
+namespace djv
+{
+    namespace models_tests
+    {
+        ScopesTest::ScopesTest(const std::shared_ptr<ftk::Context>& context) :
+            ITest(context, "models_tests::ScopesTest")
+        {}
+
+        std::shared_ptr<ScopesTest> ScopesTest::create(
+            const std::shared_ptr<ftk::Context>& context)
+        {
+            return std::shared_ptr<ScopesTest>(new ScopesTest(context));
+        }
+
+        void ScopesTest::run()
+        {
+            _scopes();
+        }
+
+        namespace
+        {
+            // Whether anything is drawn at a pixel of a scope.
+            bool isDrawn(const std::shared_ptr<ftk::Image>& image, int x, int y)
+            {
+                const ftk::Size2I& size = image->getInfo().size;
+                return image->getData()[(y * size.w + x) * 4 + 3] > 0;
+            }
+
+            // Count the pixels of a scope that have anything drawn.
+            size_t getDrawn(const std::shared_ptr<ftk::Image>& image)
+            {
+                const ftk::Size2I& size = image->getInfo().size;
+                size_t out = 0;
+                for (int y = 0; y < size.h; ++y)
+                {
+                    for (int x = 0; x < size.w; ++x)
+                    {
+                        out += isDrawn(image, x, y) ? 1 : 0;
+                    }
+                }
+                return out;
+            }
+        }
+
+        void ScopesTest::_scopes()
+        {
+            // A frame that is black on the left and white on the right.
+            const ftk::Size2I size(4, 2);
+            auto image = ftk::Image::create(ftk::ImageInfo(size, ftk::ImageType::RGBA_U8));
+            for (int y = 0; y < size.h; ++y)
+            {
+                for (int x = 0; x < size.w; ++x)
+                {
+                    uint8_t* p = image->getData() + (y * size.w + x) * 4;
+                    const uint8_t v = x < 2 ? 0 : 255;
+                    p[0] = v;
+                    p[1] = v;
+                    p[2] = v;
+                    p[3] = 255;
+                }
+            }
+            const ftk::Size2I scopeSize(16, 8);
+
+            // Two bars of the full height, at either end.
+            auto scope = models::getScope(models::ScopeType::Histogram, image, scopeSize);
+            FTK_CHECK(scopeSize == scope->getInfo().size);
+            FTK_CHECK(ftk::ImageType::RGBA_U8 == scope->getInfo().type);
+            FTK_CHECK(isDrawn(scope, 0, 0));
+            FTK_CHECK(isDrawn(scope, 15, 0));
+            FTK_CHECK(!isDrawn(scope, 8, 7));
+            FTK_CHECK(2 * 8 == getDrawn(scope));
+
+            // Black at the bottom of the left half, and white at the top of
+            // the right half.
+            scope = models::getScope(models::ScopeType::Waveform, image, scopeSize);
+            FTK_CHECK(isDrawn(scope, 0, 7));
+            FTK_CHECK(isDrawn(scope, 12, 0));
+            FTK_CHECK(!isDrawn(scope, 0, 0));
+            FTK_CHECK(!isDrawn(scope, 12, 7));
+
+            // The same for each channel, in its own third.
+            scope = models::getScope(models::ScopeType::Parade, image, ftk::Size2I(12, 8));
+            for (int c = 0; c < 3; ++c)
+            {
+                FTK_CHECK(isDrawn(scope, c * 4, 7));
+                FTK_CHECK(isDrawn(scope, c * 4 + 3, 0));
+            }
+            FTK_CHECK(12 == getDrawn(scope));
+
+            // Neutral colors have no chroma.
+            scope = models::getScope(models::ScopeType::Vectorscope, image, ftk::Size2I(9, 9));
+            FTK_CHECK(isDrawn(scope, 4, 4));
+            FTK_CHECK(1 == getDrawn(scope));
+            for (int y = 0; y < size.h; ++y)
+            {
+                uint8_t* p = image->getData() + y * size.w * 4;
+                p[0] = 0;
+                p[1] = 0;
+                p[2] = 255;
+            }
+            scope = models::getScope(models::ScopeType::Vectorscope, image, ftk::Size2I(9, 9));
+            FTK_CHECK(isDrawn(scope, 8, 4));
+            FTK_CHECK(2 == getDrawn(scope));
+
+            // Only 8-bit RGB and RGBA data is measured.
+            FTK_CHECK(!models::getScope(
+                models::ScopeType::Histogram,
+                ftk::Image::create(ftk::ImageInfo(size, ftk::ImageType::RGBA_F16)),
+                scopeSize));
+            FTK_CHECK(!models::getScope(models::ScopeType::Histogram, nullptr, scopeSize));
+            FTK_CHECK(!models::getScope(models::ScopeType::Histogram, image, ftk::Size2I()));
+        }
+    }
+}
@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#pragma once
+
+#include <ftk/TestLib/ITest.h>
+
+namespace djv
+{
+    namespace models_tests
+    {
+        class ScopesTest : public ftk::test::ITest
+        {
+        protected:
+            ScopesTest(const std::shared_ptr<ftk::Context>&);
+
+        public:
+            static std::shared_ptr<ScopesTest> create(
+                const std::shared_ptr<ftk::Context>&);
+
+            void run() override;
+
+        private:
+            void _scopes();
+        };
+    }
+}
@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djv/ModelsTest/SeqCacheTest.h>
+
+#include <djv/Models/SeqCache.h>
+
+#include <ftk/Core/Assert.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+namespace djv
+{
+    namespace models_tests
+    {
+        SeqCacheTest::SeqCacheTest(const std::shared_ptr<ftk::Context>& context) :
+            ITest(context, "models_tests::SeqCacheTest")
+        {}
+
+        std::shared_ptr<SeqCacheTest> SeqCacheTest::create(
+            const std::shared_ptr<ftk::Context>& context)
+        {
+            return std::shared_ptr<SeqCacheTest>(new SeqCacheTest(context));
+        }
+
+        void SeqCacheTest::run()
+        {
+            _findSeq();
+        }
+
+        void SeqCacheTest::_findSeq()
+        {
+            const std::filesystem::path dir =
+                std::filesystem::temp_directory_path() / "djvSeqCacheTest";
+            std::filesystem::remove_all(dir);
+            std::filesystem::create_directories(dir);
+            auto write = [&dir](const std::string& fileName)
+            {
+                std::ofstream(dir / fileName) << "frame";
+            };
+            write("render.0001.exr");
+            write("render.0002.exr");
+            write("render.0003.exr");
+
+            // A directory that has only just changed is not trusted, so the
+            // test sets its time back to one that has settled.
+            const auto time = std::filesystem::file_time_type::clock::now() -
+                std::chrono::hours(1);
+            std::filesystem::last_write_time(dir, time);
+
+            auto cache = models::SeqCache::create();
+            const ftk::Path path((dir / "render.0001.exr").u8string());
+            ftk::Path seq = cache->findSeq(path, ftk::PathOptions());
+            FTK_CHECK(seq.getFrames().has_value());
+            FTK_CHECK(ftk::RangeI64(1, 3) == seq.getFrames().value());
+
+            // While the directory's time stays the same, the frames found
+            // the first time are given back without looking again.
+            write("render.0004.exr");
+            std::filesystem::last_write_time(dir, time);
+            seq = cache->findSeq(path, ftk::PathOptions());
+            FTK_CHECK(ftk::RangeI64(1, 3) == seq.getFrames().value());
+
+            // A new time means the directory has changed.
+            std::filesystem::last_write_time(dir, time + std::chrono::minutes(1));
+            seq = cache->findSeq(path, ftk::PathOptions());
+            FTK_CHECK(ftk::RangeI64(1, 4) == seq.getFrames().value());
+
+            // Invalidating the directory looks again regardless.
+            write("render.0005.exr");
+            std::filesystem::last_write_time(dir, time + std::chrono::minutes(1));
+            cache->invalidate(path.getDir());
+            seq = cache->findSeq(path, ftk::PathOptions());
+            FTK_CHECK(ftk::RangeI64(1, 5) == seq.getFrames().value());
+
+            std::filesystem::remove_all(dir);
+        }
+    }
+}
@@ -0,0 +1,99 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the DJV project.
+
+#include <djv/ModelsTest/ThreadPoolTest.h>
+
+#include <djv/Models/ThreadPool.h>
+
+#include <ftk/Core/Assert.h>
+
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace djv
+{
+    namespace models_tests
+    {
+        ThreadPoolTest::ThreadPoolTest(const std::shared_ptr<ftk::Context>& context) :
+            ITest(context, "models_tests::ThreadPoolTest")
+        {}
+
+        std::shared_ptr<ThreadPoolTest> ThreadPoolTest::create(
+            const std::shared_ptr<ftk::Context>& context)
+        {
+            return std::shared_ptr<ThreadPoolTest>(new ThreadPoolTest(context));
+        }
+
+        void ThreadPoolTest::run()
+        {
+            _pool();
+        }
+
+        void ThreadPoolTest::_pool()
+        {
+            {
+                auto pool = models::ThreadPool::create(0);
+                FTK_CHECK(1 == pool->getThreadCount());
+            }
+            {
+                // Everything added is run.
+                auto pool = models::ThreadPool::create(4);
+                FTK_CHECK(4 == pool->getThreadCount());
+                std::atomic<int> count(0);
+                std::vector<std::future<void> > futures;
+                for (int i = 0; i < 100; ++i)
+                {
+                    auto promise = std::make_shared<std::promise<void> >();
+                    futures.push_back(promise->get_future());
+                    pool->add(
+                        [&count, promise]
+                        {
+                            ++count;
+                            promise->set_value();
+                        });
+                }
+                for (auto& future : futures)
+                {
+                    future.get();
+                }
+                FTK_CHECK(100 == count);
+            }
+            {
+                // One thread runs them in order.
+                auto pool = models::ThreadPool::create(1);
+                std::vector<int> order;
+                std::promise<void> promise;
+                for (int i = 0; i < 10; ++i)
+                {
+                    pool->add([&order, i] { order.push_back(i); });
+                }
+                pool->add([&promise] { promise.set_value(); });
+                promise.get_future().get();
+                FTK_CHECK(10 == order.size());
+                for (int i = 0; i < 10; ++i)
+                {
+                    FTK_CHECK(i == order[i]);
+                }
+            }
+            {
+                // What has started is finished before the pool goes.
+                std::atomic<bool> finished(false);
+                {
+                    auto pool = models::ThreadPool::create(1);
+                    std::promise<void> started;
+                    pool->add(
+                        [&started, &finished]
+                        {
+                            started.set_value();
+                            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                            finished = true;
+                        });
+                    started.get_future().wait();
+                }
+                FTK_CHECK(finished);
+            }
+        }
+    }
+}
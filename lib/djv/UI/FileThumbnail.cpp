@@ -8,6 +8,7 @@
 #include <ftk/UI/DrawUtil.h>
 #include <ftk/Core/Context.h>
 
+#include <future>
 #include <optional>
 
 namespace djv
@@ -18,6 +19,7 @@ namespace djv
         {
             std::shared_ptr<models::FilesModelItem> item;
             tl::IOOptions ioOptions;
+            std::shared_ptr<models::ThumbnailDiskCache> diskCache;
 
             struct SizeData
             {
@@ -31,6 +33,7 @@ namespace djv
                 bool init = true;
                 float scale = 1.F;
                 int height = 40;
+                std::optional<uint64_t> diskRequest;
                 tl::ui::ThumbnailRequest request;
                 std::shared_ptr<ftk::Image> image;
             };
@@ -41,12 +44,14 @@ namespace djv
             const std::shared_ptr<ftk::Context>& context,
             const std::shared_ptr<models::FilesModelItem>& item,
             const tl::IOOptions& ioOptions,
+            const std::shared_ptr<models::ThumbnailDiskCache>& diskCache,
             const std::shared_ptr<IWidget>& parent)
         {
             IWidget::_init(context, "djv::ui::FileThumbnail", parent);
             FTK_P();
             p.item = item;
             p.ioOptions = ioOptions;
+            p.diskCache = diskCache;
         }
 
         FileThumbnail::FileThumbnail() :
@@ -54,16 +59,23 @@ namespace djv
         {}
 
         FileThumbnail::~FileThumbnail()
-        {}
+        {
+            FTK_P();
+            if (p.thumbnail.diskRequest.has_value())
+            {
+                p.diskCache->cancelRequest(p.thumbnail.diskRequest.value());
+            }
+        }
 
         std::shared_ptr<FileThumbnail> FileThumbnail::create(
             const std::shared_ptr<ftk::Context>& context,
             const std::shared_ptr<models::FilesModelItem>& item,
             const tl::IOOptions& ioOptions,
+            const std::shared_ptr<models::ThumbnailDiskCache>& diskCache,
             const std::shared_ptr<IWidget>& parent)
         {
             auto out = std::shared_ptr<FileThumbnail>(new FileThumbnail);
-            out->_init(context, item, ioOptions, parent);
+            out->_init(context, item, ioOptions, diskCache, parent);
             return out;
         }
 
@@ -86,10 +98,38 @@ namespace djv
         {
             IWidget::tickEvent(parentsVisible, parentsEnabled, event);
             FTK_P();
+            if (p.thumbnail.diskRequest.has_value())
+            {
+                const auto result = p.diskCache->getResult(p.thumbnail.diskRequest.value());
+                if (result.has_value())
+                {
+                    p.thumbnail.diskRequest.reset();
+                    p.thumbnail.image = result.value();
+                    if (p.thumbnail.image)
+                    {
+                        setSizeUpdate();
+                        setDrawUpdate();
+                    }
+                    else
+                    {
+                        _thumbnailRequest();
+                    }
+                }
+            }
             if (p.thumbnail.request.future.valid() &&
                 p.thumbnail.request.future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
             {
                 p.thumbnail.image = p.thumbnail.request.future.get();
+                if (p.diskCache && p.thumbnail.image)
+                {
+                    // Written on the cache's threads, since the cache may
+                    // be on slow storage too.
+                    p.diskCache->addAsync(
+                        p.item->path,
+                        p.thumbnail.height,
+                        p.ioOptions,
+                        p.thumbnail.image);
+                }
                 setSizeUpdate();
                 setDrawUpdate();
             }
@@ -114,15 +154,37 @@ namespace djv
             if (p.thumbnail.init)
             {
                 p.thumbnail.init = false;
-                if (auto context = getContext())
+                if (p.diskCache)
                 {
-                    auto thumbnailSystem = context->getSystem<tl::ui::ThumbnailSystem>();
-                    p.thumbnail.request = thumbnailSystem->getThumbnail(
+                    // Looked for on disk first; the file is only read
+                    // when the cache does not have it.
+                    if (p.thumbnail.diskRequest.has_value())
+                    {
+                        p.diskCache->cancelRequest(p.thumbnail.diskRequest.value());
+                    }
+                    p.thumbnail.diskRequest = p.diskCache->getAsync(
                         p.item->path,
                         p.thumbnail.height,
-                        std::nullopt,
                         p.ioOptions);
                 }
+                else
+                {
+                    _thumbnailRequest();
+                }
+            }
+        }
+
+        void FileThumbnail::_thumbnailRequest()
+        {
+            FTK_P();
+            if (auto context = getContext())
+            {
+                auto thumbnailSystem = context->getSystem<tl::ui::ThumbnailSystem>();
+                p.thumbnail.request = thumbnailSystem->getThumbnail(
+                    p.item->path,
+                    p.thumbnail.height,
+                    std::nullopt,
+                    p.ioOptions);
             }
         }
 
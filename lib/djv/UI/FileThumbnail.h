@@ -5,6 +5,7 @@
 
 #include <djv/App/FilesTool.h>
 #include <djv/Models/Export.h>
+#include <djv/Models/ThumbnailDiskCache.h>
 
 #include <tlRender/IO/IO.h>
 
@@ -23,6 +24,7 @@ namespace djv
                 const std::shared_ptr<ftk::Context>&,
                 const std::shared_ptr<models::FilesModelItem>&,
                 const tl::IOOptions&,
+                const std::shared_ptr<models::ThumbnailDiskCache>&,
                 const std::shared_ptr<IWidget>& parent);
 
             FileThumbnail();
@@ -34,6 +36,7 @@ namespace djv
                 const std::shared_ptr<ftk::Context>&,
                 const std::shared_ptr<models::FilesModelItem>&,
                 const tl::IOOptions&,
+                const std::shared_ptr<models::ThumbnailDiskCache>& = nullptr,
                 const std::shared_ptr<IWidget>& parent = nullptr);
 
             DJV_API ftk::Size2I getSizeHint() const override;
@@ -45,6 +48,8 @@ namespace djv
             DJV_API void drawEvent(const ftk::Box2I&, const ftk::DrawEvent&) override;
 
         private:
+            void _thumbnailRequest();
+
             FTK_PRIVATE();
         };
     }
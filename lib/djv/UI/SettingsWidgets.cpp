@@ -112,15 +112,28 @@ namespace djv
         {
             std::shared_ptr<models::SettingsModel> settings;
 
+            std::shared_ptr<ftk::FloatEdit> budgetEdit;
             std::shared_ptr<ftk::FloatEdit> videoEdit;
+            std::shared_ptr<ftk::ComboBox> modeComboBox;
             std::shared_ptr<ftk::FloatEdit> audioEdit;
             std::shared_ptr<ftk::FloatEdit> readBehindEdit;
             std::shared_ptr<ftk::FloatEdit> thumbnailEdit;
             std::shared_ptr<ftk::FloatEdit> waveformEdit;
+            std::shared_ptr<ftk::FloatEdit> thumbnailDiskEdit;
+            std::shared_ptr<ftk::FloatEdit> frameDiskEdit;
+            std::shared_ptr<ftk::LineEdit> frameDirEdit;
+            std::shared_ptr<ftk::IntEdit> prefetchFilesEdit;
+            std::shared_ptr<ftk::FloatEdit> prefetchVideoEdit;
+            std::shared_ptr<ftk::CheckBox> lazyOpenCheckBox;
+            std::shared_ptr<ftk::CheckBox> openInBackgroundCheckBox;
             std::shared_ptr<ftk::FormLayout> layout;
 
             std::shared_ptr<ftk::Observer<tl::PlayerCacheOptions> > cacheObserver;
             std::shared_ptr<ftk::Observer<tl::ui::ThumbnailCacheOptions> > thumbnailCacheObserver;
+            std::shared_ptr<ftk::Observer<models::DiskCacheSettings> > diskCacheObserver;
+            std::shared_ptr<ftk::Observer<models::PrefetchSettings> > prefetchObserver;
+            std::shared_ptr<ftk::Observer<models::FrameCacheSettings> > frameCacheObserver;
+            std::shared_ptr<ftk::Observer<models::MemorySettings> > memoryObserver;
         };
 
         void CacheSettingsWidget::_init(
@@ -133,11 +146,33 @@ namespace djv
 
             p.settings = settings;
 
+            p.budgetEdit = ftk::FloatEdit::create(context);
+            p.budgetEdit->setRange(0.F, 4096.F);
+            p.budgetEdit->setStep(1.0);
+            p.budgetEdit->setLargeStep(10.0);
+            p.budgetEdit->setTooltip(
+                "The most memory the caches of every open file, the\n"
+                "thumbnails, and an export may take up between them. When\n"
+                "they would take more, the files kept ready are cut back\n"
+                "first and the current file last. Zero leaves each cache\n"
+                "with the size set below.");
+
             p.videoEdit = ftk::FloatEdit::create(context);
             p.videoEdit->setRange(0.F, 1024.F);
             p.videoEdit->setStep(1.0);
             p.videoEdit->setLargeStep(10.0);
 
+            p.modeComboBox = ftk::ComboBox::create(context, models::getFrameCacheModeLabels());
+            p.modeComboBox->setHStretch(ftk::Stretch::Expanding);
+            p.modeComboBox->setTooltip(
+                "How the video cache keeps frames.\n"
+                "\n"
+                "* Uncompressed: As they are read.\n"
+                "* Compressed: Losslessly compressed, so that two or three\n"
+                "  times as many half float or 16-bit image sequence frames\n"
+                "  fit, at the cost of the cores that decompress them during\n"
+                "  playback.");
+
             p.audioEdit = ftk::FloatEdit::create(context);
             p.audioEdit->setRange(0.F, 1024.F);
             p.audioEdit->setStep(1.0);
@@ -158,15 +193,74 @@ namespace djv
             p.waveformEdit->setStep(1.0);
             p.waveformEdit->setLargeStep(10.0);
 
+            p.thumbnailDiskEdit = ftk::FloatEdit::create(context);
+            p.thumbnailDiskEdit->setRange(0.F, 65536.F);
+            p.thumbnailDiskEdit->setStep(64.0);
+            p.thumbnailDiskEdit->setLargeStep(512.0);
+            p.thumbnailDiskEdit->setTooltip(
+                "Thumbnails are kept on disk from one run to the next, so "
+                "that reopening files does not read them again. Zero turns "
+                "this off.");
+
+            p.frameDiskEdit = ftk::FloatEdit::create(context);
+            p.frameDiskEdit->setRange(0.F, 65536.F);
+            p.frameDiskEdit->setStep(1.0);
+            p.frameDiskEdit->setLargeStep(10.0);
+            p.frameDiskEdit->setTooltip(
+                "Image sequence frames are also kept on local disk, so that\n"
+                "reading them again, in this run or a later one, does not go\n"
+                "back to where they are stored. Zero turns this off.");
+
+            p.frameDirEdit = ftk::LineEdit::create(context);
+            p.frameDirEdit->setHStretch(ftk::Stretch::Expanding);
+            p.frameDirEdit->setTooltip(
+                "The directory the frames are kept in, on fast local storage.\n"
+                "Empty for the default, in the user's cache directory.");
+
+            p.prefetchFilesEdit = ftk::IntEdit::create(context);
+            p.prefetchFilesEdit->setRange(0, 8);
+            p.prefetchFilesEdit->setTooltip(
+                "How many files either side of the current one in the list\n"
+                "are kept ready to play, so that changing to the next or\n"
+                "previous file does not wait for the cache to fill. Zero\n"
+                "turns this off.");
+
+            p.prefetchVideoEdit = ftk::FloatEdit::create(context);
+            p.prefetchVideoEdit->setRange(0.F, 1024.F);
+            p.prefetchVideoEdit->setStep(1.0);
+            p.prefetchVideoEdit->setLargeStep(10.0);
+            p.prefetchVideoEdit->setTooltip(
+                "The video cache shared by the files kept ready. It is\n"
+                "taken from the video cache of the current file.");
+
+            p.lazyOpenCheckBox = ftk::CheckBox::create(context);
+            p.lazyOpenCheckBox->setHStretch(ftk::Stretch::Expanding);
+            p.lazyOpenCheckBox->setTooltip(
+                "Open a file when it is first looked at rather than when it\n"
+                "is added, so that a long list of files shows straight away\n"
+                "and only the files looked at are read.");
+
+            p.openInBackgroundCheckBox = ftk::CheckBox::create(context);
+            p.openInBackgroundCheckBox->setHStretch(ftk::Stretch::Expanding);
+            p.openInBackgroundCheckBox->setTooltip(
+                "With files opened when they are looked at, open the rest\n"
+                "one at a time in the background while nothing is playing.");
+
             p.layout = ftk::FormLayout::create(context);
 
             _setWidget(p.layout);
             p.layout->setSpacingRole(ftk::SizeRole::SpacingSmall);
             auto hLayout = ftk::HorizontalLayout::create(context);
             hLayout->setSpacingRole(ftk::SizeRole::SpacingSmall);
+            p.budgetEdit->setParent(hLayout);
+            ftk::Label::create(context, "GB", hLayout);
+            p.layout->addRow("Memory budget:", hLayout);
+            hLayout = ftk::HorizontalLayout::create(context);
+            hLayout->setSpacingRole(ftk::SizeRole::SpacingSmall);
             p.videoEdit->setParent(hLayout);
             ftk::Label::create(context, "GB", hLayout);
             p.layout->addRow("Video cache:", hLayout);
+            p.layout->addRow("Video cache mode:", p.modeComboBox);
             hLayout = ftk::HorizontalLayout::create(context);
             hLayout->setSpacingRole(ftk::SizeRole::SpacingSmall);
             p.audioEdit->setParent(hLayout);
@@ -187,6 +281,25 @@ namespace djv
             p.waveformEdit->setParent(hLayout);
             ftk::Label::create(context, "MB", hLayout);
             p.layout->addRow("Waveforms:", hLayout);
+            hLayout = ftk::HorizontalLayout::create(context);
+            hLayout->setSpacingRole(ftk::SizeRole::SpacingSmall);
+            p.thumbnailDiskEdit->setParent(hLayout);
+            ftk::Label::create(context, "MB", hLayout);
+            p.layout->addRow("Thumbnails on disk:", hLayout);
+            hLayout = ftk::HorizontalLayout::create(context);
+            hLayout->setSpacingRole(ftk::SizeRole::SpacingSmall);
+            p.frameDiskEdit->setParent(hLayout);
+            ftk::Label::create(context, "GB", hLayout);
+            p.layout->addRow("Frames on disk:", hLayout);
+            p.layout->addRow("Frame cache directory:", p.frameDirEdit);
+            p.layout->addRow("Prefetch files:", p.prefetchFilesEdit);
+            hLayout = ftk::HorizontalLayout::create(context);
+            hLayout->setSpacingRole(ftk::SizeRole::SpacingSmall);
+            p.prefetchVideoEdit->setParent(hLayout);
+            ftk::Label::create(context, "GB", hLayout);
+            p.layout->addRow("Prefetch cache:", hLayout);
+            p.layout->addRow("Open files when looked at:", p.lazyOpenCheckBox);
+            p.layout->addRow("Open the rest in the background:", p.openInBackgroundCheckBox);
 
             p.cacheObserver = ftk::Observer<tl::PlayerCacheOptions>::create(
                 settings->observeCache(),
@@ -207,6 +320,51 @@ namespace djv
                     p.waveformEdit->setValue(value.waveformMB);
                 });
 
+            p.diskCacheObserver = ftk::Observer<models::DiskCacheSettings>::create(
+                settings->observeDiskCache(),
+                [this](const models::DiskCacheSettings& value)
+                {
+                    FTK_P();
+                    p.thumbnailDiskEdit->setValue(value.thumbnailMB);
+                    p.frameDiskEdit->setValue(value.frameGB);
+                    p.frameDirEdit->setText(value.frameDir);
+                });
+
+            p.prefetchObserver = ftk::Observer<models::PrefetchSettings>::create(
+                settings->observePrefetch(),
+                [this](const models::PrefetchSettings& value)
+                {
+                    FTK_P();
+                    p.prefetchFilesEdit->setValue(value.files);
+                    p.prefetchVideoEdit->setValue(value.videoGB);
+                    p.lazyOpenCheckBox->setChecked(value.lazyOpen);
+                    p.openInBackgroundCheckBox->setChecked(value.openInBackground);
+                    p.layout->setRowVisible(p.openInBackgroundCheckBox, value.lazyOpen);
+                });
+
+            p.frameCacheObserver = ftk::Observer<models::FrameCacheSettings>::create(
+                settings->observeFrameCache(),
+                [this](const models::FrameCacheSettings& value)
+                {
+                    _p->modeComboBox->setCurrentIndex(static_cast<int>(value.mode));
+                });
+
+            p.memoryObserver = ftk::Observer<models::MemorySettings>::create(
+                settings->observeMemory(),
+                [this](const models::MemorySettings& value)
+                {
+                    _p->budgetEdit->setValue(value.budgetGB);
+                });
+
+            p.budgetEdit->setCallback(
+                [this](float value)
+                {
+                    FTK_P();
+                    models::MemorySettings settings = p.settings->getMemory();
+                    settings.budgetGB = value;
+                    p.settings->setMemory(settings);
+                });
+
             p.videoEdit->setCallback(
                 [this](float value)
                 {
@@ -216,6 +374,15 @@ namespace djv
                     p.settings->setCache(settings);
                 });
 
+            p.modeComboBox->setIndexCallback(
+                [this](int value)
+                {
+                    FTK_P();
+                    models::FrameCacheSettings settings = p.settings->getFrameCache();
+                    settings.mode = static_cast<models::FrameCacheMode>(value);
+                    p.settings->setFrameCache(settings);
+                });
+
             p.audioEdit->setCallback(
                 [this](float value)
                 {
@@ -251,6 +418,69 @@ namespace djv
                     options.waveformMB = value;
                     p.settings->setThumbnailCache(options);
                 });
+
+            p.thumbnailDiskEdit->setCallback(
+                [this](float value)
+                {
+                    FTK_P();
+                    models::DiskCacheSettings settings = p.settings->getDiskCache();
+                    settings.thumbnailMB = value;
+                    p.settings->setDiskCache(settings);
+                });
+
+            p.frameDiskEdit->setCallback(
+                [this](float value)
+                {
+                    FTK_P();
+                    models::DiskCacheSettings settings = p.settings->getDiskCache();
+                    settings.frameGB = value;
+                    p.settings->setDiskCache(settings);
+                });
+
+            p.frameDirEdit->setCallback(
+                [this](const std::string& value)
+                {
+                    FTK_P();
+                    models::DiskCacheSettings settings = p.settings->getDiskCache();
+                    settings.frameDir = value;
+                    p.settings->setDiskCache(settings);
+                });
+
+            p.prefetchFilesEdit->setCallback(
+                [this](int value)
+                {
+                    FTK_P();
+                    models::PrefetchSettings settings = p.settings->getPrefetch();
+                    settings.files = value;
+                    p.settings->setPrefetch(settings);
+                });
+
+            p.prefetchVideoEdit->setCallback(
+                [this](float value)
+                {
+                    FTK_P();
+                    models::PrefetchSettings settings = p.settings->getPrefetch();
+                    settings.videoGB = value;
+                    p.settings->setPrefetch(settings);
+                });
+
+            p.lazyOpenCheckBox->setCheckedCallback(
+                [this](bool value)
+                {
+                    FTK_P();
+                    models::PrefetchSettings settings = p.settings->getPrefetch();
+                    settings.lazyOpen = value;
+                    p.settings->setPrefetch(settings);
+                });
+
+            p.openInBackgroundCheckBox->setCheckedCallback(
+                [this](bool value)
+                {
+                    FTK_P();
+                    models::PrefetchSettings settings = p.settings->getPrefetch();
+                    settings.openInBackground = value;
+                    p.settings->setPrefetch(settings);
+                });
         }
 
         CacheSettingsWidget::CacheSettingsWidget() :
@@ -478,6 +708,7 @@ namespace djv
             std::shared_ptr<ftk::IntEditSlider> missingIndicatorWidthEdit;
             std::shared_ptr<ftk::ColorSwatch> missingIndicatorColorSwatch;
             std::shared_ptr<ftk::IntEdit> threadsEdit;
+            std::shared_ptr<ftk::CheckBox> threadsAutoCheckBox;
             std::shared_ptr<ftk::FormLayout> layout;
 
             std::shared_ptr<ftk::Observer<models::ImageSeqSettings> > settingsObserver;
@@ -573,6 +804,13 @@ namespace djv
             p.threadsEdit = ftk::IntEdit::create(context);
             p.threadsEdit->setRange(1, 64);
 
+            p.threadsAutoCheckBox = ftk::CheckBox::create(context);
+            p.threadsAutoCheckBox->setHStretch(ftk::Stretch::Expanding);
+            p.threadsAutoCheckBox->setTooltip(
+                "Find the number of I/O threads for each disk or share by\n"
+                "measuring how fast the cache fills, starting from the number\n"
+                "above. The number found is used for the files opened after.");
+
             p.layout = ftk::FormLayout::create(context);
 
             _setWidget(p.layout);
@@ -591,6 +829,7 @@ namespace djv
             p.layout->addRow("Indicator width:", p.missingIndicatorWidthEdit);
             p.layout->addRow("Indicator color:", p.missingIndicatorColorSwatch);
             p.layout->addRow("I/O threads:", p.threadsEdit);
+            p.layout->addRow("Tune I/O threads:", p.threadsAutoCheckBox);
 
             // The indicator lives with the viewport's other drawing rather
             // than with the sequence settings, since it changes only what is
@@ -648,6 +887,7 @@ namespace djv
                     p.missingFramesComboBox->setCurrentIndex(
                         static_cast<int>(value.io.missingFrames));
                     p.threadsEdit->setValue(value.readThreadCount);
+                    p.threadsAutoCheckBox->setChecked(value.readThreadAuto);
                 });
 
             p.audioComboBox->setIndexCallback(
@@ -712,6 +952,15 @@ namespace djv
                     settings.readThreadCount = value;
                     p.settings->setImageSeq(settings);
                 });
+
+            p.threadsAutoCheckBox->setCheckedCallback(
+                [this](bool value)
+                {
+                    FTK_P();
+                    models::ImageSeqSettings settings = p.settings->getImageSeq();
+                    settings.readThreadAuto = value;
+                    p.settings->setImageSeq(settings);
+                });
         }
 
         ImageSeqSettingsWidget::ImageSeqSettingsWidget() :
@@ -992,6 +1241,8 @@ namespace djv
         {
             std::shared_ptr<models::SettingsModel> settings;
             std::shared_ptr<ftk::CheckBox> startPlaybackCheckBox;
+            std::shared_ptr<ftk::CheckBox> adaptiveResolutionCheckBox;
+            std::shared_ptr<ftk::CheckBox> scrubProxiesCheckBox;
             std::shared_ptr<ftk::FormLayout> layout;
 
             std::shared_ptr<ftk::Observer<models::PlaybackSettings> > settingsObserver;
@@ -1009,11 +1260,24 @@ namespace djv
 
             p.startPlaybackCheckBox = ftk::CheckBox::create(context);
 
+            p.adaptiveResolutionCheckBox = ftk::CheckBox::create(context);
+            p.adaptiveResolutionCheckBox->setTooltip(
+                "Play image sequences at half or a quarter of their resolution "
+                "when they cannot be read fast enough, and go back to the full "
+                "resolution when playback stops.");
+
+            p.scrubProxiesCheckBox = ftk::CheckBox::create(context);
+            p.scrubProxiesCheckBox->setTooltip(
+                "Show a small version of the frame while it is read when "
+                "scrubbing the timeline or using the frame shuttle.");
+
             p.layout = ftk::FormLayout::create(context);
 
             _setWidget(p.layout);
             p.layout->setSpacingRole(ftk::SizeRole::SpacingSmall);
             p.layout->addRow("Start playback on open:", p.startPlaybackCheckBox);
+            p.layout->addRow("Adaptive resolution:", p.adaptiveResolutionCheckBox);
+            p.layout->addRow("Show proxies when scrubbing:", p.scrubProxiesCheckBox);
 
             p.settingsObserver = ftk::Observer<models::PlaybackSettings>::create(
                 settings->observePlayback(),
@@ -1021,6 +1285,8 @@ namespace djv
                 {
                     FTK_P();
                     p.startPlaybackCheckBox->setChecked(value.startPlayback);
+                    p.adaptiveResolutionCheckBox->setChecked(value.adaptiveResolution);
+                    p.scrubProxiesCheckBox->setChecked(value.scrubProxies);
                 });
 
             p.startPlaybackCheckBox->setCheckedCallback(
@@ -1031,6 +1297,24 @@ namespace djv
                     settings.startPlayback = value;
                     p.settings->setPlayback(settings);
                 });
+
+            p.adaptiveResolutionCheckBox->setCheckedCallback(
+                [this](bool value)
+                {
+                    FTK_P();
+                    auto settings = p.settings->getPlayback();
+                    settings.adaptiveResolution = value;
+                    p.settings->setPlayback(settings);
+                });
+
+            p.scrubProxiesCheckBox->setCheckedCallback(
+                [this](bool value)
+                {
+                    FTK_P();
+                    auto settings = p.settings->getPlayback();
+                    settings.scrubProxies = value;
+                    p.settings->setPlayback(settings);
+                });
         }
 
         PlaybackSettingsWidget::PlaybackSettingsWidget() :
@@ -4,8 +4,18 @@
 #include "djv-test.h"
 
 #include <djv/ModelsTest/AudioModelTest.h>
+#include <djv/ModelsTest/CacheWarmUpModelTest.h>
+#include <djv/ModelsTest/CompressedImageCacheTest.h>
 #include <djv/ModelsTest/FilesModelTest.h>
+#include <djv/ModelsTest/FrameBufferPoolTest.h>
+#include <djv/ModelsTest/ImageDiskCacheTest.h>
+#include <djv/ModelsTest/ImageUtilTest.h>
+#include <djv/ModelsTest/MemoryModelTest.h>
+#include <djv/ModelsTest/ReadThreadModelTest.h>
 #include <djv/ModelsTest/RecentFilesModelTest.h>
+#include <djv/ModelsTest/ScopesTest.h>
+#include <djv/ModelsTest/SeqCacheTest.h>
+#include <djv/ModelsTest/ThreadPoolTest.h>
 #include <djv/ModelsTest/TimeUnitsModelTest.h>
 #include <djv/ModelsTest/ToolsModelTest.h>
 #include <djv/ModelsTest/ViewportModelTest.h>
@@ -54,8 +64,18 @@ namespace djv
 
             // Models tests.
             p.tests.push_back(models_tests::AudioModelTest::create(context));
+            p.tests.push_back(models_tests::CacheWarmUpModelTest::create(context));
+            p.tests.push_back(models_tests::CompressedImageCacheTest::create(context));
             p.tests.push_back(models_tests::FilesModelTest::create(context));
+            p.tests.push_back(models_tests::FrameBufferPoolTest::create(context));
+            p.tests.push_back(models_tests::ImageDiskCacheTest::create(context));
+            p.tests.push_back(models_tests::ImageUtilTest::create(context));
+            p.tests.push_back(models_tests::MemoryModelTest::create(context));
+            p.tests.push_back(models_tests::ReadThreadModelTest::create(context));
             p.tests.push_back(models_tests::RecentFilesModelTest::create(context));
+            p.tests.push_back(models_tests::ScopesTest::create(context));
+            p.tests.push_back(models_tests::SeqCacheTest::create(context));
+            p.tests.push_back(models_tests::ThreadPoolTest::create(context));
             p.tests.push_back(models_tests::TimeUnitsModelTest::create(context));
             p.tests.push_back(models_tests::ToolsModelTest::create(context));
             p.tests.push_back(models_tests::ViewportModelTest::create(context));
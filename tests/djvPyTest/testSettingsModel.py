@@ -41,9 +41,33 @@ class SettingsModelTest(unittest.TestCase):
         model = djv.models.SettingsModel(self.context, self.settings, 1.0)
         playback = model.playback
         playback.startPlayback = not playback.startPlayback
+        playback.adaptiveResolution = not playback.adaptiveResolution
+        playback.scrubProxies = not playback.scrubProxies
         model.playback = playback
         self.assertEqual(playback, model.playback)
 
+    def test_diskCache(self):
+        model = djv.models.SettingsModel(self.context, self.settings, 1.0)
+        diskCache = model.diskCache
+        diskCache.frameGB = 100.0
+        diskCache.frameDir = self.tempDir
+        model.diskCache = diskCache
+        self.assertEqual(diskCache, model.diskCache)
+
+    def test_frameCache(self):
+        model = djv.models.SettingsModel(self.context, self.settings, 1.0)
+        frameCache = model.frameCache
+        frameCache.mode = djv.models.FrameCacheMode.Compressed
+        model.frameCache = frameCache
+        self.assertEqual(djv.models.FrameCacheMode.Compressed, model.frameCache.mode)
+
+    def test_memory(self):
+        model = djv.models.SettingsModel(self.context, self.settings, 1.0)
+        memory = model.memory
+        memory.budgetGB = 96.0
+        model.memory = memory
+        self.assertEqual(96.0, model.memory.budgetGB)
+
     def test_timeline(self):
         model = djv.models.SettingsModel(self.context, self.settings, 1.0)
         timeline = model.timeline